@@ -0,0 +1,571 @@
+#include <net/if.h>
+#include <errno.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <netlink/genl/genl.h>
+#include <netlink/genl/family.h>
+#include <netlink/genl/ctrl.h>
+#include <netlink/msg.h>
+#include <netlink/attr.h>
+
+#include "nl80211.h"
+#include "iw.h"
+
+SECTION(airtime);
+
+/*
+ * Closed-loop airtime balancing: every interval the airtime (tx + rx
+ * duration) each station used is compared with the share the config
+ * file asks for, and the airtime weight of the stations that are off by
+ * more than the hysteresis is scaled towards the target. A weight moves
+ * by at most max-step per change and a station that was just changed is
+ * left alone for holdoff intervals, so the loop doesn't oscillate.
+ *
+ * The config file holds one "<MAC address> <share in %>" per target
+ * station, plus optional tunables:
+ *
+ *	hysteresis <percentage points>	(default 2)
+ *	max-step <percent>		(default 25)
+ *	holdoff <intervals>		(default 2)
+ *	min-weight <weight>		(default 16)
+ *	max-weight <weight>		(default 4096)
+ *	min-airtime <us>		(default 10000)
+ *
+ * Intervals in which the stations used less than min-airtime in total
+ * are considered idle and don't change anything.
+ */
+#define AIRTIME_DEFAULT_WEIGHT	256
+
+struct airtime_target {
+	unsigned char addr[ETH_ALEN];
+	double share;
+	uint16_t weight;	/* weight we believe the station has */
+	bool have_weight;
+	int holdoff;
+	bool changed;
+};
+
+struct airtime_cfg {
+	struct airtime_target *targets;
+	int n_targets;
+	double hysteresis;
+	double max_step;
+	int holdoff;
+	unsigned int min_weight, max_weight;
+	uint64_t min_airtime;
+	bool dry_run;
+};
+
+struct airtime_sta {
+	unsigned char addr[ETH_ALEN];
+	uint64_t airtime;	/* tx + rx duration, us */
+	uint16_t weight;
+	bool have_weight;
+};
+
+struct airtime_sample {
+	struct airtime_sta *sta;
+	int n, size;
+};
+
+static struct airtime_sta *airtime_sample_find(struct airtime_sample *s,
+					       const unsigned char *addr)
+{
+	int i;
+
+	for (i = 0; i < s->n; i++)
+		if (!memcmp(s->sta[i].addr, addr, ETH_ALEN))
+			return &s->sta[i];
+	return NULL;
+}
+
+static struct airtime_sta *airtime_sample_add(struct airtime_sample *s,
+					      const unsigned char *addr)
+{
+	struct airtime_sta *sta;
+
+	if (s->n == s->size) {
+		int size = s->size ? s->size * 2 : 32;
+
+		sta = realloc(s->sta, size * sizeof(*sta));
+		if (!sta)
+			return NULL;
+		s->sta = sta;
+		s->size = size;
+	}
+
+	sta = &s->sta[s->n++];
+	memset(sta, 0, sizeof(*sta));
+	memcpy(sta->addr, addr, ETH_ALEN);
+	return sta;
+}
+
+static int airtime_parse_cfg(struct airtime_cfg *cfg, const char *file)
+{
+	char line[256], key[64], *p;
+	struct airtime_target *t;
+	double val, total = 0;
+	int line_num = 0, err = 0;
+	FILE *f;
+
+	cfg->hysteresis = 2;
+	cfg->max_step = 0.25;
+	cfg->holdoff = 2;
+	cfg->min_weight = 16;
+	cfg->max_weight = 4096;
+	cfg->min_airtime = 10000;
+
+	f = fopen(file, "r");
+	if (!f) {
+		fprintf(stderr, "cannot open %s: %s\n", file, strerror(errno));
+		return -errno;
+	}
+
+	while (!err && fgets(line, sizeof(line), f)) {
+		line_num++;
+		p = strchr(line, '#');
+		if (p)
+			*p = '\0';
+		if (sscanf(line, "%63s %lf", key, &val) != 2) {
+			if (sscanf(line, "%63s", key) == 1)
+				err = -EINVAL;
+			continue;
+		}
+
+		if (!strcmp(key, "hysteresis") && val >= 0) {
+			cfg->hysteresis = val;
+		} else if (!strcmp(key, "max-step") && val > 0 && val < 100) {
+			cfg->max_step = val / 100;
+		} else if (!strcmp(key, "holdoff") && val >= 0) {
+			cfg->holdoff = val;
+		} else if (!strcmp(key, "min-weight") && val >= 1 && val <= 0xffff) {
+			cfg->min_weight = val;
+		} else if (!strcmp(key, "max-weight") && val >= 1 && val <= 0xffff) {
+			cfg->max_weight = val;
+		} else if (!strcmp(key, "min-airtime") && val >= 0) {
+			cfg->min_airtime = val;
+		} else if (val > 0 && val <= 100) {
+			t = realloc(cfg->targets,
+				    (cfg->n_targets + 1) * sizeof(*t));
+			if (!t) {
+				err = -ENOMEM;
+				break;
+			}
+			cfg->targets = t;
+			t = &cfg->targets[cfg->n_targets];
+			memset(t, 0, sizeof(*t));
+			if (mac_addr_a2n(t->addr, key)) {
+				err = -EINVAL;
+				continue;
+			}
+			t->share = val;
+			total += val;
+			cfg->n_targets++;
+		} else {
+			err = -EINVAL;
+		}
+	}
+
+	fclose(f);
+
+	if (err == -EINVAL)
+		fprintf(stderr, "%s:%d: invalid line\n", file, line_num);
+	else if (!err && !cfg->n_targets)
+		fprintf(stderr, "%s: no target stations\n", file);
+	else if (!err && total > 100)
+		fprintf(stderr, "%s: target shares add up to %.1f%%\n",
+			file, total);
+	else if (!err && cfg->min_weight > cfg->max_weight)
+		fprintf(stderr, "%s: min-weight is above max-weight\n", file);
+	else
+		return err;
+
+	return err ? err : -EINVAL;
+}
+
+/*
+ * One controller step from the previous to the current sample; marks
+ * the targets whose weight changed. Stations missing in the previous
+ * sample (or whose counters went backwards) only give a baseline.
+ */
+static int airtime_step(struct airtime_cfg *cfg, struct airtime_sample *prev,
+			struct airtime_sample *cur)
+{
+	struct airtime_sta *sta, *old;
+	struct airtime_target *t;
+	uint64_t total = 0, delta;
+	double measured, factor;
+	char mac_addr[20];
+	long weight;
+	bool hold;
+	int i, changes = 0;
+
+	for (i = 0; i < cur->n; i++) {
+		old = airtime_sample_find(prev, cur->sta[i].addr);
+		if (old && cur->sta[i].airtime >= old->airtime)
+			total += cur->sta[i].airtime - old->airtime;
+	}
+
+	if (total < cfg->min_airtime) {
+		printf("idle (%llu us airtime)\n", (unsigned long long)total);
+		return 0;
+	}
+
+	for (i = 0; i < cfg->n_targets; i++) {
+		t = &cfg->targets[i];
+		t->changed = false;
+		mac_addr_n2a(mac_addr, t->addr);
+
+		sta = airtime_sample_find(cur, t->addr);
+		old = airtime_sample_find(prev, t->addr);
+		if (!sta) {
+			printf("%s target %5.1f%%  not associated\n",
+			       mac_addr, t->share);
+			t->have_weight = false;
+			continue;
+		}
+
+		/* a live weight wins, unless we only pretend to set it */
+		if (!t->have_weight || (!cfg->dry_run && sta->have_weight)) {
+			t->weight = sta->have_weight ? sta->weight :
+						       AIRTIME_DEFAULT_WEIGHT;
+			t->have_weight = true;
+		}
+
+		if (!old || sta->airtime < old->airtime) {
+			printf("%s target %5.1f%%  (new or reset)\n",
+			       mac_addr, t->share);
+			continue;
+		}
+
+		delta = sta->airtime - old->airtime;
+		measured = delta * 100.0 / total;
+		printf("%s target %5.1f%%  measured %5.1f%%  weight %u",
+		       mac_addr, t->share, measured, t->weight);
+
+		hold = t->holdoff > 0;
+		if (hold)
+			t->holdoff--;
+
+		if (measured > t->share - cfg->hysteresis &&
+		    measured < t->share + cfg->hysteresis) {
+			printf("\n");
+			continue;
+		}
+		if (hold) {
+			printf(" (hold)\n");
+			continue;
+		}
+
+		factor = measured > 0 ? t->share / measured : 1 + cfg->max_step;
+		if (factor > 1 + cfg->max_step)
+			factor = 1 + cfg->max_step;
+		if (factor < 1 - cfg->max_step)
+			factor = 1 - cfg->max_step;
+
+		weight = (long)(t->weight * factor + 0.5);
+		if (weight < (long)cfg->min_weight)
+			weight = cfg->min_weight;
+		if (weight > (long)cfg->max_weight)
+			weight = cfg->max_weight;
+
+		if (weight == t->weight) {
+			printf(" (at limit)\n");
+			continue;
+		}
+
+		printf(" -> %ld\n", weight);
+		t->weight = weight;
+		t->holdoff = cfg->holdoff;
+		t->changed = true;
+		changes++;
+	}
+
+	return changes;
+}
+
+static void airtime_sample_swap(struct airtime_sample *a,
+				struct airtime_sample *b)
+{
+	struct airtime_sample tmp = *a;
+
+	*a = *b;
+	*b = tmp;
+	b->n = 0;
+}
+
+static int airtime_sta_handler(struct nl_msg *msg, void *arg)
+{
+	struct airtime_sample *s = arg;
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr *sinfo[NL80211_STA_INFO_MAX + 1];
+	struct airtime_sta *sta;
+
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+
+	if (!tb[NL80211_ATTR_MAC] || !tb[NL80211_ATTR_STA_INFO] ||
+	    nla_parse_nested(sinfo, NL80211_STA_INFO_MAX,
+			     tb[NL80211_ATTR_STA_INFO], NULL))
+		return NL_SKIP;
+
+	sta = airtime_sample_add(s, nla_data(tb[NL80211_ATTR_MAC]));
+	if (!sta)
+		return NL_SKIP;
+
+	if (sinfo[NL80211_STA_INFO_TX_DURATION])
+		sta->airtime += nla_get_u64(sinfo[NL80211_STA_INFO_TX_DURATION]);
+	if (sinfo[NL80211_STA_INFO_RX_DURATION])
+		sta->airtime += nla_get_u64(sinfo[NL80211_STA_INFO_RX_DURATION]);
+	if (sinfo[NL80211_STA_INFO_AIRTIME_WEIGHT]) {
+		sta->weight = nla_get_u16(sinfo[NL80211_STA_INFO_AIRTIME_WEIGHT]);
+		sta->have_weight = true;
+	}
+
+	return NL_SKIP;
+}
+
+static int airtime_sample_live(struct nl80211_state *state, int ifindex,
+			       struct airtime_sample *s)
+{
+	struct nl80211_batch_req req = {};
+	int err;
+
+	req.msg = nl80211_batch_msg(state, NL80211_CMD_GET_STATION,
+				    NLM_F_DUMP, ifindex);
+	if (!req.msg)
+		return -ENOMEM;
+	req.handler = airtime_sta_handler;
+	req.arg = s;
+
+	err = nl80211_batch(state, &req, 1, 1);
+	nlmsg_free(req.msg);
+	return err ? err : req.err;
+}
+
+/* set the changed weights, all requests pipelined */
+static void airtime_apply(struct nl80211_state *state, int ifindex,
+			  struct airtime_cfg *cfg, uint16_t *old_weight)
+{
+	struct nl80211_batch_req *reqs;
+	struct airtime_target *t;
+	char mac_addr[20];
+	int i;
+
+	reqs = calloc(cfg->n_targets, sizeof(*reqs));
+	if (!reqs)
+		return;
+
+	for (i = 0; i < cfg->n_targets; i++) {
+		t = &cfg->targets[i];
+		if (!t->changed)
+			continue;
+		reqs[i].msg = nl80211_batch_msg(state, NL80211_CMD_SET_STATION,
+						0, ifindex);
+		if (reqs[i].msg &&
+		    (nla_put(reqs[i].msg, NL80211_ATTR_MAC, ETH_ALEN, t->addr) ||
+		     nla_put_u16(reqs[i].msg, NL80211_ATTR_AIRTIME_WEIGHT,
+				 t->weight))) {
+			nlmsg_free(reqs[i].msg);
+			reqs[i].msg = NULL;
+		}
+	}
+
+	nl80211_batch(state, reqs, cfg->n_targets, 0);
+
+	for (i = 0; i < cfg->n_targets; i++) {
+		t = &cfg->targets[i];
+		if (!t->changed)
+			continue;
+		if (reqs[i].err) {
+			mac_addr_n2a(mac_addr, t->addr);
+			fprintf(stderr, "%s: setting airtime weight failed: %s%s%s\n",
+				mac_addr, strerror(-reqs[i].err),
+				reqs[i].ext_msg[0] ? ", kernel reports: " : "",
+				reqs[i].ext_msg);
+			t->weight = old_weight[i];
+		}
+		nlmsg_free(reqs[i].msg);
+	}
+
+	free(reqs);
+}
+
+static int handle_airtime_balance(struct nl80211_state *state,
+				  struct nl_msg *msg,
+				  int argc, char **argv,
+				  enum id_input id)
+{
+	struct airtime_cfg cfg = {};
+	struct airtime_sample prev = {}, cur = {};
+	unsigned long interval_ms = 1000, count = 0, n;
+	uint16_t *old_weight = NULL;
+	int ifindex, err, i, used;
+
+	ifindex = if_nametoindex(argv[0]);
+	if (!ifindex)
+		return -ENODEV;
+
+	/* we get the full command line, skip "<dev> airtime balance" */
+	argc -= 3;
+	argv += 3;
+
+	if (argc < 1)
+		return HANDLER_RET_USAGE;
+	err = airtime_parse_cfg(&cfg, argv[0]);
+	if (err)
+		return 2;
+	argc--;
+	argv++;
+
+	while (argc) {
+		if (!strcmp(argv[0], "--dry-run")) {
+			cfg.dry_run = true;
+			argc--;
+			argv++;
+			continue;
+		}
+		used = parse_interval_count(argc, argv, &interval_ms, &count);
+		if (used <= 0)
+			goto usage;
+		argc -= used;
+		argv += used;
+	}
+
+	old_weight = calloc(cfg.n_targets, sizeof(*old_weight));
+	if (!old_weight) {
+		err = -ENOMEM;
+		goto out;
+	}
+
+	err = airtime_sample_live(state, ifindex, &prev);
+	for (n = 1; !err && (!count || n <= count); n++) {
+		usleep(interval_ms * 1000);
+
+		err = airtime_sample_live(state, ifindex, &cur);
+		if (err)
+			break;
+
+		for (i = 0; i < cfg.n_targets; i++)
+			old_weight[i] = cfg.targets[i].weight;
+		if (airtime_step(&cfg, &prev, &cur) && !cfg.dry_run)
+			airtime_apply(state, ifindex, &cfg, old_weight);
+		printf("\n");
+		fflush(stdout);
+
+		airtime_sample_swap(&prev, &cur);
+	}
+
+ out:
+	free(old_weight);
+	free(prev.sta);
+	free(cur.sta);
+	free(cfg.targets);
+	return err;
+ usage:
+	err = HANDLER_RET_USAGE;
+	goto out;
+}
+COMMAND(airtime, balance, "<config file> [--interval <ms>] [--count <n>] [--dry-run]",
+	0, 0, CIB_NETDEV, handle_airtime_balance,
+	"Keep the stations listed in the config file at their target share\n"
+	"of the airtime used by all stations, by adjusting their airtime\n"
+	"weight every <ms> milliseconds (default 1000). The config file has\n"
+	"one '<MAC address> <share in %>' line per station and optional\n"
+	"hysteresis, max-step, holdoff, min-weight, max-weight and\n"
+	"min-airtime lines. --dry-run only prints what would be changed.");
+
+/*
+ * Offline run of the controller over a recorded 'station dump' output,
+ * e.g. from a loop of 'iw dev wlan0 station dump; echo ---; sleep 1'.
+ * A sample ends at a line starting with "---" or when a station shows
+ * up a second time. Weights are simulated, nothing is sent.
+ */
+static void airtime_replay_flush(struct airtime_cfg *cfg,
+				 struct airtime_sample *prev,
+				 struct airtime_sample *cur, int *n)
+{
+	if (!cur->n)
+		return;
+
+	if (*n >= 0) {
+		printf("sample %d:\n", *n + 1);
+		airtime_step(cfg, prev, cur);
+		printf("\n");
+	}
+	(*n)++;
+	airtime_sample_swap(prev, cur);
+}
+
+static int handle_airtime_replay(struct nl80211_state *state,
+				 struct nl_msg *msg,
+				 int argc, char **argv,
+				 enum id_input id)
+{
+	struct airtime_cfg cfg = {};
+	struct airtime_sample prev = {}, cur = {};
+	struct airtime_sta *sta = NULL;
+	unsigned char addr[ETH_ALEN];
+	unsigned long long val;
+	char line[256], mac[20];
+	bool is_sta;
+	int n = -1, err;
+	FILE *f;
+
+	/* we get the full command line, skip "airtime replay" */
+	argc -= 2;
+	argv += 2;
+
+	if (argc != 2)
+		return HANDLER_RET_USAGE;
+
+	err = airtime_parse_cfg(&cfg, argv[0]);
+	if (err)
+		return 2;
+	cfg.dry_run = true;
+
+	f = fopen(argv[1], "r");
+	if (!f) {
+		fprintf(stderr, "cannot open %s: %s\n", argv[1], strerror(errno));
+		free(cfg.targets);
+		return 2;
+	}
+
+	while (fgets(line, sizeof(line), f)) {
+		is_sta = sscanf(line, "Station %19s", mac) == 1 &&
+			 !mac_addr_a2n(addr, mac);
+
+		if (!strncmp(line, "---", 3) ||
+		    (is_sta && airtime_sample_find(&cur, addr))) {
+			airtime_replay_flush(&cfg, &prev, &cur, &n);
+			sta = NULL;
+		}
+
+		if (is_sta)
+			sta = airtime_sample_add(&cur, addr);
+		else if (sta && sscanf(line, " tx duration: %llu", &val) == 1)
+			sta->airtime += val;
+		else if (sta && sscanf(line, " rx duration: %llu", &val) == 1)
+			sta->airtime += val;
+		else if (sta && sscanf(line, " airtime weight: %llu", &val) == 1) {
+			sta->weight = val;
+			sta->have_weight = true;
+		}
+	}
+	airtime_replay_flush(&cfg, &prev, &cur, &n);
+
+	fclose(f);
+	free(prev.sta);
+	free(cur.sta);
+	free(cfg.targets);
+	return 0;
+}
+COMMAND(airtime, replay, "<config file> <recorded station dump>",
+	0, 0, CIB_NONE, handle_airtime_replay,
+	"Run the 'airtime balance' controller over a recorded 'station dump'\n"
+	"output (samples separated by '---' lines) and print the weight\n"
+	"changes it would make.");
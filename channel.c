@@ -0,0 +1,949 @@
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <net/if.h>
+
+#include <netlink/genl/genl.h>
+#include <netlink/genl/family.h>
+#include <netlink/genl/ctrl.h>
+#include <netlink/msg.h>
+#include <netlink/attr.h>
+
+#include "nl80211.h"
+#include "iw.h"
+
+SECTION(channel);
+
+/*
+ * Channel ranking: every 20 MHz channel of the phy gets a cost out of
+ *
+ *  - the share of its active time the survey saw it busy with traffic
+ *    that wasn't our own transmissions,
+ *  - the neighbor BSSs in the scan results, each weighted by signal
+ *    strength (and on 2.4 GHz by how far its channel overlaps),
+ *  - the highest channel utilisation advertised in a neighbor's BSS
+ *    Load element,
+ *  - the DFS state (a channel that still needs a CAC costs more than
+ *    one that is available, unavailable ones are left out),
+ *  - the noise floor above -95 dBm.
+ *
+ * Wider channels are ranked as blocks of their 20 MHz members; half of
+ * the average and half of the worst member's cost, so one bad member
+ * spoils the block. Ties go to the lower frequency and nothing depends
+ * on the order in which the inputs arrive, so the same inputs always
+ * give the same ranking: 'iw channel rank' with recorded output of
+ * 'iw phy X channels', 'iw dev Y survey dump' and 'iw dev Y scan dump'
+ * computes exactly what 'iw phy X channel rank' prints live. The one
+ * exception is 320 MHz: 'iw phy X channels' doesn't list it as a
+ * channel width, so recorded input never has 320 MHz blocks.
+ *
+ * The vendor channel data (intel_vendor_channel_data) is only sent as
+ * an event during ACS and cannot be queried, so it isn't used here.
+ */
+#define RANK_MAX_CHANNELS	256
+
+#define RANK_W_UTIL		40.0
+#define RANK_W_NEIGHBOR		10.0
+#define RANK_W_LOAD		20.0
+#define RANK_COST_CAC		10.0
+#define RANK_COST_DFS		2.0
+#define RANK_NOISE_REF		-95
+
+enum rank_dfs {
+	RANK_DFS_NONE,
+	RANK_DFS_USABLE,
+	RANK_DFS_AVAILABLE,
+	RANK_DFS_UNAVAILABLE,
+};
+
+enum rank_factor {
+	RANK_F_UTIL,
+	RANK_F_NEIGHBOR,
+	RANK_F_LOAD,
+	RANK_F_DFS,
+	RANK_F_NOISE,
+	__RANK_F_NUM
+};
+
+struct rank_chan {
+	uint32_t freq;
+	int chan, band;
+	bool disabled, radar;
+	enum rank_dfs dfs;
+	/* widths the phy and regulatory allow with this channel */
+	bool ht40_plus, ht40_minus, vht80, vht160, eht320;
+
+	bool have_survey, have_busy, have_tx, have_noise;
+	uint64_t active, busy, tx;
+	int noise;
+
+	/* filled in by rank_compute() */
+	int n_bss, max_load;
+	double cost[__RANK_F_NUM];
+	double total;
+};
+
+struct rank_bss {
+	uint32_t freq;
+	bool have_signal;
+	int signal;		/* dBm */
+	int load;		/* BSS Load channel utilisation, -1 if none */
+};
+
+struct rank_state {
+	int wiphy;
+	struct rank_chan chans[RANK_MAX_CHANNELS];
+	int n_chans;
+	struct rank_bss *bss;
+	int n_bss, size_bss;
+
+	/* band capabilities while parsing the (split) wiphy dump */
+	bool band_40[NUM_NL80211_BANDS];
+	bool band_80[NUM_NL80211_BANDS];
+	bool band_160[NUM_NL80211_BANDS];
+	bool band_320[NUM_NL80211_BANDS];
+	int ifindex;
+};
+
+static struct rank_state rank_state;
+
+struct rank_block {
+	struct rank_chan *members[16];
+	int n;
+	struct rank_chan *primary;
+	double cost[__RANK_F_NUM];
+	double total;
+};
+
+static struct rank_chan *rank_find(struct rank_state *rs, uint32_t freq)
+{
+	int i;
+
+	for (i = 0; i < rs->n_chans; i++)
+		if (rs->chans[i].freq == freq)
+			return &rs->chans[i];
+	return NULL;
+}
+
+static struct rank_chan *rank_add(struct rank_state *rs, uint32_t freq)
+{
+	struct rank_chan *c = rank_find(rs, freq);
+
+	if (c)
+		return c;
+	if (rs->n_chans == RANK_MAX_CHANNELS)
+		return NULL;
+
+	c = &rs->chans[rs->n_chans++];
+	memset(c, 0, sizeof(*c));
+	c->freq = freq;
+	c->chan = ieee80211_frequency_to_channel(freq);
+	if (freq < 2500)
+		c->band = NL80211_BAND_2GHZ;
+	else if (freq < 5950)
+		c->band = NL80211_BAND_5GHZ;
+	else
+		c->band = NL80211_BAND_6GHZ;
+	return c;
+}
+
+static struct rank_bss *rank_add_bss(struct rank_state *rs, uint32_t freq)
+{
+	struct rank_bss *b;
+
+	if (rs->n_bss == rs->size_bss) {
+		int size = rs->size_bss ? rs->size_bss * 2 : 64;
+
+		b = realloc(rs->bss, size * sizeof(*b));
+		if (!b)
+			return NULL;
+		rs->bss = b;
+		rs->size_bss = size;
+	}
+
+	b = &rs->bss[rs->n_bss++];
+	memset(b, 0, sizeof(*b));
+	b->freq = freq;
+	b->load = -1;
+	return b;
+}
+
+static double rank_clamp(double v, double min, double max)
+{
+	if (v < min)
+		return min;
+	if (v > max)
+		return max;
+	return v;
+}
+
+static void rank_compute(struct rank_state *rs)
+{
+	int i, j;
+
+	for (i = 0; i < rs->n_chans; i++) {
+		struct rank_chan *c = &rs->chans[i];
+		double neighbors = 0;
+
+		c->n_bss = 0;
+		c->max_load = -1;
+
+		for (j = 0; j < rs->n_bss; j++) {
+			struct rank_bss *b = &rs->bss[j];
+			double overlap, weight = 0.5;
+			int d;
+
+			d = abs(ieee80211_frequency_to_channel(b->freq) - c->chan);
+			if (c->band == NL80211_BAND_2GHZ && b->freq < 2500)
+				overlap = rank_clamp(1.0 - d / 5.0, 0, 1);
+			else
+				overlap = b->freq == c->freq;
+			if (!overlap)
+				continue;
+
+			if (b->have_signal)
+				weight = rank_clamp((b->signal + 90) / 40.0, 0, 1);
+			neighbors += overlap * weight;
+
+			if (b->freq != c->freq)
+				continue;
+			c->n_bss++;
+			if (b->load > c->max_load)
+				c->max_load = b->load;
+		}
+
+		memset(c->cost, 0, sizeof(c->cost));
+		if (c->have_survey && c->have_busy && c->active) {
+			uint64_t foreign = c->busy;
+
+			if (c->have_tx)
+				foreign = c->busy > c->tx ? c->busy - c->tx : 0;
+			c->cost[RANK_F_UTIL] = RANK_W_UTIL *
+				rank_clamp((double)foreign / c->active, 0, 1);
+		}
+		c->cost[RANK_F_NEIGHBOR] = RANK_W_NEIGHBOR * neighbors;
+		if (c->max_load >= 0)
+			c->cost[RANK_F_LOAD] = RANK_W_LOAD * c->max_load / 255.0;
+		if (c->dfs == RANK_DFS_USABLE ||
+		    (c->radar && c->dfs == RANK_DFS_NONE))
+			c->cost[RANK_F_DFS] = RANK_COST_CAC;
+		else if (c->dfs == RANK_DFS_AVAILABLE)
+			c->cost[RANK_F_DFS] = RANK_COST_DFS;
+		if (c->have_noise && c->noise > RANK_NOISE_REF)
+			c->cost[RANK_F_NOISE] = c->noise - RANK_NOISE_REF;
+
+		c->total = 0;
+		for (j = 0; j < __RANK_F_NUM; j++)
+			c->total += c->cost[j];
+	}
+}
+
+static bool rank_usable(struct rank_chan *c)
+{
+	return c && !c->disabled && c->dfs != RANK_DFS_UNAVAILABLE;
+}
+
+/* first channel of the 20 MHz raster the channel's block is aligned to */
+static int rank_block_base(struct rank_chan *c)
+{
+	if (c->band == NL80211_BAND_6GHZ)
+		return 1;
+	if (c->chan >= 149)
+		return 149;
+	if (c->chan >= 100)
+		return 100;
+	return 36;
+}
+
+static bool rank_width_ok(struct rank_chan *c, int width)
+{
+	switch (width) {
+	case 40:
+		return c->ht40_plus || c->ht40_minus;
+	case 80:
+		return c->vht80;
+	case 160:
+		return c->vht160;
+	case 320:
+		return c->eht320;
+	}
+	return true;
+}
+
+/*
+ * Build the block of <width> MHz starting at channel <start> out of
+ * 20 MHz channels <step> apart; false if any member is missing or
+ * can't be used at that width.
+ */
+static bool rank_build_block(struct rank_state *rs, struct rank_block *blk,
+			     int band, int start, int width, int step)
+{
+	double avg = 0, worst = 0;
+	int i, j;
+
+	memset(blk, 0, sizeof(*blk));
+	blk->n = width / 20;
+
+	for (i = 0; i < blk->n; i++) {
+		struct rank_chan *c = NULL;
+
+		for (j = 0; j < rs->n_chans; j++) {
+			if (rs->chans[j].band == band &&
+			    rs->chans[j].chan == start + i * step) {
+				c = &rs->chans[j];
+				break;
+			}
+		}
+		if (!rank_usable(c) || !rank_width_ok(c, width))
+			return false;
+		blk->members[i] = c;
+	}
+
+	for (i = 0; i < blk->n; i++) {
+		struct rank_chan *c = blk->members[i];
+
+		for (j = 0; j < __RANK_F_NUM; j++)
+			blk->cost[j] += c->cost[j] / blk->n;
+		if (!blk->primary || c->total < blk->primary->total)
+			blk->primary = c;
+	}
+
+	/* the worst member, not just the average, decides */
+	for (i = 0; i < blk->n; i++) {
+		avg += blk->members[i]->total / blk->n;
+		if (blk->members[i]->total > worst)
+			worst = blk->members[i]->total;
+	}
+	blk->total = (avg + worst) / 2;
+	return true;
+}
+
+static int rank_block_cmp(const void *_a, const void *_b)
+{
+	const struct rank_block *a = _a, *b = _b;
+
+	if (a->total < b->total)
+		return -1;
+	if (a->total > b->total)
+		return 1;
+	return a->members[0]->freq < b->members[0]->freq ? -1 :
+	       a->members[0]->freq > b->members[0]->freq;
+}
+
+static int rank_print_width(struct rank_state *rs, int width)
+{
+	struct rank_block *blks;
+	int n = 0, i, j;
+
+	blks = calloc(rs->n_chans * 2, sizeof(*blks));
+	if (!blks)
+		return -ENOMEM;
+
+	for (i = 0; i < rs->n_chans; i++) {
+		struct rank_chan *c = &rs->chans[i];
+		int n20 = width / 20;
+
+		if (c->band == NL80211_BAND_2GHZ) {
+			/* 20 MHz, and HT40+ made of the channel and +4 */
+			if (width == 20 &&
+			    rank_build_block(rs, &blks[n], c->band, c->chan, 20, 4))
+				n++;
+			else if (width == 40 && c->ht40_plus &&
+				 rank_build_block(rs, &blks[n], c->band, c->chan,
+						  40, 4))
+				n++;
+			continue;
+		}
+
+		if (width == 320) {
+			/* 320 MHz only exists on 6 GHz, in two overlapping rasters */
+			if (c->band != NL80211_BAND_6GHZ ||
+			    ((c->chan - 1) % 64 && (c->chan - 33) % 64))
+				continue;
+		} else if ((c->chan - rank_block_base(c)) % (n20 * 4)) {
+			continue;
+		}
+
+		if (rank_build_block(rs, &blks[n], c->band, c->chan, width, 4))
+			n++;
+	}
+
+	qsort(blks, n, sizeof(*blks), rank_block_cmp);
+
+	printf("%d MHz:\n", width);
+	if (!n) {
+		printf("\tno usable channels\n");
+		free(blks);
+		return 0;
+	}
+
+	printf("  %4s  %-9s %7s %7s %6s %6s %6s %6s %6s %5s %5s\n",
+	       "rank", "channels", "primary", "cost", "util", "neigh", "load",
+	       "dfs", "noise", "bss", "bssld");
+	for (i = 0; i < n; i++) {
+		struct rank_block *b = &blks[i];
+		char chans[16];
+		int n_bss = 0, max_load = -1;
+
+		for (j = 0; j < b->n; j++) {
+			n_bss += b->members[j]->n_bss;
+			if (b->members[j]->max_load > max_load)
+				max_load = b->members[j]->max_load;
+		}
+
+		if (b->n == 1)
+			snprintf(chans, sizeof(chans), "%d", b->members[0]->chan);
+		else
+			snprintf(chans, sizeof(chans), "%d-%d",
+				 b->members[0]->chan, b->members[b->n - 1]->chan);
+
+		printf("  %4d  %-9s %7d %7.1f", i + 1, chans, b->primary->chan,
+		       b->total);
+		for (j = 0; j < __RANK_F_NUM; j++)
+			printf(" %6.1f", b->cost[j]);
+		printf(" %5d", n_bss);
+		if (max_load >= 0)
+			printf(" %4d%%\n", max_load * 100 / 255);
+		else
+			printf(" %5s\n", "-");
+	}
+	printf("\n");
+
+	free(blks);
+	return 0;
+}
+
+static int rank_print(struct rank_state *rs, int width)
+{
+	static const int widths[] = { 20, 40, 80, 160, 320 };
+	bool have_6g = false;
+	unsigned int i;
+	int err;
+
+	rank_compute(rs);
+
+	if (width)
+		return rank_print_width(rs, width);
+
+	for (i = 0; i < (unsigned int)rs->n_chans; i++)
+		if (rs->chans[i].band == NL80211_BAND_6GHZ)
+			have_6g = true;
+
+	for (i = 0; i < ARRAY_SIZE(widths); i++) {
+		if (widths[i] == 320 && !have_6g)
+			continue;
+		err = rank_print_width(rs, widths[i]);
+		if (err)
+			return err;
+	}
+	return 0;
+}
+
+static int rank_parse_width(const char *arg)
+{
+	char *end;
+	long w = strtol(arg, &end, 10);
+
+	if (*end || (w != 20 && w != 40 && w != 80 && w != 160 && w != 320))
+		return -1;
+	return w;
+}
+
+/* live collection */
+
+static int rank_wiphy_handler(struct nl_msg *msg, void *arg)
+{
+	struct rank_state *rs = arg;
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr *tb_band[NL80211_BAND_ATTR_MAX + 1];
+	struct nlattr *tb_freq[NL80211_FREQUENCY_ATTR_MAX + 1];
+	struct nlattr *nl_band, *nl_freq, *nl_iftype;
+	int rem_band, rem_freq, rem_iftype;
+
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+
+	if (tb[NL80211_ATTR_WIPHY])
+		rs->wiphy = nla_get_u32(tb[NL80211_ATTR_WIPHY]);
+
+	if (!tb[NL80211_ATTR_WIPHY_BANDS])
+		return NL_SKIP;
+
+	nla_for_each_nested(nl_band, tb[NL80211_ATTR_WIPHY_BANDS], rem_band) {
+		int band = nl_band->nla_type;
+
+		if (band >= NUM_NL80211_BANDS)
+			continue;
+
+		nla_parse(tb_band, NL80211_BAND_ATTR_MAX, nla_data(nl_band),
+			  nla_len(nl_band), NULL);
+
+		if (tb_band[NL80211_BAND_ATTR_HT_CAPA] &&
+		    nla_get_u16(tb_band[NL80211_BAND_ATTR_HT_CAPA]) & BIT(1))
+			rs->band_40[band] = true;
+
+		if (tb_band[NL80211_BAND_ATTR_VHT_CAPA]) {
+			uint32_t capa = nla_get_u32(tb_band[NL80211_BAND_ATTR_VHT_CAPA]);
+
+			rs->band_80[band] = true;
+			if ((capa >> 2) & 3)
+				rs->band_160[band] = true;
+		}
+
+		/* as in 'iw phy X channels', HE/EHT implies all widths */
+		if (tb_band[NL80211_BAND_ATTR_IFTYPE_DATA]) {
+			nla_for_each_nested(nl_iftype,
+					    tb_band[NL80211_BAND_ATTR_IFTYPE_DATA],
+					    rem_iftype) {
+				struct nlattr *tb_if[NL80211_BAND_IFTYPE_ATTR_MAX + 1];
+				struct nlattr *eht;
+
+				nla_parse(tb_if, NL80211_BAND_IFTYPE_ATTR_MAX,
+					  nla_data(nl_iftype), nla_len(nl_iftype),
+					  NULL);
+				eht = tb_if[NL80211_BAND_IFTYPE_ATTR_EHT_CAP_PHY];
+				if (tb_if[NL80211_BAND_IFTYPE_ATTR_HE_CAP_PHY] || eht)
+					rs->band_40[band] = rs->band_80[band] =
+						rs->band_160[band] = true;
+
+				/* EHT PHY capabilities B1: 320 MHz in 6 GHz */
+				if (eht && nla_len(eht) &&
+				    *(uint8_t *)nla_data(eht) & BIT(1))
+					rs->band_320[band] = true;
+			}
+		}
+
+		if (!tb_band[NL80211_BAND_ATTR_FREQS])
+			continue;
+
+		nla_for_each_nested(nl_freq, tb_band[NL80211_BAND_ATTR_FREQS],
+				    rem_freq) {
+			struct rank_chan *c;
+
+			nla_parse(tb_freq, NL80211_FREQUENCY_ATTR_MAX,
+				  nla_data(nl_freq), nla_len(nl_freq), NULL);
+			if (!tb_freq[NL80211_FREQUENCY_ATTR_FREQ])
+				continue;
+
+			c = rank_add(rs, nla_get_u32(tb_freq[NL80211_FREQUENCY_ATTR_FREQ]));
+			if (!c)
+				continue;
+			c->band = band;
+			c->disabled = !!tb_freq[NL80211_FREQUENCY_ATTR_DISABLED];
+			c->radar = !!tb_freq[NL80211_FREQUENCY_ATTR_RADAR];
+			/* the band capabilities are applied in rank_apply_caps() */
+			c->ht40_plus = !tb_freq[NL80211_FREQUENCY_ATTR_NO_HT40_PLUS];
+			c->ht40_minus = !tb_freq[NL80211_FREQUENCY_ATTR_NO_HT40_MINUS];
+			c->vht80 = !tb_freq[NL80211_FREQUENCY_ATTR_NO_80MHZ];
+			c->vht160 = !tb_freq[NL80211_FREQUENCY_ATTR_NO_160MHZ];
+			c->eht320 = !tb_freq[NL80211_FREQUENCY_ATTR_NO_320MHZ];
+
+			if (tb_freq[NL80211_FREQUENCY_ATTR_DFS_STATE]) {
+				switch (nla_get_u32(tb_freq[NL80211_FREQUENCY_ATTR_DFS_STATE])) {
+				case NL80211_DFS_USABLE:
+					c->dfs = RANK_DFS_USABLE;
+					break;
+				case NL80211_DFS_AVAILABLE:
+					c->dfs = RANK_DFS_AVAILABLE;
+					break;
+				case NL80211_DFS_UNAVAILABLE:
+					c->dfs = RANK_DFS_UNAVAILABLE;
+					break;
+				}
+			}
+		}
+	}
+
+	return NL_SKIP;
+}
+
+static void rank_apply_caps(struct rank_state *rs)
+{
+	int i;
+
+	for (i = 0; i < rs->n_chans; i++) {
+		struct rank_chan *c = &rs->chans[i];
+
+		c->ht40_plus &= rs->band_40[c->band];
+		c->ht40_minus &= rs->band_40[c->band];
+		c->vht80 &= rs->band_80[c->band];
+		c->vht160 &= rs->band_160[c->band];
+		c->eht320 &= rs->band_320[c->band];
+	}
+}
+
+static int rank_iface_handler(struct nl_msg *msg, void *arg)
+{
+	struct rank_state *rs = arg;
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+
+	if (rs->ifindex || !tb[NL80211_ATTR_IFINDEX] || !tb[NL80211_ATTR_WIPHY] ||
+	    nla_get_u32(tb[NL80211_ATTR_WIPHY]) != (uint32_t)rs->wiphy)
+		return NL_SKIP;
+
+	rs->ifindex = nla_get_u32(tb[NL80211_ATTR_IFINDEX]);
+	return NL_SKIP;
+}
+
+static int rank_survey_handler(struct nl_msg *msg, void *arg)
+{
+	struct rank_state *rs = arg;
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr *sinfo[NL80211_SURVEY_INFO_MAX + 1];
+	struct rank_chan *c;
+
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+
+	if (!tb[NL80211_ATTR_SURVEY_INFO] ||
+	    nla_parse_nested(sinfo, NL80211_SURVEY_INFO_MAX,
+			     tb[NL80211_ATTR_SURVEY_INFO], NULL) ||
+	    !sinfo[NL80211_SURVEY_INFO_FREQUENCY])
+		return NL_SKIP;
+
+	c = rank_find(rs, nla_get_u32(sinfo[NL80211_SURVEY_INFO_FREQUENCY]));
+	if (!c)
+		return NL_SKIP;
+
+	if (sinfo[NL80211_SURVEY_INFO_CHANNEL_TIME]) {
+		c->have_survey = true;
+		c->active = nla_get_u64(sinfo[NL80211_SURVEY_INFO_CHANNEL_TIME]);
+	}
+	if (sinfo[NL80211_SURVEY_INFO_CHANNEL_TIME_BUSY]) {
+		c->have_busy = true;
+		c->busy = nla_get_u64(sinfo[NL80211_SURVEY_INFO_CHANNEL_TIME_BUSY]);
+	}
+	if (sinfo[NL80211_SURVEY_INFO_CHANNEL_TIME_TX]) {
+		c->have_tx = true;
+		c->tx = nla_get_u64(sinfo[NL80211_SURVEY_INFO_CHANNEL_TIME_TX]);
+	}
+	if (sinfo[NL80211_SURVEY_INFO_NOISE]) {
+		c->have_noise = true;
+		c->noise = (int8_t)nla_get_u8(sinfo[NL80211_SURVEY_INFO_NOISE]);
+	}
+	return NL_SKIP;
+}
+
+static int rank_scan_handler(struct nl_msg *msg, void *arg)
+{
+	struct rank_state *rs = arg;
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr *bss[NL80211_BSS_MAX + 1];
+	struct nlattr *ies;
+	struct rank_bss *b;
+
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+
+	if (!tb[NL80211_ATTR_BSS] ||
+	    nla_parse_nested(bss, NL80211_BSS_MAX, tb[NL80211_ATTR_BSS], NULL) ||
+	    !bss[NL80211_BSS_FREQUENCY])
+		return NL_SKIP;
+
+	b = rank_add_bss(rs, nla_get_u32(bss[NL80211_BSS_FREQUENCY]));
+	if (!b)
+		return NL_SKIP;
+
+	if (bss[NL80211_BSS_SIGNAL_MBM]) {
+		b->have_signal = true;
+		b->signal = (int)nla_get_u32(bss[NL80211_BSS_SIGNAL_MBM]) / 100;
+	}
+
+	ies = bss[NL80211_BSS_INFORMATION_ELEMENTS];
+	if (!ies)
+		ies = bss[NL80211_BSS_BEACON_IES];
+	if (ies) {
+		const uint8_t *ie = nla_data(ies);
+		int len = nla_len(ies);
+
+		/* BSS Load: station count (2), channel utilisation (1), ... */
+		while (len >= 2 && len >= ie[1] + 2) {
+			if (ie[0] == 11 && ie[1] >= 5) {
+				b->load = ie[4];
+				break;
+			}
+			len -= ie[1] + 2;
+			ie += ie[1] + 2;
+		}
+	}
+	return NL_SKIP;
+}
+
+static int handle_channel_rank_wiphy(struct nl80211_state *state,
+				     struct nl_msg *msg,
+				     int argc, char **argv,
+				     enum id_input id)
+{
+	nla_put_flag(msg, NL80211_ATTR_SPLIT_WIPHY_DUMP);
+	register_handler(rank_wiphy_handler, &rank_state);
+	return 0;
+}
+HIDDEN(channel, rank_wiphy, NULL, NL80211_CMD_GET_WIPHY, NLM_F_DUMP, CIB_PHY,
+	handle_channel_rank_wiphy);
+
+static int handle_channel_rank(struct nl80211_state *state,
+			       struct nl_msg *msg,
+			       int argc, char **argv,
+			       enum id_input id)
+{
+	struct rank_state *rs = &rank_state;
+	struct nl80211_batch_req reqs[2] = {};
+	char *wiphy_argv[] = {
+		argv[0],
+		"channel",
+		"rank_wiphy",
+	};
+	int width = 0, err, i;
+
+	/* we get the full command line, skip "<phy> channel rank" */
+	argc -= 3;
+	argv += 3;
+
+	if (argc == 2 && !strcmp(argv[0], "--bw"))
+		width = rank_parse_width(argv[1]);
+	else if (argc)
+		return HANDLER_RET_USAGE;
+	if (width < 0)
+		return HANDLER_RET_USAGE;
+
+	rs->wiphy = -1;
+	err = handle_cmd(state, id, ARRAY_SIZE(wiphy_argv), wiphy_argv);
+	if (err)
+		return err;
+	rank_apply_caps(rs);
+
+	reqs[0].msg = nl80211_batch_msg(state, NL80211_CMD_GET_INTERFACE,
+					NLM_F_DUMP, 0);
+	reqs[0].handler = rank_iface_handler;
+	reqs[0].arg = rs;
+	if (!reqs[0].msg)
+		return -ENOMEM;
+	err = nl80211_batch(state, reqs, 1, 0);
+	nlmsg_free(reqs[0].msg);
+	if (!err)
+		err = reqs[0].err;
+	if (err)
+		return err;
+	if (!rs->ifindex) {
+		fprintf(stderr, "no interface on this phy for survey and scan data\n");
+		return 2;
+	}
+
+	/* survey and cached scan results, both from the first interface */
+	memset(reqs, 0, sizeof(reqs));
+	reqs[0].msg = nl80211_batch_msg(state, NL80211_CMD_GET_SURVEY,
+					NLM_F_DUMP, rs->ifindex);
+	reqs[0].handler = rank_survey_handler;
+	reqs[1].msg = nl80211_batch_msg(state, NL80211_CMD_GET_SCAN,
+					NLM_F_DUMP, rs->ifindex);
+	reqs[1].handler = rank_scan_handler;
+	reqs[0].arg = reqs[1].arg = rs;
+
+	err = -ENOMEM;
+	if (reqs[0].msg && reqs[1].msg)
+		err = nl80211_batch(state, reqs, 2, 0);
+	for (i = 0; i < 2; i++) {
+		nlmsg_free(reqs[i].msg);
+		/* either may be unsupported, rank with what we have */
+		if (!err && reqs[i].err)
+			fprintf(stderr, "%s: %s (ignored)\n",
+				i ? "scan dump" : "survey dump",
+				strerror(-reqs[i].err));
+	}
+
+	if (!err)
+		err = rank_print(rs, width);
+	free(rs->bss);
+	return err;
+}
+COMMAND(channel, rank, "[--bw <20|40|80|160|320>]", 0, 0, CIB_PHY,
+	handle_channel_rank,
+	"Rank the channels of the phy for the given bandwidth (default all)\n"
+	"by a cost made of survey utilization (busy but not our tx), neighbor\n"
+	"BSSs weighted by signal, their BSS Load channel utilisation, DFS\n"
+	"state and noise floor, with the per-factor breakdown. The survey\n"
+	"and the cached scan results of the first interface of the phy are\n"
+	"used, run a scan first for fresh neighbor data.");
+
+/* recorded inputs */
+
+static FILE *rank_open(const char *name)
+{
+	FILE *f = fopen(name, "r");
+
+	if (!f)
+		fprintf(stderr, "%s: %s\n", name, strerror(errno));
+	return f;
+}
+
+/* 'iw phy X channels' */
+static int rank_read_channels(struct rank_state *rs, const char *name)
+{
+	struct rank_chan *c = NULL;
+	char line[512], *p;
+	FILE *f;
+
+	f = rank_open(name);
+	if (!f)
+		return 2;
+
+	while (fgets(line, sizeof(line), f)) {
+		unsigned int freq;
+
+		if (sscanf(line, "\t* %u MHz", &freq) == 1) {
+			c = rank_add(rs, freq);
+			if (c) {
+				c->disabled = !!strstr(line, "(disabled)");
+				c->ht40_plus = c->ht40_minus = false;
+				c->vht80 = c->vht160 = c->eht320 = false;
+			}
+			continue;
+		}
+		if (!c)
+			continue;
+
+		if (strstr(line, "Radar detection")) {
+			c->radar = true;
+		} else if ((p = strstr(line, "Channel widths:"))) {
+			c->ht40_plus = !!strstr(p, "HT40+");
+			c->ht40_minus = !!strstr(p, "HT40-");
+			c->vht80 = !!strstr(p, "VHT80");
+			c->vht160 = !!strstr(p, "VHT160");
+		} else if ((p = strstr(line, "DFS state: "))) {
+			p += strlen("DFS state: ");
+			if (!strncmp(p, "usable", 6))
+				c->dfs = RANK_DFS_USABLE;
+			else if (!strncmp(p, "available", 9))
+				c->dfs = RANK_DFS_AVAILABLE;
+			else if (!strncmp(p, "unavailable", 11))
+				c->dfs = RANK_DFS_UNAVAILABLE;
+		}
+	}
+
+	fclose(f);
+	return 0;
+}
+
+/* 'iw dev Y survey dump' */
+static int rank_read_survey(struct rank_state *rs, const char *name)
+{
+	struct rank_chan *c = NULL;
+	unsigned long long val;
+	char line[512];
+	unsigned int freq;
+	int noise;
+	FILE *f;
+
+	f = rank_open(name);
+	if (!f)
+		return 2;
+
+	while (fgets(line, sizeof(line), f)) {
+		if (!strncmp(line, "Survey data from", 16)) {
+			c = NULL;
+		} else if (sscanf(line, " frequency: %u MHz", &freq) == 1) {
+			c = rank_find(rs, freq);
+		} else if (!c) {
+			continue;
+		} else if (sscanf(line, " noise: %d dBm", &noise) == 1) {
+			c->have_noise = true;
+			c->noise = noise;
+		} else if (sscanf(line, " channel active time: %llu ms", &val) == 1) {
+			c->have_survey = true;
+			c->active = val;
+		} else if (sscanf(line, " channel busy time: %llu ms", &val) == 1) {
+			c->have_busy = true;
+			c->busy = val;
+		} else if (sscanf(line, " channel transmit time: %llu ms", &val) == 1) {
+			c->have_tx = true;
+			c->tx = val;
+		}
+	}
+
+	fclose(f);
+	return 0;
+}
+
+/* 'iw dev Y scan dump' */
+static int rank_read_scan(struct rank_state *rs, const char *name)
+{
+	struct rank_bss *b = NULL;
+	char line[1024];
+	unsigned int freq;
+	double signal;
+	int load;
+	FILE *f;
+
+	f = rank_open(name);
+	if (!f)
+		return 2;
+
+	/* the frequency follows the BSS line, so add the entry there */
+	while (fgets(line, sizeof(line), f)) {
+		if (!strncmp(line, "BSS ", 4)) {
+			b = NULL;
+		} else if (!b && sscanf(line, "\tfreq: %u", &freq) == 1) {
+			b = rank_add_bss(rs, freq);
+			if (!b) {
+				fclose(f);
+				return -ENOMEM;
+			}
+		} else if (!b) {
+			continue;
+		} else if (sscanf(line, "\tsignal: %lf dBm", &signal) == 1) {
+			b->have_signal = true;
+			b->signal = (int)signal;
+		} else if (sscanf(line, "\t\t * channel utilisation: %d/255",
+				  &load) == 1) {
+			b->load = load;
+		}
+	}
+
+	fclose(f);
+	return 0;
+}
+
+static int handle_channel_rank_recorded(struct nl80211_state *state,
+					struct nl_msg *msg,
+					int argc, char **argv,
+					enum id_input id)
+{
+	struct rank_state *rs = &rank_state;
+	int width = 0, err;
+
+	/* we get the full command line, skip "channel rank" */
+	argc -= 2;
+	argv += 2;
+
+	if (argc == 5 && !strcmp(argv[3], "--bw"))
+		width = rank_parse_width(argv[4]);
+	else if (argc != 3)
+		return HANDLER_RET_USAGE;
+	if (width < 0)
+		return HANDLER_RET_USAGE;
+
+	err = rank_read_channels(rs, argv[0]);
+	if (!err)
+		err = rank_read_survey(rs, argv[1]);
+	if (!err)
+		err = rank_read_scan(rs, argv[2]);
+	if (!err)
+		err = rank_print(rs, width);
+
+	free(rs->bss);
+	return err;
+}
+COMMAND(channel, rank, "<channels> <survey dump> <scan dump> [--bw <20|40|80|160|320>]",
+	0, 0, CIB_NONE, handle_channel_rank_recorded,
+	"Rank channels as 'iw phy X channel rank' does, but from recorded\n"
+	"output of 'iw phy X channels', 'iw dev Y survey dump' and\n"
+	"'iw dev Y scan dump'.");
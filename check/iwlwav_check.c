@@ -0,0 +1,682 @@
+/*! \file  iwlwav_check.c
+ *  \brief Host-side check of the iwlwav command table
+ *
+ * Every iwlwav command that is now a 'struct iwlwav_cmd' table entry used
+ * to be a handler calling set_int(), set_text(), set_addr() or
+ * sub_cmd_print_{int,text}_function(). The old_cmds[] list below names
+ * each of them with the encoder and vendor sub command of that handler
+ * and a sample command line. For each one the message built by
+ * iwlwav_cmd_put() (through iwlwav_cmd_encode()) must carry the same
+ * vendor sub command and be byte-identical to the message the old
+ * handler built, and every table entry must be in the list.
+ *
+ * Run by 'make check'. It includes iwlwav.c to reach its static table
+ * and links against util.o and libnl only, so nothing is sent anywhere.
+ */
+
+#include "../iwlwav.c"
+
+/* iw.c isn't linked in, these are all iwlwav.c needs from it */
+int iw_debug;
+
+void register_handler(int (*handler)(struct nl_msg *, void *), void *data)
+{
+}
+
+struct nl_msg *nl80211_batch_msg(struct nl80211_state *state, int cmd,
+				 int flags, int ifindex)
+{
+	return NULL;
+}
+
+int nl80211_batch(struct nl80211_state *state,
+		  struct nl80211_batch_req *reqs, int n_reqs, int window)
+{
+	return -EOPNOTSUPP;
+}
+
+/********************** ENCODERS BEFORE THE TABLE ***********************/
+/*
+ * Copies of the encoders the old handlers called, as reference. They
+ * only differ in that set_text() didn't clear its buffer, so the bytes
+ * after the string were whatever malloc() returned; here they are zero,
+ * as the table encodes them.
+ */
+static int old_set_int(struct nl_msg *msg, int argc, char **argv,
+		       int min_num_of_params, int max_num_of_params,
+		       enum ltq_nl80211_vendor_subcmds subcmd)
+{
+	int *data;
+	int array_size = sizeof(int) * argc;
+	int i;
+
+	if (argc < min_num_of_params || argc > max_num_of_params)
+		return -EINVAL;
+
+	data = (int *) malloc(array_size);
+	if (!data)
+		return -ENOMEM;
+
+	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ);
+	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_SUBCMD, subcmd);
+
+	for (i = 0; i < argc; i++)
+		if (sscanf(argv[i], "%i", &data[i]) != 1)
+			goto nla_put_failure;
+	NLA_PUT(msg, NL80211_ATTR_VENDOR_DATA, array_size, (char *) data);
+
+	free(data);
+	return 0;
+
+nla_put_failure:
+	free(data);
+	return -ENOBUFS;
+}
+
+static int old_set_text(struct nl_msg *msg, int argc, char **argv,
+			int min_num_of_params, int max_num_of_params,
+			enum ltq_nl80211_vendor_subcmds subcmd)
+{
+	char *data;
+
+	if (argc < min_num_of_params || argc > max_num_of_params)
+		return -EINVAL;
+
+	data = (char *) calloc(1, TEXT_ARRAY_SIZE);
+	if (!data)
+		return -ENOMEM;
+
+	strncpy_s(data, TEXT_ARRAY_SIZE, argv[0], strnlen_s(argv[0], TEXT_ARRAY_SIZE));
+
+	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ);
+	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_SUBCMD, subcmd);
+
+	NLA_PUT(msg, NL80211_ATTR_VENDOR_DATA, TEXT_ARRAY_SIZE, data);
+
+	free(data);
+	return 0;
+
+nla_put_failure:
+	free(data);
+	return -ENOBUFS;
+}
+
+static int old_set_addr(struct nl_msg *msg, int argc, char **argv,
+			enum ltq_nl80211_vendor_subcmds subcmd)
+{
+	unsigned int data[SET_ADDR_LEN];
+	int i, count;
+	uint8_t data8[SET_ADDR_LEN];
+	uint16_t sa_family = 1;
+
+	if (argc != 1)
+		return -EINVAL;
+
+	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ);
+	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_SUBCMD, subcmd);
+
+	memcpy_s(data8, sizeof(data8), &sa_family, sizeof(sa_family));
+
+	count = sscanf(argv[0], "%2x:%2x:%2x:%2x:%2x:%2x",
+		       &data[2], &data[3], &data[4], &data[5], &data[6], &data[7]);
+
+	if (count != 6)
+		return -EINVAL;
+
+	for (i = 2; i < SET_ADDR_LEN; i++)
+		data8[i] = (uint8_t) data[i];
+
+	NLA_PUT(msg, NL80211_ATTR_VENDOR_DATA, SET_ADDR_LEN, (char *) data8);
+
+	return 0;
+
+nla_put_failure:
+	return -ENOBUFS;
+}
+
+/* sub_cmd_print_{int,text}_function(), without the reply handler */
+static int old_get(struct nl_msg *msg, enum ltq_nl80211_vendor_subcmds subcmd)
+{
+	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ);
+	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_SUBCMD, subcmd);
+
+	return 0;
+nla_put_failure:
+	return -ENOBUFS;
+}
+
+/***************************** OLD COMMANDS *****************************/
+enum old_encoder {
+	OLD_SET_INT,
+	OLD_SET_TEXT,
+	OLD_SET_ADDR,
+	OLD_GET_INT,
+	OLD_GET_TEXT,
+};
+
+#define OLD_MAX_ARGS	16
+
+static const struct old_cmd {
+	const char *name;
+	enum old_encoder encoder;
+	/* argument limits the old handler passed to set_int()/set_text() */
+	int min_args, max_args;
+	enum ltq_nl80211_vendor_subcmds subcmd;
+	const char *argv[OLD_MAX_ARGS];
+} old_cmds[] = {
+	{ "sMtlkLogLevel", OLD_SET_INT, 1, 3, LTQ_NL80211_VENDOR_SUBCMD_SET_MTLK_LOG_LEVEL,
+	  { "1", "2", "3" } },
+	{ "s11hRadarDetect", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_11H_RADAR_DETECT,
+	  { "1" } },
+	{ "s11hChCheckTime", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_11H_CH_CHECK_TIME,
+	  { "1" } },
+	{ "emulateInterferer", OLD_SET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_EMULATE_INTERFERER, { } },
+	{ "sAddPeerAP", OLD_SET_ADDR, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_ADD_PEERAP,
+	  { "00:11:22:33:44:55" } },
+	{ "sDelPeerAP", OLD_SET_ADDR, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_DEL_PEERAP,
+	  { "00:11:22:33:44:55" } },
+	{ "sPeerAPkeyIdx", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_PEERAP_KEY_IDX,
+	  { "1" } },
+	{ "sBridgeMode", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_BRIDGE_MODE,
+	  { "1" } },
+	{ "sReliableMcast", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_RELIABLE_MULTICAST,
+	  { "1" } },
+	{ "sAPforwarding", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_AP_FORWARDING,
+	  { "1" } },
+	{ "sLtPathEnabled", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_DCDP_API_LITEPATH,
+	  { "1" } },
+	{ "sIpxPpaEnabled", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_DCDP_API_LITEPATH_COMP,
+	  { "1" } },
+	{ "sCoCPower", OLD_SET_INT, 1, 9, LTQ_NL80211_VENDOR_SUBCMD_SET_COC_POWER_MODE,
+	  { "1", "2", "3", "4", "5", "6", "7", "8", "9" } },
+	{ "sCoCAutoCfg", OLD_SET_INT, 10, 17, LTQ_NL80211_VENDOR_SUBCMD_SET_COC_AUTO_PARAMS,
+	  { "1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11", "12",
+	    "13", "14", "15", "16" } },
+	{ "sTpcLoopType", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_PRM_ID_TPC_LOOP_TYPE,
+	  { "1" } },
+	{ "sInterfDetThresh", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_INTERFER_THRESH,
+	  { "1" } },
+	{ "s11bAntSelection", OLD_SET_INT, 3, 3, LTQ_NL80211_VENDOR_SUBCMD_SET_11B_ANTENNA_SELECTION,
+	  { "1", "2", "3" } },
+	{ "sFWRecovery", OLD_SET_INT, 5, 5, LTQ_NL80211_VENDOR_SUBCMD_SET_FW_RECOVERY,
+	  { "1", "2", "3", "4", "5" } },
+	{ "sOOScanCaching", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_OUT_OF_SCAN_CACHING,
+	  { "1" } },
+	{ "sEnableRadio", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_RADIO_MODE,
+	  { "1" } },
+	{ "sAggrConfig", OLD_SET_INT, 2, 3, LTQ_NL80211_VENDOR_SUBCMD_SET_AGGR_CONFIG,
+	  { "1", "2", "3" } },
+	{ "sNumMsduInAmsdu", OLD_SET_INT, 1, 4, LTQ_NL80211_VENDOR_SUBCMD_SET_AMSDU_NUM,
+	  { "1", "2", "3", "4" } },
+	{ "sAggRateLimit", OLD_SET_INT, 2, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_AGG_RATE_LIMIT,
+	  { "1", "2" } },
+	{ "sMuOfdmaBf", OLD_SET_INT, 2, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_MU_OFDMA_BF,
+	  { "1", "2" } },
+	{ "sAvailAdmCap", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_ADMISSION_CAPACITY,
+	  { "1" } },
+	{ "sSetRxTH", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_RX_THRESHOLD,
+	  { "1" } },
+	{ "sRxDutyCyc", OLD_SET_INT, 2, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_RX_DUTY_CYCLE,
+	  { "1", "2" } },
+	{ "sPowerSelection", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_TX_POWER_LIMIT_OFFSET,
+	  { "1" } },
+	{ "s11nProtection", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_PROTECTION_METHOD,
+	  { "1" } },
+	{ "sCalibOnDemand", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_TEMPERATURE_SENSOR,
+	  { "1" } },
+	{ "sQAMplus", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_QAMPLUS_MODE,
+	  { "1" } },
+	{ "sAcsUpdateTo", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_ACS_UPDATE_TO,
+	  { "1" } },
+	{ "sMuOperation", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_MU_OPERATION,
+	  { "1" } },
+	{ "sCcaTh", OLD_SET_INT, 5, 5, LTQ_NL80211_VENDOR_SUBCMD_SET_CCA_THRESHOLD,
+	  { "1", "2", "3", "4", "5" } },
+	{ "sCcaAdapt", OLD_SET_INT, 7, 7, LTQ_NL80211_VENDOR_SUBCMD_SET_CCA_ADAPT,
+	  { "1", "2", "3", "4", "5", "6", "7" } },
+	{ "sRadarRssiTh", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_RADAR_RSSI_TH,
+	  { "1" } },
+	{ "sFilsBeaconFlag", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_FILS_BEACON_FLAG,
+	  { "1" } },
+	{ "sRTSmode", OLD_SET_INT, 2, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_RTS_MODE,
+	  { "1", "2" } },
+	{ "sMaxMpduLen", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_MAX_MPDU_LENGTH,
+	  { "1" } },
+	{ "sBfMode", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_BF_MODE,
+	  { "1" } },
+	{ "sProbeReqCltMode", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_CLT_PROBE_REQS_MODE,
+	  { "1" } },
+	{ "sActiveAntMask", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_ACTIVE_ANT_MASK,
+	  { "1" } },
+	{ "sAddFourAddrSta", OLD_SET_ADDR, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_4ADDR_STA_ADD,
+	  { "00:11:22:33:44:55" } },
+	{ "sDelFourAddrSta", OLD_SET_ADDR, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_4ADDR_STA_DEL,
+	  { "00:11:22:33:44:55" } },
+	{ "sTxopConfig", OLD_SET_INT, 4, 4, LTQ_NL80211_VENDOR_SUBCMD_SET_TXOP_CONFIG,
+	  { "1", "2", "3", "4" } },
+	{ "sSsbMode", OLD_SET_INT, 2, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_SSB_MODE,
+	  { "1", "2" } },
+	{ "sMcastRange", OLD_SET_TEXT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_MCAST_RANGE_SETUP,
+	  { "check" } },
+	{ "sMcastRange6", OLD_SET_TEXT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_MCAST_RANGE_SETUP_IPV6,
+	  { "check" } },
+	{ "sFwrdUnkwnMcast", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_FORWARD_UNKNOWN_MCAST_FLAG,
+	  { "1" } },
+	{ "sOnlineACM", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_ONLINE_CALIBRATION_ALGO_MASK,
+	  { "1" } },
+	{ "sAlgoCalibrMask", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_CALIBRATION_ALGO_MASK,
+	  { "1" } },
+	{ "sWhmReset", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_WHM_RESET,
+	  { "1" } },
+	{ "sWhmTrigger", OLD_SET_INT, 1, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_WHM_TRIGGER,
+	  { "1", "2" } },
+	{ "sRestrictAcMode", OLD_SET_INT, 4, 4, LTQ_NL80211_VENDOR_SUBCMD_SET_RESTRICTED_AC_MODE,
+	  { "1", "2", "3", "4" } },
+	{ "sPdThresh", OLD_SET_INT, 3, 3, LTQ_NL80211_VENDOR_SUBCMD_SET_PD_THRESHOLD,
+	  { "1", "2", "3" } },
+	{ "sFastDrop", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_FAST_DROP,
+	  { "1" } },
+	{ "sErpSet", OLD_SET_INT, 10, 10, LTQ_NL80211_VENDOR_SUBCMD_SET_ERP,
+	  { "1", "2", "3", "4", "5", "6", "7", "8", "9", "10" } },
+	{ "sPreamPunCcaOvr", OLD_SET_INT, 3, 3, LTQ_NL80211_VENDOR_SUBCMD_SET_CCA_PREAMBLE_PUNCTURE_CFG,
+	  { "1", "2", "3" } },
+	{ "sRtsRate", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_RTS_RATE,
+	  { "1" } },
+	{ "sStationsStat", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_STATIONS_STATISTICS,
+	  { "1" } },
+	{ "sStatsPollPeriod", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_STATS_POLL_PERIOD,
+	  { "1" } },
+	{ "sDynamicMu", OLD_SET_INT, 5, 5, LTQ_NL80211_VENDOR_SUBCMD_SET_DYNAMIC_MU_TYPE,
+	  { "1", "2", "3", "4", "5" } },
+	{ "sMuFixedCfg", OLD_SET_INT, 4, 4, LTQ_NL80211_VENDOR_SUBCMD_SET_HE_MU_FIXED_PARAMETERS,
+	  { "1", "2", "3", "4" } },
+	{ "sMuDurationCfg", OLD_SET_INT, 4, 4, LTQ_NL80211_VENDOR_SUBCMD_SET_HE_MU_DURATION,
+	  { "1", "2", "3", "4" } },
+	{ "sETSILimitation", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_ETSI_PPDU_LIMITS,
+	  { "1" } },
+	{ "sTxRetryLimit", OLD_SET_INT, 3, 3, LTQ_NL80211_VENDOR_SUBCMD_SET_AP_RETRY_LIMIT,
+	  { "1", "2", "3" } },
+	{ "sTxExceRetryLimit", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_AP_EXCE_RETRY_LIMIT,
+	  { "1" } },
+	{ "sCtsToSelfTo", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_CTS_TO_SELF_TO,
+	  { "1" } },
+	{ "sTxAmpduDensity", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_TX_AMPDU_DENSITY,
+	  { "1" } },
+	{ "sSlowProbingMask", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_PROBING_MASK,
+	  { "1" } },
+	{ "sScanModifFlags", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_SCAN_MODIFS,
+	  { "1" } },
+	{ "sScanPauseBGCache", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_SCAN_PAUSE_BG_CACHE,
+	  { "1" } },
+	{ "sZwdfsAnt", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_ZWDFS_ANT,
+	  { "1" } },
+	{ "sConfigMRCoex", OLD_SET_INT, 4, 4, LTQ_NL80211_VENDOR_SUBCMD_SET_COEX_CFG,
+	  { "1", "2", "3", "4" } },
+	{ "sFixedLtfGi", OLD_SET_INT, 2, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_FIXED_LTF_AND_GI,
+	  { "1", "2" } },
+	{ "sMgmtFramePwrCtrl", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_MGMT_FRAME_PWR_CTRL,
+	  { "1" } },
+	{ "sCsiSendQosNull", OLD_SET_ADDR, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_CSI_SEND_NDP,
+	  { "00:11:22:33:44:55" } },
+	{ "sFixedRateCfg", OLD_SET_INT, 11, 11, LTQ_NL80211_VENDOR_SUBCMD_SET_FIXED_RATE,
+	  { "1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11" } },
+	{ "sAllow3AddrMcast", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_ALLOW_3ADDR_MCAST,
+	  { "1" } },
+	{ "sDoDebugAssert", OLD_SET_INT, 1, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_DBG_ASSERT,
+	  { "1", "2" } },
+	{ "sLoggerFifoMuxCfg", OLD_SET_INT, 1, 1, MXL_NL80211_VENDOR_SUBCMD_SET_LOGGER_FIFO_MUX_CFG,
+	  { "1" } },
+	{ "sMuStaRangeForGroupPerType", OLD_SET_INT, 3, 3, LTQ_NL80211_VENDOR_SUBCMD_SET_MU_GROUPS_CONFIG,
+	  { "1", "2", "3" } },
+	{ "sTIDlinkSpreading", OLD_SET_INT, 1, 3, LTQ_NL80211_VENDOR_SUBCMD_SET_STR_TID_LINK_SPREADING,
+	  { "1", "2", "3" } },
+	{ "sPcieAutoGenEnable", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_PCIE_AUTO_GEN_ENABLE,
+	  { "1" } },
+	{ "svWtest", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_VW_TEST_MODE,
+	  { "1" } },
+	{ "sStartCcaMsr", OLD_SET_INT, 2, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_START_CCA_MSR_OFF_CHAN,
+	  { "1", "2" } },
+	{ "sAdvertiseBcTwtSp", OLD_SET_INT, 8, 50, LTQ_NL80211_VENDOR_SUBCMD_ADVERTISE_BTWT_SCHEDULE,
+	  { "1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11", "12",
+	    "13", "14", "15", "16" } },
+	{ "sTerminateBcTwtSp", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_TERMINATE_BTWT_SCHEDULE,
+	  { "1" } },
+	{ "sTxTwtTeardown", OLD_SET_INT, 2, 4, LTQ_NL80211_VENDOR_SUBCMD_TX_TWT_TEARDOWN,
+	  { "1", "2", "3", "4" } },
+	{ "g11hRadarDetect", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_11H_RADAR_DETECT, { } },
+	{ "g11hChCheckTime", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_11H_CH_CHECK_TIME, { } },
+	{ "gPeerAPkeyIdx", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_PEERAP_KEY_IDX, { } },
+	{ "gPeerAPs", OLD_GET_TEXT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_PEERAP_LIST, { } },
+	{ "gBridgeMode", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_BRIDGE_MODE, { } },
+	{ "gReliableMcast", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_RELIABLE_MULTICAST, { } },
+	{ "gAPforwarding", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_AP_FORWARDING, { } },
+	{ "gEEPROM", OLD_GET_TEXT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_EEPROM, { } },
+	{ "gDataPathMode", OLD_GET_TEXT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_DCDP_DATAPATH_MODE, { } },
+	{ "gLtPathEnabled", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_DCDP_API_LITEPATH, { } },
+	{ "gIpxPpaEnabled", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_DCDP_API_LITEPATH_COMP, { } },
+	{ "gCoCPower", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_COC_POWER_MODE, { } },
+	{ "gCoCAutoCfg", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_COC_AUTO_PARAMS, { } },
+	{ "gErpSet", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_ERP_CFG, { } },
+	{ "gTpcLoopType", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_PRM_ID_TPC_LOOP_TYPE, { } },
+	{ "gInterfDetThresh", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_INTERFER_MODE, { } },
+	{ "gAPCapsMaxSTAs", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_AP_CAPABILITIES_MAX_STAs, { } },
+	{ "gAPCapsMaxVAPs", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_AP_CAPABILITIES_MAX_VAPs, { } },
+	{ "g11bAntSelection", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_11B_ANTENNA_SELECTION, { } },
+	{ "gFWRecovery", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_FW_RECOVERY, { } },
+	{ "gFWRecoveryStat", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_RCVRY_STATS, { } },
+	{ "gOOScanCaching", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_OUT_OF_SCAN_CACHING, { } },
+	{ "gAllowScanInCac", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_ALLOW_SCAN_DURING_CAC, { } },
+	{ "gEnableRadio", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_RADIO_MODE, { } },
+	{ "gAggrConfig", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_AGGR_CONFIG, { } },
+	{ "gNumMsduInAmsdu", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_AMSDU_NUM, { } },
+	{ "gAggRateLimit", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_AGG_RATE_LIMIT, { } },
+	{ "gMuOfdmaBf", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_MU_OFDMA_BF, { } },
+	{ "gAvailAdmCap", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_ADMISSION_CAPACITY, { } },
+	{ "gSetRxTH", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_RX_THRESHOLD, { } },
+	{ "gRxDutyCyc", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_RX_DUTY_CYCLE, { } },
+	{ "gPowerSelection", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_TX_POWER_LIMIT_OFFSET, { } },
+	{ "g11nProtection", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_PROTECTION_METHOD, { } },
+	{ "gTemperature", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_TEMPERATURE_SENSOR, { } },
+	{ "gQAMplus", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_QAMPLUS_MODE, { } },
+	{ "gAcsUpdateTo", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_ACS_UPDATE_TO, { } },
+	{ "gMuOperation", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_MU_OPERATION, { } },
+	{ "gCcaTh", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_CCA_THRESHOLD, { } },
+	{ "gCcaAdapt", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_CCA_ADAPT, { } },
+	{ "gRadarRssiTh", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_RADAR_RSSI_TH, { } },
+	{ "gvWtest", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_VW_TEST_MODE, { } },
+	{ "gFilsBeaconFlag", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_FILS_BEACON_FLAG, { } },
+	{ "gRTSmode", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_RTS_MODE, { } },
+	{ "gMaxMpduLen", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_MAX_MPDU_LENGTH, { } },
+	{ "gBfMode", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_BF_MODE, { } },
+	{ "gProbeReqCltMode", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_CLT_PROBE_REQS_MODE, { } },
+	{ "gActiveAntMask", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_ACTIVE_ANT_MASK, { } },
+	{ "gFourAddrStas", OLD_GET_TEXT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_4ADDR_STA_LIST, { } },
+	{ "gTxopConfig", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_TXOP_CONFIG, { } },
+	{ "gSsbMode", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_SSB_MODE, { } },
+	{ "gMcastRange", OLD_GET_TEXT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_MCAST_RANGE_SETUP, { } },
+	{ "gMcastRange6", OLD_GET_TEXT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_MCAST_RANGE_SETUP_IPV6, { } },
+	{ "gFwrdUnkwnMcast", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_FORWARD_UNKNOWN_MCAST_FLAG, { } },
+	{ "gOnlineACM", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_ONLINE_CALIBRATION_ALGO_MASK, { } },
+	{ "gAlgoCalibrMask", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_CALIBRATION_ALGO_MASK, { } },
+	{ "gRestrictAcMode", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_RESTRICTED_AC_MODE, { } },
+	{ "gPdThresh", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_PD_THRESHOLD, { } },
+	{ "gFastDrop", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_FAST_DROP, { } },
+	{ "gPVT", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_PVT_SENSOR, { } },
+	{ "gRtsRate", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_RTS_RATE, { } },
+	{ "gStationsStat", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_STATIONS_STATISTICS, { } },
+	{ "gRtsThreshold", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_RTS_THRESHOLD, { } },
+	{ "g20mhzTxPower", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_20MHZ_TX_POWER, { } },
+	{ "gStatsPollPeriod", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_STATS_POLL_PERIOD, { } },
+	{ "gDynamicMu", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_DYNAMIC_MU_TYPE, { } },
+	{ "gMuFixedCfg", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_HE_MU_FIXED_PARAMETERS, { } },
+	{ "gMuDurationCfg", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_HE_MU_DURATION, { } },
+	{ "gIBpowerPerAnt", OLD_GET_TEXT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_PHY_INBAND_POWER, { } },
+	{ "gETSILimitation", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_ETSI_PPDU_LIMITS, { } },
+	{ "gPreamPunCcaOvr", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_CCA_PREAMBLE_PUNCTURE_CFG, { } },
+	{ "gAxDefaultParams", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_AX_DEFAULT_PARAMS, { } },
+	{ "gTxRetryLimit", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_AP_RETRY_LIMIT, { } },
+	{ "gTxExceRetryLimit", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_AP_EXCE_RETRY_LIMIT, { } },
+	{ "gCtsToSelfTo", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_CTS_TO_SELF_TO, { } },
+	{ "gTxAmpduDensity", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_TX_AMPDU_DENSITY, { } },
+	{ "gGetCcaStats", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_CCA_STATS_CURRENT_CHAN, { } },
+	{ "gSlowProbingMask", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_PROBING_MASK, { } },
+	{ "gScanModifFlags", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_SCAN_MODIFS, { } },
+	{ "gScanPauseBGCache", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_SCAN_PAUSE_BG_CACHE, { } },
+	{ "gZwdfsAnt", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_ZWDFS_ANT, { } },
+	{ "gAdvertisedBcTwtSp", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_ADVERTISED_BTWT_SCHEDULE, { } },
+	{ "gConfigMRCoex", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_COEX_CFG, { } },
+	{ "gFixedLtfGi", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_FIXED_LTF_AND_GI, { } },
+	{ "gMgmtFramePwrCtrl", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_MGMT_FRAME_PWR_CTRL, { } },
+	{ "gAllow3AddrMcast", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_ALLOW_3ADDR_MCAST, { } },
+	{ "gLoggerFifoMuxCfg", OLD_GET_INT, 0, 0, MXL_NL80211_VENDOR_SUBCMD_GET_LOGGER_FIFO_MUX_CFG, { } },
+	{ "gPcieAutoGenEnable", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_PCIE_AUTO_GEN_ENABLE, { } },
+#ifdef WAVE_ENABLE_PIE
+	{ "sAqmEn", OLD_SET_INT, 2, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_AQM_STA_EN,
+	  { "1", "2" } },
+	{ "gPIEcfg", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_PIE_CFG, { } },
+#endif /* WAVE_ENABLE_PIE */
+#ifdef CONFIG_WAVE_DEBUG
+	{ "sFixedRateThermal", OLD_SET_INT, 1, 3, LTQ_NL80211_VENDOR_SUBCMD_SET_FIXED_RATE_THERMAL,
+	  { "1", "2", "3" } },
+	{ "sCountersSrc", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_COUNTERS_SRC,
+	  { "1" } },
+	{ "sUnconnTime", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_UNCONNECTED_STA_SCAN_TIME,
+	  { "1" } },
+	{ "sFixedPower", OLD_SET_INT, 4, 4, LTQ_NL80211_VENDOR_SUBCMD_SET_FIXED_POWER,
+	  { "1", "2", "3", "4" } },
+	{ "sCpuDmaLatency", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_CPU_DMA_LATENCY,
+	  { "1" } },
+	{ "sTaskletLimits", OLD_SET_INT, 5, 5, LTQ_NL80211_VENDOR_SUBCMD_SET_TASKLET_LIMITS,
+	  { "1", "2", "3", "4", "5" } },
+	{ "sScanExpTime", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_SCAN_EXP_TIME,
+	  { "1" } },
+	{ "sScanParams", OLD_SET_INT, 6, 6, LTQ_NL80211_VENDOR_SUBCMD_SET_SCAN_PARAMS,
+	  { "1", "2", "3", "4", "5", "6" } },
+	{ "sScanParamsBG", OLD_SET_INT, 10, 10, LTQ_NL80211_VENDOR_SUBCMD_SET_SCAN_PARAMS_BG,
+	  { "1", "2", "3", "4", "5", "6", "7", "8", "9", "10" } },
+	{ "sTATimerRes", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_TA_TIMER_RESOLUTION,
+	  { "1" } },
+	{ "sPCoCAutoCfg", OLD_SET_INT, 4, 4, LTQ_NL80211_VENDOR_SUBCMD_SET_PCOC_AUTO_PARAMS,
+	  { "1", "2", "3", "4" } },
+	{ "sPCoCPower", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_PCOC_POWER_MODE,
+	  { "1" } },
+	{ "sWDSHostTO", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_WDS_HOST_TIMEOUT,
+	  { "1" } },
+	{ "sMACWdPeriodMs", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_MAC_WATCHDOG_PERIOD_MS,
+	  { "1" } },
+	{ "sMACWdTimeoutMs", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_MAC_WATCHDOG_TIMEOUT_MS,
+	  { "1" } },
+	{ "sNonOccupatePrd", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_NON_OCCUPATED_PRD,
+	  { "1" } },
+	{ "s11hBeaconCount", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_11H_BEACON_COUNT,
+	  { "1" } },
+	{ "sEnableTestBus", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_ENABLE_TEST_BUS,
+	  { "1" } },
+	{ "sDoFwDebug", OLD_SET_INT, 1, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_FW_DEBUG,
+	  { "1", "2" } },
+	{ "sDoSimpleCLI", OLD_SET_INT, 1, 4, LTQ_NL80211_VENDOR_SUBCMD_SET_DBG_CLI,
+	  { "1", "2", "3", "4" } },
+	{ "sPMCUDebug", OLD_SET_INT, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_PCOC_PMCU_DEBUG,
+	  { "1" } },
+	{ "sFwLogSeverity", OLD_SET_INT, 2, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_FW_LOG_SEVERITY,
+	  { "1", "2" } },
+	{ "sDebugCmdFw", OLD_SET_INT, 3, 1000, LTQ_NL80211_VENDOR_SUBCMD_SET_DBG_CMD_FW,
+	  { "1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11", "12",
+	    "13", "14", "15", "16" } },
+	{ "sEnableRadarFiFoDump", OLD_SET_INT, 1, 3, LTQ_NL80211_VENDOR_SUBCMD_SET_RADAR_FIFO_DUMP,
+	  { "1", "2", "3" } },
+	{ "gFixedRateThermal", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_FIXED_RATE_THERMAL, { } },
+	{ "gCountersSrc", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_COUNTERS_SRC, { } },
+	{ "gUnconnTime", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_UNCONNECTED_STA_SCAN_TIME, { } },
+	{ "gFixedPower", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_FIXED_POWER, { } },
+	{ "gCpuDmaLatency", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_CPU_DMA_LATENCY, { } },
+	{ "gBfExplicitCap", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_BEAMFORM_EXPLICIT, { } },
+	{ "gTaskletLimits", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_TASKLET_LIMITS, { } },
+	{ "gGenlFamilyId", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_GENL_FAMILY_ID, { } },
+	{ "gScanExpTime", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_SCAN_EXP_TIME, { } },
+	{ "gScanParams", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_SCAN_PARAMS, { } },
+	{ "gScanParamsBG", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_SCAN_PARAMS_BG, { } },
+	{ "gTADbg", OLD_GET_TEXT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_TA_DBG, { } },
+	{ "gTATimerRes", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_TA_TIMER_RESOLUTION, { } },
+	{ "gPCoCAutoCfg", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_PCOC_AUTO_PARAMS, { } },
+	{ "gPCoCPower", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_PCOC_POWER_MODE, { } },
+	{ "gWDSHostTO", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_WDS_HOST_TIMEOUT, { } },
+	{ "gMACWdPeriodMs", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_MAC_WATCHDOG_PERIOD_MS, { } },
+	{ "gMACWdTimeoutMs", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_MAC_WATCHDOG_TIMEOUT_MS, { } },
+	{ "gNonOccupatePrd", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_NON_OCCUPATED_PRD, { } },
+	{ "g11hBeaconCount", OLD_GET_INT, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_GET_11H_BEACON_COUNT, { } },
+#endif /* CONFIG_WAVE_DEBUG */
+};
+
+static int old_put(const struct old_cmd *old, struct nl_msg *msg,
+		   int argc, char **argv)
+{
+	switch (old->encoder) {
+	case OLD_SET_INT:
+		return old_set_int(msg, argc, argv, old->min_args,
+				   old->max_args, old->subcmd);
+	case OLD_SET_TEXT:
+		return old_set_text(msg, argc, argv, old->min_args,
+				    old->max_args, old->subcmd);
+	case OLD_SET_ADDR:
+		return old_set_addr(msg, argc, argv, old->subcmd);
+	case OLD_GET_INT:
+	case OLD_GET_TEXT:
+		return old_get(msg, old->subcmd);
+	}
+	return -EINVAL;
+}
+
+/* the encoders may write to the arguments, as mac_addr_a2n() does */
+static char **copy_argv(const struct old_cmd *old, int argc,
+			char buf[][TEXT_ARRAY_SIZE], char **argv)
+{
+	int i;
+
+	for (i = 0; i < argc; i++) {
+		snprintf(buf[i], TEXT_ARRAY_SIZE, "%s", old->argv[i]);
+		argv[i] = buf[i];
+	}
+	return argv;
+}
+
+static void dump_msg(const char *prefix, struct nl_msg *msg)
+{
+	struct nlmsghdr *hdr = nlmsg_hdr(msg);
+
+	iw_hexdump(prefix, nlmsg_data(hdr), nlmsg_datalen(hdr));
+}
+
+static int check_cmd(const struct old_cmd *old)
+{
+	const struct iwlwav_cmd *cmd = iwlwav_cmd_find(old->name);
+	enum iwlwav_reply reply = IWLWAV_REPLY_NONE;
+	struct nl_msg *want = NULL, *got = NULL;
+	char buf[OLD_MAX_ARGS][TEXT_ARRAY_SIZE], *argv[OLD_MAX_ARGS];
+	struct nlmsghdr *w, *g;
+	int argc, err, ret = 1;
+
+	for (argc = 0; argc < OLD_MAX_ARGS && old->argv[argc]; argc++)
+		;
+
+	if (!cmd) {
+		fprintf(stderr, "%s: no table entry\n", old->name);
+		return 1;
+	}
+	if (cmd->subcmd != old->subcmd) {
+		fprintf(stderr, "%s: sub command %d, was %d\n", old->name,
+			cmd->subcmd, old->subcmd);
+		return 1;
+	}
+	if (old->encoder == OLD_GET_INT)
+		reply = IWLWAV_REPLY_INT;
+	else if (old->encoder == OLD_GET_TEXT)
+		reply = IWLWAV_REPLY_TEXT;
+	if (cmd->reply != reply) {
+		fprintf(stderr, "%s: reply type %d, was %d\n", old->name,
+			cmd->reply, reply);
+		return 1;
+	}
+	if ((old->encoder == OLD_SET_INT || old->encoder == OLD_SET_TEXT) &&
+	    (cmd->min_args != old->min_args || cmd->max_args != old->max_args)) {
+		fprintf(stderr, "%s: takes %d..%d arguments, took %d..%d\n",
+			old->name, cmd->min_args, cmd->max_args,
+			old->min_args, old->max_args);
+		return 1;
+	}
+
+	want = nlmsg_alloc();
+	got = nlmsg_alloc();
+	if (!want || !got) {
+		fprintf(stderr, "%s: %s\n", old->name, strerror(ENOMEM));
+		goto out;
+	}
+
+	err = old_put(old, want, argc, copy_argv(old, argc, buf, argv));
+	if (err) {
+		fprintf(stderr, "%s: old encoder failed: %d\n", old->name, err);
+		goto out;
+	}
+	err = iwlwav_cmd_put(cmd, got, argc, copy_argv(old, argc, buf, argv));
+	if (err) {
+		fprintf(stderr, "%s: iwlwav_cmd_put() failed: %d\n",
+			old->name, err);
+		goto out;
+	}
+
+	w = nlmsg_hdr(want);
+	g = nlmsg_hdr(got);
+	if (nlmsg_datalen(w) != nlmsg_datalen(g) ||
+	    memcmp(nlmsg_data(w), nlmsg_data(g), nlmsg_datalen(w))) {
+		fprintf(stderr, "%s: message differs\n", old->name);
+		dump_msg("was", want);
+		dump_msg("now", got);
+		goto out;
+	}
+	ret = 0;
+ out:
+	nlmsg_free(want);
+	nlmsg_free(got);
+	return ret;
+}
+
+/* an entry must accept as many integer arguments as it allows */
+static int check_max_args(const struct iwlwav_cmd *cmd)
+{
+	char buf[32], **argv;
+	struct nl_msg *msg;
+	int i, err;
+
+	if (!cmd->max_args || iwlwav_cmd_arg(cmd, 0)->type != IWLWAV_ARG_INT)
+		return 0;
+
+	msg = nlmsg_alloc();
+	argv = calloc(cmd->max_args, sizeof(*argv));
+	if (!msg || !argv) {
+		fprintf(stderr, "%s: %s\n", cmd->name, strerror(ENOMEM));
+		err = -ENOMEM;
+		goto out;
+	}
+	for (i = 0; i < cmd->max_args; i++) {
+		snprintf(buf, sizeof(buf), "%lld", iwlwav_cmd_arg(cmd, i)->min);
+		argv[i] = strdup(buf);
+	}
+
+	err = iwlwav_cmd_put(cmd, msg, cmd->max_args, argv);
+	if (err)
+		fprintf(stderr, "%s: %d arguments: iwlwav_cmd_put() failed: %d\n",
+			cmd->name, cmd->max_args, err);
+
+	for (i = 0; i < cmd->max_args; i++)
+		free(argv[i]);
+ out:
+	free(argv);
+	nlmsg_free(msg);
+	return !!err;
+}
+
+int main(void)
+{
+	const struct iwlwav_cmd *cmd;
+	unsigned int j;
+	int i, failed = 0;
+
+	for (j = 0; j < ARRAY_SIZE(old_cmds); j++)
+		failed += check_cmd(&old_cmds[j]);
+
+	for_each_iwlwav_cmd(cmd, i) {
+		for (j = 0; j < ARRAY_SIZE(old_cmds); j++)
+			if (!strcmp(old_cmds[j].name, cmd->name))
+				break;
+		if (j == ARRAY_SIZE(old_cmds)) {
+			fprintf(stderr, "%s: table entry not checked\n",
+				cmd->name);
+			failed++;
+		}
+		failed += check_max_args(cmd);
+	}
+
+	printf("iwlwav: %zu commands checked, %d failed\n",
+	       ARRAY_SIZE(old_cmds), failed);
+	return failed ? 1 : 0;
+}
@@ -284,16 +284,45 @@ static size_t iwstrnlen(const char *s, size_t max_len)
     return i;
 }
 
-static int error_handler(struct sockaddr_nl *nla, struct nlmsgerr *err,
-			 void *arg)
+/*
+ * Find the extended ACK message in an error reply; returns its length
+ * and points *msg at it, or returns 0 if the kernel didn't add one.
+ */
+static int nlerr_extack_msg(struct nlmsgerr *err, const char **msg)
 {
 	struct nlmsghdr *nlh = (struct nlmsghdr *)err - 1;
 	int len = nlh->nlmsg_len;
 	struct nlattr *attrs;
 	struct nlattr *tb[NLMSGERR_ATTR_MAX + 1];
-	int *ret = arg;
 	int ack_len = sizeof(*nlh) + sizeof(int) + sizeof(*nlh);
 
+	if (!(nlh->nlmsg_flags & NLM_F_ACK_TLVS))
+		return 0;
+
+	if (!(nlh->nlmsg_flags & NLM_F_CAPPED))
+		ack_len += err->msg.nlmsg_len - sizeof(*nlh);
+
+	if (len <= ack_len)
+		return 0;
+
+	attrs = (void *)((unsigned char *)nlh + ack_len);
+	len -= ack_len;
+
+	nla_parse(tb, NLMSGERR_ATTR_MAX, attrs, len, NULL);
+	if (!tb[NLMSGERR_ATTR_MSG])
+		return 0;
+
+	*msg = nla_data(tb[NLMSGERR_ATTR_MSG]);
+	return iwstrnlen(*msg, nla_len(tb[NLMSGERR_ATTR_MSG]));
+}
+
+static int error_handler(struct sockaddr_nl *nla, struct nlmsgerr *err,
+			 void *arg)
+{
+	const char *ext_msg;
+	int *ret = arg;
+	int len;
+
 	if (err->error > 0) {
 		/*
 		 * This is illegal, per netlink(7), but not impossible (think
@@ -308,25 +337,9 @@ static int error_handler(struct sockaddr_nl *nla, struct nlmsgerr *err,
 		*ret = err->error;
 	}
 
-	if (!(nlh->nlmsg_flags & NLM_F_ACK_TLVS))
-		return NL_STOP;
-
-	if (!(nlh->nlmsg_flags & NLM_F_CAPPED))
-		ack_len += err->msg.nlmsg_len - sizeof(*nlh);
-
-	if (len <= ack_len)
-		return NL_STOP;
-
-	attrs = (void *)((unsigned char *)nlh + ack_len);
-	len -= ack_len;
-
-	nla_parse(tb, NLMSGERR_ATTR_MAX, attrs, len, NULL);
-	if (tb[NLMSGERR_ATTR_MSG]) {
-		len = iwstrnlen((char *)nla_data(tb[NLMSGERR_ATTR_MSG]),
-			      nla_len(tb[NLMSGERR_ATTR_MSG]));
-		fprintf(stderr, "kernel reports: %*s\n", len,
-			(char *)nla_data(tb[NLMSGERR_ATTR_MSG]));
-	}
+	len = nlerr_extack_msg(err, &ext_msg);
+	if (len)
+		fprintf(stderr, "kernel reports: %*s\n", len, ext_msg);
 
 	return NL_STOP;
 }
@@ -566,6 +579,203 @@ int handle_cmd(struct nl80211_state *state, enum id_input idby,
 	return __handle_cmd(state, idby, argc, argv, NULL);
 }
 
+/*
+ * Pipelined requests: the prepared messages are sent back-to-back on the
+ * nl80211 socket, with at most 'window' of them outstanding, and every
+ * reply is dispatched by its sequence number to the handler of the
+ * request it belongs to. N requests thus cost about one round trip
+ * instead of N, and replies may come back in any order. Requests
+ * without a message are skipped and fail with -EINVAL.
+ */
+#define NL80211_BATCH_RXBUF	(256 * 1024)
+
+struct nl80211_batch {
+	struct nl80211_batch_req *reqs;
+	int n_reqs;
+	unsigned int first_seq;
+	int pending, done;
+};
+
+static struct nl80211_batch_req *batch_find(struct nl80211_batch *b,
+					    unsigned int seq)
+{
+	unsigned int idx = seq - b->first_seq;
+	int i;
+
+	/* sequence numbers are handed out in order, so try that first */
+	if (idx < (unsigned int)b->n_reqs && b->reqs[idx].seq == seq)
+		return &b->reqs[idx];
+
+	for (i = 0; i < b->n_reqs; i++)
+		if (b->reqs[i].seq == seq)
+			return &b->reqs[i];
+
+	return NULL;
+}
+
+static void batch_complete(struct nl80211_batch *b,
+			   struct nl80211_batch_req *req, int err)
+{
+	if (!req || req->done)
+		return;
+	req->done = true;
+	req->err = err;
+	b->pending--;
+	b->done++;
+}
+
+static int batch_seq_check(struct nl_msg *msg, void *arg)
+{
+	return NL_OK;
+}
+
+static int batch_valid(struct nl_msg *msg, void *arg)
+{
+	struct nl80211_batch *b = arg;
+	struct nl80211_batch_req *req;
+
+	req = batch_find(b, nlmsg_hdr(msg)->nlmsg_seq);
+	if (req && !req->done && req->handler)
+		req->handler(msg, req->arg);
+
+	/* never NL_STOP here, that would drop the rest of a multipart reply */
+	return NL_SKIP;
+}
+
+static int batch_finish(struct nl_msg *msg, void *arg)
+{
+	struct nl80211_batch *b = arg;
+
+	batch_complete(b, batch_find(b, nlmsg_hdr(msg)->nlmsg_seq), 0);
+	return NL_SKIP;
+}
+
+static int batch_error(struct sockaddr_nl *nla, struct nlmsgerr *err,
+		       void *arg)
+{
+	struct nl80211_batch *b = arg;
+	struct nl80211_batch_req *req;
+	const char *ext_msg;
+	int len;
+
+	req = batch_find(b, err->msg.nlmsg_seq);
+	if (!req || req->done)
+		return NL_SKIP;
+
+	len = nlerr_extack_msg(err, &ext_msg);
+	if (len) {
+		if (len >= (int)sizeof(req->ext_msg))
+			len = sizeof(req->ext_msg) - 1;
+		memcpy(req->ext_msg, ext_msg, len);
+		req->ext_msg[len] = '\0';
+	}
+
+	batch_complete(b, req, err->error > 0 ? -EPROTO : err->error);
+	return NL_SKIP;
+}
+
+struct nl_msg *nl80211_batch_msg(struct nl80211_state *state, int cmd,
+				 int flags, int ifindex)
+{
+	struct nl_msg *msg;
+
+	msg = nlmsg_alloc();
+	if (!msg)
+		return NULL;
+
+	if (!genlmsg_put(msg, 0, 0, state->nl80211_id, 0, flags, cmd, 0))
+		goto nla_put_failure;
+	if (ifindex)
+		NLA_PUT_U32(msg, NL80211_ATTR_IFINDEX, ifindex);
+
+	return msg;
+ nla_put_failure:
+	nlmsg_free(msg);
+	return NULL;
+}
+
+int nl80211_batch(struct nl80211_state *state,
+		  struct nl80211_batch_req *reqs, int n_reqs, int window)
+{
+	struct nl80211_batch b = {
+		.reqs = reqs,
+		.n_reqs = n_reqs,
+	};
+	struct nl80211_batch_req *req;
+	struct nlmsghdr *nlh;
+	struct nl_cb *cb;
+	int sent = 0, err, i;
+
+	if (window <= 0)
+		window = n_reqs;
+
+	cb = nl_cb_alloc(iw_debug ? NL_CB_DEBUG : NL_CB_DEFAULT);
+	if (!cb)
+		return -ENOMEM;
+
+	/*
+	 * The kernel drops replies that don't fit into the receive buffer
+	 * (and we'd see ENOBUFS), so make room for a full window of them.
+	 */
+	nl_socket_set_buffer_size(state->nl_sock, NL80211_BATCH_RXBUF, 0);
+
+	nl_cb_set(cb, NL_CB_SEQ_CHECK, NL_CB_CUSTOM, batch_seq_check, NULL);
+	nl_cb_set(cb, NL_CB_VALID, NL_CB_CUSTOM, batch_valid, &b);
+	nl_cb_set(cb, NL_CB_FINISH, NL_CB_CUSTOM, batch_finish, &b);
+	nl_cb_set(cb, NL_CB_ACK, NL_CB_CUSTOM, batch_finish, &b);
+	nl_cb_err(cb, NL_CB_CUSTOM, batch_error, &b);
+
+	for (i = 0; i < n_reqs; i++) {
+		reqs[i].seq = 0;
+		reqs[i].err = 0;
+		reqs[i].done = false;
+		reqs[i].ext_msg[0] = '\0';
+	}
+
+	while (b.done < n_reqs) {
+		while (sent < n_reqs && b.pending < window) {
+			req = &reqs[sent++];
+			if (!req->msg) {
+				req->done = true;
+				req->err = -EINVAL;
+				b.done++;
+				continue;
+			}
+			nlh = nlmsg_hdr(req->msg);
+
+			/* a dump ends with NLMSG_DONE, anything else needs the ACK */
+			if (!(nlh->nlmsg_flags & NLM_F_DUMP))
+				nlh->nlmsg_flags |= NLM_F_ACK;
+
+			b.pending++;
+			err = nl_send_auto_complete(state->nl_sock, req->msg);
+			req->seq = nlh->nlmsg_seq;
+			if (!b.first_seq)
+				b.first_seq = req->seq;
+			if (err < 0)
+				batch_complete(&b, req, -EIO);
+		}
+
+		if (!b.pending)
+			continue;
+
+		err = nl_recvmsgs(state->nl_sock, cb);
+		if (err < 0) {
+			/* lost track of the replies, fail whatever is left */
+			for (i = 0; i < n_reqs; i++) {
+				if (reqs[i].done)
+					continue;
+				reqs[i].done = true;
+				reqs[i].err = -EIO;
+			}
+			break;
+		}
+	}
+
+	nl_cb_put(cb);
+	return 0;
+}
+
 /*
  * Unfortunately, I don't know how densely the linker packs the struct cmd.
  * For example, if you have a 72-byte struct cmd, the linker will pad each
@@ -187,6 +187,25 @@ extern int iw_debug;
 int handle_cmd(struct nl80211_state *state, enum id_input idby,
 	       int argc, char **argv);
 
+struct nl80211_batch_req {
+	struct nl_msg *msg;	/* prepared request, owned by the caller */
+	int (*handler)(struct nl_msg *msg, void *arg);
+	void *arg;
+
+	/* results */
+	bool done;
+	int err;
+	char ext_msg[128];	/* extended ACK message, if any */
+
+	/* internal */
+	unsigned int seq;
+};
+
+struct nl_msg *nl80211_batch_msg(struct nl80211_state *state, int cmd,
+				 int flags, int ifindex);
+int nl80211_batch(struct nl80211_state *state,
+		  struct nl80211_batch_req *reqs, int n_reqs, int window);
+
 struct print_event_args {
 	struct timeval ts; /* internal */
 	bool have_ts; /* must be set false */
@@ -260,6 +279,22 @@ void print_ies(unsigned char *ie, int ielen, bool unknown,
 
 void parse_bitrate(struct nlattr *bitrate_attr, char *buf, int buflen);
 void iw_hexdump(const char *prefix, const __u8 *data, size_t len);
+unsigned long long now_ms(void);
+int parse_interval_count(int argc, char **argv,
+			 unsigned long *interval_ms, unsigned long *count);
+int print_vendor_sta_info(const void *data, int len);
+
+struct vendor_schema;
+struct vendor_schema *vendor_schema_load(const char *path);
+void vendor_schema_free(struct vendor_schema *vs);
+const struct vendor_schema *
+vendor_schema_find(const struct vendor_schema *vs, unsigned int oui,
+		   unsigned int subcmd);
+void vendor_schema_decode(const struct vendor_schema *vs, bool export,
+			  const uint8_t *data, int len);
+void vendor_schema_delta(const struct vendor_schema *vs, const uint8_t *prev,
+			 const uint8_t *cur, int len,
+			 unsigned long long interval_ms);
 
 int get_cf1(const struct chanmode *chanmode, unsigned long freq);
 
@@ -5,6 +5,11 @@
 #include <errno.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <net/if.h>
 
 #include <netlink/genl/genl.h>
 #include <netlink/genl/family.h>
@@ -102,98 +107,6 @@ nla_put_failure:
 	return -ENOBUFS;
 }
 
-/******************************************************************************/
-/*! \brief      Prepare Intel vendor netlink command with text data for sending
- *
- *  \param[out] msg                pointer to NL message data to be filled, must not be NULL
- *  \param[in]  argc               number of arguments
- *  \param[in]  argv               pointer to arguments
- *  \param[in]  min_num_of_params  minimum number of allowed arguments
- *  \param[in]  max_num_of_params  maximum number of allowed arguments
- *  \param[in]  subcmd             Intel vendor sub command, from 'enum ltq_nl80211_vendor_subcmds'
- *
- *  \return     0 on success, non 0 on error
- */
-static int set_text(struct nl_msg *msg,
-		    int argc, char **argv,
-		    int min_num_of_params,
-		    int max_num_of_params,
-		    enum ltq_nl80211_vendor_subcmds subcmd)
-{
-	char *data;
-
-	if (!msg)
-		return -EFAULT;
-
-	if (argc < min_num_of_params || argc > max_num_of_params)
-		return -EINVAL;
-
-	data = (char *) malloc(TEXT_ARRAY_SIZE);
-	if (!data)
-		return -ENOMEM;
-
-	strncpy_s(data, TEXT_ARRAY_SIZE, argv[0], strnlen_s(argv[0], TEXT_ARRAY_SIZE));
-
-	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ);
-	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_SUBCMD, subcmd);
-
-	NLA_PUT(msg, NL80211_ATTR_VENDOR_DATA, TEXT_ARRAY_SIZE, data);
-
-	free(data);
-	return 0;
-
-nla_put_failure:
-	free(data);
-	return -ENOBUFS;
-}
-
-/******************************************************************************/
-/*! \brief      Prepare Intel vendor netlink command with MAC address for sending
- *
- *  \param[out] msg                pointer to NL message data to be filled, must not be NULL
- *  \param[in]  argc               number of arguments, must be 1
- *  \param[in]  argv               pointer to arguments, must be in MAC address format
- *  \param[in]  subcmd             Intel vendor sub command, from 'enum ltq_nl80211_vendor_subcmds'
- *
- *  \return     0 on success, non 0 on error
- */
-static int set_addr(struct nl_msg *msg,
-		    int argc, char **argv,
-		    enum ltq_nl80211_vendor_subcmds subcmd)
-{
-	unsigned int data[SET_ADDR_LEN];
-	int i, count;
-	uint8_t data8[SET_ADDR_LEN];
-	uint16_t sa_family = 1;
-
-	if (!msg)
-		return -EFAULT;
-
-	if (argc != 1)
-		return -EINVAL;
-
-	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ);
-	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_SUBCMD, subcmd);
-
-	memcpy_s(data8, sizeof(data8), &sa_family, sizeof(sa_family));
-
-	count = sscanf(argv[0], "%2x:%2x:%2x:%2x:%2x:%2x",
-		       &data[2], &data[3], &data[4], &data[5], &data[6], &data[7]);
-
-	if (count != 6)
-		return -EINVAL;
-
-	for(i = 2; i < SET_ADDR_LEN; i++)
-		data8[i] = (uint8_t) data[i];
-
-	NLA_PUT(msg, NL80211_ATTR_VENDOR_DATA, SET_ADDR_LEN, (char *) data8);
-
-	return 0;
-
-nla_put_failure:
-	return -ENOBUFS;
-}
-
 /**********************************************************************************************/
 /*! \brief      Prepare Intel vendor netlink command with MAC address and integer for sending
  *
@@ -272,32 +185,339 @@ nla_put_failure:
     return -EINVAL;
 }
 
-static int handle_iwlwav_set_mtlk_log_level(struct nl80211_state *state,
-						 struct nl_msg *msg,
-						 int argc, char **argv,
-						 enum id_input id)
+/**************************** COMMAND TABLE *****************************/
+/*
+ * Most iwlwav commands only pass a few integers (or one MAC address or
+ * text) to a vendor sub command, or print what it returns. Those are
+ * described by a 'struct iwlwav_cmd' entry instead of a handler each:
+ * IWLWAV_SET()/IWLWAV_GET() register the iw command and put the entry
+ * in the "iwlwav_cmd" section, so 'iwlwav help' and other commands can
+ * walk all of them. The arguments are checked against the entry before
+ * anything is put into the message, into a buffer sized for the entry.
+ */
+
+/* words of a snapshot line or of a watched reply */
+#define IWLWAV_MAX_ARGS 256
+
+enum iwlwav_arg_type {
+	IWLWAV_ARG_INT,		/* 32-bit word, signed or unsigned */
+	IWLWAV_ARG_MAC,		/* MAC address, as for set_addr() */
+	IWLWAV_ARG_TEXT,	/* string, as for set_text() */
+};
+
+enum iwlwav_reply {
+	IWLWAV_REPLY_NONE,
+	IWLWAV_REPLY_INT,	/* 32-bit words, see print_vendor_int() */
+	IWLWAV_REPLY_TEXT,	/* see print_vendor_text() */
+};
+
+struct iwlwav_arg {
+	enum iwlwav_arg_type type;
+	long long min, max;
+};
+
+/*! \brief Description of a table driven iwlwav command */
+struct iwlwav_cmd {
+	const char *name;
+	enum ltq_nl80211_vendor_subcmds subcmd;
+	int min_args, max_args;
+	/* per argument, the last one applies to all further arguments */
+	const struct iwlwav_arg *args;
+	int n_args;
+	enum iwlwav_reply reply;
+	const char *usage;
+	const char *help;
+};
+
+#define IWLWAV_INT		{ IWLWAV_ARG_INT, INT32_MIN, UINT32_MAX }
+#define IWLWAV_RANGE(_min, _max) { IWLWAV_ARG_INT, (_min), (_max) }
+#define IWLWAV_MAC		{ IWLWAV_ARG_MAC, 0, 0 }
+#define IWLWAV_TEXT		{ IWLWAV_ARG_TEXT, 0, 0 }
+
+static int iwlwav_cmd_run(const struct iwlwav_cmd *cmd, struct nl_msg *msg,
+			  int argc, char **argv);
+
+#define __IWLWAV_CMD(_name, _subcmd, _min, _max, _reply, _usage, _help, ...)\
+	static const struct iwlwav_arg iwlwav_args_ ## _name[] = { __VA_ARGS__ };\
+	static const struct iwlwav_cmd iwlwav_cmd_ ## _name = {		\
+		.name = #_name,						\
+		.subcmd = (_subcmd),					\
+		.min_args = (_min),					\
+		.max_args = (_max),					\
+		.args = iwlwav_args_ ## _name,				\
+		.n_args = ARRAY_SIZE(iwlwav_args_ ## _name),		\
+		.reply = (_reply),					\
+		.usage = (_usage),					\
+		.help = (_help),					\
+	}, * const iwlwav_cmd_ ## _name ## _p				\
+	__attribute__((used,section("iwlwav_cmd"))) = &iwlwav_cmd_ ## _name;\
+	static int handle_iwlwav_ ## _name(struct nl80211_state *state,	\
+					   struct nl_msg *msg,		\
+					   int argc, char **argv,	\
+					   enum id_input id)		\
+	{								\
+		return iwlwav_cmd_run(&iwlwav_cmd_ ## _name, msg, argc, argv);\
+	}								\
+	COMMAND(iwlwav, _name, _usage, NL80211_CMD_VENDOR, 0, CIB_NETDEV,\
+		handle_iwlwav_ ## _name, _help)
+
+/* setter taking <min>..<max> arguments, IWLWAV_INT unless given */
+#define IWLWAV_SET(_name, _subcmd, _min, _max, _usage, _help, ...)	\
+	__IWLWAV_CMD(_name, _subcmd, _min, _max, IWLWAV_REPLY_NONE,	\
+		     _usage, _help, __VA_ARGS__)
+
+/* getter without arguments */
+#define IWLWAV_GET(_name, _subcmd, _reply, _help)			\
+	__IWLWAV_CMD(_name, _subcmd, 0, 0, _reply, "", _help)
+
+extern const struct iwlwav_cmd *__start_iwlwav_cmd[];
+extern const struct iwlwav_cmd *__stop_iwlwav_cmd;
+
+#define for_each_iwlwav_cmd(_cmd, i)					\
+	for (i = 0; i < &__stop_iwlwav_cmd - __start_iwlwav_cmd; i++)	\
+		if ((_cmd = __start_iwlwav_cmd[i]))
+
+static const struct iwlwav_cmd *iwlwav_cmd_find(const char *name)
+{
+	const struct iwlwav_cmd *cmd;
+	int i;
+
+	for_each_iwlwav_cmd(cmd, i)
+		if (!strcmp(cmd->name, name))
+			return cmd;
+	return NULL;
+}
+
+static const struct iwlwav_arg *iwlwav_cmd_arg(const struct iwlwav_cmd *cmd,
+					       int i)
+{
+	static const struct iwlwav_arg any_int = IWLWAV_INT;
+
+	if (!cmd->n_args)
+		return &any_int;
+	return &cmd->args[i < cmd->n_args ? i : cmd->n_args - 1];
+}
+
+/* the <i>th word of the usage string, for error messages */
+static void iwlwav_usage_word(const struct iwlwav_cmd *cmd, int i,
+			      const char **word, int *len)
+{
+	const char *p = cmd->usage;
+
+	*word = NULL;
+	*len = 0;
+	while (*p) {
+		while (*p == ' ')
+			p++;
+		if (!*p)
+			break;
+		*word = p;
+		while (*p && *p != ' ')
+			p++;
+		*len = p - *word;
+		if (!i--)
+			return;
+	}
+	/* fewer words than arguments, name the last one */
+}
+
+/*! \brief      Check the arguments of \a cmd and encode them
+ *
+ *  \param[in]  cmd                table entry, must not be NULL
+ *  \param[in]  argc               number of arguments
+ *  \param[in]  argv               pointer to arguments
+ *  \param[out] data               encoded vendor data
+ *  \param[in]  size               size of \a data
+ *
+ *  \return     length of the encoded data, -EINVAL after printing what is wrong
+ */
+static int iwlwav_cmd_encode(const struct iwlwav_cmd *cmd,
+			     int argc, char **argv,
+			     void *data, int size)
+{
+	const struct iwlwav_arg *arg;
+	const char *word;
+	int32_t *words = data;
+	long long val;
+	char *end;
+	int i, len;
+
+	if (argc < cmd->min_args || argc > cmd->max_args) {
+		if (cmd->min_args == cmd->max_args)
+			fprintf(stderr, "%s: expects %d argument(s)\n",
+				cmd->name, cmd->min_args);
+		else
+			fprintf(stderr, "%s: expects %d to %d arguments\n",
+				cmd->name, cmd->min_args, cmd->max_args);
+		goto usage;
+	}
+
+	arg = iwlwav_cmd_arg(cmd, 0);
+	if (arg->type == IWLWAV_ARG_MAC) {
+		uint16_t sa_family = 1;
+		uint8_t *d = data;
+
+		if (size < SET_ADDR_LEN || mac_addr_a2n(d + 2, argv[0])) {
+			fprintf(stderr, "%s: invalid MAC address '%s'\n",
+				cmd->name, argv[0]);
+			goto usage;
+		}
+		memcpy(d, &sa_family, sizeof(sa_family));
+		return SET_ADDR_LEN;
+	}
+
+	if (arg->type == IWLWAV_ARG_TEXT) {
+		if (size < TEXT_ARRAY_SIZE ||
+		    strnlen_s(argv[0], TEXT_ARRAY_SIZE) >= TEXT_ARRAY_SIZE) {
+			fprintf(stderr, "%s: text too long\n", cmd->name);
+			goto usage;
+		}
+		memset(data, 0, TEXT_ARRAY_SIZE);
+		strncpy_s(data, TEXT_ARRAY_SIZE, argv[0],
+			  strnlen_s(argv[0], TEXT_ARRAY_SIZE));
+		return TEXT_ARRAY_SIZE;
+	}
+
+	if (argc * (int)sizeof(*words) > size) {
+		fprintf(stderr, "%s: too many arguments\n", cmd->name);
+		goto usage;
+	}
+
+	for (i = 0; i < argc; i++) {
+		arg = iwlwav_cmd_arg(cmd, i);
+		errno = 0;
+		val = strtoll(argv[i], &end, 0);
+		if (*end || end == argv[i] || errno ||
+		    val < arg->min || val > arg->max) {
+			iwlwav_usage_word(cmd, i, &word, &len);
+			fprintf(stderr, "%s: argument %d", cmd->name, i + 1);
+			if (word)
+				fprintf(stderr, " %.*s", len, word);
+			if (*end || end == argv[i] || errno == EINVAL)
+				fprintf(stderr, " is not a number: '%s'\n",
+					argv[i]);
+			else
+				fprintf(stderr, " out of range %lld..%lld: '%s'\n",
+					arg->min, arg->max, argv[i]);
+			goto usage;
+		}
+		words[i] = (int32_t)(uint32_t)val;
+	}
+
+	return argc * sizeof(*words);
+ usage:
+	fprintf(stderr, "usage: iwlwav %s %s\n", cmd->name, cmd->usage);
+	return -EINVAL;
+}
+
+static int print_vendor_int(struct nl_msg *msg, void *arg);
+static int print_vendor_text(struct nl_msg *msg, void *arg);
+
+/*! \brief      Put the vendor command of table entry \a cmd into \a msg
+ *
+ *  \param[in]  cmd                table entry, must not be NULL
+ *  \param[out] msg                pointer to NL message data to be filled, must not be NULL
+ *  \param[in]  argc               number of arguments
+ *  \param[in]  argv               pointer to arguments
+ *
+ *  \return     0 on success, 2 for invalid arguments, negative error otherwise
+ */
+static int iwlwav_cmd_put(const struct iwlwav_cmd *cmd, struct nl_msg *msg,
+			  int argc, char **argv)
 {
-	return set_int(msg, argc, argv, 1, 3, LTQ_NL80211_VENDOR_SUBCMD_SET_MTLK_LOG_LEVEL);
+	int32_t *data;
+	int len, size, err = 0;
+
+	if (!msg)
+		return -EFAULT;
+
+	/* room for max_args words, or for one MAC address or text */
+	size = cmd->max_args * sizeof(*data);
+	if (size < TEXT_ARRAY_SIZE)
+		size = TEXT_ARRAY_SIZE;
+	data = malloc(size);
+	if (!data)
+		return -ENOMEM;
+
+	len = iwlwav_cmd_encode(cmd, argc, argv, data, size);
+	if (len < 0) {
+		err = 2;
+		goto out;
+	}
+
+	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ);
+	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_SUBCMD, cmd->subcmd);
+	/* setters always carry the vendor data, even if empty */
+	if (len || cmd->reply == IWLWAV_REPLY_NONE)
+		NLA_PUT(msg, NL80211_ATTR_VENDOR_DATA, len, data);
+	goto out;
+
+nla_put_failure:
+	err = -ENOBUFS;
+ out:
+	free(data);
+	return err;
 }
-COMMAND(iwlwav, sMtlkLogLevel, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_mtlk_log_level, "");
 
-static int handle_iwlwav_set_11h_radar_detection(struct nl80211_state *state,
-						 struct nl_msg *msg,
-						 int argc, char **argv,
-						 enum id_input id)
+/*! \brief      Prepare the vendor command of table entry \a cmd
+ *
+ *  \param[in]  cmd                table entry, must not be NULL
+ *  \param[out] msg                pointer to NL message data to be filled, must not be NULL
+ *  \param[in]  argc               number of arguments
+ *  \param[in]  argv               pointer to arguments
+ *
+ *  \return     0 on success, 2 for invalid arguments, negative error otherwise
+ */
+static int iwlwav_cmd_run(const struct iwlwav_cmd *cmd, struct nl_msg *msg,
+			  int argc, char **argv)
 {
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_11H_RADAR_DETECT);
+	static struct print_data print_d;
+	int err;
+
+	err = iwlwav_cmd_put(cmd, msg, argc, argv);
+	if (err || cmd->reply == IWLWAV_REPLY_NONE)
+		return err;
+
+	print_d.num_of_params = 0;
+	strncpy_s(print_d.print_msg, sizeof(print_d.print_msg),
+		  cmd->name, strnlen_s(cmd->name, sizeof(print_d.print_msg)));
+	register_handler(cmd->reply == IWLWAV_REPLY_TEXT ?
+			 print_vendor_text : print_vendor_int, &print_d);
+	return 0;
 }
-COMMAND(iwlwav, s11hRadarDetect, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_11h_radar_detection, "");
 
-static int handle_iwlwav_set_11h_ch_check_time(struct nl80211_state *state,
-					       struct nl_msg *msg,
-					       int argc, char **argv,
-					       enum id_input id)
+/* help for all table entries, in the style of handle_iwlwav_help() */
+static void iwlwav_cmd_help(void)
 {
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_11H_CH_CHECK_TIME);
+	const struct iwlwav_cmd *cmd;
+	const char *p, *nl;
+	int i;
+
+	for_each_iwlwav_cmd(cmd, i) {
+		printf("\tdev <devname> iwlwav %s%s%s\n", cmd->name,
+		       cmd->usage[0] ? " " : "", cmd->usage);
+		for (p = cmd->help; p && *p; p = nl ? nl + 1 : NULL) {
+			nl = strchr(p, '\n');
+			printf("\t\t%.*s\n", nl ? (int)(nl - p) : (int)strlen(p), p);
+			if (!nl)
+				break;
+		}
+		printf("\n");
+	}
 }
-COMMAND(iwlwav, s11hChCheckTime, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_11h_ch_check_time, "");
+
+IWLWAV_SET(sMtlkLogLevel, LTQ_NL80211_VENDOR_SUBCMD_SET_MTLK_LOG_LEVEL, 1, 3,
+	"<oid:0-31> [<level:0-2> [<mode:1-3>]]",
+	"set mtlk debug level oid: e.g. 8(mtlk) 6(tools) level: e.g. 1(level one) mode:e.g. (1)cdebug",
+	IWLWAV_RANGE(0, 31), IWLWAV_RANGE(0, 2), IWLWAV_RANGE(1, 3));
+
+IWLWAV_SET(s11hRadarDetect, LTQ_NL80211_VENDOR_SUBCMD_SET_11H_RADAR_DETECT, 1, 1,
+	"<radar detection>",
+	"Set 11h radar detection.");
+
+IWLWAV_SET(s11hChCheckTime, LTQ_NL80211_VENDOR_SUBCMD_SET_11H_CH_CHECK_TIME, 1, 1,
+	"<channel check time>",
+	"Set 11h channel availability check time.");
 
 static int handle_iwlwav_set_11h_emulat_radar(struct nl80211_state *state,
 					      struct nl_msg *msg,
@@ -342,153 +562,69 @@ FAILURE:
 }
 COMMAND(iwlwav, s11hEmulatRadar, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_11h_emulat_radar, "");
 
-static int handle_iwlwav_emulat_interferer(struct nl80211_state *state,
-					      struct nl_msg *msg,
-					      int argc, char **argv,
-					      enum id_input id)
-{
-	return set_int(msg, argc, argv, 0, 0, LTQ_NL80211_VENDOR_SUBCMD_EMULATE_INTERFERER);
-}
-COMMAND(iwlwav, emulateInterferer, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_emulat_interferer, "");
-
-static int handle_iwlwav_set_add_peer_ap(struct nl80211_state *state,
-					 struct nl_msg *msg,
-					 int argc, char **argv,
-					 enum id_input id)
-{
-	return set_addr(msg, argc, argv, LTQ_NL80211_VENDOR_SUBCMD_SET_ADD_PEERAP);
-}
-COMMAND(iwlwav, sAddPeerAP, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_add_peer_ap, "");
-
-static int handle_iwlwav_set_del_peer_ap(struct nl80211_state *state,
-					 struct nl_msg *msg,
-					 int argc, char **argv,
-					 enum id_input id)
-{
-	return set_addr(msg, argc, argv, LTQ_NL80211_VENDOR_SUBCMD_SET_DEL_PEERAP);
-}
-COMMAND(iwlwav, sDelPeerAP, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_del_peer_ap, "");
-
-static int handle_iwlwav_set_peer_ap_key_idx(struct nl80211_state *state,
-					     struct nl_msg *msg,
-					     int argc, char **argv,
-					     enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_PEERAP_KEY_IDX);
-}
-COMMAND(iwlwav, sPeerAPkeyIdx, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_peer_ap_key_idx, "");
-
-static int handle_iwlwav_set_bridge_mode(struct nl80211_state *state,
-					 struct nl_msg *msg,
-					 int argc, char **argv,
-					 enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_BRIDGE_MODE);
+IWLWAV_SET(emulateInterferer, LTQ_NL80211_VENDOR_SUBCMD_EMULATE_INTERFERER, 0, 0,
+	"",
+	"Set emulate Interferer detection.");
 
-}
-COMMAND(iwlwav, sBridgeMode, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_bridge_mode, "");
+IWLWAV_SET(sAddPeerAP, LTQ_NL80211_VENDOR_SUBCMD_SET_ADD_PEERAP, 1, 1,
+	"<peer ap>",
+	"Set add peer ap.", IWLWAV_MAC);
 
-static int handle_iwlwav_set_reliable_mcast(struct nl80211_state *state,
-					    struct nl_msg *msg,
-					    int argc, char **argv,
-					    enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_RELIABLE_MULTICAST);
+IWLWAV_SET(sDelPeerAP, LTQ_NL80211_VENDOR_SUBCMD_SET_DEL_PEERAP, 1, 1,
+	"<peer ap>",
+	"Set delete peer ap.", IWLWAV_MAC);
 
-}
-COMMAND(iwlwav, sReliableMcast, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_reliable_mcast, "");
+IWLWAV_SET(sPeerAPkeyIdx, LTQ_NL80211_VENDOR_SUBCMD_SET_PEERAP_KEY_IDX, 1, 1,
+	"<peer ap key index>",
+	"Set peer ap key index.");
 
-static int handle_iwlwav_set_ap_forwarding(struct nl80211_state *state,
-					   struct nl_msg *msg,
-					   int argc, char **argv,
-					   enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_AP_FORWARDING);
+IWLWAV_SET(sBridgeMode, LTQ_NL80211_VENDOR_SUBCMD_SET_BRIDGE_MODE, 1, 1,
+	"<bridge mode>",
+	"Set bridge mode.");
 
-}
-COMMAND(iwlwav, sAPforwarding, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_ap_forwarding, "");
+IWLWAV_SET(sReliableMcast, LTQ_NL80211_VENDOR_SUBCMD_SET_RELIABLE_MULTICAST, 1, 1,
+	"<reliable multicast>",
+	"Set reliable multicast.");
 
-static int handle_iwlwav_set_lt_path_enabled(struct nl80211_state *state,
-					     struct nl_msg *msg,
-					     int argc, char **argv,
-					     enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_DCDP_API_LITEPATH);
-}
-COMMAND(iwlwav, sLtPathEnabled, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_lt_path_enabled, "");
+IWLWAV_SET(sAPforwarding, LTQ_NL80211_VENDOR_SUBCMD_SET_AP_FORWARDING, 1, 1,
+	"<AP forwarding>",
+	"Set AP forwarding.");
 
-static int handle_iwlwav_set_ipx_ppa_enabled(struct nl80211_state *state,
-					     struct nl_msg *msg,
-					     int argc, char **argv,
-					     enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_DCDP_API_LITEPATH_COMP);
-}
-COMMAND(iwlwav, sIpxPpaEnabled, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_ipx_ppa_enabled, "");
+IWLWAV_SET(sLtPathEnabled, LTQ_NL80211_VENDOR_SUBCMD_SET_DCDP_API_LITEPATH, 1, 1,
+	"<enabled>",
+	"Set lite path enabled.");
 
-static int handle_iwlwav_set_coc_power(struct nl80211_state *state,
-				       struct nl_msg *msg,
-				       int argc, char **argv,
-				       enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 9, LTQ_NL80211_VENDOR_SUBCMD_SET_COC_POWER_MODE);
-}
-COMMAND(iwlwav, sCoCPower, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_coc_power, "");
+IWLWAV_SET(sIpxPpaEnabled, LTQ_NL80211_VENDOR_SUBCMD_SET_DCDP_API_LITEPATH_COMP, 1, 1,
+	"<enabled>",
+	"Set ipx ppa enabled.");
 
-static int handle_iwlwav_set_coc_auto_cfg(struct nl80211_state *state,
-					  struct nl_msg *msg,
-					  int argc, char **argv,
-					  enum id_input id)
-{
-	return set_int(msg, argc, argv, 10, 17, LTQ_NL80211_VENDOR_SUBCMD_SET_COC_AUTO_PARAMS);
-}
-COMMAND(iwlwav, sCoCAutoCfg, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_coc_auto_cfg, "");
+IWLWAV_SET(sCoCPower, LTQ_NL80211_VENDOR_SUBCMD_SET_COC_POWER_MODE, 1, 9,
+	"<enable mode> <tx num> <rx num>",
+	"Set COC power mode.");
 
-static int handle_iwlwav_set_tcp_loop_type(struct nl80211_state *state,
-					   struct nl_msg *msg,
-					   int argc, char **argv,
-					   enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_PRM_ID_TPC_LOOP_TYPE);
-}
-COMMAND(iwlwav, sTpcLoopType, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_tcp_loop_type, "");
+IWLWAV_SET(sCoCAutoCfg, LTQ_NL80211_VENDOR_SUBCMD_SET_COC_AUTO_PARAMS, 10, 17,
+	"<interval_1x1> <interval_2x2> <interval_3x3> < interval_4x4> <high_limit_1x1> <low_limit_2x2> <high_limit_2x2> <low_limit_3x3> <high_limit_3x3> <low_limit_4x4>",
+	"Set COC auto parameters.");
 
-static int handle_iwlwav_set_inter_det_thresh(struct nl80211_state *state,
-					      struct nl_msg *msg,
-					      int argc, char **argv,
-					      enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_INTERFER_THRESH);
-}
-COMMAND(iwlwav, sInterfDetThresh, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_inter_det_thresh, "");
+IWLWAV_SET(sTpcLoopType, LTQ_NL80211_VENDOR_SUBCMD_SET_PRM_ID_TPC_LOOP_TYPE, 1, 1,
+	"<loop type>",
+	"Set TPC loop type.");
 
-static int handle_iwlwav_set_11b_ant_selection(struct nl80211_state *state,
-					       struct nl_msg *msg,
-					       int argc, char **argv,
-					       enum id_input id)
-{
-	return set_int(msg, argc, argv, 3, 3, LTQ_NL80211_VENDOR_SUBCMD_SET_11B_ANTENNA_SELECTION);
+IWLWAV_SET(sInterfDetThresh, LTQ_NL80211_VENDOR_SUBCMD_SET_INTERFER_THRESH, 1, 1,
+	"<notification_threshold>",
+	"Set interferer detection threshold");
 
-}
-COMMAND(iwlwav, s11bAntSelection, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_11b_ant_selection, "");
+IWLWAV_SET(s11bAntSelection, LTQ_NL80211_VENDOR_SUBCMD_SET_11B_ANTENNA_SELECTION, 3, 3,
+	"<txAnt> <rxAnt> <Rate>",
+	"Set 11b antenna selection.");
 
-static int handle_iwlwav_set_fw_recovery(struct nl80211_state *state,
-					 struct nl_msg *msg,
-					 int argc, char **argv,
-					 enum id_input id)
-{
-	return set_int(msg, argc, argv, 5, 5, LTQ_NL80211_VENDOR_SUBCMD_SET_FW_RECOVERY);
-}
-COMMAND(iwlwav, sFWRecovery, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_fw_recovery, "");
+IWLWAV_SET(sFWRecovery, LTQ_NL80211_VENDOR_SUBCMD_SET_FW_RECOVERY, 5, 5,
+	"<recovery mode> <number of Fast recovery> <number of full recovery> <dump evacuation on fault> <time period for consecutive recovery>",
+	"Set FW recovery.");
 
-static int handle_iwlwav_set_out_of_scan_caching(struct nl80211_state *state,
-						 struct nl_msg *msg,
-						 int argc, char **argv,
-						 enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_OUT_OF_SCAN_CACHING);
-}
-COMMAND(iwlwav, sOOScanCaching, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_out_of_scan_caching, "");
+IWLWAV_SET(sOOScanCaching, LTQ_NL80211_VENDOR_SUBCMD_SET_OUT_OF_SCAN_CACHING, 1, 1,
+	"",
+	"");
 
 static int handle_iwlwav_set_allow_scan_during_cac(struct nl80211_state *state,
 						   struct nl_msg *msg,
@@ -501,350 +637,158 @@ static int handle_iwlwav_set_allow_scan_during_cac(struct nl80211_state *state,
 }
 COMMAND(iwlwav, sAllowScanInCac, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_allow_scan_during_cac, "");
 
-static int handle_iwlwav_set_enable_radio(struct nl80211_state *state,
-					  struct nl_msg *msg,
-					  int argc, char **argv,
-					  enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_RADIO_MODE);
-}
-COMMAND(iwlwav, sEnableRadio, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_enable_radio, "");
+IWLWAV_SET(sEnableRadio, LTQ_NL80211_VENDOR_SUBCMD_SET_RADIO_MODE, 1, 1,
+	"<enable radio>",
+	"Set radio mode.");
 
-static int handle_iwlwav_set_aggr_config(struct nl80211_state *state,
-					 struct nl_msg *msg,
-					 int argc, char **argv,
-					 enum id_input id)
-{
-	return set_int(msg, argc, argv, 2, 3, LTQ_NL80211_VENDOR_SUBCMD_SET_AGGR_CONFIG);
+IWLWAV_SET(sAggrConfig, LTQ_NL80211_VENDOR_SUBCMD_SET_AGGR_CONFIG, 2, 3,
+	"<amsdu_mode> <ba_mode> [<window_size>]",
+	"Set aggr config.");
 
-}
-COMMAND(iwlwav, sAggrConfig, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_aggr_config, "");
+IWLWAV_SET(sNumMsduInAmsdu, LTQ_NL80211_VENDOR_SUBCMD_SET_AMSDU_NUM, 1, 4,
+	"<amsdu_num> <amsdu_vnum>",
+	"Set amsdu number.");
 
-static int handle_iwlwav_set_num_msdu_in_amsdu(struct nl80211_state *state,
-					       struct nl_msg *msg,
-					       int argc, char **argv,
-					       enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 4, LTQ_NL80211_VENDOR_SUBCMD_SET_AMSDU_NUM);
-}
-COMMAND(iwlwav, sNumMsduInAmsdu, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_num_msdu_in_amsdu, "");
+IWLWAV_SET(sAggRateLimit, LTQ_NL80211_VENDOR_SUBCMD_SET_AGG_RATE_LIMIT, 2, 2,
+	"<mode> <maxRate>",
+	"Set aggr rate limit.");
 
-static int handle_iwlwav_set_agg_rate_limit(struct nl80211_state *state,
-					    struct nl_msg *msg,
-					    int argc, char **argv,
-					    enum id_input id)
-{
-	return set_int(msg, argc, argv, 2, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_AGG_RATE_LIMIT);
-}
-COMMAND(iwlwav, sAggRateLimit, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_agg_rate_limit, "");
+IWLWAV_SET(sMuOfdmaBf, LTQ_NL80211_VENDOR_SUBCMD_SET_MU_OFDMA_BF, 2, 2,
+	"<mode> <bfPeriod>",
+	"Set mu ofdma beamforming.");
 
-static int handle_iwlwav_set_mu_ofdma_bf(struct nl80211_state *state,
-				struct nl_msg *msg,
-				int argc, char **argv,
-				enum id_input id)
-{
-	return set_int(msg, argc, argv, 2, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_MU_OFDMA_BF);
-}
-COMMAND(iwlwav, sMuOfdmaBf, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_mu_ofdma_bf, "");
+IWLWAV_SET(sAvailAdmCap, LTQ_NL80211_VENDOR_SUBCMD_SET_ADMISSION_CAPACITY, 1, 1,
+	"<admission capacity>",
+	"Set admission capacity.");
 
-static int handle_iwlwav_set_avail_adm_cap(struct nl80211_state *state,
-					   struct nl_msg *msg,
-					   int argc, char **argv,
-					   enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_ADMISSION_CAPACITY);
-}
-COMMAND(iwlwav, sAvailAdmCap, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_avail_adm_cap, "");
+IWLWAV_SET(sSetRxTH, LTQ_NL80211_VENDOR_SUBCMD_SET_RX_THRESHOLD, 1, 1,
+	"<rx threshold>",
+	"Set rx threshold.");
 
-static int handle_iwlwav_set_rx_th(struct nl80211_state *state,
-				   struct nl_msg *msg,
-				   int argc, char **argv,
-				   enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_RX_THRESHOLD);
-}
-COMMAND(iwlwav, sSetRxTH, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_rx_th, "");
-
-static int handle_iwlwav_set_rx_duty_cyc(struct nl80211_state *state,
-					 struct nl_msg *msg,
-					 int argc, char **argv,
-					 enum id_input id)
-{
-	return set_int(msg, argc, argv, 2, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_RX_DUTY_CYCLE);
-}
-COMMAND(iwlwav, sRxDutyCyc, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_rx_duty_cyc, "");
-
-static int handle_iwlwav_set_power_selection(struct nl80211_state *state,
-					     struct nl_msg *msg,
-					     int argc, char **argv,
-					     enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_TX_POWER_LIMIT_OFFSET);
-}
-COMMAND(iwlwav, sPowerSelection, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_power_selection, "");
+IWLWAV_SET(sRxDutyCyc, LTQ_NL80211_VENDOR_SUBCMD_SET_RX_DUTY_CYCLE, 2, 2,
+	"<onTime> <offTime>",
+	"Set rx duty cycle.");
 
-static int handle_iwlwav_set_11n_protection(struct nl80211_state *state,
-					    struct nl_msg *msg,
-					    int argc, char **argv,
-					    enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_PROTECTION_METHOD);
-}
-COMMAND(iwlwav, s11nProtection, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_11n_protection, "");
+IWLWAV_SET(sPowerSelection, LTQ_NL80211_VENDOR_SUBCMD_SET_TX_POWER_LIMIT_OFFSET, 1, 1,
+	"<power selection>",
+	"Set tx power limit offset.");
 
-static int handle_iwlwav_set_calib_on_demand(struct nl80211_state *state,
-					     struct nl_msg *msg,
-					     int argc, char **argv,
-					     enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_TEMPERATURE_SENSOR);
-}
-COMMAND(iwlwav, sCalibOnDemand, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_calib_on_demand, "");
+IWLWAV_SET(s11nProtection, LTQ_NL80211_VENDOR_SUBCMD_SET_PROTECTION_METHOD, 1, 1,
+	"<protection>",
+	"Set s11 protection method.");
 
-static int handle_iwlwav_set_qam_plus(struct nl80211_state *state,
-				      struct nl_msg *msg,
-				      int argc, char **argv,
-				      enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_QAMPLUS_MODE);
-}
-COMMAND(iwlwav, sQAMplus, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_qam_plus, "");
+IWLWAV_SET(sCalibOnDemand, LTQ_NL80211_VENDOR_SUBCMD_SET_TEMPERATURE_SENSOR, 1, 1,
+	"<calib on demand>",
+	"Set calib on demand.");
 
-static int handle_iwlwav_set_acs_update_to(struct nl80211_state *state,
-					   struct nl_msg *msg,
-					   int argc, char **argv,
-					   enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_ACS_UPDATE_TO);
-}
-COMMAND(iwlwav, sAcsUpdateTo, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_acs_update_to, "");
+IWLWAV_SET(sQAMplus, LTQ_NL80211_VENDOR_SUBCMD_SET_QAMPLUS_MODE, 1, 1,
+	"<QAMplus mode>",
+	"Set QAMplus mode.");
 
-static int handle_iwlwav_set_mu_operation(struct nl80211_state *state,
-					  struct nl_msg *msg,
-					  int argc, char **argv,
-					  enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_MU_OPERATION);
+IWLWAV_SET(sAcsUpdateTo, LTQ_NL80211_VENDOR_SUBCMD_SET_ACS_UPDATE_TO, 1, 1,
+	"<update to>",
+	"Set acs update to.");
 
-}
-COMMAND(iwlwav, sMuOperation, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_mu_operation, "");
+IWLWAV_SET(sMuOperation, LTQ_NL80211_VENDOR_SUBCMD_SET_MU_OPERATION, 1, 1,
+	"<mu operation>",
+	"Set mu operation.");
 
-static int handle_iwlwav_set_cca_th(struct nl80211_state *state,
-				    struct nl_msg *msg,
-				    int argc, char **argv,
-				    enum id_input id)
-{
-	return set_int(msg, argc, argv, 5, 5, LTQ_NL80211_VENDOR_SUBCMD_SET_CCA_THRESHOLD);
-}
-COMMAND(iwlwav, sCcaTh, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_cca_th, "");
+IWLWAV_SET(sCcaTh, LTQ_NL80211_VENDOR_SUBCMD_SET_CCA_THRESHOLD, 5, 5,
+	"<primary> <secondary> <midPktPrimary> <midPktSecondary20> <midPktSecondary40>",
+	"Set CCA threshold.");
 
-static int handle_iwlwav_set_cca_adapt(struct nl80211_state *state,
-				       struct nl_msg *msg,
-				       int argc, char **argv,
-				       enum id_input id)
-{
-	return set_int(msg, argc, argv, 7, 7, LTQ_NL80211_VENDOR_SUBCMD_SET_CCA_ADAPT);
-}
-COMMAND(iwlwav, sCcaAdapt, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_cca_adapt, "");
+IWLWAV_SET(sCcaAdapt, LTQ_NL80211_VENDOR_SUBCMD_SET_CCA_ADAPT, 7, 7,
+	"<initial interval> <iterative interval> <limit> <step up> <step down> <step down interval> <min unblocked time>",
+	"Set CCA adapt.");
 
-static int handle_iwlwav_set_radar_rssi_th(struct nl80211_state *state,
-					   struct nl_msg *msg,
-					   int argc, char **argv,
-					   enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_RADAR_RSSI_TH);
-}
-COMMAND(iwlwav, sRadarRssiTh, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_radar_rssi_th, "");
+IWLWAV_SET(sRadarRssiTh, LTQ_NL80211_VENDOR_SUBCMD_SET_RADAR_RSSI_TH, 1, 1,
+	"<radar rssi>",
+	"Set radar rssi threashold.");
 
-static int handle_iwlwav_set_fils_beacon_flag(struct nl80211_state *state,
-					   struct nl_msg *msg,
-					   int argc, char **argv,
-					   enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_FILS_BEACON_FLAG);
-}
-COMMAND(iwlwav, sFilsBeaconFlag, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_fils_beacon_flag, "");
+IWLWAV_SET(sFilsBeaconFlag, LTQ_NL80211_VENDOR_SUBCMD_SET_FILS_BEACON_FLAG, 1, 1,
+	"<beacon flag>",
+	"Set Fils Beacon Flag.");
 
 
-static int handle_iwlwav_set_rts_mode(struct nl80211_state *state,
-				      struct nl_msg *msg,
-				      int argc, char **argv,
-				      enum id_input id)
-{
-	return set_int(msg, argc, argv, 2, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_RTS_MODE);
-}
-COMMAND(iwlwav, sRTSmode, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_rts_mode, "");
+IWLWAV_SET(sRTSmode, LTQ_NL80211_VENDOR_SUBCMD_SET_RTS_MODE, 2, 2,
+	"<dynamic_bw> <static_bw>",
+	"Set RTS mode.");
 
-static int handle_iwlwav_set_max_mpdu_len(struct nl80211_state *state,
-					  struct nl_msg *msg,
-					  int argc, char **argv,
-					  enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_MAX_MPDU_LENGTH);
-}
-COMMAND(iwlwav, sMaxMpduLen, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_max_mpdu_len, "");
+IWLWAV_SET(sMaxMpduLen, LTQ_NL80211_VENDOR_SUBCMD_SET_MAX_MPDU_LENGTH, 1, 1,
+	"<max length>",
+	"Set max mpdu length.");
 
-static int handle_iwlwav_set_bf_mode(struct nl80211_state *state,
-				     struct nl_msg *msg,
-				     int argc, char **argv,
-				     enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_BF_MODE);
-}
-COMMAND(iwlwav, sBfMode, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_bf_mode, "");
+IWLWAV_SET(sBfMode, LTQ_NL80211_VENDOR_SUBCMD_SET_BF_MODE, 1, 1,
+	"<bf mode>",
+	"Set bf mode.");
 
-static int handle_iwlwav_set_probe_req_list_mode(struct nl80211_state *state,
-						 struct nl_msg *msg,
-						 int argc, char **argv,
-						 enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_CLT_PROBE_REQS_MODE);
-}
-COMMAND(iwlwav, sProbeReqCltMode, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_probe_req_list_mode, "");
+IWLWAV_SET(sProbeReqCltMode, LTQ_NL80211_VENDOR_SUBCMD_SET_CLT_PROBE_REQS_MODE, 1, 1,
+	"<enable/disable probe request collection>",
+	"Set bf mode.");
 
-static int handle_iwlwav_set_active_ant_mask(struct nl80211_state *state,
-					     struct nl_msg *msg,
-					     int argc, char **argv,
-					     enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_ACTIVE_ANT_MASK);
-}
-COMMAND(iwlwav, sActiveAntMask, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_active_ant_mask, "");
+IWLWAV_SET(sActiveAntMask, LTQ_NL80211_VENDOR_SUBCMD_SET_ACTIVE_ANT_MASK, 1, 1,
+	"<active ant mask>",
+	"Set active ant mask.");
 
-static int handle_iwlwav_set_add_four_addr_sta(struct nl80211_state *state,
-					       struct nl_msg *msg,
-					       int argc, char **argv,
-					       enum id_input id)
-{
-	return set_addr(msg, argc, argv, LTQ_NL80211_VENDOR_SUBCMD_SET_4ADDR_STA_ADD);
-}
-COMMAND(iwlwav, sAddFourAddrSta, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_add_four_addr_sta, "");
+IWLWAV_SET(sAddFourAddrSta, LTQ_NL80211_VENDOR_SUBCMD_SET_4ADDR_STA_ADD, 1, 1,
+	"<mac address>",
+	"Set add 4addr STA.", IWLWAV_MAC);
 
-static int handle_iwlwav_set_del_four_addr_sta(struct nl80211_state *state,
-					       struct nl_msg *msg,
-					       int argc, char **argv,
-					       enum id_input id)
-{
-	return set_addr(msg, argc, argv, LTQ_NL80211_VENDOR_SUBCMD_SET_4ADDR_STA_DEL);
-}
-COMMAND(iwlwav, sDelFourAddrSta, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_del_four_addr_sta, "");
+IWLWAV_SET(sDelFourAddrSta, LTQ_NL80211_VENDOR_SUBCMD_SET_4ADDR_STA_DEL, 1, 1,
+	"<mac address>",
+	"Set delete 4addr STA.", IWLWAV_MAC);
 
-static int handle_iwlwav_set_txop_config(struct nl80211_state *state,
-					 struct nl_msg *msg,
-					 int argc, char **argv,
-					 enum id_input id)
-{
-	return set_int(msg, argc, argv, 4, 4, LTQ_NL80211_VENDOR_SUBCMD_SET_TXOP_CONFIG);
-}
-COMMAND(iwlwav, sTxopConfig, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_txop_config, "");
+IWLWAV_SET(sTxopConfig, LTQ_NL80211_VENDOR_SUBCMD_SET_TXOP_CONFIG, 4, 4,
+	"<STA ID> <Mode> <Duration> <Max number of STAs>",
+	"Set txop config.");
 
-static int handle_iwlwav_set_ssb_mode(struct nl80211_state *state,
-				      struct nl_msg *msg,
-				      int argc, char **argv,
-				      enum id_input id)
-{
-	return set_int(msg, argc, argv, 2, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_SSB_MODE);
-}
-COMMAND(iwlwav, sSsbMode, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_ssb_mode, "");
+IWLWAV_SET(sSsbMode, LTQ_NL80211_VENDOR_SUBCMD_SET_SSB_MODE, 2, 2,
+	"<value_1> <value_2>",
+	"Set SSB mode.");
 
-static int handle_iwlwav_set_mcast_range(struct nl80211_state *state,
-					 struct nl_msg *msg,
-					 int argc, char **argv,
-					 enum id_input id)
-{
-	return set_text(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_MCAST_RANGE_SETUP);
-}
-COMMAND(iwlwav, sMcastRange, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_mcast_range, "");
+IWLWAV_SET(sMcastRange, LTQ_NL80211_VENDOR_SUBCMD_SET_MCAST_RANGE_SETUP, 1, 1,
+	"<operation>,<mcast range>",
+	"Set mcast range.\n<operation> = 0 delete all.\n<operation> = 1 add.\n<operation> = 2 delete.", IWLWAV_TEXT);
 
-static int handle_iwlwav_set_mcast_range6(struct nl80211_state *state,
-					  struct nl_msg *msg,
-					  int argc, char **argv,
-					  enum id_input id)
-{
-	return set_text(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_MCAST_RANGE_SETUP_IPV6);
-}
-COMMAND(iwlwav, sMcastRange6, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_mcast_range6, "");
+IWLWAV_SET(sMcastRange6, LTQ_NL80211_VENDOR_SUBCMD_SET_MCAST_RANGE_SETUP_IPV6, 1, 1,
+	"<operation>,<mcast range6>",
+	"Set mcast range.\n<operation> = 0 delete all.\n<operation> = 1 add.\n<operation> = 2 delete.", IWLWAV_TEXT);
 
-static int handle_iwlwav_set_unknown_mcast_filter_mode(struct nl80211_state *state,
-						       struct nl_msg *msg,
-						       int argc, char **argv,
-						       enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_FORWARD_UNKNOWN_MCAST_FLAG);
-}
-COMMAND(iwlwav, sFwrdUnkwnMcast, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_unknown_mcast_filter_mode, "");
+IWLWAV_SET(sFwrdUnkwnMcast, LTQ_NL80211_VENDOR_SUBCMD_SET_FORWARD_UNKNOWN_MCAST_FLAG, 1, 1,
+	"",
+	"");
 
-static int handle_iwlwav_set_online_acm(struct nl80211_state *state,
-					struct nl_msg *msg,
-					int argc, char **argv,
-					enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_ONLINE_CALIBRATION_ALGO_MASK);
-}
-COMMAND(iwlwav, sOnlineACM, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_online_acm, "");
+IWLWAV_SET(sOnlineACM, LTQ_NL80211_VENDOR_SUBCMD_SET_ONLINE_CALIBRATION_ALGO_MASK, 1, 1,
+	"<online acm>",
+	"Set online acm.");
 
-static int handle_iwlwav_set_algo_calibr_mask(struct nl80211_state *state,
-					      struct nl_msg *msg,
-					      int argc, char **argv,
-					      enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_CALIBRATION_ALGO_MASK);
-}
-COMMAND(iwlwav, sAlgoCalibrMask, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_algo_calibr_mask, "");
+IWLWAV_SET(sAlgoCalibrMask, LTQ_NL80211_VENDOR_SUBCMD_SET_CALIBRATION_ALGO_MASK, 1, 1,
+	"<calibr mask>",
+	"Set algo calibration mask.");
 
-static int handle_iwlwav_set_whm_reset(struct nl80211_state *state,
-					    struct nl_msg *msg,
-					    int argc, char **argv,
-					    enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_WHM_RESET);
-}
-COMMAND(iwlwav, sWhmReset, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_whm_reset, "");
+IWLWAV_SET(sWhmReset, LTQ_NL80211_VENDOR_SUBCMD_SET_WHM_RESET, 1, 1,
+	"<Reset WHM>",
+	"Set WHM Reset.");
 
-static int handle_iwlwav_set_whm_trigger(struct nl80211_state *state,
-					    struct nl_msg *msg,
-					    int argc, char **argv,
-					    enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_WHM_TRIGGER);
-}
-COMMAND(iwlwav, sWhmTrigger, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_whm_trigger, "");
+IWLWAV_SET(sWhmTrigger, LTQ_NL80211_VENDOR_SUBCMD_SET_WHM_TRIGGER, 1, 2,
+	"<WHM WarningId 101...150> <WHM WarningLayer>",
+	"Set WHM Trigger.");
 
-static int handle_iwlwav_set_restrict_ac_mode(struct nl80211_state *state,
-					      struct nl_msg *msg,
-					      int argc, char **argv,
-					      enum id_input id)
-{
-	return set_int(msg, argc, argv, 4, 4, LTQ_NL80211_VENDOR_SUBCMD_SET_RESTRICTED_AC_MODE);
-}
-COMMAND(iwlwav, sRestrictAcMode, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_restrict_ac_mode, "");
+IWLWAV_SET(sRestrictAcMode, LTQ_NL80211_VENDOR_SUBCMD_SET_RESTRICTED_AC_MODE, 4, 4,
+	"<restrictedAcModeEnable> <acRestrictedBitmap> <restrictedAcThreshEnter> <restrictedAcThreshExit>",
+	"Set restricted ac mode.");
 
-static int handle_iwlwav_set_pd_thresh(struct nl80211_state *state,
-				       struct nl_msg *msg,
-				       int argc, char **argv,
-				       enum id_input id)
-{
-	return set_int(msg, argc, argv, 3, 3, LTQ_NL80211_VENDOR_SUBCMD_SET_PD_THRESHOLD);
-}
-COMMAND(iwlwav, sPdThresh, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_pd_thresh, "");
+IWLWAV_SET(sPdThresh, LTQ_NL80211_VENDOR_SUBCMD_SET_PD_THRESHOLD, 3, 3,
+	"<mode> <minPdDiff> <minPdAmount>",
+	"Set pd threshold.");
 
-static int handle_iwlwav_set_fast_drop(struct nl80211_state *state,
-				       struct nl_msg *msg,
-				       int argc, char **argv,
-				       enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_FAST_DROP);
-}
-COMMAND(iwlwav, sFastDrop, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_fast_drop, "");
+IWLWAV_SET(sFastDrop, LTQ_NL80211_VENDOR_SUBCMD_SET_FAST_DROP, 1, 1,
+	"<fast drop>",
+	"Set fast drop.");
 
-static int handle_iwlwav_set_erp_set(struct nl80211_state *state,
-				     struct nl_msg *msg,
-				     int argc, char **argv,
-				     enum id_input id)
-{
-	return set_int(msg, argc, argv, 10, 10, LTQ_NL80211_VENDOR_SUBCMD_SET_ERP);
-}
-COMMAND(iwlwav, sErpSet, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_erp_set, "");
+IWLWAV_SET(sErpSet, LTQ_NL80211_VENDOR_SUBCMD_SET_ERP, 10, 10,
+	"",
+	"");
 
 static int handle_iwlwav_set_mu_stat_plan_cfg(struct nl80211_state *state,
 					      struct nl_msg *msg,
@@ -865,24 +809,14 @@ static int handle_iwlwav_set_pie_cfg(struct nl80211_state *state,
 }
 COMMAND(iwlwav, sPIEcfg, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_pie_cfg, "");
 
-static int handle_iwlwav_set_aqm_en(struct nl80211_state *state,
-				     struct nl_msg *msg,
-				     int argc, char **argv,
-				     enum id_input id)
-{
-	return set_int(msg, argc, argv, 2, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_AQM_STA_EN);
-}
-COMMAND(iwlwav, sAqmEn, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_aqm_en, "");
+IWLWAV_SET(sAqmEn, LTQ_NL80211_VENDOR_SUBCMD_SET_AQM_STA_EN, 2, 2,
+	"<sid> <0/1>",
+	"Set AQM enabled.");
 #endif /* WAVE_ENABLE_PIE */
 
-static int handle_iwlwav_set_cca_preamble_puncture_cfg(struct nl80211_state *state,
-					struct nl_msg *msg,
-					int argc, char **argv,
-					enum id_input id)
-{
-	return set_int(msg, argc, argv, 3, 3, LTQ_NL80211_VENDOR_SUBCMD_SET_CCA_PREAMBLE_PUNCTURE_CFG);
-}
-COMMAND(iwlwav, sPreamPunCcaOvr, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_cca_preamble_puncture_cfg, "");
+IWLWAV_SET(sPreamPunCcaOvr, LTQ_NL80211_VENDOR_SUBCMD_SET_CCA_PREAMBLE_PUNCTURE_CFG, 3, 3,
+	"",
+	"Set Preamble puncture cca override.");
 
 /******************************************************************************/
 /*! \brief      Prepare Intel vendor netlink command with WEP ecryption data for sending
@@ -927,169 +861,83 @@ nla_put_failure:
 }
 COMMAND(iwlwav, sWdsWepEncCfg, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_wds_wep_enc_cfg, "");
 
-static int handle_iwlwav_set_rts_rate(struct nl80211_state *state,
-				      struct nl_msg *msg,
-				      int argc, char **argv,
-				      enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_RTS_RATE);
-}
-COMMAND(iwlwav, sRtsRate, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_rts_rate, "");
-
-static int handle_iwlwav_set_stations_statistics(struct nl80211_state *state,
-						 struct nl_msg *msg,
-						 int argc, char **argv,
-						 enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_STATIONS_STATISTICS);
-}
-COMMAND(iwlwav, sStationsStat, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_stations_statistics, "");
-
-static int handle_iwlwav_set_stats_poll_period(struct nl80211_state *state,
-					       struct nl_msg *msg,
-					       int argc, char **argv,
-					       enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_STATS_POLL_PERIOD);
-}
-COMMAND(iwlwav, sStatsPollPeriod, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_stats_poll_period, "");
+IWLWAV_SET(sRtsRate, LTQ_NL80211_VENDOR_SUBCMD_SET_RTS_RATE, 1, 1,
+	"<0..2>",
+	"Set RTS protection rate.",
+	IWLWAV_RANGE(0, 2));
 
-static int handle_iwlwav_set_dynamic_mu_type(struct nl80211_state *state,
-					     struct nl_msg *msg,
-					     int argc, char **argv,
-					     enum id_input id)
-{
-	return set_int(msg, argc, argv, 5, 5, LTQ_NL80211_VENDOR_SUBCMD_SET_DYNAMIC_MU_TYPE);
-}
-COMMAND(iwlwav, sDynamicMu, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_dynamic_mu_type, "");
+IWLWAV_SET(sStationsStat, LTQ_NL80211_VENDOR_SUBCMD_SET_STATIONS_STATISTICS, 1, 1,
+	"<0..1>",
+	"Set stations statistics (enable/disable).",
+	IWLWAV_RANGE(0, 1));
 
-static int handle_iwlwav_set_he_mu_fixed_parameters(struct nl80211_state *state,
-						    struct nl_msg *msg,
-						    int argc, char **argv,
-						    enum id_input id)
-{
-	return set_int(msg, argc, argv, 4, 4, LTQ_NL80211_VENDOR_SUBCMD_SET_HE_MU_FIXED_PARAMETERS);
-}
-COMMAND(iwlwav, sMuFixedCfg, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_he_mu_fixed_parameters, "");
+IWLWAV_SET(sStatsPollPeriod, LTQ_NL80211_VENDOR_SUBCMD_SET_STATS_POLL_PERIOD, 1, 1,
+	"<1..300>",
+	"Set statistics auto polling period.",
+	IWLWAV_RANGE(1, 300));
 
-static int handle_iwlwav_set_he_mu_duration(struct nl80211_state *state,
-					    struct nl_msg *msg,
-					    int argc, char **argv,
-					    enum id_input id)
-{
-	return set_int(msg, argc, argv, 4, 4, LTQ_NL80211_VENDOR_SUBCMD_SET_HE_MU_DURATION);
-}
-COMMAND(iwlwav, sMuDurationCfg, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_he_mu_duration, "");
+IWLWAV_SET(sDynamicMu, LTQ_NL80211_VENDOR_SUBCMD_SET_DYNAMIC_MU_TYPE, 5, 5,
+	"<dl mu type> <ul mu type> <min stas in group> <max stas in group> <cdb cfg>",
+	"Set Dynamic MU type.");
 
-static int handle_iwlwav_set_etsi_ppdu_limits(struct nl80211_state *state,
-					      struct nl_msg *msg,
-					      int argc, char **argv,
-					      enum id_input id)
-{
-    return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_ETSI_PPDU_LIMITS);
-}
-COMMAND(iwlwav, sETSILimitation, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_etsi_ppdu_limits, "");
+IWLWAV_SET(sMuFixedCfg, LTQ_NL80211_VENDOR_SUBCMD_SET_HE_MU_FIXED_PARAMETERS, 4, 4,
+	"<mu sequence> <ltf gi> <coding type> <he rate>",
+	"Set HE MU Fixed parameters.");
 
-static int handle_iwlwav_set_tx_retry_limit(struct nl80211_state *state,
-					    struct nl_msg *msg,
-					    int argc, char **argv,
-					    enum id_input id)
-{
-	return set_int(msg, argc, argv, 3, 3, LTQ_NL80211_VENDOR_SUBCMD_SET_AP_RETRY_LIMIT);
-}
-COMMAND(iwlwav, sTxRetryLimit, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_tx_retry_limit, "");
+IWLWAV_SET(sMuDurationCfg, LTQ_NL80211_VENDOR_SUBCMD_SET_HE_MU_DURATION, 4, 4,
+	"<ppdu duration> <txop duration> <tf length> <num of repetitions>",
+	"Set HE MU Duration.");
 
+IWLWAV_SET(sETSILimitation, LTQ_NL80211_VENDOR_SUBCMD_SET_ETSI_PPDU_LIMITS, 1, 1,
+	"<enable/disable>",
+	"Set ETSI PPDU Limitation.");
 
-static int handle_iwlwav_set_tx_exce_retry_limit(struct nl80211_state *state,
-					    struct nl_msg *msg,
-					    int argc, char **argv,
-					    enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_AP_EXCE_RETRY_LIMIT);
-}
-COMMAND(iwlwav, sTxExceRetryLimit, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_tx_exce_retry_limit, "");
+IWLWAV_SET(sTxRetryLimit, LTQ_NL80211_VENDOR_SUBCMD_SET_AP_RETRY_LIMIT, 3, 3,
+	"<mgmt[0...15]> <data[0...15]> <proberesp[0...15]>",
+	"Set Tx Retry Limit.",
+	IWLWAV_RANGE(0, 15));
 
-static int handle_iwlwav_set_cts_to_self_to(struct nl80211_state *state,
-					    struct nl_msg *msg,
-					    int argc, char **argv,
-					    enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_CTS_TO_SELF_TO);
-}
-COMMAND(iwlwav, sCtsToSelfTo, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_cts_to_self_to, "");
+IWLWAV_SET(sTxExceRetryLimit, LTQ_NL80211_VENDOR_SUBCMD_SET_AP_EXCE_RETRY_LIMIT, 1, 1,
+	"<threshold[0..255]>",
+	"Set excessive retry limit.",
+	IWLWAV_RANGE(0, 255));
 
-static int handle_iwlwav_set_tx_ampdu_density(struct nl80211_state *state,
-					      struct nl_msg *msg,
-					      int argc, char **argv,
-					      enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_TX_AMPDU_DENSITY);
-}
-COMMAND(iwlwav, sTxAmpduDensity, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_tx_ampdu_density, "");
+IWLWAV_SET(sCtsToSelfTo, LTQ_NL80211_VENDOR_SUBCMD_SET_CTS_TO_SELF_TO, 1, 1,
+	"<1..32ms>",
+	"Set Cts to self timeout.",
+	IWLWAV_RANGE(1, 32));
 
-static int handle_iwlwav_set_slow_probing_mask(struct nl80211_state *state,
-					       struct nl_msg *msg,
-					       int argc, char **argv,
-					       enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_PROBING_MASK);
-}
-COMMAND(iwlwav, sSlowProbingMask, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_slow_probing_mask, "");
+IWLWAV_SET(sTxAmpduDensity, LTQ_NL80211_VENDOR_SUBCMD_SET_TX_AMPDU_DENSITY, 1, 1,
+	"",
+	"");
 
-static int handle_iwlwav_set_scan_modif_flags(struct nl80211_state *state,
-					      struct nl_msg *msg,
-					      int argc, char **argv,
-					      enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_SCAN_MODIFS);
-}
-COMMAND(iwlwav, sScanModifFlags, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_scan_modif_flags, "");
+IWLWAV_SET(sSlowProbingMask, LTQ_NL80211_VENDOR_SUBCMD_SET_PROBING_MASK, 1, 1,
+	"<probing mask>",
+	"Set slow probing mask.");
 
-static int handle_iwlwav_set_scan_pause_bg_cache(struct nl80211_state *state,
-					    struct nl_msg *msg,
-					    int argc, char **argv,
-					    enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_SCAN_PAUSE_BG_CACHE);
-}
-COMMAND(iwlwav, sScanPauseBGCache, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_scan_pause_bg_cache, "");
+IWLWAV_SET(sScanModifFlags, LTQ_NL80211_VENDOR_SUBCMD_SET_SCAN_MODIFS, 1, 1,
+	"<modifs flags>",
+	"Set scan modifs.");
 
-static int handle_iwlwav_set_zwdfs_antenna(struct nl80211_state *state,
-					    struct nl_msg *msg,
-					    int argc, char **argv,
-					    enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_ZWDFS_ANT);
-}
+IWLWAV_SET(sScanPauseBGCache, LTQ_NL80211_VENDOR_SUBCMD_SET_SCAN_PAUSE_BG_CACHE, 1, 1,
+	"<flag>",
+	"Set scan pause bg cache.");
 
-COMMAND(iwlwav, sZwdfsAnt, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_zwdfs_antenna, "");
+IWLWAV_SET(sZwdfsAnt, LTQ_NL80211_VENDOR_SUBCMD_SET_ZWDFS_ANT, 1, 1,
+	"<flag>",
+	"Set zwdfs antenna.");
 
-static int handle_iwlwav_set_config_mrcoex(struct nl80211_state *state,
-					   struct nl_msg *msg,
-					   int argc, char **argv,
-					   enum id_input id)
-{
-	return set_int(msg, argc, argv, 4, 4, LTQ_NL80211_VENDOR_SUBCMD_SET_COEX_CFG);
-}
-COMMAND(iwlwav, sConfigMRCoex, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_config_mrcoex, "");
+IWLWAV_SET(sConfigMRCoex, LTQ_NL80211_VENDOR_SUBCMD_SET_COEX_CFG, 4, 4,
+	"<coex mode> <active time> <inactive time> <cts2self active>",
+	"Set coex enable.");
 
-static int handle_iwlwav_set_fixed_ltf_gi(struct nl80211_state *state,
-					  struct nl_msg *msg,
-					  int argc, char **argv,
-					  enum id_input id)
-{
-	return set_int(msg, argc, argv, 2, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_FIXED_LTF_AND_GI);
-}
-COMMAND(iwlwav, sFixedLtfGi, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_fixed_ltf_gi, "");
+IWLWAV_SET(sFixedLtfGi, LTQ_NL80211_VENDOR_SUBCMD_SET_FIXED_LTF_AND_GI, 2, 2,
+	"<0-fixed, 1-auto> <value for fixed>",
+	"Set fixed lt fgi.");
 
-static int handle_iwlwav_set_mgmt_frame_pwr_ctrl(struct nl80211_state *state,
-					    struct nl_msg *msg,
-					    int argc, char **argv,
-					    enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_MGMT_FRAME_PWR_CTRL);
-}
-COMMAND(iwlwav, sMgmtFramePwrCtrl, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_mgmt_frame_pwr_ctrl, "");
+IWLWAV_SET(sMgmtFramePwrCtrl, LTQ_NL80211_VENDOR_SUBCMD_SET_MGMT_FRAME_PWR_CTRL, 1, 1,
+	"<power>",
+	"Set Management Frame Tx Power.");
 
 static int handle_iwlwav_set_csi_enable(struct nl80211_state *state,
 					    struct nl_msg *msg,
@@ -1100,14 +948,9 @@ static int handle_iwlwav_set_csi_enable(struct nl80211_state *state,
 }
 COMMAND(iwlwav, sEnableCsiEngine, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_csi_enable, "");
 
-static int handle_iwlwav_set_csi_send_qos_null(struct nl80211_state *state,
-					    struct nl_msg *msg,
-					    int argc, char **argv,
-					    enum id_input id)
-{
-	return set_addr(msg, argc, argv, LTQ_NL80211_VENDOR_SUBCMD_CSI_SEND_NDP);
-}
-COMMAND(iwlwav, sCsiSendQosNull, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_csi_send_qos_null, "");
+IWLWAV_SET(sCsiSendQosNull, LTQ_NL80211_VENDOR_SUBCMD_CSI_SEND_NDP, 1, 1,
+	"<Station MAC Addr>",
+	"Set CSI Send QOS NULL.", IWLWAV_MAC);
 
 static int handle_iwlwav_set_csi_auto_rate(struct nl80211_state *state,
 					    struct nl_msg *msg,
@@ -1118,41 +961,22 @@ static int handle_iwlwav_set_csi_auto_rate(struct nl80211_state *state,
 }
 COMMAND(iwlwav, sCsi, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_csi_auto_rate, "");
 
-static int handle_iwlwav_set_fixed_rate_cfg(struct nl80211_state *state,
-					    struct nl_msg *msg,
-					    int argc, char **argv,
-					    enum id_input id)
-{
-	return set_int(msg, argc, argv, 11, 11, LTQ_NL80211_VENDOR_SUBCMD_SET_FIXED_RATE);
-}
-COMMAND(iwlwav, sFixedRateCfg, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_fixed_rate_cfg, "");
+IWLWAV_SET(sFixedRateCfg, LTQ_NL80211_VENDOR_SUBCMD_SET_FIXED_RATE, 11, 11,
+	"<stationIndex> <isAutoRate> <bw> <phyMode> <nss> <mcs> <scp> <dcm> <heExtPartialBwData> <heExtPartialBwMng> <changeType>",
+	"Set fixed rate.");
 
-static int handle_iwlwav_set_allow_3addr_mcast(struct nl80211_state *state,
-					   struct nl_msg *msg,
-					   int argc, char **argv,
-					   enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_ALLOW_3ADDR_MCAST);
-}
-COMMAND(iwlwav, sAllow3AddrMcast, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_allow_3addr_mcast, "");
+IWLWAV_SET(sAllow3AddrMcast, LTQ_NL80211_VENDOR_SUBCMD_SET_ALLOW_3ADDR_MCAST, 1, 1,
+	"<3addr Flag 0/1>",
+	"Allow 3Address Multicast mode.",
+	IWLWAV_RANGE(0, 1));
 
-static int handle_iwlwav_set_do_debug_assert(struct nl80211_state *state,
-					     struct nl_msg *msg,
-					     int argc, char **argv,
-					     enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_DBG_ASSERT);
-}
-COMMAND(iwlwav, sDoDebugAssert, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_do_debug_assert, "");
+IWLWAV_SET(sDoDebugAssert, LTQ_NL80211_VENDOR_SUBCMD_SET_DBG_ASSERT, 1, 2,
+	"<assert type> [optional type]",
+	"Assert FW.");
 
-static int handle_iwlwav_set_logger_fifo_mux_cfg(struct nl80211_state *state,
-					     struct nl_msg *msg,
-					     int argc, char **argv,
-					     enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, MXL_NL80211_VENDOR_SUBCMD_SET_LOGGER_FIFO_MUX_CFG);
-}
-COMMAND(iwlwav, sLoggerFifoMuxCfg, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_logger_fifo_mux_cfg, "");
+IWLWAV_SET(sLoggerFifoMuxCfg, MXL_NL80211_VENDOR_SUBCMD_SET_LOGGER_FIFO_MUX_CFG, 1, 1,
+	"",
+	"");
 
 
 static int handle_iwlwav_set_ml_link_stats(struct nl80211_state *state,
@@ -1184,297 +1008,138 @@ nla_put_failure:
 }
 COMMAND(iwlwav, sMLLinkStats, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_ml_link_stats, "");
 
-static int handle_iwlwav_set_mu_groups_config(struct nl80211_state *state,
-                                              struct nl_msg *msg,
-                                              int argc, char **argv,
-                                              enum id_input id)
-{
-    return set_int(msg, argc, argv, 3, 3, LTQ_NL80211_VENDOR_SUBCMD_SET_MU_GROUPS_CONFIG);
-}
-COMMAND(iwlwav, sMuStaRangeForGroupPerType, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_mu_groups_config, "");
+IWLWAV_SET(sMuStaRangeForGroupPerType, LTQ_NL80211_VENDOR_SUBCMD_SET_MU_GROUPS_CONFIG, 3, 3,
+	"<formation type> <minimum STAs> <maximum STAs>",
+	"Set Min and Max number of STAs for MU for formation type");
 
-static int handle_iwlwav_set_str_tid_link_spreading_config(struct nl80211_state *state,
-                                                         struct nl_msg *msg,
-                                                         int argc, char **argv,
-                                                         enum id_input id)
-{
-    return set_int(msg, argc, argv, 1, 3, LTQ_NL80211_VENDOR_SUBCMD_SET_STR_TID_LINK_SPREADING);
-}
-COMMAND(iwlwav, sTIDlinkSpreading, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_str_tid_link_spreading_config, "");
+IWLWAV_SET(sTIDlinkSpreading, LTQ_NL80211_VENDOR_SUBCMD_SET_STR_TID_LINK_SPREADING, 1, 3,
+	"<enable:1|0> [<dynamic_mode:1|0> [<static tid split ratio>]]",
+	"TID to link spreading configuration for MLD STR clients");
 
-static int handle_iwlwav_set_pcie_auto_cfg(struct nl80211_state *state,
-                                            struct nl_msg *msg,
-                                            int argc, char **argv,
-                                            enum id_input id)
-{
-        return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_PCIE_AUTO_GEN_ENABLE);
-}
-COMMAND(iwlwav, sPcieAutoGenEnable, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_pcie_auto_cfg, "");
+IWLWAV_SET(sPcieAutoGenEnable, LTQ_NL80211_VENDOR_SUBCMD_SET_PCIE_AUTO_GEN_ENABLE, 1, 1,
+	"",
+	"");
 
 /***************************** DEBUG SET COMMANDS ************************/
 #ifdef CONFIG_WAVE_DEBUG
-static int handle_iwlwav_set_fixed_rate_thermal(struct nl80211_state *state,
-					 struct nl_msg *msg,
-					 int argc, char **argv,
-					 enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 3, LTQ_NL80211_VENDOR_SUBCMD_SET_FIXED_RATE_THERMAL);
-}
-COMMAND(iwlwav, sFixedRateThermal, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_fixed_rate_thermal, "");
+IWLWAV_SET(sFixedRateThermal, LTQ_NL80211_VENDOR_SUBCMD_SET_FIXED_RATE_THERMAL, 1, 3,
+	"<enable/disable> <threshold> <power_reduction_amount>",
+	"Set fixed rate thermal.");
 
-static int handle_iwlwav_set_counters_src(struct nl80211_state *state,
-					  struct nl_msg *msg,
-					  int argc, char **argv,
-					  enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_COUNTERS_SRC);
-}
-COMMAND(iwlwav, sCountersSrc, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_counters_src, "");
+IWLWAV_SET(sCountersSrc, LTQ_NL80211_VENDOR_SUBCMD_SET_COUNTERS_SRC, 1, 1,
+	"<counter src>",
+	"Set switch counter src.");
 
-static int handle_iwlwav_set_unconn_time(struct nl80211_state *state,
-					 struct nl_msg *msg,
-					 int argc, char **argv,
-					 enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_UNCONNECTED_STA_SCAN_TIME);
-}
-COMMAND(iwlwav, sUnconnTime, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_unconn_time, "");
+IWLWAV_SET(sUnconnTime, LTQ_NL80211_VENDOR_SUBCMD_SET_UNCONNECTED_STA_SCAN_TIME, 1, 1,
+	"<unconnected scan time>",
+	"Set unconnected STA scan time.");
 
-static int handle_iwlwav_set_fixed_power(struct nl80211_state *state,
-					 struct nl_msg *msg,
-					 int argc, char **argv,
-					 enum id_input id)
-{
-	return set_int(msg, argc, argv, 4, 4, LTQ_NL80211_VENDOR_SUBCMD_SET_FIXED_POWER);
-}
-COMMAND(iwlwav, sFixedPower, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_fixed_power, "");
+IWLWAV_SET(sFixedPower, LTQ_NL80211_VENDOR_SUBCMD_SET_FIXED_POWER, 4, 4,
+	"<vapId> <stationId> <powerVal> <changeType>",
+	"Set fixed power.");
 
-static int handle_iwlwav_set_cpu_dma_latency(struct nl80211_state *state,
-					     struct nl_msg *msg,
-					     int argc, char **argv,
-					     enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_CPU_DMA_LATENCY);
-}
-COMMAND(iwlwav, sCpuDmaLatency, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_cpu_dma_latency, "");
+IWLWAV_SET(sCpuDmaLatency, LTQ_NL80211_VENDOR_SUBCMD_SET_CPU_DMA_LATENCY, 1, 1,
+	"<latency>",
+	"Set control CPU DMA Latency.");
 
-static int handle_iwlwav_set_tasklet_limits(struct nl80211_state *state,
-					    struct nl_msg *msg,
-					    int argc, char **argv,
-					    enum id_input id)
-{
-	return set_int(msg, argc, argv, 5, 5, LTQ_NL80211_VENDOR_SUBCMD_SET_TASKLET_LIMITS);
-}
-COMMAND(iwlwav, sTaskletLimits, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_tasklet_limits, "");
+IWLWAV_SET(sTaskletLimits, LTQ_NL80211_VENDOR_SUBCMD_SET_TASKLET_LIMITS, 5, 5,
+	"<data_txout_lim> <data_rx_lim> <bss_rx_lim> <bss_cfm_lim> <legacy_lim>",
+	"Set tasklet limits.");
 
-static int handle_intel_vendor_set_scan_cal_exp_time(struct nl80211_state *state,
-						     struct nl_msg *msg,
-						     int argc, char **argv,
-						     enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_SCAN_EXP_TIME);
-}
-COMMAND(iwlwav, sScanExpTime, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_intel_vendor_set_scan_cal_exp_time, "");
+IWLWAV_SET(sScanExpTime, LTQ_NL80211_VENDOR_SUBCMD_SET_SCAN_EXP_TIME, 1, 1,
+	"<exp time>",
+	"Set scan exp time.");
 
-static int handle_iwlwav_set_scan_params(struct nl80211_state *state,
-					 struct nl_msg *msg,
-					 int argc, char **argv,
-					 enum id_input id)
-{
-	return set_int(msg, argc, argv, 6, 6, LTQ_NL80211_VENDOR_SUBCMD_SET_SCAN_PARAMS);
-}
-COMMAND(iwlwav, sScanParams, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_scan_params, "");
+IWLWAV_SET(sScanParams, LTQ_NL80211_VENDOR_SUBCMD_SET_SCAN_PARAMS, 6, 6,
+	"<passiveScanTime> <activeScanTime> <numProbeReqs> <probeReqInterval> <passiveScanValidTime> <activeScanValidTime>",
+	"Set scan parameters.");
 
-static int handle_iwlwav_set_scan_params_bg(struct nl80211_state *state,
-					    struct nl_msg *msg,
-					    int argc, char **argv,
-					    enum id_input id)
-{
-	return set_int(msg, argc, argv, 10, 10, LTQ_NL80211_VENDOR_SUBCMD_SET_SCAN_PARAMS_BG);
-}
-COMMAND(iwlwav, sScanParamsBG, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_scan_params_bg, "");
+IWLWAV_SET(sScanParamsBG, LTQ_NL80211_VENDOR_SUBCMD_SET_SCAN_PARAMS_BG, 10, 10,
+	"<passiveScanTimeBG> <activeScanTimeBG> <numProbeReqsBG> <probeReqIntervalBG> "
+	"<numChansInChunkBG> <chanChunkIntervalBG> <window_slice> <window_slice_overlap> <cts_to_self_duration>",
+	"Set scan parameters background.");
 
-static int handle_iwlwav_set_ta_timer_res(struct nl80211_state *state,
-					  struct nl_msg *msg,
-					  int argc, char **argv,
-					  enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_TA_TIMER_RESOLUTION);
-}
-COMMAND(iwlwav, sTATimerRes, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_ta_timer_res, "");
+IWLWAV_SET(sTATimerRes, LTQ_NL80211_VENDOR_SUBCMD_SET_TA_TIMER_RESOLUTION, 1, 1,
+	"<timer resolution>",
+	"Set TA timer resolution.");
 
-static int handle_iwlwav_set_pcoc_auto_cfg(struct nl80211_state *state,
-					   struct nl_msg *msg,
-					   int argc, char **argv,
-					   enum id_input id)
-{
-	return set_int(msg, argc, argv, 4, 4, LTQ_NL80211_VENDOR_SUBCMD_SET_PCOC_AUTO_PARAMS);
-}
-COMMAND(iwlwav, sPCoCAutoCfg, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_pcoc_auto_cfg, "");
+IWLWAV_SET(sPCoCAutoCfg, LTQ_NL80211_VENDOR_SUBCMD_SET_PCOC_AUTO_PARAMS, 4, 4,
+	"<interval_low2high> <interval_high2low> <limit_lower> <limit_upper active_polling_timeout>",
+	"Set PCOC auto parameters.");
 
-static int handle_iwlwav_set_pcoc_power(struct nl80211_state *state,
-					struct nl_msg *msg,
-					int argc, char **argv,
-					enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_PCOC_POWER_MODE);
-}
-COMMAND(iwlwav, sPCoCPower, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_pcoc_power, "");
+IWLWAV_SET(sPCoCPower, LTQ_NL80211_VENDOR_SUBCMD_SET_PCOC_POWER_MODE, 1, 1,
+	"<enable mode>",
+	"Set PCOC power mode.");
 
-static int handle_iwlwav_set_wds_host_to(struct nl80211_state *state,
-					 struct nl_msg *msg,
-					 int argc, char **argv,
-					 enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_WDS_HOST_TIMEOUT);
-}
-COMMAND(iwlwav, sWDSHostTO, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_wds_host_to, "");
+IWLWAV_SET(sWDSHostTO, LTQ_NL80211_VENDOR_SUBCMD_SET_WDS_HOST_TIMEOUT, 1, 1,
+	"<host timeput>",
+	"Set WDS host timeout.");
 
-static int handle_iwlwav_set_mac_wd_period_ms(struct nl80211_state *state,
-					      struct nl_msg *msg,
-					      int argc, char **argv,
-					      enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_MAC_WATCHDOG_PERIOD_MS);
-}
-COMMAND(iwlwav, sMACWdPeriodMs, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_mac_wd_period_ms, "");
+IWLWAV_SET(sMACWdPeriodMs, LTQ_NL80211_VENDOR_SUBCMD_SET_MAC_WATCHDOG_PERIOD_MS, 1, 1,
+	"<period ms>",
+	"Set mac watchdog period ms.");
 
-static int handle_iwlwav_set_mac_wd_timeout_ms(struct nl80211_state *state,
-					       struct nl_msg *msg,
-					       int argc, char **argv,
-					       enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_MAC_WATCHDOG_TIMEOUT_MS);
-}
-COMMAND(iwlwav, sMACWdTimeoutMs, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_mac_wd_timeout_ms, "");
+IWLWAV_SET(sMACWdTimeoutMs, LTQ_NL80211_VENDOR_SUBCMD_SET_MAC_WATCHDOG_TIMEOUT_MS, 1, 1,
+	"<timeout ms>",
+	"Set mac watchdog timeout ms.");
 
-static int handle_iwlwav_set_non_occupated_period(struct nl80211_state *state,
-						  struct nl_msg *msg,
-						  int argc, char **argv,
-						  enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_NON_OCCUPATED_PRD);
-}
-COMMAND(iwlwav, sNonOccupatePrd, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_non_occupated_period, "");
+IWLWAV_SET(sNonOccupatePrd, LTQ_NL80211_VENDOR_SUBCMD_SET_NON_OCCUPATED_PRD, 1, 1,
+	"<non occupated period>",
+	"Set non occupated period.");
 
-static int handle_iwlwav_set_11h_beacon_count(struct nl80211_state *state,
-					      struct nl_msg *msg,
-					      int argc, char **argv,
-					      enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_11H_BEACON_COUNT);
-}
-COMMAND(iwlwav, s11hBeaconCount, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_11h_beacon_count, "");
+IWLWAV_SET(s11hBeaconCount, LTQ_NL80211_VENDOR_SUBCMD_SET_11H_BEACON_COUNT, 1, 1,
+	"<beacon count>",
+	"Set 11h beacon count.");
 
-static int handle_iwlwav_set_enable_test_bus(struct nl80211_state *state,
-					     struct nl_msg *msg,
-					     int argc, char **argv,
-					     enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_ENABLE_TEST_BUS);
-}
-COMMAND(iwlwav, sEnableTestBus, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_enable_test_bus, "");
+IWLWAV_SET(sEnableTestBus, LTQ_NL80211_VENDOR_SUBCMD_SET_ENABLE_TEST_BUS, 1, 1,
+	"<enable/disable>",
+	"Set enable test bus.");
 
-static int handle_iwlwav_set_do_fw_debug(struct nl80211_state *state,
-					 struct nl_msg *msg,
-					 int argc, char **argv,
-					 enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_FW_DEBUG);
-}
-COMMAND(iwlwav, sDoFwDebug, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_do_fw_debug, "");
+IWLWAV_SET(sDoFwDebug, LTQ_NL80211_VENDOR_SUBCMD_SET_FW_DEBUG, 1, 2,
+	"<value>",
+	"Set FW debug.");
 
-static int handle_iwlwav_set_do_simple_cli(struct nl80211_state *state,
-					   struct nl_msg *msg,
-					   int argc, char **argv,
-					   enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 4, LTQ_NL80211_VENDOR_SUBCMD_SET_DBG_CLI);
-}
-COMMAND(iwlwav, sDoSimpleCLI, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_do_simple_cli, "");
+IWLWAV_SET(sDoSimpleCLI, LTQ_NL80211_VENDOR_SUBCMD_SET_DBG_CLI, 1, 4,
+	"<value>",
+	"Set debug CLI.");
 
-static int handle_iwlwav_set_pmcu_debug(struct nl80211_state *state,
-					struct nl_msg *msg,
-					int argc, char **argv,
-					enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_PCOC_PMCU_DEBUG);
-}
-COMMAND(iwlwav, sPMCUDebug, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_pmcu_debug, "");
+IWLWAV_SET(sPMCUDebug, LTQ_NL80211_VENDOR_SUBCMD_SET_PCOC_PMCU_DEBUG, 1, 1,
+	"<debug>",
+	"Set pmcu debug.");
 
-static int handle_iwlwav_set_fw_log_severity(struct nl80211_state *state,
-					     struct nl_msg *msg,
-					     int argc, char **argv,
-					     enum id_input id)
-{
-	return set_int(msg, argc, argv, 2, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_FW_LOG_SEVERITY);
-}
-COMMAND(iwlwav, sFwLogSeverity, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_fw_log_severity, "");
+IWLWAV_SET(sFwLogSeverity, LTQ_NL80211_VENDOR_SUBCMD_SET_FW_LOG_SEVERITY, 2, 2,
+	"<newLevel> <targetCPU>",
+	"Set fw log severity.");
 
-static int handle_iwlwav_set_fw_debug_cmd(struct nl80211_state *state,
-					  struct nl_msg *msg,
-					  int argc, char **argv,
-					  enum id_input id)
-{
-  return set_int(msg, argc, argv, 3, 1000, LTQ_NL80211_VENDOR_SUBCMD_SET_DBG_CMD_FW);
-}
-COMMAND(iwlwav, sDebugCmdFw, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_fw_debug_cmd, "");
+IWLWAV_SET(sDebugCmdFw, LTQ_NL80211_VENDOR_SUBCMD_SET_DBG_CMD_FW, 3, 1000,
+	"<CMD ID> <param1 size> <param1 value> [param2 size] [param2 value] ...",
+	"Manually compose any message to FW.");
 
-static int handle_iwlwav_set_radar_fifo_dump(struct nl80211_state *state,
-					  struct nl_msg *msg,
-					  int argc, char **argv,
-					  enum id_input id)
-{
-  return set_int(msg, argc, argv, 1, 3, LTQ_NL80211_VENDOR_SUBCMD_SET_RADAR_FIFO_DUMP);
-}
-COMMAND(iwlwav, sEnableRadarFiFoDump, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_radar_fifo_dump, "");
+IWLWAV_SET(sEnableRadarFiFoDump, LTQ_NL80211_VENDOR_SUBCMD_SET_RADAR_FIFO_DUMP, 1, 3,
+	"<enable_dump> [immediate] [dfs_band]",
+	"Set Radar Fifo Dump.");
 
 #endif
 
-static int handle_iwlwav_set_vw_test_mode(struct nl80211_state *state,
-					     struct nl_msg *msg,
-					     int argc, char **argv,
-					     enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_SET_VW_TEST_MODE);
-}
-COMMAND(iwlwav, svWtest, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_vw_test_mode, "");
+IWLWAV_SET(svWtest, LTQ_NL80211_VENDOR_SUBCMD_SET_VW_TEST_MODE, 1, 1,
+	"<enable/disable>",
+	"Set Veriwave test mode.");
 
-static int handle_iwlwav_set_start_cca_msr(struct nl80211_state *state,
-				     struct nl_msg *msg,
-				     int argc, char **argv,
-				     enum id_input id)
-{
-	return set_int(msg, argc, argv, 2, 2, LTQ_NL80211_VENDOR_SUBCMD_SET_START_CCA_MSR_OFF_CHAN);
-}
-COMMAND(iwlwav, sStartCcaMsr, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_set_start_cca_msr, "");
+IWLWAV_SET(sStartCcaMsr, LTQ_NL80211_VENDOR_SUBCMD_SET_START_CCA_MSR_OFF_CHAN, 2, 2,
+	"<channel> <dwellTimeMs>",
+	"Starts a CCA (Clear Channel Assessment) scan for a given interface and the given channel using a specific dwell time.");
 
-static int handle_iwlwav_advertise_btwt_schedule(struct nl80211_state *state,
-					   struct nl_msg *msg,
-					   int argc, char **argv,
-					   enum id_input id)
-{
-	return set_int(msg, argc, argv, 8, 50, LTQ_NL80211_VENDOR_SUBCMD_ADVERTISE_BTWT_SCHEDULE);
-}
-COMMAND(iwlwav, sAdvertiseBcTwtSp, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_advertise_btwt_schedule, "");
+IWLWAV_SET(sAdvertiseBcTwtSp, LTQ_NL80211_VENDOR_SUBCMD_ADVERTISE_BTWT_SCHEDULE, 8, 50,
+	"<numberOfSpsToAdd> <wakeDurationUnit> [<broadcastTwtId> <flowType> <triggerType> <twtWakeDuration> <twtWakeIntervalMantissa> <wakeIntervalExponent>]",
+	"Advertise broadcast TWT schedule(s) upto a maximum of 8 schedules per request. The fields starting from broadcastTwtId and upto wakeIntervalExponent are per schedule.");
 
-static int handle_iwlwav_terminate_btwt_schedule(struct nl80211_state *state,
-					   struct nl_msg *msg,
-					   int argc, char **argv,
-					   enum id_input id)
-{
-	return set_int(msg, argc, argv, 1, 1, LTQ_NL80211_VENDOR_SUBCMD_TERMINATE_BTWT_SCHEDULE);
-}
-COMMAND(iwlwav, sTerminateBcTwtSp, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_terminate_btwt_schedule, "");
+IWLWAV_SET(sTerminateBcTwtSp, LTQ_NL80211_VENDOR_SUBCMD_TERMINATE_BTWT_SCHEDULE, 1, 1,
+	"<broadcastTwtPersistence>",
+	"Terminate all broadcast TWT schedules after a fixed number of TBTTs indicated by the persistence field.");
 
-static int handle_iwlwav_tx_twt_teardown(struct nl80211_state *state,
-					 struct nl_msg *msg,
-					 int argc, char **argv,
-					 enum id_input id)
-{
-	return set_int(msg, argc, argv, 2, 4, LTQ_NL80211_VENDOR_SUBCMD_TX_TWT_TEARDOWN);
-}
-COMMAND(iwlwav, sTxTwtTeardown, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_tx_twt_teardown, "");
+IWLWAV_SET(sTxTwtTeardown, LTQ_NL80211_VENDOR_SUBCMD_TX_TWT_TEARDOWN, 2, 4,
+	"<staId> <allTWT> <agreementType> <twtId>",
+	"Transmit a TWT teardown frame to an associated station with the configured parameters.");
 
 /***************************** GET FUNCTIONS *****************************/
 
@@ -1736,37 +1401,6 @@ static int print_vendor_text(struct nl_msg *msg,
 	return NL_OK;
 }
 
-/******************************************************************************/
-/*! \brief      Prepare Intel vendor netlink command to retrieve data from \a sub_cmd
- *
- *  \param[out] msg                pointer to NL message data to be filled, must not be NULL
- *  \param[in]  sub_cmd            Intel vendor sub command, from 'enum ltq_nl80211_vendor_subcmds'
- *  \param[in]  print_msg          Text to be printed prior to printing data
- *
- *  \return     0 on success, non 0 on error
- */
-static int sub_cmd_print_text_function(struct nl_msg *msg,
-				       uint16_t sub_cmd,
-				       char* print_msg)
-{
-	static struct print_data print_d;
-
-	if (!msg)
-		return -EFAULT;
-
-	strncpy_s(print_d.print_msg, sizeof(print_d.print_msg),
-		print_msg, strnlen_s(print_msg, sizeof(print_d.print_msg)));
-
-	register_handler(print_vendor_text, (void *)&print_d);
-
-	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ);
-	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_SUBCMD, sub_cmd);
-
-	return 0;
-nla_put_failure:
-	return -ENOBUFS;
-}
-
 static int print_prop_phy_cap(struct nl_msg *msg, void *arg)
 {
 	struct nlattr *attr;
@@ -1937,350 +1571,93 @@ static int print_ml_vap_list(struct nl_msg *msg, void *arg)
 	return NL_OK;
 }
 
-static int handle_iwlwav_get_11h_radar_detect(struct nl80211_state *state,
-					      struct nl_msg *msg, int argc,
-					      char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_11H_RADAR_DETECT, "g11hRadarDetect");
-}
-COMMAND(iwlwav, g11hRadarDetect, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_11h_radar_detect, "");
+IWLWAV_GET(g11hRadarDetect, LTQ_NL80211_VENDOR_SUBCMD_GET_11H_RADAR_DETECT, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_11h_ch_check_time(struct nl80211_state *state,
-					       struct nl_msg *msg, int argc,
-					       char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_11H_CH_CHECK_TIME, "g11hChCheckTime");
-}
-COMMAND(iwlwav, g11hChCheckTime, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_11h_ch_check_time, "");
+IWLWAV_GET(g11hChCheckTime, LTQ_NL80211_VENDOR_SUBCMD_GET_11H_CH_CHECK_TIME, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_peer_ap_key_idx(struct nl80211_state *state,
-					     struct nl_msg *msg, int argc,
-					     char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_PEERAP_KEY_IDX, "gPeerAPkeyIdx");
-}
-COMMAND(iwlwav, gPeerAPkeyIdx, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_peer_ap_key_idx, "");
+IWLWAV_GET(gPeerAPkeyIdx, LTQ_NL80211_VENDOR_SUBCMD_GET_PEERAP_KEY_IDX, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_peer_aps(struct nl80211_state *state,
-				      struct nl_msg *msg, int argc,
-				      char **argv, enum id_input id)
-{
-	return sub_cmd_print_text_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_PEERAP_LIST, "gPeerAPs");
-}
-COMMAND(iwlwav, gPeerAPs, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_peer_aps, "");
+IWLWAV_GET(gPeerAPs, LTQ_NL80211_VENDOR_SUBCMD_GET_PEERAP_LIST, IWLWAV_REPLY_TEXT, "");
 
-static int handle_iwlwav_get_bridge_mode(struct nl80211_state *state,
-					 struct nl_msg *msg, int argc,
-					 char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_BRIDGE_MODE, "gBridgeMode");
-}
-COMMAND(iwlwav, gBridgeMode, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_bridge_mode, "");
+IWLWAV_GET(gBridgeMode, LTQ_NL80211_VENDOR_SUBCMD_GET_BRIDGE_MODE, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_reliable_mcast(struct nl80211_state *state,
-					    struct nl_msg *msg, int argc,
-					    char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_RELIABLE_MULTICAST, "gReliableMcast");
-}
-COMMAND(iwlwav, gReliableMcast, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_reliable_mcast, "");
+IWLWAV_GET(gReliableMcast, LTQ_NL80211_VENDOR_SUBCMD_GET_RELIABLE_MULTICAST, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_ap_forwarding(struct nl80211_state *state,
-					   struct nl_msg *msg, int argc,
-					   char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_AP_FORWARDING, "gAPforwarding");
-}
-COMMAND(iwlwav, gAPforwarding, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_ap_forwarding, "");
+IWLWAV_GET(gAPforwarding, LTQ_NL80211_VENDOR_SUBCMD_GET_AP_FORWARDING, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_eeprom(struct nl80211_state *state,
-				    struct nl_msg *msg, int argc,
-				    char **argv, enum id_input id)
-{
-	return sub_cmd_print_text_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_EEPROM, "gEEPROM");
-}
-COMMAND(iwlwav, gEEPROM, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_eeprom, "");
+IWLWAV_GET(gEEPROM, LTQ_NL80211_VENDOR_SUBCMD_GET_EEPROM, IWLWAV_REPLY_TEXT, "");
 
-static int handle_iwlwav_datapath_mode(struct nl80211_state *state,
-				       struct nl_msg *msg, int argc,
-				       char **argv, enum id_input id)
-{
-    return sub_cmd_print_text_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_DCDP_DATAPATH_MODE, "gDataPathMode");
-}
-COMMAND(iwlwav, gDataPathMode, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_datapath_mode, "");
+IWLWAV_GET(gDataPathMode, LTQ_NL80211_VENDOR_SUBCMD_GET_DCDP_DATAPATH_MODE, IWLWAV_REPLY_TEXT,
+	"Get actual datapath mode for a specified device");
 
-static int handle_iwlwav_lt_path_enabled(struct nl80211_state *state,
-					 struct nl_msg *msg, int argc,
-					 char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_DCDP_API_LITEPATH, "gLtPathEnabled");
-}
-COMMAND(iwlwav, gLtPathEnabled, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_lt_path_enabled, "");
+IWLWAV_GET(gLtPathEnabled, LTQ_NL80211_VENDOR_SUBCMD_GET_DCDP_API_LITEPATH, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_ipx_ppa_enabled(struct nl80211_state *state,
-					 struct nl_msg *msg, int argc,
-					 char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_DCDP_API_LITEPATH_COMP, "gIpxPpaEnabled");
-}
-COMMAND(iwlwav, gIpxPpaEnabled, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_ipx_ppa_enabled, "");
+IWLWAV_GET(gIpxPpaEnabled, LTQ_NL80211_VENDOR_SUBCMD_GET_DCDP_API_LITEPATH_COMP, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_coc_power(struct nl80211_state *state,
-				       struct nl_msg *msg, int argc,
-				       char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_COC_POWER_MODE, "gCoCPower");
-}
-COMMAND(iwlwav, gCoCPower, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_coc_power, "");
+IWLWAV_GET(gCoCPower, LTQ_NL80211_VENDOR_SUBCMD_GET_COC_POWER_MODE, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_coc_auto_cfg(struct nl80211_state *state,
-					  struct nl_msg *msg, int argc,
-					  char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_COC_AUTO_PARAMS, "gCoCAutoCfg");
-}
-COMMAND(iwlwav, gCoCAutoCfg, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_coc_auto_cfg, "");
+IWLWAV_GET(gCoCAutoCfg, LTQ_NL80211_VENDOR_SUBCMD_GET_COC_AUTO_PARAMS, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_erp_cfg(struct nl80211_state *state,
-				     struct nl_msg *msg, int argc,
-				     char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_ERP_CFG, "gErpSet");
-}
-COMMAND(iwlwav, gErpSet, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_erp_cfg, "");
+IWLWAV_GET(gErpSet, LTQ_NL80211_VENDOR_SUBCMD_GET_ERP_CFG, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_tcp_loop_type(struct nl80211_state *state,
-					   struct nl_msg *msg, int argc,
-					   char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_PRM_ID_TPC_LOOP_TYPE, "gTpcLoopType");
-}
-COMMAND(iwlwav, gTpcLoopType, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_tcp_loop_type, "");
+IWLWAV_GET(gTpcLoopType, LTQ_NL80211_VENDOR_SUBCMD_GET_PRM_ID_TPC_LOOP_TYPE, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_inter_det_thresh(struct nl80211_state *state,
-					      struct nl_msg *msg, int argc,
-					      char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_INTERFER_MODE, "gInterfDetThresh");
-}
-COMMAND(iwlwav, gInterfDetThresh, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_inter_det_thresh, "");
+IWLWAV_GET(gInterfDetThresh, LTQ_NL80211_VENDOR_SUBCMD_GET_INTERFER_MODE, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_ap_caps_max_stas(struct nl80211_state *state,
-					      struct nl_msg *msg, int argc,
-					      char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_AP_CAPABILITIES_MAX_STAs, "gAPCapsMaxSTAs");
-}
-COMMAND(iwlwav, gAPCapsMaxSTAs, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_ap_caps_max_stas, "");
+IWLWAV_GET(gAPCapsMaxSTAs, LTQ_NL80211_VENDOR_SUBCMD_GET_AP_CAPABILITIES_MAX_STAs, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_ap_caps_max_vaps(struct nl80211_state *state,
-					      struct nl_msg *msg, int argc,
-					      char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_AP_CAPABILITIES_MAX_VAPs, "gAPCapsMaxVAPs");
-}
-COMMAND(iwlwav, gAPCapsMaxVAPs, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_ap_caps_max_vaps, "");
+IWLWAV_GET(gAPCapsMaxVAPs, LTQ_NL80211_VENDOR_SUBCMD_GET_AP_CAPABILITIES_MAX_VAPs, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_11b_ant_selection(struct nl80211_state *state,
-					       struct nl_msg *msg, int argc,
-					       char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_11B_ANTENNA_SELECTION, "g11bAntSelection");
-}
-COMMAND(iwlwav, g11bAntSelection, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_11b_ant_selection, "");
+IWLWAV_GET(g11bAntSelection, LTQ_NL80211_VENDOR_SUBCMD_GET_11B_ANTENNA_SELECTION, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_fw_recovery(struct nl80211_state *state,
-					 struct nl_msg *msg, int argc,
-					 char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_FW_RECOVERY, "gFWRecovery");
-}
-COMMAND(iwlwav, gFWRecovery, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_fw_recovery, "");
+IWLWAV_GET(gFWRecovery, LTQ_NL80211_VENDOR_SUBCMD_GET_FW_RECOVERY, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_fw_recovery_statistics(struct nl80211_state *state,
-						    struct nl_msg *msg, int argc,
-						    char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_RCVRY_STATS, "gFWRecoveryStat");
-}
-COMMAND(iwlwav, gFWRecoveryStat, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_fw_recovery_statistics, "");
+IWLWAV_GET(gFWRecoveryStat, LTQ_NL80211_VENDOR_SUBCMD_GET_RCVRY_STATS, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_out_of_scan_caching(struct nl80211_state *state,
-						 struct nl_msg *msg, int argc,
-						 char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_OUT_OF_SCAN_CACHING, "gOOScanCaching");
-}
-COMMAND(iwlwav, gOOScanCaching, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_out_of_scan_caching, "");
+IWLWAV_GET(gOOScanCaching, LTQ_NL80211_VENDOR_SUBCMD_GET_OUT_OF_SCAN_CACHING, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_allow_scan_during_cac(struct nl80211_state *state,
-						   struct nl_msg *msg, int argc,
-						   char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_ALLOW_SCAN_DURING_CAC, "gAllowScanInCac");
-}
-COMMAND(iwlwav, gAllowScanInCac, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_allow_scan_during_cac, "");
+IWLWAV_GET(gAllowScanInCac, LTQ_NL80211_VENDOR_SUBCMD_GET_ALLOW_SCAN_DURING_CAC, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_enable_radio(struct nl80211_state *state,
-					  struct nl_msg *msg, int argc,
-					  char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_RADIO_MODE, "gEnableRadio");
-}
-COMMAND(iwlwav, gEnableRadio, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_enable_radio, "");
+IWLWAV_GET(gEnableRadio, LTQ_NL80211_VENDOR_SUBCMD_GET_RADIO_MODE, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_aggr_config(struct nl80211_state *state,
-					 struct nl_msg *msg, int argc,
-					 char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_AGGR_CONFIG, "gAggrConfig");
-}
-COMMAND(iwlwav, gAggrConfig, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_aggr_config, "");
+IWLWAV_GET(gAggrConfig, LTQ_NL80211_VENDOR_SUBCMD_GET_AGGR_CONFIG, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_num_msdu_in_amsdu(struct nl80211_state *state,
-					       struct nl_msg *msg, int argc,
-					       char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_AMSDU_NUM, "gNumMsduInAmsdu");
-}
-COMMAND(iwlwav, gNumMsduInAmsdu, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_num_msdu_in_amsdu, "");
+IWLWAV_GET(gNumMsduInAmsdu, LTQ_NL80211_VENDOR_SUBCMD_GET_AMSDU_NUM, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_agg_rate_limit(struct nl80211_state *state,
-					    struct nl_msg *msg, int argc,
-					    char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_AGG_RATE_LIMIT, "gAggRateLimit");
-}
-COMMAND(iwlwav, gAggRateLimit, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_agg_rate_limit, "");
+IWLWAV_GET(gAggRateLimit, LTQ_NL80211_VENDOR_SUBCMD_GET_AGG_RATE_LIMIT, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_mu_ofdma_bf(struct nl80211_state *state,
-			      struct nl_msg *msg, int argc,
-			      char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_MU_OFDMA_BF, "gMuOfdmaBf");
-}
-COMMAND(iwlwav, gMuOfdmaBf, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_mu_ofdma_bf, "");
+IWLWAV_GET(gMuOfdmaBf, LTQ_NL80211_VENDOR_SUBCMD_GET_MU_OFDMA_BF, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_avail_adm_cap(struct nl80211_state *state,
-					   struct nl_msg *msg, int argc,
-					   char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_ADMISSION_CAPACITY, "gAvailAdmCap");
-}
-COMMAND(iwlwav, gAvailAdmCap, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_avail_adm_cap, "");
+IWLWAV_GET(gAvailAdmCap, LTQ_NL80211_VENDOR_SUBCMD_GET_ADMISSION_CAPACITY, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_set_rx_th(struct nl80211_state *state,
-				       struct nl_msg *msg, int argc,
-				       char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_RX_THRESHOLD, "gSetRxTH");
-}
-COMMAND(iwlwav, gSetRxTH, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_set_rx_th, "");
+IWLWAV_GET(gSetRxTH, LTQ_NL80211_VENDOR_SUBCMD_GET_RX_THRESHOLD, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_rx_duty_cyc(struct nl80211_state *state,
-					 struct nl_msg *msg, int argc,
-					 char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_RX_DUTY_CYCLE, "gRxDutyCyc");
-}
-COMMAND(iwlwav, gRxDutyCyc, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_rx_duty_cyc, "");
+IWLWAV_GET(gRxDutyCyc, LTQ_NL80211_VENDOR_SUBCMD_GET_RX_DUTY_CYCLE, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_power_selection(struct nl80211_state *state,
-					     struct nl_msg *msg, int argc,
-					     char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_TX_POWER_LIMIT_OFFSET, "gPowerSelection");
-}
-COMMAND(iwlwav, gPowerSelection, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_power_selection, "");
+IWLWAV_GET(gPowerSelection, LTQ_NL80211_VENDOR_SUBCMD_GET_TX_POWER_LIMIT_OFFSET, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_11n_protection(struct nl80211_state *state,
-					    struct nl_msg *msg, int argc,
-					    char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_PROTECTION_METHOD, "g11nProtection");
-}
-COMMAND(iwlwav, g11nProtection, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_11n_protection, "");
+IWLWAV_GET(g11nProtection, LTQ_NL80211_VENDOR_SUBCMD_GET_PROTECTION_METHOD, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_temperature(struct nl80211_state *state,
-					 struct nl_msg *msg, int argc,
-					 char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_TEMPERATURE_SENSOR, "gTemperature");
-}
-COMMAND(iwlwav, gTemperature, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_temperature, "");
+IWLWAV_GET(gTemperature, LTQ_NL80211_VENDOR_SUBCMD_GET_TEMPERATURE_SENSOR, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_qam_plus(struct nl80211_state *state,
-				      struct nl_msg *msg, int argc,
-				      char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_QAMPLUS_MODE, "gQAMplus");
-}
-COMMAND(iwlwav, gQAMplus, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_qam_plus, "");
+IWLWAV_GET(gQAMplus, LTQ_NL80211_VENDOR_SUBCMD_GET_QAMPLUS_MODE, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_acs_update_to(struct nl80211_state *state,
-					   struct nl_msg *msg, int argc,
-					   char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_ACS_UPDATE_TO, "gAcsUpdateTo");
-}
-COMMAND(iwlwav, gAcsUpdateTo, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_acs_update_to, "");
+IWLWAV_GET(gAcsUpdateTo, LTQ_NL80211_VENDOR_SUBCMD_GET_ACS_UPDATE_TO, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_mu_operation(struct nl80211_state *state,
-					  struct nl_msg *msg, int argc,
-					  char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_MU_OPERATION, "gMuOperation");
-}
-COMMAND(iwlwav, gMuOperation, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_mu_operation, "");
+IWLWAV_GET(gMuOperation, LTQ_NL80211_VENDOR_SUBCMD_GET_MU_OPERATION, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_cac_th(struct nl80211_state *state,
-				    struct nl_msg *msg, int argc,
-				    char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_CCA_THRESHOLD, "gCcaTh");
-}
-COMMAND(iwlwav, gCcaTh, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_cac_th, "");
+IWLWAV_GET(gCcaTh, LTQ_NL80211_VENDOR_SUBCMD_GET_CCA_THRESHOLD, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_cca_adapt(struct nl80211_state *state,
-				       struct nl_msg *msg, int argc,
-				       char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_CCA_ADAPT, "gCcaAdapt");
-}
-COMMAND(iwlwav, gCcaAdapt, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_cca_adapt, "");
+IWLWAV_GET(gCcaAdapt, LTQ_NL80211_VENDOR_SUBCMD_GET_CCA_ADAPT, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_radar_rssi_th(struct nl80211_state *state,
-					   struct nl_msg *msg, int argc,
-					   char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_RADAR_RSSI_TH, "gRadarRssiTh");
-}
-COMMAND(iwlwav, gRadarRssiTh, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_radar_rssi_th, "");
+IWLWAV_GET(gRadarRssiTh, LTQ_NL80211_VENDOR_SUBCMD_GET_RADAR_RSSI_TH, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_vw_test_mode(struct nl80211_state *state,
-					   struct nl_msg *msg, int argc,
-					   char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_VW_TEST_MODE, "gvWtest");
-}
-COMMAND(iwlwav, gvWtest, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_vw_test_mode, "");
+IWLWAV_GET(gvWtest, LTQ_NL80211_VENDOR_SUBCMD_GET_VW_TEST_MODE, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_fils_beacon_flag(struct nl80211_state *state,
-					   struct nl_msg *msg, int argc,
-					   char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_FILS_BEACON_FLAG, "gFilsBeaconFlag");
-}
-COMMAND(iwlwav, gFilsBeaconFlag, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_fils_beacon_flag, "");
+IWLWAV_GET(gFilsBeaconFlag, LTQ_NL80211_VENDOR_SUBCMD_GET_FILS_BEACON_FLAG, IWLWAV_REPLY_INT, "");
 
 
-static int handle_iwlwav_get_rts_mode(struct nl80211_state *state,
-				      struct nl_msg *msg, int argc,
-				      char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_RTS_MODE, "gRTSmode");
-}
-COMMAND(iwlwav, gRTSmode, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_rts_mode, "");
+IWLWAV_GET(gRTSmode, LTQ_NL80211_VENDOR_SUBCMD_GET_RTS_MODE, IWLWAV_REPLY_INT, "");
 
 static int handle_iwlwav_get_max_tx_power(struct nl80211_state *state,
 					  struct nl_msg *msg,
@@ -2311,150 +1688,42 @@ nla_put_failure:
 }
 COMMAND(iwlwav, gMaxTxPower, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_max_tx_power, "");
 
-static int handle_iwlwav_get_max_mpdu_len(struct nl80211_state *state,
-					  struct nl_msg *msg, int argc,
-					  char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_MAX_MPDU_LENGTH, "gMaxMpduLen");
-}
-COMMAND(iwlwav, gMaxMpduLen, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_max_mpdu_len, "");
+IWLWAV_GET(gMaxMpduLen, LTQ_NL80211_VENDOR_SUBCMD_GET_MAX_MPDU_LENGTH, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_bf_mode(struct nl80211_state *state,
-				     struct nl_msg *msg, int argc,
-				     char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_BF_MODE, "gBfMode");
-}
-COMMAND(iwlwav, gBfMode, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_bf_mode, "");
+IWLWAV_GET(gBfMode, LTQ_NL80211_VENDOR_SUBCMD_GET_BF_MODE, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_probe_req_list_mode(struct nl80211_state *state,
-						 struct nl_msg *msg, int argc,
-						 char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_CLT_PROBE_REQS_MODE, "gProbeReqCltMode");
-}
-COMMAND(iwlwav, gProbeReqCltMode, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_probe_req_list_mode, "");
+IWLWAV_GET(gProbeReqCltMode, LTQ_NL80211_VENDOR_SUBCMD_GET_CLT_PROBE_REQS_MODE, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_active_ant_mask(struct nl80211_state *state,
-					     struct nl_msg *msg, int argc,
-					     char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_ACTIVE_ANT_MASK, "gActiveAntMask");
-}
-COMMAND(iwlwav, gActiveAntMask, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_active_ant_mask, "");
+IWLWAV_GET(gActiveAntMask, LTQ_NL80211_VENDOR_SUBCMD_GET_ACTIVE_ANT_MASK, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_four_addr_stats(struct nl80211_state *state,
-					     struct nl_msg *msg, int argc,
-					     char **argv, enum id_input id)
-{
-	return sub_cmd_print_text_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_4ADDR_STA_LIST, "gFourAddrStas");
-}
-COMMAND(iwlwav, gFourAddrStas, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_four_addr_stats, "");
+IWLWAV_GET(gFourAddrStas, LTQ_NL80211_VENDOR_SUBCMD_GET_4ADDR_STA_LIST, IWLWAV_REPLY_TEXT, "");
 
-static int handle_iwlwav_get_txop_config(struct nl80211_state *state,
-					 struct nl_msg *msg, int argc,
-					 char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_TXOP_CONFIG, "gTxopConfig");
-}
-COMMAND(iwlwav, gTxopConfig, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_txop_config, "");
+IWLWAV_GET(gTxopConfig, LTQ_NL80211_VENDOR_SUBCMD_GET_TXOP_CONFIG, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_ssb_mode(struct nl80211_state *state,
-				      struct nl_msg *msg, int argc,
-				      char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_SSB_MODE, "gSsbMode");
-}
-COMMAND(iwlwav, gSsbMode, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_ssb_mode, "");
+IWLWAV_GET(gSsbMode, LTQ_NL80211_VENDOR_SUBCMD_GET_SSB_MODE, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_mcast_range(struct nl80211_state *state,
-					 struct nl_msg *msg, int argc,
-					 char **argv, enum id_input id)
-{
-	return sub_cmd_print_text_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_MCAST_RANGE_SETUP, "gMcastRange");
-}
-COMMAND(iwlwav, gMcastRange, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_mcast_range, "");
+IWLWAV_GET(gMcastRange, LTQ_NL80211_VENDOR_SUBCMD_GET_MCAST_RANGE_SETUP, IWLWAV_REPLY_TEXT, "");
 
-static int handle_iwlwav_get_mcast_range6(struct nl80211_state *state,
-					  struct nl_msg *msg, int argc,
-					  char **argv, enum id_input id)
-{
-	return sub_cmd_print_text_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_MCAST_RANGE_SETUP_IPV6, "gMcastRange6");
-}
-COMMAND(iwlwav, gMcastRange6, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_mcast_range6, "");
+IWLWAV_GET(gMcastRange6, LTQ_NL80211_VENDOR_SUBCMD_GET_MCAST_RANGE_SETUP_IPV6, IWLWAV_REPLY_TEXT, "");
 
-static int handle_iwlwav_get_unknown_mcast_filter_mode(struct nl80211_state *state,
-						       struct nl_msg *msg, int argc,
-						       char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_FORWARD_UNKNOWN_MCAST_FLAG, "gFwrdUnkwnMcast");
-}
-COMMAND(iwlwav, gFwrdUnkwnMcast, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_unknown_mcast_filter_mode, "");
+IWLWAV_GET(gFwrdUnkwnMcast, LTQ_NL80211_VENDOR_SUBCMD_GET_FORWARD_UNKNOWN_MCAST_FLAG, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_online_acm(struct nl80211_state *state,
-					struct nl_msg *msg, int argc,
-					char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_ONLINE_CALIBRATION_ALGO_MASK, "gOnlineACM");
-}
-COMMAND(iwlwav, gOnlineACM, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_online_acm, "");
+IWLWAV_GET(gOnlineACM, LTQ_NL80211_VENDOR_SUBCMD_GET_ONLINE_CALIBRATION_ALGO_MASK, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_algo_calibr_mask(struct nl80211_state *state,
-					      struct nl_msg *msg, int argc,
-					      char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_CALIBRATION_ALGO_MASK, "gAlgoCalibrMask");
-}
-COMMAND(iwlwav, gAlgoCalibrMask, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_algo_calibr_mask, "");
+IWLWAV_GET(gAlgoCalibrMask, LTQ_NL80211_VENDOR_SUBCMD_GET_CALIBRATION_ALGO_MASK, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_restrict_ac_mode(struct nl80211_state *state,
-					      struct nl_msg *msg, int argc,
-					      char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_RESTRICTED_AC_MODE, "gRestrictAcMode");
-}
-COMMAND(iwlwav, gRestrictAcMode, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_restrict_ac_mode, "");
+IWLWAV_GET(gRestrictAcMode, LTQ_NL80211_VENDOR_SUBCMD_GET_RESTRICTED_AC_MODE, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_pd_thresh(struct nl80211_state *state,
-				       struct nl_msg *msg, int argc,
-				       char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_PD_THRESHOLD, "gPdThresh");
-}
-COMMAND(iwlwav, gPdThresh, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_pd_thresh, "");
+IWLWAV_GET(gPdThresh, LTQ_NL80211_VENDOR_SUBCMD_GET_PD_THRESHOLD, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_fast_drop(struct nl80211_state *state,
-				       struct nl_msg *msg, int argc,
-				       char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_FAST_DROP, "gFastDrop");
-}
-COMMAND(iwlwav, gFastDrop, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_fast_drop, "");
+IWLWAV_GET(gFastDrop, LTQ_NL80211_VENDOR_SUBCMD_GET_FAST_DROP, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_pvt_sensor(struct nl80211_state *state,
-					struct nl_msg *msg, int argc,
-					char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_PVT_SENSOR, "gPVT");
-}
-COMMAND(iwlwav, gPVT, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_pvt_sensor, "");
+IWLWAV_GET(gPVT, LTQ_NL80211_VENDOR_SUBCMD_GET_PVT_SENSOR, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_rts_rate(struct nl80211_state *state,
-				      struct nl_msg *msg, int argc,
-				      char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_RTS_RATE, "gRtsRate");
-}
-COMMAND(iwlwav, gRtsRate, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_rts_rate, "");
+IWLWAV_GET(gRtsRate, LTQ_NL80211_VENDOR_SUBCMD_GET_RTS_RATE, IWLWAV_REPLY_INT, "");
 
 #ifdef WAVE_ENABLE_PIE
-static int handle_iwlwav_get_pie_cfg(struct nl80211_state *state,
-				     struct nl_msg *msg, int argc,
-				     char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_PIE_CFG, "gPIEcfg");
-}
-COMMAND(iwlwav, gPIEcfg, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_pie_cfg, "");
+IWLWAV_GET(gPIEcfg, LTQ_NL80211_VENDOR_SUBCMD_GET_PIE_CFG, IWLWAV_REPLY_INT, "");
 
 static int handle_iwlwav_get_aqm_en(struct nl80211_state *state,
 				     struct nl_msg *msg, int argc,
@@ -2478,81 +1747,23 @@ nla_put_failure:
 COMMAND(iwlwav, gAqmEn, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_aqm_en, "");
 #endif /* WAVE_ENABLE_PIE */
 
-static int handle_iwlwav_get_stations_statistics(struct nl80211_state *state,
-						 struct nl_msg *msg, int argc,
-						 char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_STATIONS_STATISTICS, "gStationsStat");
-}
-COMMAND(iwlwav, gStationsStat, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_stations_statistics, "");
+IWLWAV_GET(gStationsStat, LTQ_NL80211_VENDOR_SUBCMD_GET_STATIONS_STATISTICS, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_rts_threshold(struct nl80211_state *state,
-					   struct nl_msg *msg, int argc,
-					   char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_RTS_THRESHOLD, "gRtsThreshold");
-}
-COMMAND(iwlwav, gRtsThreshold, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_rts_threshold, "");
+IWLWAV_GET(gRtsThreshold, LTQ_NL80211_VENDOR_SUBCMD_GET_RTS_THRESHOLD, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_20mhz_tx_power(struct nl80211_state *state,
-					   struct nl_msg *msg, int argc,
-					   char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_20MHZ_TX_POWER, "g20mhzTxPower");
-}
-COMMAND(iwlwav, g20mhzTxPower, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_20mhz_tx_power, "");
+IWLWAV_GET(g20mhzTxPower, LTQ_NL80211_VENDOR_SUBCMD_GET_20MHZ_TX_POWER, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_stats_poll_period(struct nl80211_state *state,
-					       struct nl_msg *msg, int argc,
-					       char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_STATS_POLL_PERIOD, "gStatsPollPeriod");
-}
-COMMAND(iwlwav, gStatsPollPeriod, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_stats_poll_period, "");
+IWLWAV_GET(gStatsPollPeriod, LTQ_NL80211_VENDOR_SUBCMD_GET_STATS_POLL_PERIOD, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_dynamic_mu_type(struct nl80211_state *state,
-					     struct nl_msg *msg,
-					     int argc, char **argv,
-					     enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_DYNAMIC_MU_TYPE, "gDynamicMu");
-}
-COMMAND(iwlwav, gDynamicMu, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_dynamic_mu_type, "");
+IWLWAV_GET(gDynamicMu, LTQ_NL80211_VENDOR_SUBCMD_GET_DYNAMIC_MU_TYPE, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_he_mu_fixed_parameters(struct nl80211_state *state,
-						    struct nl_msg *msg,
-						    int argc, char **argv,
-						    enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_HE_MU_FIXED_PARAMETERS, "gMuFixedCfg");
-}
-COMMAND(iwlwav, gMuFixedCfg, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_he_mu_fixed_parameters, "");
+IWLWAV_GET(gMuFixedCfg, LTQ_NL80211_VENDOR_SUBCMD_GET_HE_MU_FIXED_PARAMETERS, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_he_mu_duration(struct nl80211_state *state,
-					    struct nl_msg *msg,
-					    int argc, char **argv,
-					    enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_HE_MU_DURATION, "gMuDurationCfg");
-}
-COMMAND(iwlwav, gMuDurationCfg, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_he_mu_duration, "");
+IWLWAV_GET(gMuDurationCfg, LTQ_NL80211_VENDOR_SUBCMD_GET_HE_MU_DURATION, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_in_band_power(struct nl80211_state *state,
-					   struct nl_msg *msg, int argc,
-					   char **argv, enum id_input id)
-{
-	return sub_cmd_print_text_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_PHY_INBAND_POWER, "gIBpowerPerAnt");
-}
-COMMAND(iwlwav, gIBpowerPerAnt, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_in_band_power, "");
+IWLWAV_GET(gIBpowerPerAnt, LTQ_NL80211_VENDOR_SUBCMD_GET_PHY_INBAND_POWER, IWLWAV_REPLY_TEXT, "");
 
-static int handle_iwlwav_get_etsi_ppdu_limits(struct nl80211_state *state,
-					      struct nl_msg *msg,
-					      int argc, char **argv,
-					      enum id_input id)
-{
-    return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_ETSI_PPDU_LIMITS, "gETSILimitation");
-}
-COMMAND(iwlwav, gETSILimitation, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_etsi_ppdu_limits, "");
+IWLWAV_GET(gETSILimitation, LTQ_NL80211_VENDOR_SUBCMD_GET_ETSI_PPDU_LIMITS, IWLWAV_REPLY_INT, "");
 
 static int handle_iwlwav_get_probe_req_list(struct nl80211_state *state,
 					    struct nl_msg *msg, int argc,
@@ -2562,13 +1773,7 @@ static int handle_iwlwav_get_probe_req_list(struct nl80211_state *state,
 }
 COMMAND(iwlwav, gProbeReqList, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_probe_req_list, "");
 
-static int handle_iwlwav_get_cca_preamble_puncture_cfg(struct nl80211_state *state,
-					struct nl_msg *msg, int argc,
-					char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_CCA_PREAMBLE_PUNCTURE_CFG, "gPreamPunCcaOvr");
-}
-COMMAND(iwlwav, gPreamPunCcaOvr, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_cca_preamble_puncture_cfg, "");
+IWLWAV_GET(gPreamPunCcaOvr, LTQ_NL80211_VENDOR_SUBCMD_GET_CCA_PREAMBLE_PUNCTURE_CFG, IWLWAV_REPLY_INT, "");
 
 /******************************************************************************/
 /*! \brief      Prepare Intel vendor netlink command to retrieve data from LTQ_NL80211_VENDOR_SUBCMD_GET_TWT_PARAMETERS
@@ -2614,47 +1819,15 @@ nla_put_failure:
 }
 COMMAND(iwlwav, gTwtParams, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_twt_parameters, "");
 
-static int handle_iwlwav_get_ax_default_params(struct nl80211_state *state,
-					       struct nl_msg *msg, int argc,
-					       char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_AX_DEFAULT_PARAMS, "gAxDefaultParams");
-}
-COMMAND(iwlwav, gAxDefaultParams, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_ax_default_params, "");
+IWLWAV_GET(gAxDefaultParams, LTQ_NL80211_VENDOR_SUBCMD_GET_AX_DEFAULT_PARAMS, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_tx_retry_limit(struct nl80211_state *state,
-					    struct nl_msg *msg, int argc,
-					    char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_AP_RETRY_LIMIT, "gTxRetryLimit");
-}
-COMMAND(iwlwav, gTxRetryLimit, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_tx_retry_limit, "");
+IWLWAV_GET(gTxRetryLimit, LTQ_NL80211_VENDOR_SUBCMD_GET_AP_RETRY_LIMIT, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_tx_exce_retry_limit(struct nl80211_state *state,
-					    struct nl_msg *msg, int argc,
-					    char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_AP_EXCE_RETRY_LIMIT, "gTxExceRetryLimit");
-}
-COMMAND(iwlwav, gTxExceRetryLimit, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_tx_exce_retry_limit, "");
+IWLWAV_GET(gTxExceRetryLimit, LTQ_NL80211_VENDOR_SUBCMD_GET_AP_EXCE_RETRY_LIMIT, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_cts_to_self_to(struct nl80211_state *state,
-					    struct nl_msg *msg,
-					    int argc, char **argv,
-					    enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_CTS_TO_SELF_TO, "gCtsToSelfTo");
-}
-COMMAND(iwlwav, gCtsToSelfTo, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_cts_to_self_to, "");
+IWLWAV_GET(gCtsToSelfTo, LTQ_NL80211_VENDOR_SUBCMD_GET_CTS_TO_SELF_TO, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_tx_ampdu_density(struct nl80211_state *state,
-					      struct nl_msg *msg,
-					      int argc, char **argv,
-					      enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_TX_AMPDU_DENSITY, "gTxAmpduDensity");
-}
-COMMAND(iwlwav, gTxAmpduDensity, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_tx_ampdu_density, "");
+IWLWAV_GET(gTxAmpduDensity, LTQ_NL80211_VENDOR_SUBCMD_GET_TX_AMPDU_DENSITY, IWLWAV_REPLY_INT, "");
 
 static int handle_iwlwav_get_cca_msr(struct nl80211_state *state,
 				     struct nl_msg *msg, int argc,
@@ -2684,13 +1857,7 @@ nla_put_failure:
 }
 COMMAND(iwlwav, gGetCcaMsr, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_cca_msr, "");
 
-static int handle_iwlwav_get_cca_stats(struct nl80211_state *state,
-				     struct nl_msg *msg, int argc,
-				     char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_CCA_STATS_CURRENT_CHAN, "gGetCcaStats");
-}
-COMMAND(iwlwav, gGetCcaStats, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_cca_stats, "");
+IWLWAV_GET(gGetCcaStats, LTQ_NL80211_VENDOR_SUBCMD_GET_CCA_STATS_CURRENT_CHAN, IWLWAV_REPLY_INT, "");
 
 static int handle_iwlwav_get_radio_usage_stats(struct nl80211_state *state,
 				     struct nl_msg *msg, int argc,
@@ -2702,69 +1869,21 @@ static int handle_iwlwav_get_radio_usage_stats(struct nl80211_state *state,
 }
 COMMAND(iwlwav, gRadioUsageStats, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_radio_usage_stats, "");
 
-static int handle_iwlwav_get_slow_probing_mask(struct nl80211_state *state,
-					       struct nl_msg *msg, int argc,
-					       char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_PROBING_MASK, "gSlowProbingMask");
-}
-COMMAND(iwlwav, gSlowProbingMask, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_slow_probing_mask, "");
+IWLWAV_GET(gSlowProbingMask, LTQ_NL80211_VENDOR_SUBCMD_GET_PROBING_MASK, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_scan_modif_flags(struct nl80211_state *state,
-					      struct nl_msg *msg, int argc,
-					      char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_SCAN_MODIFS, "gScanModifFlags");
-}
-COMMAND(iwlwav, gScanModifFlags, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_scan_modif_flags, "");
+IWLWAV_GET(gScanModifFlags, LTQ_NL80211_VENDOR_SUBCMD_GET_SCAN_MODIFS, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_scan_pause_bg_cache(struct nl80211_state *state,
-					    struct nl_msg *msg, int argc,
-					    char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_SCAN_PAUSE_BG_CACHE, "gScanPauseBGCache");
-}
-COMMAND(iwlwav, gScanPauseBGCache, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_scan_pause_bg_cache, "");
+IWLWAV_GET(gScanPauseBGCache, LTQ_NL80211_VENDOR_SUBCMD_GET_SCAN_PAUSE_BG_CACHE, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_zwdfs_antenna(struct nl80211_state *state,
-					    struct nl_msg *msg, int argc,
-					    char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_ZWDFS_ANT, "gZwdfsAnt");
-}
-COMMAND(iwlwav, gZwdfsAnt, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_zwdfs_antenna, "");
+IWLWAV_GET(gZwdfsAnt, LTQ_NL80211_VENDOR_SUBCMD_GET_ZWDFS_ANT, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_advertised_btwt_schedule(struct nl80211_state *state,
-						      struct nl_msg *msg, int argc,
-						      char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_ADVERTISED_BTWT_SCHEDULE, "gAdvertisedBcTwtSp");
-}
-COMMAND(iwlwav, gAdvertisedBcTwtSp, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_advertised_btwt_schedule, "");
+IWLWAV_GET(gAdvertisedBcTwtSp, LTQ_NL80211_VENDOR_SUBCMD_GET_ADVERTISED_BTWT_SCHEDULE, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_config_mrcoex(struct nl80211_state *state,
-					   struct nl_msg *msg, int argc,
-					   char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_COEX_CFG, "gConfigMRCoex");
-}
-COMMAND(iwlwav, gConfigMRCoex, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_config_mrcoex, "");
+IWLWAV_GET(gConfigMRCoex, LTQ_NL80211_VENDOR_SUBCMD_GET_COEX_CFG, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_fixed_ltf_gi(struct nl80211_state *state,
-					  struct nl_msg *msg, int argc,
-					  char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_FIXED_LTF_AND_GI, "gFixedLtfGi");
-}
-COMMAND(iwlwav, gFixedLtfGi, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_fixed_ltf_gi, "");
+IWLWAV_GET(gFixedLtfGi, LTQ_NL80211_VENDOR_SUBCMD_GET_FIXED_LTF_AND_GI, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_mgmt_frame_pwr_ctrl(struct nl80211_state *state,
-					    struct nl_msg *msg, int argc,
-					    char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_MGMT_FRAME_PWR_CTRL, "gMgmtFramePwrCtrl");
-}
-COMMAND(iwlwav, gMgmtFramePwrCtrl, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_mgmt_frame_pwr_ctrl, "");
+IWLWAV_GET(gMgmtFramePwrCtrl, LTQ_NL80211_VENDOR_SUBCMD_GET_MGMT_FRAME_PWR_CTRL, IWLWAV_REPLY_INT, "");
 
 static int handle_iwlwav_get_csi_enable(struct nl80211_state *state,
 					    struct nl_msg *msg, int argc,
@@ -2891,21 +2010,9 @@ nla_put_failure:
 }
 COMMAND(iwlwav, gCsi, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_csi_auto_rate, "");
 
-static int handle_iwlwav_get_allow_3addr_mcast(struct nl80211_state *state,
-					  struct nl_msg *msg, int argc,
-					  char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_ALLOW_3ADDR_MCAST, "gAllow3AddrMcast");
-}
-COMMAND(iwlwav, gAllow3AddrMcast, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_allow_3addr_mcast, "");
+IWLWAV_GET(gAllow3AddrMcast, LTQ_NL80211_VENDOR_SUBCMD_GET_ALLOW_3ADDR_MCAST, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_logger_fifo_mux_cfg(struct nl80211_state *state,
-					     struct nl_msg *msg, int argc,
-					     char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, MXL_NL80211_VENDOR_SUBCMD_GET_LOGGER_FIFO_MUX_CFG, "gLoggerFifoMuxCfg");
-}
-COMMAND(iwlwav, gLoggerFifoMuxCfg, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_logger_fifo_mux_cfg, "");
+IWLWAV_GET(gLoggerFifoMuxCfg, MXL_NL80211_VENDOR_SUBCMD_GET_LOGGER_FIFO_MUX_CFG, IWLWAV_REPLY_INT, "");
 static int handle_get_prop_phy_cap(struct nl80211_state *state, struct nl_msg *msg, int argc, char **argv, enum id_input id)
 {
 	if (!msg)
@@ -2951,664 +2058,3230 @@ nla_put_failure:
 }
 COMMAND(iwlwav, gMuStaRangeForGroupPerType, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_mu_groups_config, "");
 
-static int handle_iwlwav_get_pcie_auto_cfg(struct nl80211_state *state,
-                                            struct nl_msg *msg, int argc,
-                                            char **argv, enum id_input id)
-{
-        return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_PCIE_AUTO_GEN_ENABLE, "gPcieAutoGenEnable");
-}
-COMMAND(iwlwav, gPcieAutoGenEnable, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_pcie_auto_cfg, "");
+IWLWAV_GET(gPcieAutoGenEnable, LTQ_NL80211_VENDOR_SUBCMD_GET_PCIE_AUTO_GEN_ENABLE, IWLWAV_REPLY_INT, "");
 
 /***************************** DEBUG GET COMMANDS ****************************/
 #ifdef CONFIG_WAVE_DEBUG
 
-static int handle_iwlwav_get_fixed_rate_thermal(struct nl80211_state *state,
-					 struct nl_msg *msg, int argc,
-					 char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_FIXED_RATE_THERMAL, "gFixedRateThermal");
-}
-COMMAND(iwlwav, gFixedRateThermal, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_fixed_rate_thermal, "");
+IWLWAV_GET(gFixedRateThermal, LTQ_NL80211_VENDOR_SUBCMD_GET_FIXED_RATE_THERMAL, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_counters_src(struct nl80211_state *state,
-					  struct nl_msg *msg, int argc,
-					  char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_COUNTERS_SRC, "gCountersSrc");
-}
-COMMAND(iwlwav, gCountersSrc, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_counters_src, "");
+IWLWAV_GET(gCountersSrc, LTQ_NL80211_VENDOR_SUBCMD_GET_COUNTERS_SRC, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_unconn_time(struct nl80211_state *state,
-					 struct nl_msg *msg, int argc,
-					 char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_UNCONNECTED_STA_SCAN_TIME, "gUnconnTime");
-}
-COMMAND(iwlwav, gUnconnTime, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_unconn_time, "");
+IWLWAV_GET(gUnconnTime, LTQ_NL80211_VENDOR_SUBCMD_GET_UNCONNECTED_STA_SCAN_TIME, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_fixed_power(struct nl80211_state *state,
-					 struct nl_msg *msg, int argc,
-					 char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_FIXED_POWER, "gFixedPower");
-}
-COMMAND(iwlwav, gFixedPower, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_fixed_power, "");
+IWLWAV_GET(gFixedPower, LTQ_NL80211_VENDOR_SUBCMD_GET_FIXED_POWER, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_cpu_dma_latency(struct nl80211_state *state,
-					     struct nl_msg *msg, int argc,
-					     char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_CPU_DMA_LATENCY, "gCpuDmaLatency");
-}
-COMMAND(iwlwav, gCpuDmaLatency, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_cpu_dma_latency, "");
+IWLWAV_GET(gCpuDmaLatency, LTQ_NL80211_VENDOR_SUBCMD_GET_CPU_DMA_LATENCY, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_bf_explicit_cap(struct nl80211_state *state,
-					     struct nl_msg *msg, int argc,
-					     char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_BEAMFORM_EXPLICIT, "gBfExplicitCap");
-}
-COMMAND(iwlwav, gBfExplicitCap, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_bf_explicit_cap, "");
+IWLWAV_GET(gBfExplicitCap, LTQ_NL80211_VENDOR_SUBCMD_GET_BEAMFORM_EXPLICIT, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_tasklet_limits(struct nl80211_state *state,
-					    struct nl_msg *msg, int argc,
-					    char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_TASKLET_LIMITS, "gTaskletLimits");
-}
-COMMAND(iwlwav, gTaskletLimits, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_tasklet_limits, "");
+IWLWAV_GET(gTaskletLimits, LTQ_NL80211_VENDOR_SUBCMD_GET_TASKLET_LIMITS, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_genl_family_id(struct nl80211_state *state,
-					    struct nl_msg *msg, int argc,
-					    char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_GENL_FAMILY_ID, "gGenlFamilyId");
-}
-COMMAND(iwlwav, gGenlFamilyId, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_genl_family_id, "");
+IWLWAV_GET(gGenlFamilyId, LTQ_NL80211_VENDOR_SUBCMD_GET_GENL_FAMILY_ID, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_scan_exp_time(struct nl80211_state *state,
-					   struct nl_msg *msg, int argc,
-					   char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_SCAN_EXP_TIME, "gScanExpTime");
-}
-COMMAND(iwlwav, gScanExpTime, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_scan_exp_time, "");
+IWLWAV_GET(gScanExpTime, LTQ_NL80211_VENDOR_SUBCMD_GET_SCAN_EXP_TIME, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_scan_params(struct nl80211_state *state,
-					 struct nl_msg *msg, int argc,
-					 char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_SCAN_PARAMS, "gScanParams");
-}
-COMMAND(iwlwav, gScanParams, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_scan_params, "");
+IWLWAV_GET(gScanParams, LTQ_NL80211_VENDOR_SUBCMD_GET_SCAN_PARAMS, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_scan_params_bg(struct nl80211_state *state,
-					    struct nl_msg *msg, int argc,
-					    char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_SCAN_PARAMS_BG, "gScanParamsBG");
-}
-COMMAND(iwlwav, gScanParamsBG, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_scan_params_bg, "");
+IWLWAV_GET(gScanParamsBG, LTQ_NL80211_VENDOR_SUBCMD_GET_SCAN_PARAMS_BG, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_ta_dbg(struct nl80211_state *state,
-				    struct nl_msg *msg, int argc,
-				    char **argv, enum id_input id)
-{
-	return sub_cmd_print_text_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_TA_DBG, "gTADbg");
-}
-COMMAND(iwlwav, gTADbg, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_ta_dbg, "");
+IWLWAV_GET(gTADbg, LTQ_NL80211_VENDOR_SUBCMD_GET_TA_DBG, IWLWAV_REPLY_TEXT, "");
 
-static int handle_iwlwav_get_ta_timer_res(struct nl80211_state *state,
-					  struct nl_msg *msg, int argc,
-					  char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_TA_TIMER_RESOLUTION, "gTATimerRes");
-}
-COMMAND(iwlwav, gTATimerRes, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_ta_timer_res, "");
+IWLWAV_GET(gTATimerRes, LTQ_NL80211_VENDOR_SUBCMD_GET_TA_TIMER_RESOLUTION, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_pcoc_auto_cfg(struct nl80211_state *state,
-					   struct nl_msg *msg, int argc,
-					   char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_PCOC_AUTO_PARAMS, "gPCoCAutoCfg");
-}
-COMMAND(iwlwav, gPCoCAutoCfg, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_pcoc_auto_cfg, "");
+IWLWAV_GET(gPCoCAutoCfg, LTQ_NL80211_VENDOR_SUBCMD_GET_PCOC_AUTO_PARAMS, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_pcoc_power(struct nl80211_state *state,
-					struct nl_msg *msg, int argc,
-					char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_PCOC_POWER_MODE, "gPCoCPower");
-}
-COMMAND(iwlwav, gPCoCPower, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_pcoc_power, "");
+IWLWAV_GET(gPCoCPower, LTQ_NL80211_VENDOR_SUBCMD_GET_PCOC_POWER_MODE, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_wds_host_to(struct nl80211_state *state,
-					 struct nl_msg *msg, int argc,
-					 char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_WDS_HOST_TIMEOUT, "gWDSHostTO");
-}
-COMMAND(iwlwav, gWDSHostTO, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_wds_host_to, "");
+IWLWAV_GET(gWDSHostTO, LTQ_NL80211_VENDOR_SUBCMD_GET_WDS_HOST_TIMEOUT, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_mac_wd_period_ms(struct nl80211_state *state,
-					      struct nl_msg *msg, int argc,
-					      char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_MAC_WATCHDOG_PERIOD_MS, "gMACWdPeriodMs");
-}
-COMMAND(iwlwav, gMACWdPeriodMs, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_mac_wd_period_ms, "");
+IWLWAV_GET(gMACWdPeriodMs, LTQ_NL80211_VENDOR_SUBCMD_GET_MAC_WATCHDOG_PERIOD_MS, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_mac_wd_timeout_ms(struct nl80211_state *state,
-					       struct nl_msg *msg, int argc,
-					       char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_MAC_WATCHDOG_TIMEOUT_MS, "gMACWdTimeoutMs");
-}
-COMMAND(iwlwav, gMACWdTimeoutMs, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_mac_wd_timeout_ms, "");
+IWLWAV_GET(gMACWdTimeoutMs, LTQ_NL80211_VENDOR_SUBCMD_GET_MAC_WATCHDOG_TIMEOUT_MS, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_non_occupate_prd(struct nl80211_state *state,
-					      struct nl_msg *msg, int argc,
-					      char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_NON_OCCUPATED_PRD, "gNonOccupatePrd");
-}
-COMMAND(iwlwav, gNonOccupatePrd, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_non_occupate_prd, "");
+IWLWAV_GET(gNonOccupatePrd, LTQ_NL80211_VENDOR_SUBCMD_GET_NON_OCCUPATED_PRD, IWLWAV_REPLY_INT, "");
 
-static int handle_iwlwav_get_11h_beacon_count(struct nl80211_state *state,
-					      struct nl_msg *msg, int argc,
-					      char **argv, enum id_input id)
-{
-	return sub_cmd_print_int_function(msg, LTQ_NL80211_VENDOR_SUBCMD_GET_11H_BEACON_COUNT, "g11hBeaconCount");
-}
-COMMAND(iwlwav, g11hBeaconCount, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_iwlwav_get_11h_beacon_count, "");
+IWLWAV_GET(g11hBeaconCount, LTQ_NL80211_VENDOR_SUBCMD_GET_11H_BEACON_COUNT, IWLWAV_REPLY_INT, "");
 
 #endif
 
-/***************************** HELP FUNCTION *****************************/
+/***************************** SNAPSHOTS *****************************/
+/*
+ * 'iwlwav snapshot' reads every integer getter of the command table that
+ * has a matching setter (gXxx -> sXxx) and prints "<getter> <values>"
+ * lines, sorted by name, so a file of them can be kept and compared.
+ * Read-only getters (counters, temperature, ...) are left out, they
+ * would always differ and can't be applied; lines for them in an older
+ * file are ignored. The text getters (peer AP and 4-address station
+ * lists, EEPROM, multicast ranges, ...) are left out too, their replies
+ * are dumps rather than values a setter takes back. 'iwlwav diff' reads
+ * the getters named in such a file and shows what changed, 'iwlwav
+ * apply' also sends the setters for the values that differ. All the
+ * requests of a step are sent back to back on the nl80211 socket, see
+ * nl80211_batch().
+ */
+#define IWLWAV_SNAP_MAX_LINE	4096
+
+struct iwlwav_snap_entry {
+	const struct iwlwav_cmd *get;
+	/* from the file */
+	char *line;
+	char *argv[IWLWAV_MAX_ARGS];
+	int argc;
+	/* read from the driver */
+	int32_t *live;
+	int n_live;
+	int err;
+	/* the setter, for 'apply' */
+	const struct iwlwav_cmd *set;
+	int order;
+};
 
-static int handle_iwlwav_help(struct nl80211_state *state,
-			      struct nl_msg *msg, int argc,
-			      char **argv, enum id_input id)
+/*
+ * Setters that depend on others being set first; anything not listed
+ * goes before them, in file order.
+ */
+static const char * const iwlwav_apply_late[] = {
+	"sCoCPower",		/* after sCoCAutoCfg */
+	"sPCoCPower",		/* after sPCoCAutoCfg */
+	"sEnableRadio",		/* after all radio parameters */
+};
+
+static int iwlwav_snap_handler(struct nl_msg *msg, void *arg)
 {
-	printf("\tdev <devname> iwlwav s11hRadarDetect <radar detection>\n");
-	printf("\t\tSet 11h radar detection.\n\n");
+	struct iwlwav_snap_entry *e = arg;
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr *attr;
 
-	printf("\tdev <devname> iwlwav s11hChCheckTime <channel check time>\n");
-	printf("\t\tSet 11h channel availability check time.\n\n");
+	attr = nla_find(genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0),
+			NL80211_ATTR_VENDOR_DATA);
+	if (!attr)
+		return NL_SKIP;
 
-	printf("\tdev <devname> iwlwav s11hEmulatRadar <unused_param> [<radar bit map>] [<dfs band>]");
-	printf("\t\tSet emulate radar detection.\n\n");
-	printf("\t\t<radar bit map> should be between 0x1 to 0xFF\n\n");
-	printf("\t\t<dfs band> = ZWDFS ZWDFS_Band\n\n");
+	free(e->live);
+	e->n_live = nla_len(attr) / sizeof(int32_t);
+	e->live = malloc(e->n_live * sizeof(int32_t) + 1);
+	if (!e->live) {
+		e->n_live = 0;
+		return NL_SKIP;
+	}
+	memcpy(e->live, nla_data(attr), e->n_live * sizeof(int32_t));
+	return NL_SKIP;
+}
 
+/* send the getter (or setter) of each entry, back to back */
+static int iwlwav_snap_send(struct nl80211_state *state, int ifindex,
+			    struct iwlwav_snap_entry **es, int n, bool set)
+{
+	struct nl80211_batch_req *reqs;
+	int i, err = 0;
 
-	printf("\tdev <devname> iwlwav emulateInterferer\n");
-	printf("\t\tSet emulate Interferer detection.\n\n");
+	reqs = calloc(n, sizeof(*reqs));
+	if (!reqs)
+		return -ENOMEM;
 
-	printf("\tdev <devname> iwlwav sAddPeerAP <peer ap>\n");
-	printf("\t\tSet add peer ap.\n\n");
+	for (i = 0; i < n; i++) {
+		const struct iwlwav_cmd *cmd = set ? es[i]->set : es[i]->get;
 
-	printf("\tdev <devname> iwlwav sDelPeerAP <peer ap>\n");
-	printf("\t\tSet delete peer ap.\n\n");
+		reqs[i].msg = nl80211_batch_msg(state, NL80211_CMD_VENDOR, 0,
+						ifindex);
+		if (!reqs[i].msg) {
+			err = -ENOMEM;
+			break;
+		}
+		if (set) {
+			/* the arguments were validated before */
+			if (iwlwav_cmd_put(cmd, reqs[i].msg, es[i]->argc,
+					   es[i]->argv)) {
+				err = -ENOBUFS;
+				break;
+			}
+		} else {
+			if (iwlwav_cmd_put(cmd, reqs[i].msg, 0, NULL)) {
+				err = -ENOBUFS;
+				break;
+			}
+			reqs[i].handler = iwlwav_snap_handler;
+			reqs[i].arg = es[i];
+		}
+	}
 
-	printf("\tdev <devname> iwlwav sPeerAPkeyIdx <peer ap key index>\n");
-	printf("\t\tSet peer ap key index.\n\n");
+	if (!err)
+		err = nl80211_batch(state, reqs, n, 0);
+
+	for (i = 0; i < n; i++) {
+		nlmsg_free(reqs[i].msg);
+		es[i]->err = err ? err : reqs[i].err;
+		if (set && es[i]->err) {
+			fprintf(stderr, "%s: failed: %s", es[i]->set->name,
+				strerror(-es[i]->err));
+			if (reqs[i].ext_msg[0])
+				fprintf(stderr, " (%s)", reqs[i].ext_msg);
+			fprintf(stderr, "\n");
+		} else if (set) {
+			printf("%s: ok\n", es[i]->set->name);
+		}
+	}
 
-	printf("\tdev <devname> iwlwav sBridgeModen <bridge mode>\n");
-	printf("\t\tSet bridge mode.\n\n");
+	free(reqs);
+	return err;
+}
 
-	printf("\tdev <devname> iwlwav sReliableMcast <reliable multicast>\n");
-	printf("\t\tSet reliable multicast.\n\n");
+/* the setter that takes back what @get reads, if any */
+static const struct iwlwav_cmd *iwlwav_snap_setter(const struct iwlwav_cmd *get)
+{
+	const struct iwlwav_cmd *set;
+	char name[32];
 
-	printf("\tdev <devname> iwlwav sAPforwarding <AP forwarding>\n");
-	printf("\t\tSet AP forwarding.\n\n");
+	if (get->reply != IWLWAV_REPLY_INT || get->name[0] != 'g')
+		return NULL;
+	snprintf(name, sizeof(name), "s%s", get->name + 1);
+	set = iwlwav_cmd_find(name);
+	if (!set || set->reply != IWLWAV_REPLY_NONE)
+		return NULL;
+	return set;
+}
 
-	printf("\tdev <devname> iwlwav sLtPathEnabled <enabled>\n");
-	printf("\t\tSet lite path enabled.\n\n");
+static int iwlwav_snap_name_cmp(const void *_a, const void *_b)
+{
+	const struct iwlwav_snap_entry *a = _a, *b = _b;
 
-	printf("\tdev <devname> iwlwav sIpxPpaEnabled <enabled>\n");
-	printf("\t\tSet ipx ppa enabled.\n\n");
+	return strcmp(a->get->name, b->get->name);
+}
 
-	printf("\tdev <devname> iwlwav sCoCPower <enable mode> <tx num> <rx num>\n");
-	printf("\t\tSet COC power mode.\n\n");
+static void iwlwav_snap_free(struct iwlwav_snap_entry *es, int n)
+{
+	int i;
 
-	printf("\tdev <devname> iwlwav sCoCAutoCfg <interval_1x1> <interval_2x2> <interval_3x3> < interval_4x4> <high_limit_1x1> <low_limit_2x2> <high_limit_2x2> <low_limit_3x3> <high_limit_3x3> <low_limit_4x4>\n");
-	printf("\t\tSet COC auto parameters.\n\n");
+	for (i = 0; i < n; i++) {
+		free(es[i].line);
+		free(es[i].live);
+	}
+	free(es);
+}
 
-	printf("\tdev <devname> iwlwav sTpcLoopType <loop type>\n");
-	printf("\t\tSet TPC loop type.\n\n");
+static int iwlwav_snap_read(const char *name, struct iwlwav_snap_entry **_es,
+			    int *_n, int *_skipped)
+{
+	struct iwlwav_snap_entry *es = NULL, *e;
+	char line[IWLWAV_SNAP_MAX_LINE], *tok, *save;
+	int n = 0, size = 0, lineno = 0, skipped = 0, err = 0;
+	FILE *f;
 
-	printf("\tdev <devname> iwlwav sInterfDetThresh <notification_threshold> \n");
-	printf("\t\tSet interferer detection threshold\n\n");
+	f = fopen(name, "r");
+	if (!f) {
+		fprintf(stderr, "%s: %s\n", name, strerror(errno));
+		return 2;
+	}
 
-	printf("\tdev <devname> iwlwav s11bAntSelection <txAnt> <rxAnt> <Rate>\n");
-	printf("\t\tSet 11b antenna selection.\n\n");
+	while (fgets(line, sizeof(line), f)) {
+		lineno++;
+		tok = strtok_r(line, " \t\r\n", &save);
+		if (!tok || tok[0] == '#')
+			continue;
+
+		if (n == size) {
+			size = size ? size * 2 : 64;
+			e = realloc(es, size * sizeof(*es));
+			if (!e) {
+				err = -ENOMEM;
+				break;
+			}
+			es = e;
+		}
 
-	printf("\tdev <devname> iwlwav sFWRecovery <recovery mode> <number of Fast recovery> <number of full recovery> <dump evacuation on fault> <time period for consecutive recovery>\n");
-	printf("\t\tSet FW recovery.\n\n");
+		e = &es[n];
+		memset(e, 0, sizeof(*e));
+		e->get = iwlwav_cmd_find(tok);
+		if (!e->get || e->get->reply != IWLWAV_REPLY_INT) {
+			fprintf(stderr, "%s:%d: unknown getter '%s'\n",
+				name, lineno, tok);
+			err = 2;
+			break;
+		}
+		/* read-only, e.g. from a snapshot of an older iw */
+		e->set = iwlwav_snap_setter(e->get);
+		if (!e->set) {
+			fprintf(stderr, "%s:%d: %s: skipped, no setter\n",
+				name, lineno, tok);
+			skipped++;
+			continue;
+		}
 
-	printf("\tdev <devname> iwlwav sEnableRadio <enable radio>\n");
-	printf("\t\tSet radio mode.\n\n");
+		/* keep the values as text, the setter validates them */
+		e->line = strdup(save);
+		if (!e->line) {
+			err = -ENOMEM;
+			break;
+		}
+		n++;
+		for (tok = strtok_r(e->line, " \t\r\n", &save);
+		     tok && e->argc < IWLWAV_MAX_ARGS;
+		     tok = strtok_r(NULL, " \t\r\n", &save))
+			e->argv[e->argc++] = tok;
+	}
 
-	printf("\tdev <devname> iwlwav sAggrConfig <amsdu_mode> <ba_mode> [<window_size>]\n");
-	printf("\t\tSet aggr config.\n\n");
+	fclose(f);
+	if (err) {
+		iwlwav_snap_free(es, n);
+		return err;
+	}
+	*_es = es;
+	*_n = n;
+	if (_skipped)
+		*_skipped = skipped;
+	return 0;
+}
 
-	printf("\tdev <devname> iwlwav sNumMsduInAmsdu <amsdu_num> <amsdu_vnum>\n");
-	printf("\t\tSet amsdu number.\n\n");
+/* does the value in the file match what the driver returned? */
+static bool iwlwav_snap_equal(struct iwlwav_snap_entry *e)
+{
+	char *end;
+	int i;
 
-	printf("\tdev <devname> iwlwav sAggRateLimit <mode> <maxRate>\n");
-	printf("\t\tSet aggr rate limit.\n\n");
+	if (e->argc != e->n_live)
+		return false;
+	for (i = 0; i < e->argc; i++) {
+		long long val = strtoll(e->argv[i], &end, 0);
 
-	printf("\tdev <devname> iwlwav sMuOfdmaBf <mode> <bfPeriod>\n");
-	printf("\t\tSet mu ofdma beamforming.\n\n");
+		if (*end || (int32_t)(uint32_t)val != e->live[i])
+			return false;
+	}
+	return true;
+}
 
-	printf("\tdev <devname> iwlwav sAvailAdmCap <admission capacity>\n");
-	printf("\t\tSet admission capacity.\n\n");
+static void iwlwav_snap_print_live(struct iwlwav_snap_entry *e)
+{
+	int i;
 
-	printf("\tdev <devname> iwlwav sSetRxTH <rx threshold>\n");
-	printf("\t\tSet rx threshold.\n\n");
+	for (i = 0; i < e->n_live; i++)
+		printf(" %d", e->live[i]);
+}
 
-	printf("\tdev <devname> iwlwav sRxDutyCyc <onTime> <offTime>\n");
-	printf("\t\tSet rx duty cycle.\n\n");
+static int iwlwav_snap_live(struct nl80211_state *state, int ifindex,
+			    struct iwlwav_snap_entry *es, int n)
+{
+	struct iwlwav_snap_entry **ptrs;
+	int i, err;
 
-	printf("\tdev <devname> iwlwav sPowerSelection <power selection>\n");
-	printf("\t\tSet tx power limit offset.\n\n");
+	ptrs = calloc(n, sizeof(*ptrs));
+	if (!ptrs)
+		return -ENOMEM;
+	for (i = 0; i < n; i++)
+		ptrs[i] = &es[i];
+	err = iwlwav_snap_send(state, ifindex, ptrs, n, false);
+	free(ptrs);
+	return err;
+}
 
-	printf("\tdev <devname> iwlwav s11nProtection <protection>\n");
-	printf("\t\tSet s11 protection method.\n\n");
+static int handle_iwlwav_snapshot(struct nl80211_state *state,
+				  struct nl_msg *msg,
+				  int argc, char **argv,
+				  enum id_input id)
+{
+	const struct iwlwav_cmd *cmd;
+	struct iwlwav_snap_entry *es;
+	int ifindex, n = 0, failed = 0, i, err;
 
-	printf("\tdev <devname> iwlwav sCalibOnDemand <calib on demand>\n");
-	printf("\t\tSet calib on demand.\n\n");
+	/* we get the full command line, skip "<dev> iwlwav snapshot" */
+	if (argc != 3)
+		return HANDLER_RET_USAGE;
 
-	printf("\tdev <devname> iwlwav sQAMplus <QAMplus mode>\n");
-	printf("\t\tSet QAMplus mode.\n\n");
+	ifindex = if_nametoindex(argv[0]);
+	if (!ifindex)
+		return -errno;
 
-	printf("\tdev <devname> iwlwav sAcsUpdateTo <update to>\n\n");
-	printf("\t\tSet acs update to.\n\n");
+	es = calloc(&__stop_iwlwav_cmd - __start_iwlwav_cmd, sizeof(*es));
+	if (!es)
+		return -ENOMEM;
+	for_each_iwlwav_cmd(cmd, i)
+		if (iwlwav_snap_setter(cmd))
+			es[n++].get = cmd;
+	qsort(es, n, sizeof(*es), iwlwav_snap_name_cmp);
+
+	err = iwlwav_snap_live(state, ifindex, es, n);
+	if (err)
+		goto out;
+
+	printf("# iwlwav snapshot of %s\n", argv[0]);
+	for (i = 0; i < n; i++) {
+		if (es[i].err) {
+			fprintf(stderr, "%s: %s\n", es[i].get->name,
+				strerror(-es[i].err));
+			failed++;
+			continue;
+		}
+		printf("%s", es[i].get->name);
+		iwlwav_snap_print_live(&es[i]);
+		printf("\n");
+	}
+	if (failed) {
+		fprintf(stderr, "%d of %d getters failed\n", failed, n);
+		err = 2;
+	}
+ out:
+	iwlwav_snap_free(es, n);
+	return err;
+}
+COMMAND(iwlwav, snapshot, "", 0, 0, CIB_NETDEV, handle_iwlwav_snapshot,
+	"Print the values of all integer getters that have a setter as\n"
+	"\"<getter> <values>\" lines.");
 
-	printf("\tdev <devname> iwlwav sMuOperation <mu operation>\n");
-	printf("\t\tSet mu operation.\n\n");
+/* the values that differ, with a message for each */
+static int iwlwav_snap_diff(struct iwlwav_snap_entry *es, int n, bool quiet)
+{
+	int i, diffs = 0;
 
-	printf("\tdev <devname> iwlwav sCcaTh <primary> <secondary> <midPktPrimary> <midPktSecondary20> <midPktSecondary40>\n");
-	printf("\t\tSet CCA threshold.\n\n");
+	for (i = 0; i < n; i++) {
+		struct iwlwav_snap_entry *e = &es[i];
+		int j;
 
-	printf("\tdev <devname> iwlwav sCcaAdapt <initial interval> <iterative interval> <limit> <step up> <step down> <step down interval> <min unblocked time>\n");
-	printf("\t\tSet CCA adapt.\n\n");
+		if (e->err) {
+			if (!quiet)
+				printf("%s: %s\n", e->get->name,
+				       strerror(-e->err));
+			continue;
+		}
+		if (iwlwav_snap_equal(e))
+			continue;
+
+		diffs++;
+		if (quiet)
+			continue;
+		printf("%s:", e->get->name);
+		for (j = 0; j < e->argc; j++)
+			printf(" %s", e->argv[j]);
+		printf(" ->");
+		iwlwav_snap_print_live(e);
+		printf("\n");
+	}
+	return diffs;
+}
 
-	printf("\tdev <devname> iwlwav sRadarRssiTh <radar rssi>\n");
-	printf("\t\tSet radar rssi threashold.\n\n");
+static int handle_iwlwav_diff(struct nl80211_state *state,
+			      struct nl_msg *msg,
+			      int argc, char **argv,
+			      enum id_input id)
+{
+	struct iwlwav_snap_entry *es;
+	int ifindex, n, diffs, err;
 
+	/* we get the full command line, skip "<dev> iwlwav diff" */
+	if (argc != 4)
+		return HANDLER_RET_USAGE;
 
-	printf("\tdev <devname> iwlwav sFilsBeaconFlag <beacon flag>\n");
-	printf("\t\tSet Fils Beacon Flag.\n\n");
+	ifindex = if_nametoindex(argv[0]);
+	if (!ifindex)
+		return -errno;
 
-	printf("\tdev <devname> iwlwav sRTSmode <dynamic_bw> <static_bw>\n");
-	printf("\t\tSet RTS mode.\n\n");
+	err = iwlwav_snap_read(argv[3], &es, &n, NULL);
+	if (err)
+		return err;
 
-	printf("\tdev <devname> iwlwav sMaxMpduLen <max length>\n");
-	printf("\t\tSet max mpdu length.\n\n");
+	err = iwlwav_snap_live(state, ifindex, es, n);
+	if (!err) {
+		diffs = iwlwav_snap_diff(es, n, false);
+		printf("%d of %d values differ\n", diffs, n);
+	}
 
-	printf("\tdev <devname> iwlwav sBfMode <bf mode>\n");
-	printf("\t\tSet bf mode.\n\n");
+	iwlwav_snap_free(es, n);
+	return err;
+}
+COMMAND(iwlwav, diff, "<snapshot file>", 0, 0, CIB_NETDEV, handle_iwlwav_diff,
+	"Compare the getters in a snapshot file with the current values,\n"
+	"printing \"<getter>: <file values> -> <current values>\".");
 
-	printf("\tdev <devname> iwlwav sProbeReqCltMode <enable/disable probe request collection>\n");
-	printf("\t\tSet bf mode.\n\n");
+static int iwlwav_apply_order(const struct iwlwav_cmd *set)
+{
+	unsigned int i;
 
-	printf("\tdev <devname> iwlwav sActiveAntMask <active ant mask>\n");
-	printf("\t\tSet active ant mask.\n\n");
+	for (i = 0; i < ARRAY_SIZE(iwlwav_apply_late); i++)
+		if (!strcmp(set->name, iwlwav_apply_late[i]))
+			return i + 1;
+	return 0;
+}
 
-	printf("\tdev <devname> iwlwav sFourAddrMode <4addr mode>\n");
-	printf("\t\tSet 4addr mode.\n\n");
+static int iwlwav_apply_cmp(const void *_a, const void *_b)
+{
+	const struct iwlwav_snap_entry *a = *(struct iwlwav_snap_entry * const *)_a;
+	const struct iwlwav_snap_entry *b = *(struct iwlwav_snap_entry * const *)_b;
 
-	printf("\tdev <devname> iwlwav sAddFourAddrSta <mac address>\n");
-	printf("\t\tSet add 4addr STA.\n\n");
+	if (a->order != b->order)
+		return a->order - b->order;
+	/* keep the file order otherwise */
+	return a < b ? -1 : a > b;
+}
 
-	printf("\tdev <devname> iwlwav sDelFourAddrSta <mac address>\n");
-	printf("\t\tSet delete 4addr STA.\n\n");
+static int handle_iwlwav_apply(struct nl80211_state *state,
+			       struct nl_msg *msg,
+			       int argc, char **argv,
+			       enum id_input id)
+{
+	struct iwlwav_snap_entry *es, **todo = NULL;
+	char dummy[IWLWAV_MAX_ARGS * sizeof(int32_t)];
+	int ifindex, n, n_todo = 0, failed = 0, skipped = 0, i, err;
+	bool dry_run = false;
 
-	printf("\tdev <devname> iwlwav sTxopConfig <STA ID> <Mode> <Duration> <Max number of STAs>\n");
-	printf("\t\tSet txop config.\n\n");
+	/* we get the full command line, skip "<dev> iwlwav apply" */
+	if (argc == 5 && !strcmp(argv[4], "--dry-run"))
+		dry_run = true;
+	else if (argc != 4)
+		return HANDLER_RET_USAGE;
 
-	printf("\tdev <devname> iwlwav sSsbMode <value_1> <value_2>\n");
-	printf("\t\tSet SSB mode.\n\n");
+	ifindex = if_nametoindex(argv[0]);
+	if (!ifindex)
+		return -errno;
 
-	printf("\tdev <devname> iwlwav sMcastRange <operation>,<mcast range>\n");
-	printf("\t\tSet mcast range.\n\n");
-	printf("\t\t<operation> = 0 delete all.\n\n");
-	printf("\t\t<operation> = 1 add.\n\n");
-	printf("\t\t<operation> = 2 delete.\n\n");
+	err = iwlwav_snap_read(argv[3], &es, &n, &skipped);
+	if (err)
+		return err;
 
-	printf("\tdev <devname> iwlwav sMcastRange6 <operation>,<mcast range6>\n");
-	printf("\t\tSet mcast range.\n\n");
-	printf("\t\t<operation> = 0 delete all.\n\n");
-	printf("\t\t<operation> = 1 add.\n\n");
-	printf("\t\t<operation> = 2 delete.\n\n");
+	err = iwlwav_snap_live(state, ifindex, es, n);
+	if (err)
+		goto out;
 
-	printf("\tdev <devname> iwlwav sOnlineACM <online acm>\n");
-	printf("\t\tSet online acm.\n\n");
+	todo = calloc(n, sizeof(*todo));
+	if (!todo) {
+		err = -ENOMEM;
+		goto out;
+	}
 
-	printf("\tdev <devname> iwlwav sAlgoCalibrMask <calibr mask>\n");
-	printf("\t\tSet algo calibration mask.\n\n");
+	for (i = 0; i < n; i++) {
+		struct iwlwav_snap_entry *e = &es[i];
 
-	printf("\tdev <devname> iwlwav sWhmReset <Reset WHM>\n");
-	printf("\t\tSet WHM Reset.\n\n");
+		if (!e->err && iwlwav_snap_equal(e)) {
+			printf("%s: unchanged\n", e->get->name);
+			continue;
+		}
 
-	printf("\tdev <devname> iwlwav sWhmTrigger <WHM WarningId 101...150> <WHM WarningLayer>\n");
-	printf("\t\tSet WHM Trigger.\n\n");
+		/* check the arguments now, not halfway through the batch */
+		if (iwlwav_cmd_encode(e->set, e->argc, e->argv, dummy,
+				      sizeof(dummy)) < 0) {
+			fprintf(stderr, "%s: skipped, arguments don't fit %s\n",
+				e->get->name, e->set->name);
+			skipped++;
+			continue;
+		}
+		e->order = iwlwav_apply_order(e->set);
+		todo[n_todo++] = e;
+	}
 
-	printf("\tdev <devname> iwlwav sRestrictAcMode <restrictedAcModeEnable> <acRestrictedBitmap> <restrictedAcThreshEnter> <restrictedAcThreshExit>\n");
-	printf("\t\tSet restricted ac mode.\n\n");
+	qsort(todo, n_todo, sizeof(*todo), iwlwav_apply_cmp);
 
-	printf("\tdev <devname> iwlwav sPdThresh <mode> <minPdDiff> <minPdAmount>\n");
-	printf("\t\tSet pd threshold.\n\n");
+	if (dry_run) {
+		for (i = 0; i < n_todo; i++) {
+			int j;
 
-	printf("\tdev <devname> iwlwav sFastDrop <fast drop>\n");
-	printf("\t\tSet fast drop.\n\n");
+			printf("%s", todo[i]->set->name);
+			for (j = 0; j < todo[i]->argc; j++)
+				printf(" %s", todo[i]->argv[j]);
+			printf("\n");
+		}
+		goto out;
+	}
 
-	printf("\tdev <devname> iwlwav sMuStatPlanCfg <19 to 170 params> <...>\n");
-	printf("\t\tSet mu stat plan cfg.\n\n");
+	if (n_todo) {
+		err = iwlwav_snap_send(state, ifindex, todo, n_todo, true);
+		if (err)
+			goto out;
+		for (i = 0; i < n_todo; i++)
+			if (todo[i]->err)
+				failed++;
+
+		/* read back what was set */
+		err = iwlwav_snap_send(state, ifindex, todo, n_todo, false);
+		if (err)
+			goto out;
+		for (i = 0; i < n_todo; i++)
+			if (!todo[i]->err && !iwlwav_snap_equal(todo[i]))
+				fprintf(stderr, "%s: still differs after %s\n",
+					todo[i]->get->name, todo[i]->set->name);
+	}
 
-	printf("\tdev <devname> iwlwav sWdsWepEncCfg <key_id> <wds wep key>\n");
-	printf("\t\tSet wds wep key.\n\n");
+	printf("%d values set, %d failed, %d skipped\n", n_todo - failed,
+	       failed, skipped);
+	if (failed || skipped)
+		err = 2;
+ out:
+	free(todo);
+	iwlwav_snap_free(es, n);
+	return err;
+}
+COMMAND(iwlwav, apply, "<snapshot file> [--dry-run]", 0, 0, CIB_NETDEV,
+	handle_iwlwav_apply,
+	"Set the values of a snapshot file that differ from the current ones\n"
+	"with the matching setters, dependent settings last, and report the\n"
+	"result of each. --dry-run only prints the setters.");
+
+/***************************** WATCH *****************************/
+/*
+ * 'iwlwav watch' polls one getter and interprets its reply words with a
+ * field schema: counters are shown as the change since the previous
+ * sample and as a rate, gauges with their min/avg/max over the run.
+ * Every field is one 32-bit word and counters wrap. Getters without a
+ * schema, such as gStationsStat whose reply layout isn't in the vendor
+ * header, are taken as gauges word by word. The request is built once
+ * and sent again for each sample.
+ */
+enum iwlwav_field_kind {
+	IWLWAV_GAUGE,
+	IWLWAV_COUNTER,
+};
 
-	printf("\tdev <devname> iwlwav sRtsRate <0..2>\n");
-	printf("\t\tSet RTS protection rate.\n\n");
+struct iwlwav_field {
+	const char *name;
+	enum iwlwav_field_kind kind;
+};
 
-#ifdef WAVE_ENABLE_PIE
-	printf("\tdev <devname> iwlwav sPIEcfg <param_1> <..> <param_n>\n");
-	printf("\t\tSet PIE configuration.\n\n");
-	printf("\tdev <devname> iwlwav sAqmEn <sid> <0/1>\n");
-	printf("\t\tSet AQM enabled.\n\n");
-#endif /* WAVE_ENABLE_PIE */
+struct iwlwav_schema {
+	const char *getter;
+	enum ltq_nl80211_vendor_subcmds subcmd;
+	/* for words past the listed fields */
+	enum iwlwav_field_kind kind;
+	const struct iwlwav_field *fields;
+	int n_fields;
+};
 
-	printf("\tdev <devname> iwlwav sStationsStat <0..1>\n");
-	printf("\t\tSet stations statistics (enable/disable).\n\n");
+static const struct iwlwav_field iwlwav_radio_usage_fields[] = {
+	{ "Active", IWLWAV_COUNTER },
+	{ "Busy", IWLWAV_COUNTER },
+	{ "BusyTx", IWLWAV_COUNTER },
+	{ "BusyRx", IWLWAV_COUNTER },
+	{ "BusySelf", IWLWAV_COUNTER },
+	{ "Interfer", IWLWAV_COUNTER },
+	{ "Idle", IWLWAV_COUNTER },
+	{ "BusyExt", IWLWAV_COUNTER },
+};
 
-	printf("\tdev <devname> iwlwav sTxExceRetryLimit <threshold[0..255]>\n");
-	printf("\t\tSet excessive retry limit.\n\n");
+static const struct iwlwav_schema iwlwav_schemas[] = {
+	{ "gRadioUsageStats", LTQ_NL80211_VENDOR_SUBCMD_GET_RADIO_USAGE_STATS,
+	  IWLWAV_COUNTER, iwlwav_radio_usage_fields,
+	  ARRAY_SIZE(iwlwav_radio_usage_fields) },
+	{ "gFWRecoveryStat", LTQ_NL80211_VENDOR_SUBCMD_GET_RCVRY_STATS,
+	  IWLWAV_COUNTER, NULL, 0 },
+	{ "gGetCcaStats", LTQ_NL80211_VENDOR_SUBCMD_GET_CCA_STATS_CURRENT_CHAN,
+	  IWLWAV_GAUGE, NULL, 0 },
+	{ "gTemperature", LTQ_NL80211_VENDOR_SUBCMD_GET_TEMPERATURE_SENSOR,
+	  IWLWAV_GAUGE, NULL, 0 },
+};
 
-	printf("\tdev <devname> iwlwav sStatsPollPeriod<1..300>\n");
-	printf("\t\tSet statistics auto polling period.\n\n");
-	printf("\tdev <devname> iwlwav sDynamicMu <dl mu type> <ul mu type> <min stas in group> <max stas in group> <cdb cfg>\n");
-	printf("\t\tSet Dynamic MU type.\n\n");
-	printf("\tdev <devname> iwlwav sMuFixedCfg <mu sequence> <ltf gi> <coding type> <he rate>\n");
-	printf("\t\tSet HE MU Fixed parameters.\n\n");
-	printf("\tdev <devname> iwlwav sMuDurationCfg <ppdu duration> <txop duration> <tf length> <num of repetitions>\n");
-	printf("\t\tSet HE MU Duration.\n\n");
-	printf("\tdev <devname> iwlwav sETSILimitation <enable/disable>\n");
-	printf("\t\tSet ETSI PPDU Limitation.\n\n");
-	printf("\tdev <devname> iwlwav sTxRetryLimit <mgmt[0...15]> <data[0...15]> <proberesp[0...15]>\n");
-	printf("\t\tSet Tx Retry Limit.\n\n");
-	printf("\tdev <devname> iwlwav sCtsToSelfTo <1..32ms>\n");
-	printf("\t\tSet Cts to self timeout.\n\n");
+struct iwlwav_watch_field {
+	bool seen;
+	uint32_t prev;
+	long long min, max, sum;
+	unsigned long long n;
+};
 
-	printf("\tdev <devname> iwlwav sPreamPunCcaOvr\n\n");
-	printf("\t\tSet Preamble puncture cca override.\n\n");
+struct iwlwav_watch {
+	const struct iwlwav_schema *schema;
+	uint32_t words[IWLWAV_MAX_ARGS];
+	int n_words;
+	struct iwlwav_watch_field fields[IWLWAV_MAX_ARGS];
+};
 
-	printf("\tdev <devname> iwlwav sSlowProbingMask <probing mask>\n");
-	printf("\t\tSet slow probing mask.\n\n");
+static struct iwlwav_watch iwlwav_watch;
 
-	printf("\tdev <devname> iwlwav sScanModifFlags <modifs flags>\n");
-	printf("\t\tSet scan modifs.\n\n");
+static int iwlwav_watch_handler(struct nl_msg *msg, void *arg)
+{
+	struct iwlwav_watch *w = arg;
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr *attr;
+	int len;
 
-	printf("\tdev <devname> iwlwav sScanPauseBGCache <flag>\n");
-	printf("\t\tSet scan pause bg cache.\n\n");
+	attr = nla_find(genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0),
+			NL80211_ATTR_VENDOR_DATA);
+	if (!attr)
+		return NL_SKIP;
 
-	printf("\tdev <devname> iwlwav sZwdfsAnt <flag>\n");
-	printf("\t\tSet zwdfs antenna.\n\n");
+	len = nla_len(attr);
+	if (len > (int)sizeof(w->words))
+		len = sizeof(w->words);
+	w->n_words = len / sizeof(uint32_t);
+	memcpy(w->words, nla_data(attr), w->n_words * sizeof(uint32_t));
+	return NL_SKIP;
+}
 
-	printf("\tdev <devname> iwlwav sAdvertiseBcTwtSp <numberOfSpsToAdd> <wakeDurationUnit> [<broadcastTwtId> <flowType> <triggerType> <twtWakeDuration> <twtWakeIntervalMantissa> <wakeIntervalExponent>]\n");
-	printf("\t\tAdvertise broadcast TWT schedule(s) upto a maximum of 8 schedules per request. The fields starting from broadcastTwtId and upto wakeIntervalExponent are per schedule.\n\n");
+static void iwlwav_watch_report(struct iwlwav_watch *w, const char *getter,
+				unsigned long long ms, bool report)
+{
+	const struct iwlwav_schema *sc = w->schema;
+	int f;
 
-	printf("\tdev <devname> iwlwav sTerminateBcTwtSP <broadcastTwtPersistence>\n");
-	printf("\t\tTerminate all broadcast TWT schedules after a fixed number of TBTTs indicated by the persistence field.\n\n");
+	if (report)
+		printf("%s (%llu ms):\n", getter, ms);
 
-	printf("\tdev <devname> iwlwav sTxTwtTeardown <staId> <allTWT> <agreementType> <twtId>\n");
-	printf("\t\tTransmit a TWT teardown frame to an associated station with the configured parameters.\n\n");
+	for (f = 0; f < w->n_words; f++) {
+		const struct iwlwav_field *fd = NULL;
+		struct iwlwav_watch_field *st = &w->fields[f];
+		enum iwlwav_field_kind kind = sc ? sc->kind : IWLWAV_GAUGE;
+		uint32_t val, delta;
+		char name[16];
 
-	printf("\tdev <devname> iwlwav sConfigMRCoex <coex mode> <active time> <inactive time> <cts2self active>\n");
-	printf("\t\tSet coex enable.\n\n");
+		if (sc && f < sc->n_fields) {
+			fd = &sc->fields[f];
+			kind = fd->kind;
+		}
+		if (fd) {
+			snprintf(name, sizeof(name), "%s", fd->name);
+		} else {
+			snprintf(name, sizeof(name), "field %d", f);
+		}
 
-	printf("\tdev <devname> iwlwav sFixedLtfGi <0-fixed, 1-auto> <value for fixed>\n");
-	printf("\t\tSet fixed lt fgi.\n\n");
+		val = w->words[f];
 
-	printf("\tdev <devname> iwlwav sMgmtFramePwrCtrl <power>\n");
-	printf("\t\tSet Management Frame Tx Power.\n\n");
+		if (kind == IWLWAV_COUNTER) {
+			delta = st->seen ? val - st->prev : 0;
 
-	printf("\tdev <devname> iwlwav sEnableCsiEngine <Station MAC Addr> <br-lan MAC Addr> <Enable Flag>\n");
-	printf("\t\tSet Enable CSI Engine.\n\n");
+			if (report && st->seen)
+				printf("  %-12s %14u +%11u %12.1f/s\n", name,
+				       val, delta, ms ? delta * 1000.0 / ms : 0.0);
+		} else {
+			long long g = (int32_t)val;
+
+			if (!st->n || g < st->min)
+				st->min = g;
+			if (!st->n || g > st->max)
+				st->max = g;
+			st->sum += g;
+			st->n++;
+
+			if (report)
+				printf("  %-12s %14lld  min %lld avg %.1f max %lld\n",
+				       name, g, st->min, (double)st->sum / st->n,
+				       st->max);
+		}
 
-	printf("\tdev <devname> iwlwav sCsiSendQosNull <Station MAC Addr>\n");
-	printf("\t\tSet CSI Send QOS NULL.\n\n");
+		st->prev = val;
+		st->seen = true;
+	}
 
-	printf("\tdev <devname> iwlwav sCsi <Station MAC Addr> <br-lan MAC Addr> <Enable Flag> <CSI Sampling Rate>\n");
-	printf("\t\tSet CSI Auto Configuration .\n\n");
+	if (report) {
+		printf("\n");
+		fflush(stdout);
+	}
+}
+
+static int handle_iwlwav_watch(struct nl80211_state *state,
+			       struct nl_msg *msg,
+			       int argc, char **argv,
+			       enum id_input id)
+{
+	struct iwlwav_watch *w = &iwlwav_watch;
+	struct nl80211_batch_req req = {};
+	const struct iwlwav_cmd *cmd;
+	unsigned long interval_ms = 0, count = 0, n;
+	unsigned long long last_ms, sample_ms;
+	const char *getter, *dev = argv[0];
+	int ifindex, n_args, err, used;
+	unsigned int i;
+
+	/* we get the full command line, skip "<dev> iwlwav watch" */
+	argc -= 3;
+	argv += 3;
+	if (argc < 1)
+		return HANDLER_RET_USAGE;
+	getter = argv[0];
+	argc--;
+	argv++;
+
+	/* getter arguments up to the first option */
+	for (n_args = 0; n_args < argc; n_args++)
+		if (!strncmp(argv[n_args], "--", 2))
+			break;
+	for (i = n_args; (int)i < argc; i += used) {
+		used = parse_interval_count(argc - i, argv + i, &interval_ms,
+					    &count);
+		if (used <= 0)
+			return HANDLER_RET_USAGE;
+	}
+	if (!interval_ms)
+		return HANDLER_RET_USAGE;
+
+	ifindex = if_nametoindex(dev);
+	if (!ifindex)
+		return -errno;
+
+	memset(w, 0, sizeof(*w));
+	for (i = 0; i < ARRAY_SIZE(iwlwav_schemas); i++)
+		if (!strcmp(iwlwav_schemas[i].getter, getter))
+			w->schema = &iwlwav_schemas[i];
+
+	cmd = iwlwav_cmd_find(getter);
+	if ((!cmd || cmd->reply != IWLWAV_REPLY_INT) && !w->schema) {
+		fprintf(stderr, "%s: not an integer getter\n", getter);
+		return 2;
+	}
+
+	req.msg = nl80211_batch_msg(state, NL80211_CMD_VENDOR, 0, ifindex);
+	if (!req.msg)
+		return -ENOMEM;
+	req.handler = iwlwav_watch_handler;
+	req.arg = w;
+
+	if (cmd) {
+		err = iwlwav_cmd_put(cmd, req.msg, n_args, argv);
+		if (err)
+			goto out;
+	} else if (n_args) {
+		err = HANDLER_RET_USAGE;
+		goto out;
+	} else {
+		NLA_PUT_U32(req.msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ);
+		NLA_PUT_U32(req.msg, NL80211_ATTR_VENDOR_SUBCMD, w->schema->subcmd);
+	}
+
+	last_ms = now_ms();
+	for (n = 0; !count || n <= count; n++) {
+		w->n_words = 0;
+		err = nl80211_batch(state, &req, 1, 0);
+		if (!err)
+			err = req.err;
+		if (err)
+			goto out;
+
+		sample_ms = now_ms();
+		iwlwav_watch_report(w, getter, sample_ms - last_ms, n > 0);
+		last_ms = sample_ms;
+
+		if (!count || n < count)
+			usleep(interval_ms * 1000);
+	}
+	err = 0;
+	goto out;
+
+ nla_put_failure:
+	err = -ENOBUFS;
+ out:
+	nlmsg_free(req.msg);
+	return err;
+}
+COMMAND(iwlwav, watch, "<getter> [<args>] --interval <ms> [--count <n>]",
+	0, 0, CIB_NETDEV, handle_iwlwav_watch,
+	"Poll an integer getter every <ms> milliseconds (<n> times, default\n"
+	"forever); counters are shown with their change and rate, gauges\n"
+	"with min/avg/max.");
+
+/***************************** CCA SWEEP *****************************/
+/*
+ * 'iwlwav cca_sweep' runs the off-channel CCA measurement on a list of
+ * channels, one after the other: sStartCcaMsr starts the measurement
+ * and gGetCcaMsr is polled until it returns data or the per-channel
+ * timeout expires. The first two reply words are taken as the CCA busy
+ * and interference percentages. With --repeat the whole list is swept
+ * again and the results are averaged. Without a channel list all
+ * enabled channels of the radio are measured.
+ *
+ * The sweep is kept per frequency, but both vendor commands only carry
+ * a channel number. A channel number that is enabled in more than one
+ * band of the radio (2.4 and 6 GHz channel 1, say) can't be measured
+ * unambiguously: it is rejected on the command line and skipped, with a
+ * note, in the default list.
+ */
+#define IWLWAV_CCA_POLL_MS	50
+
+struct iwlwav_cca_chan {
+	unsigned int freq, chan;
+	int n;
+	int err;
+	double busy, interf;
+};
+
+struct iwlwav_cca_sweep {
+	struct iwlwav_cca_chan *chans;
+	int n_chans, size;
+	/* enabled frequencies of the radio */
+	unsigned int *freqs;
+	int n_freqs, freqs_size;
+	int err;
+	/* last gGetCcaMsr reply */
+	uint32_t words[2];
+	int n_words;
+};
+
+static struct iwlwav_cca_sweep iwlwav_cca;
+
+static int iwlwav_cca_add(struct iwlwav_cca_sweep *cs, unsigned int freq)
+{
+	struct iwlwav_cca_chan *c;
+	int i;
+
+	for (i = 0; i < cs->n_chans; i++)
+		if (cs->chans[i].freq == freq)
+			return 0;
+
+	if (cs->n_chans == cs->size) {
+		int size = cs->size ? cs->size * 2 : 32;
+
+		c = realloc(cs->chans, size * sizeof(*c));
+		if (!c)
+			return -ENOMEM;
+		cs->chans = c;
+		cs->size = size;
+	}
+
+	c = &cs->chans[cs->n_chans++];
+	memset(c, 0, sizeof(*c));
+	c->freq = freq;
+	c->chan = ieee80211_frequency_to_channel(freq);
+	return 0;
+}
+
+/* number of enabled frequencies of the radio that are channel \a chan */
+static int iwlwav_cca_chan_freqs(const struct iwlwav_cca_sweep *cs,
+				 unsigned int chan, unsigned int *freq)
+{
+	int i, n = 0;
+
+	for (i = 0; i < cs->n_freqs; i++) {
+		if ((unsigned int)ieee80211_frequency_to_channel(cs->freqs[i]) !=
+		    chan)
+			continue;
+		if (!n++ && freq)
+			*freq = cs->freqs[i];
+	}
+	return n;
+}
+
+static int iwlwav_cca_wiphy_handler(struct nl_msg *msg, void *arg)
+{
+	struct iwlwav_cca_sweep *cs = arg;
+	unsigned int *f;
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr *tb_band[NL80211_BAND_ATTR_MAX + 1];
+	struct nlattr *tb_freq[NL80211_FREQUENCY_ATTR_MAX + 1];
+	struct nlattr *nl_band, *nl_freq;
+	int rem_band, rem_freq;
+
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+	if (!tb[NL80211_ATTR_WIPHY_BANDS])
+		return NL_SKIP;
+
+	nla_for_each_nested(nl_band, tb[NL80211_ATTR_WIPHY_BANDS], rem_band) {
+		nla_parse(tb_band, NL80211_BAND_ATTR_MAX, nla_data(nl_band),
+			  nla_len(nl_band), NULL);
+		if (!tb_band[NL80211_BAND_ATTR_FREQS])
+			continue;
+
+		nla_for_each_nested(nl_freq, tb_band[NL80211_BAND_ATTR_FREQS],
+				    rem_freq) {
+			nla_parse(tb_freq, NL80211_FREQUENCY_ATTR_MAX,
+				  nla_data(nl_freq), nla_len(nl_freq), NULL);
+			if (!tb_freq[NL80211_FREQUENCY_ATTR_FREQ] ||
+			    tb_freq[NL80211_FREQUENCY_ATTR_DISABLED])
+				continue;
+			if (cs->n_freqs == cs->freqs_size) {
+				int size = cs->freqs_size ?
+					   cs->freqs_size * 2 : 64;
+
+				f = realloc(cs->freqs, size * sizeof(*f));
+				if (!f) {
+					cs->err = -ENOMEM;
+					return NL_STOP;
+				}
+				cs->freqs = f;
+				cs->freqs_size = size;
+			}
+			cs->freqs[cs->n_freqs++] =
+				nla_get_u32(tb_freq[NL80211_FREQUENCY_ATTR_FREQ]);
+		}
+	}
+	return NL_SKIP;
+}
+
+static int iwlwav_cca_handler(struct nl_msg *msg, void *arg)
+{
+	struct iwlwav_cca_sweep *cs = arg;
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr *attr;
+
+	attr = nla_find(genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0),
+			NL80211_ATTR_VENDOR_DATA);
+	if (!attr)
+		return NL_SKIP;
+
+	cs->n_words = nla_len(attr) / sizeof(uint32_t);
+	if (cs->n_words > 2)
+		cs->n_words = 2;
+	memcpy(cs->words, nla_data(attr), cs->n_words * sizeof(uint32_t));
+	return NL_SKIP;
+}
+
+static int iwlwav_cca_measure(struct nl80211_state *state, int ifindex,
+			      struct iwlwav_cca_sweep *cs,
+			      struct iwlwav_cca_chan *c,
+			      unsigned long dwell_ms, unsigned long timeout_ms)
+{
+	const struct iwlwav_cmd *start = iwlwav_cmd_find("sStartCcaMsr");
+	struct nl80211_batch_req req = {};
+	unsigned long long deadline;
+	char chan[16], dwell[24];
+	char *start_argv[] = { chan, dwell };
+	uint32_t data = c->chan;
+	int err;
+
+	snprintf(chan, sizeof(chan), "%u", c->chan);
+	snprintf(dwell, sizeof(dwell), "%lu", dwell_ms);
+
+	req.msg = nl80211_batch_msg(state, NL80211_CMD_VENDOR, 0, ifindex);
+	if (!req.msg)
+		return -ENOMEM;
+	err = iwlwav_cmd_put(start, req.msg, 2, start_argv);
+	if (!err)
+		err = nl80211_batch(state, &req, 1, 0);
+	if (!err)
+		err = req.err;
+	nlmsg_free(req.msg);
+	if (err)
+		return err;
+
+	deadline = now_ms() + timeout_ms;
+	usleep(dwell_ms * 1000);
+
+	req.msg = nl80211_batch_msg(state, NL80211_CMD_VENDOR, 0, ifindex);
+	if (!req.msg)
+		return -ENOMEM;
+	req.handler = iwlwav_cca_handler;
+	req.arg = cs;
+	NLA_PUT_U32(req.msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ);
+	NLA_PUT_U32(req.msg, NL80211_ATTR_VENDOR_SUBCMD,
+		    LTQ_NL80211_VENDOR_SUBCMD_GET_CCA_MSR_OFF_CHAN);
+	NLA_PUT(req.msg, NL80211_ATTR_VENDOR_DATA, sizeof(data), &data);
+
+	/* the result may not be there yet, keep asking until the deadline */
+	for (;;) {
+		cs->n_words = 0;
+		err = nl80211_batch(state, &req, 1, 0);
+		if (!err)
+			err = req.err;
+		if (!err && cs->n_words == 2) {
+			c->busy += cs->words[0];
+			c->interf += cs->words[1];
+			c->n++;
+			break;
+		}
+		if (!err)
+			err = -ENODATA;
+		if (now_ms() >= deadline) {
+			if (err == -ENODATA)
+				err = -ETIMEDOUT;
+			break;
+		}
+		usleep(IWLWAV_CCA_POLL_MS * 1000);
+	}
+	nlmsg_free(req.msg);
+	return err;
+
+ nla_put_failure:
+	nlmsg_free(req.msg);
+	return -ENOBUFS;
+}
+
+static int iwlwav_cca_cmp(const void *a, const void *b)
+{
+	const struct iwlwav_cca_chan *ca = a, *cb = b;
+	double ba, bb;
+
+	/* measured channels first, quietest first */
+	if (!ca->n || !cb->n)
+		return !ca->n - !cb->n;
+	ba = (ca->busy + ca->interf) / ca->n;
+	bb = (cb->busy + cb->interf) / cb->n;
+	if (ba != bb)
+		return ba < bb ? -1 : 1;
+	return (int)ca->freq - (int)cb->freq;
+}
+
+static int handle_iwlwav_cca_sweep(struct nl80211_state *state,
+				   struct nl_msg *msg,
+				   int argc, char **argv,
+				   enum id_input id)
+{
+	struct iwlwav_cca_sweep *cs = &iwlwav_cca;
+	unsigned long dwell_ms = 100, timeout_ms = 0, repeat = 1, r, val;
+	struct nl80211_batch_req req = {};
+	const char *dev = argv[0];
+	unsigned int freq = 0;
+	int ifindex, err, i, n;
+	char *end;
+
+	/* we get the full command line, skip "<dev> iwlwav cca_sweep" */
+	argc -= 3;
+	argv += 3;
+
+	for (i = 0; i < argc; i++) {
+		if (strncmp(argv[i], "--", 2))
+			continue;
+		if (i + 1 >= argc)
+			return HANDLER_RET_USAGE;
+		val = strtoul(argv[i + 1], &end, 10);
+		if (*end || !val)
+			return HANDLER_RET_USAGE;
+		if (!strcmp(argv[i], "--dwell"))
+			dwell_ms = val;
+		else if (!strcmp(argv[i], "--timeout"))
+			timeout_ms = val;
+		else if (!strcmp(argv[i], "--repeat"))
+			repeat = val;
+		else
+			return HANDLER_RET_USAGE;
+		i++;
+	}
+	if (!timeout_ms)
+		timeout_ms = dwell_ms + 1000;
+
+	ifindex = if_nametoindex(dev);
+	if (!ifindex)
+		return -errno;
+
+	/* the enabled channels tell which channel numbers are ambiguous */
+	memset(cs, 0, sizeof(*cs));
+	req.msg = nl80211_batch_msg(state, NL80211_CMD_GET_WIPHY,
+				    NLM_F_DUMP, ifindex);
+	if (!req.msg)
+		return -ENOMEM;
+	nla_put_flag(req.msg, NL80211_ATTR_SPLIT_WIPHY_DUMP);
+	req.handler = iwlwav_cca_wiphy_handler;
+	req.arg = cs;
+	err = nl80211_batch(state, &req, 1, 0);
+	if (!err)
+		err = req.err;
+	if (!err)
+		err = cs->err;
+	nlmsg_free(req.msg);
+	if (err)
+		goto out;
+
+	for (i = 0; i < argc; i++) {
+		if (!strncmp(argv[i], "--", 2)) {
+			i++;
+			continue;
+		}
+		val = strtoul(argv[i], &end, 10);
+		if (*end || !val || val > 255) {
+			err = HANDLER_RET_USAGE;
+			goto out;
+		}
+		n = iwlwav_cca_chan_freqs(cs, val, &freq);
+		if (n != 1) {
+			fprintf(stderr, "channel %lu: %s\n", val,
+				n ? "enabled in more than one band, the measurement can't tell them apart" :
+				    "not enabled");
+			err = 2;
+			goto out;
+		}
+		err = iwlwav_cca_add(cs, freq);
+		if (err)
+			goto out;
+	}
+
+	if (!cs->n_chans) {
+		for (i = 0; i < cs->n_freqs; i++) {
+			unsigned int chan;
+
+			freq = cs->freqs[i];
+			chan = ieee80211_frequency_to_channel(freq);
+			if (iwlwav_cca_chan_freqs(cs, chan, NULL) > 1) {
+				fprintf(stderr, "channel %u (%u MHz): enabled in more than one band, skipped\n",
+					chan, freq);
+				continue;
+			}
+			err = iwlwav_cca_add(cs, freq);
+			if (err)
+				goto out;
+		}
+	}
+	if (!cs->n_chans) {
+		fprintf(stderr, "%s: no enabled channels\n", dev);
+		err = 2;
+		goto out;
+	}
+
+	for (r = 0; r < repeat; r++) {
+		for (i = 0; i < cs->n_chans; i++) {
+			struct iwlwav_cca_chan *c = &cs->chans[i];
+
+			err = iwlwav_cca_measure(state, ifindex, cs, c,
+						 dwell_ms, timeout_ms);
+			if (err == -ENOMEM || err == -ENOBUFS)
+				goto out;
+			if (err) {
+				c->err = err;
+				fprintf(stderr, "channel %u (%u MHz): %s\n",
+					c->chan, c->freq, strerror(-err));
+			}
+		}
+	}
+	err = 0;
+
+	qsort(cs->chans, cs->n_chans, sizeof(cs->chans[0]), iwlwav_cca_cmp);
+
+	printf("%-5s %-5s %8s %8s %8s\n", "freq", "chan", "busy%", "interf%",
+	       "samples");
+	for (i = 0; i < cs->n_chans; i++) {
+		struct iwlwav_cca_chan *c = &cs->chans[i];
+
+		if (!c->n) {
+			printf("%-5u %-5u %8s %8s %4d/%lu (%s)\n", c->freq,
+			       c->chan, "-", "-", 0, repeat, strerror(-c->err));
+			continue;
+		}
+		printf("%-5u %-5u %8.1f %8.1f %4d/%lu\n", c->freq, c->chan,
+		       c->busy / c->n, c->interf / c->n, c->n, repeat);
+	}
+ out:
+	free(cs->chans);
+	free(cs->freqs);
+	return err;
+}
+COMMAND(iwlwav, cca_sweep,
+	"[<channel>...] [--dwell <ms>] [--timeout <ms>] [--repeat <n>]",
+	0, 0, CIB_NETDEV, handle_iwlwav_cca_sweep,
+	"Measure CCA busy and interference on each channel (default: all\n"
+	"enabled channels) and print them sorted, quietest first. The dwell\n"
+	"time defaults to 100 ms, the per-channel timeout to dwell + 1000 ms.\n"
+	"A channel number enabled in more than one band can't be measured.");
+
+/***************************** PROBE REQUESTS *****************************/
+/*
+ * 'iwlwav probe_collect' polls gProbeReqList and merges the records into
+ * a table keyed by MAC address. The firmware list is short and aged, so
+ * a single read misses transient clients. A record counts as a new probe
+ * when its MAC was not in the previous list or its age went down. The
+ * table has a fixed size; when it is full the least recently seen entry
+ * is reused. Locally administered addresses are usually randomized.
+ */
+#define IWLWAV_PROBE_MAX	4096
+#define IWLWAV_PROBE_HASH	256
+#define IWLWAV_PROBE_NONE	-1
+
+struct iwlwav_probe_entry {
+	uint8_t addr[ETH_ALEN];
+	uint16_t age;
+	/* polls, to tell whether it was in the previous list */
+	unsigned long poll;
+	unsigned long long first_ms, last_ms;
+	unsigned long probes;
+	int rssi_min, rssi_max;
+	long long rssi_sum;
+	/* hash chain and LRU list, as indices */
+	int hnext;
+	int lru_prev, lru_next;
+};
+
+struct iwlwav_probe_table {
+	struct iwlwav_probe_entry entries[IWLWAV_PROBE_MAX];
+	int hash[IWLWAV_PROBE_HASH];
+	int max, used;
+	/* most recently seen first */
+	int lru_head, lru_tail;
+	unsigned long evicted;
+	unsigned long poll;
+	unsigned long long now_ms;
+};
+
+static struct iwlwav_probe_table iwlwav_probes;
+
+static unsigned int iwlwav_probe_hash(const uint8_t *addr)
+{
+	return (addr[3] ^ addr[4] * 7 ^ addr[5] * 31) % IWLWAV_PROBE_HASH;
+}
+
+static void iwlwav_probe_unlink(struct iwlwav_probe_table *t, int i)
+{
+	struct iwlwav_probe_entry *e = &t->entries[i];
+
+	if (e->lru_prev != IWLWAV_PROBE_NONE)
+		t->entries[e->lru_prev].lru_next = e->lru_next;
+	else
+		t->lru_head = e->lru_next;
+	if (e->lru_next != IWLWAV_PROBE_NONE)
+		t->entries[e->lru_next].lru_prev = e->lru_prev;
+	else
+		t->lru_tail = e->lru_prev;
+}
+
+static void iwlwav_probe_push(struct iwlwav_probe_table *t, int i)
+{
+	struct iwlwav_probe_entry *e = &t->entries[i];
+
+	e->lru_prev = IWLWAV_PROBE_NONE;
+	e->lru_next = t->lru_head;
+	if (t->lru_head != IWLWAV_PROBE_NONE)
+		t->entries[t->lru_head].lru_prev = i;
+	else
+		t->lru_tail = i;
+	t->lru_head = i;
+}
+
+static void iwlwav_probe_unhash(struct iwlwav_probe_table *t, int i)
+{
+	int *p = &t->hash[iwlwav_probe_hash(t->entries[i].addr)];
+
+	while (*p != i)
+		p = &t->entries[*p].hnext;
+	*p = t->entries[i].hnext;
+}
+
+static struct iwlwav_probe_entry *
+iwlwav_probe_get(struct iwlwav_probe_table *t, const uint8_t *addr)
+{
+	unsigned int h = iwlwav_probe_hash(addr);
+	struct iwlwav_probe_entry *e;
+	int i;
+
+	for (i = t->hash[h]; i != IWLWAV_PROBE_NONE; i = e->hnext) {
+		e = &t->entries[i];
+		if (!memcmp(e->addr, addr, ETH_ALEN)) {
+			iwlwav_probe_unlink(t, i);
+			iwlwav_probe_push(t, i);
+			return e;
+		}
+	}
+
+	if (t->used < t->max) {
+		i = t->used++;
+	} else {
+		i = t->lru_tail;
+		iwlwav_probe_unlink(t, i);
+		iwlwav_probe_unhash(t, i);
+		t->evicted++;
+	}
+
+	e = &t->entries[i];
+	memset(e, 0, sizeof(*e));
+	memcpy(e->addr, addr, ETH_ALEN);
+	e->first_ms = t->now_ms;
+	e->hnext = t->hash[h];
+	t->hash[h] = i;
+	iwlwav_probe_push(t, i);
+	return e;
+}
+
+static int iwlwav_probe_handler(struct nl_msg *msg, void *arg)
+{
+	struct iwlwav_probe_table *t = arg;
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct intel_vendor_probe_req_info *arr;
+	struct nlattr *attr;
+	int n, i;
+
+	attr = nla_find(genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0),
+			NL80211_ATTR_VENDOR_DATA);
+	if (!attr)
+		return NL_SKIP;
+
+	n = nla_len(attr) / sizeof(*arr);
+	arr = nla_data(attr);
+	for (i = 0; i < n; i++) {
+		struct iwlwav_probe_entry *e;
+		bool fresh;
+
+		e = iwlwav_probe_get(t, arr[i].addr);
+		fresh = !e->probes || e->poll + 1 != t->poll ||
+			arr[i].age < e->age;
+		e->poll = t->poll;
+		e->age = arr[i].age;
+		if (!fresh)
+			continue;
+
+		if (!e->probes || arr[i].rssi < e->rssi_min)
+			e->rssi_min = arr[i].rssi;
+		if (!e->probes || arr[i].rssi > e->rssi_max)
+			e->rssi_max = arr[i].rssi;
+		e->rssi_sum += arr[i].rssi;
+		e->probes++;
+		e->last_ms = t->now_ms;
+	}
+	return NL_SKIP;
+}
+
+static void iwlwav_probe_report(struct iwlwav_probe_table *t,
+				bool random_only,
+				unsigned long long start_ms)
+{
+	struct iwlwav_probe_entry *e;
+	int i, n_random = 0;
+
+	for (i = t->lru_head; i != IWLWAV_PROBE_NONE; i = e->lru_next) {
+		e = &t->entries[i];
+		if (e->addr[0] & 0x02)
+			n_random++;
+	}
+
+	printf("%d clients (%d randomized), %lu evicted, after %.1f s:\n",
+	       t->used, n_random, t->evicted,
+	       (t->now_ms - start_ms) / 1000.0);
+	printf("%-17s %6s %9s %9s %17s %s\n", "mac", "probes", "first",
+	       "last", "rssi min/avg/max", "");
+
+	/* the LRU order is also the order of last sighting */
+	for (i = t->lru_head; i != IWLWAV_PROBE_NONE; i = e->lru_next) {
+		bool random;
+
+		e = &t->entries[i];
+		random = e->addr[0] & 0x02;
+		if (random_only && !random)
+			continue;
+		printf("%02x:%02x:%02x:%02x:%02x:%02x %6lu %8.1fs %8.1fs %5d/%5.1f/%-5d %s\n",
+		       e->addr[0], e->addr[1], e->addr[2],
+		       e->addr[3], e->addr[4], e->addr[5], e->probes,
+		       (e->first_ms - start_ms) / 1000.0,
+		       (e->last_ms - start_ms) / 1000.0,
+		       e->rssi_min, (double)e->rssi_sum / e->probes,
+		       e->rssi_max, random ? "random" : "");
+	}
+	printf("\n");
+	fflush(stdout);
+}
+
+static int handle_iwlwav_probe_collect(struct nl80211_state *state,
+				       struct nl_msg *msg,
+				       int argc, char **argv,
+				       enum id_input id)
+{
+	struct iwlwav_probe_table *t = &iwlwav_probes;
+	struct nl80211_batch_req req = {};
+	unsigned long interval_ms = 1000, report = 10, count = 0, val, n;
+	unsigned long long start_ms;
+	const char *dev = argv[0];
+	bool random_only = false;
+	uint8_t flush_probe_list = 0;
+	int ifindex, err, i, used;
+	char *end;
+
+	/* we get the full command line, skip "<dev> iwlwav probe_collect" */
+	argc -= 3;
+	argv += 3;
+
+	memset(t, 0, sizeof(*t));
+	t->max = 256;
+	for (i = 0; i < argc; i++) {
+		if (!strcmp(argv[i], "--random")) {
+			random_only = true;
+			continue;
+		}
+		used = parse_interval_count(argc - i, argv + i, &interval_ms,
+					    &count);
+		if (used < 0)
+			return HANDLER_RET_USAGE;
+		if (used) {
+			i += used - 1;
+			continue;
+		}
+		if (i + 1 >= argc)
+			return HANDLER_RET_USAGE;
+		val = strtoul(argv[i + 1], &end, 10);
+		if (*end)
+			return HANDLER_RET_USAGE;
+		if (!strcmp(argv[i], "--report") && val)
+			report = val;
+		else if (!strcmp(argv[i], "--max") && val &&
+			 val <= IWLWAV_PROBE_MAX)
+			t->max = val;
+		else
+			return HANDLER_RET_USAGE;
+		i++;
+	}
+
+	ifindex = if_nametoindex(dev);
+	if (!ifindex)
+		return -errno;
+
+	for (i = 0; i < IWLWAV_PROBE_HASH; i++)
+		t->hash[i] = IWLWAV_PROBE_NONE;
+	t->lru_head = t->lru_tail = IWLWAV_PROBE_NONE;
+
+	req.msg = nl80211_batch_msg(state, NL80211_CMD_VENDOR, 0, ifindex);
+	if (!req.msg)
+		return -ENOMEM;
+	req.handler = iwlwav_probe_handler;
+	req.arg = t;
+	NLA_PUT_U32(req.msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ);
+	NLA_PUT_U32(req.msg, NL80211_ATTR_VENDOR_SUBCMD,
+		    LTQ_NL80211_VENDOR_SUBCMD_GET_LAST_PROBE_REQS);
+	NLA_PUT(req.msg, NL80211_ATTR_VENDOR_DATA, sizeof(flush_probe_list),
+		&flush_probe_list);
+
+	start_ms = now_ms();
+	for (n = 1; !count || n <= count; n++) {
+		t->poll = n;
+		t->now_ms = now_ms();
+		err = nl80211_batch(state, &req, 1, 0);
+		if (!err)
+			err = req.err;
+		if (err)
+			goto out;
+
+		if (n % report == 0 || n == count)
+			iwlwav_probe_report(t, random_only, start_ms);
+		if (!count || n < count)
+			usleep(interval_ms * 1000);
+	}
+	err = 0;
+	goto out;
+
+ nla_put_failure:
+	err = -ENOBUFS;
+ out:
+	nlmsg_free(req.msg);
+	return err;
+}
+COMMAND(iwlwav, probe_collect,
+	"[--interval <ms>] [--report <polls>] [--count <polls>] [--max <clients>] [--random]",
+	0, 0, CIB_NETDEV, handle_iwlwav_probe_collect,
+	"Poll the probe request list (every 1000 ms by default) and keep\n"
+	"per-client probe counts, first/last sighting and RSSI min/avg/max.\n"
+	"A summary is printed every <polls> polls (default 10). At most\n"
+	"<clients> clients are kept (default 256), the least recently seen\n"
+	"is dropped first. --random only lists locally administered\n"
+	"(randomized) addresses.");
+
+/***************************** ML DUMP *****************************/
+/*
+ * 'iwlwav ml dump' prints one record per (MLD station, link). The ML
+ * station and VAP lists are read first, then the link stats of every
+ * station and the nl80211 station info of every link are requested in
+ * one pipelined batch. ml_link_stats only carries the time spent on
+ * each link, so the TX/RX byte counters come from the station entry of
+ * the link address on the link's interface. With --interval the same
+ * is done repeatedly and rates are printed, plus a total per MLD.
+ */
+#define IWLWAV_ML_MAX_STA	128
+
+struct iwlwav_ml_link {
+	char ifname[IFNAMSIZ + 1];
+	uint8_t addr[ETH_ALEN];
+	uint16_t sid;
+	const struct ml_vap_list *vap;
+	bool have_bytes;
+	unsigned long long tx_bytes, rx_bytes;
+};
+
+struct iwlwav_ml_sta {
+	uint8_t mld_addr[ETH_ALEN];
+	uint16_t aid;
+	int n_links;
+	struct iwlwav_ml_link links[MLD_MAX_ACTIVE_LINKS];
+	bool have_stats;
+	struct ml_link_stats stats;
+};
+
+struct iwlwav_ml_dump {
+	struct iwlwav_ml_sta stas[IWLWAV_ML_MAX_STA];
+	int n_stas;
+	struct ml_vap_list vaps[MAX_NUM_MLD];
+	int n_vaps;
+};
+
+/* current and previous sample */
+static struct iwlwav_ml_dump iwlwav_ml[2];
+
+static int iwlwav_ml_sta_list_handler(struct nl_msg *msg, void *arg)
+{
+	struct iwlwav_ml_dump *md = arg;
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct mxl_ml_sta_list *ml_sta;
+	struct nlattr *attr;
+	int len, i, l;
+
+	attr = nla_find(genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0),
+			NL80211_ATTR_VENDOR_DATA);
+	if (!attr)
+		return NL_SKIP;
+
+	ml_sta = nla_data(attr);
+	len = nla_len(attr) / sizeof(*ml_sta);
+	for (i = 0; i < len && md->n_stas < IWLWAV_ML_MAX_STA; i++) {
+		struct iwlwav_ml_sta *s = &md->stas[md->n_stas++];
+
+		memset(s, 0, sizeof(*s));
+		memcpy(s->mld_addr, ml_sta[i].mld_addr, ETH_ALEN);
+		s->aid = ml_sta[i].aid;
+		s->n_links = ml_sta[i].is_single_link ? 1 : MLD_MAX_ACTIVE_LINKS;
+		for (l = 0; l < s->n_links; l++) {
+			memcpy(s->links[l].ifname, ml_sta[i].ifname[l], IFNAMSIZ);
+			memcpy(s->links[l].addr, ml_sta[i].sta_addr[l], ETH_ALEN);
+			s->links[l].sid = ml_sta[i].sid[l];
+		}
+	}
+	return NL_SKIP;
+}
+
+static int iwlwav_ml_vap_list_handler(struct nl_msg *msg, void *arg)
+{
+	struct iwlwav_ml_dump *md = arg;
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr *attr;
+	int len;
+
+	attr = nla_find(genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0),
+			NL80211_ATTR_VENDOR_DATA);
+	if (!attr)
+		return NL_SKIP;
+
+	len = nla_len(attr) / sizeof(md->vaps[0]);
+	if (len > MAX_NUM_MLD)
+		len = MAX_NUM_MLD;
+	memcpy(md->vaps, nla_data(attr), len * sizeof(md->vaps[0]));
+	md->n_vaps = len;
+	return NL_SKIP;
+}
+
+static int iwlwav_ml_link_stats_handler(struct nl_msg *msg, void *arg)
+{
+	struct iwlwav_ml_sta *s = arg;
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr *attr;
+
+	attr = nla_find(genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0),
+			NL80211_ATTR_VENDOR_DATA);
+	if (!attr || nla_len(attr) < (int)sizeof(s->stats))
+		return NL_SKIP;
+
+	memcpy(&s->stats, nla_data(attr), sizeof(s->stats));
+	s->have_stats = s->stats.main_band < MAX_TRI_BAND &&
+			s->stats.secondary_band < MAX_TRI_BAND;
+	return NL_SKIP;
+}
+
+static int iwlwav_ml_station_handler(struct nl_msg *msg, void *arg)
+{
+	struct iwlwav_ml_link *link = arg;
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct nlattr *sinfo[NL80211_STA_INFO_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+	if (!tb[NL80211_ATTR_STA_INFO] ||
+	    nla_parse_nested(sinfo, NL80211_STA_INFO_MAX,
+			     tb[NL80211_ATTR_STA_INFO], NULL))
+		return NL_SKIP;
+
+	if (sinfo[NL80211_STA_INFO_TX_BYTES64])
+		link->tx_bytes = nla_get_u64(sinfo[NL80211_STA_INFO_TX_BYTES64]);
+	else if (sinfo[NL80211_STA_INFO_TX_BYTES])
+		link->tx_bytes = nla_get_u32(sinfo[NL80211_STA_INFO_TX_BYTES]);
+	if (sinfo[NL80211_STA_INFO_RX_BYTES64])
+		link->rx_bytes = nla_get_u64(sinfo[NL80211_STA_INFO_RX_BYTES64]);
+	else if (sinfo[NL80211_STA_INFO_RX_BYTES])
+		link->rx_bytes = nla_get_u32(sinfo[NL80211_STA_INFO_RX_BYTES]);
+	link->have_bytes = true;
+	return NL_SKIP;
+}
+
+static int iwlwav_ml_fetch(struct nl80211_state *state, int ifindex,
+			   struct iwlwav_ml_dump *md)
+{
+	struct nl80211_batch_req lists[2] = {};
+	struct nl80211_batch_req *reqs;
+	int n = 0, err, i, l, v;
+
+	memset(md, 0, sizeof(*md));
+
+	for (i = 0; i < 2; i++) {
+		lists[i].msg = nl80211_batch_msg(state, NL80211_CMD_VENDOR, 0,
+						 ifindex);
+		if (!lists[i].msg) {
+			err = -ENOMEM;
+			goto out_lists;
+		}
+		lists[i].arg = md;
+		if (nla_put_u32(lists[i].msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ) ||
+		    nla_put_u32(lists[i].msg, NL80211_ATTR_VENDOR_SUBCMD, i ?
+				LTQ_NL80211_VENDOR_SUBCMD_GET_ML_VAP_LIST :
+				LTQ_NL80211_VENDOR_SUBCMD_GET_ML_STA_LIST)) {
+			err = -ENOBUFS;
+			goto out_lists;
+		}
+	}
+	lists[0].handler = iwlwav_ml_sta_list_handler;
+	lists[1].handler = iwlwav_ml_vap_list_handler;
+
+	err = nl80211_batch(state, lists, 2, 0);
+	if (!err)
+		err = lists[0].err;
+	if (err)
+		goto out_lists;
+	if (lists[1].err)
+		fprintf(stderr, "gMLVapList: %s\n", strerror(-lists[1].err));
+
+	/* link of a station -> VAP of its MLD, by interface name */
+	for (i = 0; i < md->n_stas; i++)
+		for (l = 0; l < md->stas[i].n_links; l++)
+			for (v = 0; v < md->n_vaps; v++) {
+				const struct ml_vap_list *vap = &md->vaps[v];
+				int k;
+
+				for (k = 0; k < MLD_MAX_ACTIVE_LINKS; k++)
+					if (!strncmp((const char *)vap->ifname[k],
+						     md->stas[i].links[l].ifname,
+						     IFNAMSIZ))
+						md->stas[i].links[l].vap = vap;
+			}
+
+	reqs = calloc(md->n_stas * (1 + MLD_MAX_ACTIVE_LINKS) + 1, sizeof(*reqs));
+	if (!reqs) {
+		err = -ENOMEM;
+		goto out_lists;
+	}
+
+	for (i = 0; i < md->n_stas; i++) {
+		struct iwlwav_ml_sta *s = &md->stas[i];
+		uint8_t aid = s->aid;
+
+		reqs[n].msg = nl80211_batch_msg(state, NL80211_CMD_VENDOR, 0,
+						ifindex);
+		if (!reqs[n].msg ||
+		    nla_put_u32(reqs[n].msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ) ||
+		    nla_put_u32(reqs[n].msg, NL80211_ATTR_VENDOR_SUBCMD,
+				LTQ_NL80211_VENDOR_SUBCMD_GET_ML_LINK_STATS) ||
+		    nla_put(reqs[n].msg, NL80211_ATTR_VENDOR_DATA,
+			    sizeof(aid), &aid)) {
+			n++;
+			err = -ENOBUFS;
+			goto out;
+		}
+		reqs[n].handler = iwlwav_ml_link_stats_handler;
+		reqs[n++].arg = s;
+
+		for (l = 0; l < s->n_links; l++) {
+			struct iwlwav_ml_link *link = &s->links[l];
+			int link_ifindex = if_nametoindex(link->ifname);
+
+			if (!link_ifindex)
+				continue;
+			reqs[n].msg = nl80211_batch_msg(state,
+							NL80211_CMD_GET_STATION,
+							0, link_ifindex);
+			if (!reqs[n].msg ||
+			    nla_put(reqs[n].msg, NL80211_ATTR_MAC, ETH_ALEN,
+				    link->addr)) {
+				n++;
+				err = -ENOBUFS;
+				goto out;
+			}
+			reqs[n].handler = iwlwav_ml_station_handler;
+			reqs[n++].arg = link;
+		}
+	}
+
+	err = nl80211_batch(state, reqs, n, 0);
+ out:
+	for (i = 0; i < n; i++)
+		nlmsg_free(reqs[i].msg);
+	free(reqs);
+ out_lists:
+	for (i = 0; i < 2; i++)
+		nlmsg_free(lists[i].msg);
+	return err;
+}
+
+static const struct iwlwav_ml_sta *
+iwlwav_ml_find(const struct iwlwav_ml_dump *md, const uint8_t *mld_addr)
+{
+	int i;
+
+	for (i = 0; i < md->n_stas; i++)
+		if (!memcmp(md->stas[i].mld_addr, mld_addr, ETH_ALEN))
+			return &md->stas[i];
+	return NULL;
+}
+
+static void iwlwav_ml_print(const struct iwlwav_ml_dump *md,
+			    const struct iwlwav_ml_dump *prev,
+			    unsigned long long ms)
+{
+	static const char *band[] = {"2.4Ghz", "5Ghz", "6Ghz"};
+	int i, l;
+
+	for (i = 0; i < md->n_stas; i++) {
+		const struct iwlwav_ml_sta *s = &md->stas[i];
+		const struct iwlwav_ml_sta *ps = NULL;
+		double tx_total = 0, rx_total = 0;
+		bool total = false;
+		char mld[20];
+
+		mac_addr_n2a(mld, s->mld_addr);
+		if (prev)
+			ps = iwlwav_ml_find(prev, s->mld_addr);
+
+		for (l = 0; l < s->n_links; l++) {
+			const struct iwlwav_ml_link *link = &s->links[l];
+			const struct iwlwav_ml_link *pl = ps ? &ps->links[l] : NULL;
+			char addr[20];
+
+			mac_addr_n2a(addr, link->addr);
+			printf("mld %s aid %d link%d %s sid %d on %s", mld, s->aid,
+			       l + 1, addr, link->sid, link->ifname);
+			if (link->vap)
+				printf(" (mld#%d \"%.32s\")", link->vap->mld_id,
+				       link->vap->ssid);
+			if (s->have_stats)
+				printf(" %s", band[l ? s->stats.secondary_band :
+						     s->stats.main_band]);
+
+			if (!prev) {
+				if (s->have_stats)
+					printf(" active %.1f s",
+					       s->stats.link_active_time[l] / 1000000.0);
+				if (link->have_bytes)
+					printf(" tx %llu rx %llu bytes",
+					       link->tx_bytes, link->rx_bytes);
+				printf("\n");
+				continue;
+			}
+
+			if (!ps || ps->n_links != s->n_links ||
+			    memcmp(pl->addr, link->addr, ETH_ALEN)) {
+				printf(" new\n");
+				continue;
+			}
+			if (s->have_stats && ps->have_stats && ms)
+				printf(" active %.1f%%",
+				       (uint32_t)(s->stats.link_active_time[l] -
+						  ps->stats.link_active_time[l]) /
+				       (ms * 10.0));
+			if (link->have_bytes && pl->have_bytes && ms &&
+			    link->tx_bytes >= pl->tx_bytes &&
+			    link->rx_bytes >= pl->rx_bytes) {
+				double tx = (link->tx_bytes - pl->tx_bytes) * 8.0 / ms;
+				double rx = (link->rx_bytes - pl->rx_bytes) * 8.0 / ms;
+
+				printf(" tx %.1f rx %.1f kbit/s", tx, rx);
+				tx_total += tx;
+				rx_total += rx;
+				total = true;
+			}
+			printf("\n");
+		}
+		if (total)
+			printf("mld %s total tx %.1f rx %.1f kbit/s\n", mld,
+			       tx_total, rx_total);
+	}
+}
+
+static int handle_iwlwav_ml(struct nl80211_state *state,
+			    struct nl_msg *msg,
+			    int argc, char **argv,
+			    enum id_input id)
+{
+	unsigned long interval_ms = 0, count = 0, n;
+	unsigned long long last_ms = 0, sample_ms;
+	int ifindex, err, cur = 0, i, used;
+	const char *dev = argv[0];
+
+	/* we get the full command line, skip "<dev> iwlwav ml" */
+	argc -= 3;
+	argv += 3;
+	if (argc < 1 || strcmp(argv[0], "dump"))
+		return HANDLER_RET_USAGE;
+
+	for (i = 1; i < argc; i += used) {
+		used = parse_interval_count(argc - i, argv + i, &interval_ms,
+					    &count);
+		if (used <= 0)
+			return HANDLER_RET_USAGE;
+	}
+	if (count && !interval_ms)
+		return HANDLER_RET_USAGE;
+
+	ifindex = if_nametoindex(dev);
+	if (!ifindex)
+		return -errno;
+
+	if (!interval_ms) {
+		err = iwlwav_ml_fetch(state, ifindex, &iwlwav_ml[0]);
+		if (!err)
+			iwlwav_ml_print(&iwlwav_ml[0], NULL, 0);
+		return err;
+	}
+
+	for (n = 0; !count || n <= count; n++) {
+		err = iwlwav_ml_fetch(state, ifindex, &iwlwav_ml[cur]);
+		if (err)
+			return err;
+		sample_ms = now_ms();
+		if (n > 0) {
+			printf("%llu ms:\n", sample_ms - last_ms);
+			iwlwav_ml_print(&iwlwav_ml[cur], &iwlwav_ml[!cur],
+					sample_ms - last_ms);
+			printf("\n");
+			fflush(stdout);
+		}
+		last_ms = sample_ms;
+		cur = !cur;
+
+		if (!count || n < count)
+			usleep(interval_ms * 1000);
+	}
+	return 0;
+}
+COMMAND(iwlwav, ml, "dump [--interval <ms> [--count <n>]]",
+	0, 0, CIB_NETDEV, handle_iwlwav_ml,
+	"Print the links of all ML stations with their VAP, band, active\n"
+	"time and TX/RX bytes. With --interval, print per-link rates and a\n"
+	"total per MLD every <ms> milliseconds.");
+
+/***************************** UNCONNECTED STA *****************************/
+/*
+ * 'iwlwav unconnected_sta' measures stations that are not associated,
+ * possibly on other channels: a GET_UNCONNECTED_STA request is sent for
+ * each (MAC, channel) target and the driver reports the result later
+ * in an UNCONNECTED_STA vendor event. At most --parallel requests are
+ * outstanding; a target whose event doesn't come within --timeout is
+ * given up. The events are read on a second socket that joins the
+ * vendor multicast group before the first request goes out, so that
+ * the replies on the command socket and the events don't get mixed.
+ * The events only carry the MAC address, so targets with the same MAC
+ * (on different channels) are never outstanding at the same time.
+ */
+#define IWLWAV_UNCONN_MAX	64
+
+enum iwlwav_unconn_state {
+	IWLWAV_UNCONN_IDLE,
+	IWLWAV_UNCONN_WAITING,
+	IWLWAV_UNCONN_DONE,
+	IWLWAV_UNCONN_TIMEOUT,
+	IWLWAV_UNCONN_FAILED,
+};
+
+struct iwlwav_unconn_target {
+	uint8_t addr[ETH_ALEN];
+	uint32_t freq, center_freq1;
+	enum iwlwav_unconn_state state;
+	int err;
+	unsigned long long sent_ms, deadline_ms, done_ms;
+	struct intel_vendor_unconnected_sta result;
+};
+
+struct iwlwav_unconn {
+	struct iwlwav_unconn_target targets[IWLWAV_UNCONN_MAX];
+	int n_targets;
+	int ifindex;
+	int waiting;
+};
+
+static struct iwlwav_unconn iwlwav_unconn;
+
+/* center of the aligned block of <width> MHz holding <freq> */
+static uint32_t iwlwav_unconn_center(uint32_t freq, int width)
+{
+	uint32_t base;
+
+	if (width <= 20)
+		return freq;
+	if (freq < 2500)
+		return freq <= 2442 ? freq + 10 : freq - 10;
+	if (freq >= 5955)
+		base = 5955;
+	else if (freq >= 5745)
+		base = 5745;
+	else
+		base = 5180;
+	return base + (freq - base) / width * width + width / 2 - 10;
+}
+
+static int iwlwav_unconn_event(struct nl_msg *msg, void *arg)
+{
+	struct iwlwav_unconn *u = arg;
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct intel_vendor_unconnected_sta res;
+	int i;
+
+	if (gnlh->cmd != NL80211_CMD_VENDOR)
+		return NL_SKIP;
+
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+	if (!tb[NL80211_ATTR_VENDOR_ID] || !tb[NL80211_ATTR_VENDOR_SUBCMD] ||
+	    !tb[NL80211_ATTR_VENDOR_DATA] ||
+	    nla_get_u32(tb[NL80211_ATTR_VENDOR_ID]) != OUI_LTQ ||
+	    nla_get_u32(tb[NL80211_ATTR_VENDOR_SUBCMD]) !=
+			LTQ_NL80211_VENDOR_EVENT_UNCONNECTED_STA)
+		return NL_SKIP;
+	if (tb[NL80211_ATTR_IFINDEX] &&
+	    (int)nla_get_u32(tb[NL80211_ATTR_IFINDEX]) != u->ifindex)
+		return NL_SKIP;
+	if (nla_len(tb[NL80211_ATTR_VENDOR_DATA]) < (int)sizeof(res))
+		return NL_SKIP;
+
+	memcpy(&res, nla_data(tb[NL80211_ATTR_VENDOR_DATA]), sizeof(res));
+	for (i = 0; i < u->n_targets; i++) {
+		struct iwlwav_unconn_target *t = &u->targets[i];
+
+		if (t->state != IWLWAV_UNCONN_WAITING ||
+		    memcmp(t->addr, res.addr, ETH_ALEN))
+			continue;
+		t->result = res;
+		t->state = IWLWAV_UNCONN_DONE;
+		t->done_ms = now_ms();
+		u->waiting--;
+		break;
+	}
+	return NL_SKIP;
+}
 
-	printf("\tdev <devname> iwlwav sFixedRateCfg <stationIndex> <isAutoRate> <bw> <phyMode> <nss> <mcs> <scp> <dcm> <heExtPartialBwData> <heExtPartialBwMng> <changeType>\n");
-	printf("\t\tSet fixed rate.\n\n");
+/* is a request for this MAC address still outstanding? */
+static bool iwlwav_unconn_busy(const struct iwlwav_unconn *u,
+			       const uint8_t *addr)
+{
+	int i;
 
-	printf("\tdev <devname> iwlwav sAllow3AddrMcast <3addr Flag 0/1>\n");
-	printf("\t\tAllow 3Address Multicast mode.\n\n");
+	for (i = 0; i < u->n_targets; i++)
+		if (u->targets[i].state == IWLWAV_UNCONN_WAITING &&
+		    !memcmp(u->targets[i].addr, addr, ETH_ALEN))
+			return true;
+	return false;
+}
 
-	printf("\tdev <devname> iwlwav sDoDebugAssert <assert type> [optional type]\n");
-	printf("\t\tAssert FW.\n\n");
+static int iwlwav_event_seq_check(struct nl_msg *msg, void *arg)
+{
+	return NL_OK;
+}
 
-	printf("\tdev <devname> iwlwav sMuStaRangeForGroupPerType <formation type> <minimum STAs> <maximum STAs>\n");
-	printf("\t\tSet Min and Max number of STAs for MU for formation type\n\n");
+static struct nl_sock *iwlwav_event_socket(void)
+{
+	struct nl_sock *sock;
+	int mcid;
 
-	printf("\tdev <devname> iwlwav sMLLinkStats <ml_aid>\n\n");
-	printf("\t\t Reset multilink link switch statistics\n");
+	sock = nl_socket_alloc();
+	if (!sock)
+		return NULL;
+	if (genl_connect(sock))
+		goto err;
 
-	printf("\tdev <devname> iwlwav sTIDlinkSpreading <enable:1|0> [<dynamic_mode:1|0> [<static tid split ratio>]]\n");
-	printf("\t\t TID to link spreading configuration for MLD STR clients\n\n");
+	mcid = nl_get_multicast_id(sock, "nl80211", "vendor");
+	if (mcid < 0 || nl_socket_add_membership(sock, mcid))
+		goto err;
 
-	printf("\tdev <devname> iwlwav svWtest <enable/disable>\n");
-	printf("\t\tSet Veriwave test mode.\n\n");
+	nl_socket_set_nonblocking(sock);
+	return sock;
+ err:
+	nl_socket_free(sock);
+	return NULL;
+}
 
-/*************************** DEBUG SET COMMANDS ****************************/
-#ifdef CONFIG_WAVE_DEBUG
-	printf("\tdev <devname> iwlwav sFixedRateThermal <enable/disable> <threshold> <power_reduction_amount>\n");
-	printf("\t\tSet fixed rate thermal.\n\n");
+static int iwlwav_unconn_send(struct nl80211_state *state,
+			      struct iwlwav_unconn *u,
+			      struct iwlwav_unconn_target *t, int width)
+{
+	struct intel_vendor_unconnected_sta_req_cfg cfg;
+	struct nl80211_batch_req req = {};
+	int err;
 
-	printf("\tdev <devname> iwlwav sCountersSrc <counter src>\n");
-	printf("\t\tSet switch counter src.\n\n");
+	memset(&cfg, 0, sizeof(cfg));
+	cfg.bandwidth = width;
+	cfg.freq = t->freq;
+	cfg.center_freq1 = t->center_freq1;
+	memcpy(cfg.addr, t->addr, ETH_ALEN);
+
+	req.msg = nl80211_batch_msg(state, NL80211_CMD_VENDOR, 0, u->ifindex);
+	if (!req.msg)
+		return -ENOMEM;
+	NLA_PUT_U32(req.msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ);
+	NLA_PUT_U32(req.msg, NL80211_ATTR_VENDOR_SUBCMD,
+		    LTQ_NL80211_VENDOR_SUBCMD_GET_UNCONNECTED_STA);
+	NLA_PUT(req.msg, NL80211_ATTR_VENDOR_DATA, sizeof(cfg), &cfg);
+
+	err = nl80211_batch(state, &req, 1, 0);
+	if (!err)
+		err = req.err;
+	nlmsg_free(req.msg);
+	return err;
+
+ nla_put_failure:
+	nlmsg_free(req.msg);
+	return -ENOBUFS;
+}
 
-	printf("\tdev <devname> iwlwav sUnconnTime <unconnected scan time>\n");
-	printf("\t\tSet unconnected STA scan time.\n\n");
+static void iwlwav_unconn_print(const struct iwlwav_unconn *u)
+{
+	static const char *states[] = {
+		[IWLWAV_UNCONN_IDLE] = "not sent",
+		[IWLWAV_UNCONN_WAITING] = "waiting",
+		[IWLWAV_UNCONN_DONE] = "ok",
+		[IWLWAV_UNCONN_TIMEOUT] = "timeout",
+		[IWLWAV_UNCONN_FAILED] = "failed",
+	};
+	int i, a;
+
+	printf("%-17s %5s %-8s %6s %-24s %-24s %8s %10s %6s\n", "mac", "freq",
+	       "result", "ms", "rssi", "noise", "packets", "bytes", "rate");
+	for (i = 0; i < u->n_targets; i++) {
+		const struct iwlwav_unconn_target *t = &u->targets[i];
+		const struct intel_vendor_unconnected_sta *r = &t->result;
+		char addr[20], rssi[32] = "", noise[32] = "";
+		int rl = 0, nl = 0;
+
+		mac_addr_n2a(addr, t->addr);
+		if (t->state != IWLWAV_UNCONN_DONE) {
+			printf("%-17s %5u %-8s", addr, t->freq, states[t->state]);
+			if (t->state == IWLWAV_UNCONN_FAILED)
+				printf(" %s", strerror(-t->err));
+			printf("\n");
+			continue;
+		}
 
-	printf("\tdev <devname> iwlwav sFixedPower <vapId> <stationId> <powerVal> <changeType>\n");
-	printf("\t\tSet fixed power.\n\n");
+		for (a = 0; a < WAVE_STAT_MAX_ANTENNAS; a++) {
+			rl += snprintf(rssi + rl, sizeof(rssi) - rl, "%s%d",
+				       a ? "," : "", r->rssi[a]);
+			nl += snprintf(noise + nl, sizeof(noise) - nl, "%s%d",
+				       a ? "," : "", r->noise[a]);
+		}
+		printf("%-17s %5u %-8s %6llu %-24s %-24s %8u %10llu %6u\n",
+		       addr, t->freq, states[t->state], t->done_ms - t->sent_ms,
+		       rssi, noise, r->rx_packets, r->rx_bytes, r->rate);
+	}
+}
 
-	printf("\tdev <devname> iwlwav sCpuDmaLatency <latency>\n");
-	printf("\t\tSet control CPU DMA Latency.\n\n");
+static int handle_iwlwav_unconnected_sta(struct nl80211_state *state,
+					 struct nl_msg *msg,
+					 int argc, char **argv,
+					 enum id_input id)
+{
+	struct iwlwav_unconn *u = &iwlwav_unconn;
+	unsigned long timeout_ms = 5000, parallel = 1, val;
+	int width = 20, next = 0, err = 0, i;
+	const char *dev = argv[0];
+	struct nl_sock *ev_sock;
+	struct nl_cb *cb;
+	char *end;
+
+	/* we get the full command line, skip "<dev> iwlwav unconnected_sta" */
+	argc -= 3;
+	argv += 3;
+
+	memset(u, 0, sizeof(*u));
+	for (i = 0; i < argc; i += 2) {
+		if (i + 1 >= argc)
+			return HANDLER_RET_USAGE;
+		val = strtoul(argv[i + 1], &end, 10);
+		if (!strcmp(argv[i], "--timeout")) {
+			if (*end || !val)
+				return HANDLER_RET_USAGE;
+			timeout_ms = val;
+		} else if (!strcmp(argv[i], "--parallel")) {
+			if (*end || !val)
+				return HANDLER_RET_USAGE;
+			parallel = val;
+		} else if (!strcmp(argv[i], "--bw")) {
+			if (*end || (val != 20 && val != 40 && val != 80 &&
+				     val != 160))
+				return HANDLER_RET_USAGE;
+			width = val;
+		} else {
+			struct iwlwav_unconn_target *t;
+
+			if (u->n_targets == IWLWAV_UNCONN_MAX || *end || !val)
+				return HANDLER_RET_USAGE;
+			t = &u->targets[u->n_targets++];
+			if (mac_addr_a2n(t->addr, argv[i]))
+				return HANDLER_RET_USAGE;
+			/* a channel number, or a frequency in MHz */
+			if (val < 1000)
+				val = ieee80211_channel_to_frequency(val,
+					val <= 14 ? NL80211_BAND_2GHZ :
+						    NL80211_BAND_5GHZ);
+			if (!val)
+				return HANDLER_RET_USAGE;
+			t->freq = val;
+		}
+	}
+	if (!u->n_targets)
+		return HANDLER_RET_USAGE;
+	for (i = 0; i < u->n_targets; i++)
+		u->targets[i].center_freq1 =
+			iwlwav_unconn_center(u->targets[i].freq, width);
+
+	u->ifindex = if_nametoindex(dev);
+	if (!u->ifindex)
+		return -errno;
+
+	ev_sock = iwlwav_event_socket();
+	if (!ev_sock) {
+		fprintf(stderr, "failed to listen for vendor events\n");
+		return -ENOLINK;
+	}
+	cb = nl_cb_alloc(iw_debug ? NL_CB_DEBUG : NL_CB_DEFAULT);
+	if (!cb) {
+		nl_socket_free(ev_sock);
+		return -ENOMEM;
+	}
+	/* no sequence checking for multicast messages */
+	nl_cb_set(cb, NL_CB_SEQ_CHECK, NL_CB_CUSTOM, iwlwav_event_seq_check, NULL);
+	nl_cb_set(cb, NL_CB_VALID, NL_CB_CUSTOM, iwlwav_unconn_event, u);
+
+	for (;;) {
+		struct pollfd pfd = {
+			.fd = nl_socket_get_fd(ev_sock),
+			.events = POLLIN,
+		};
+		unsigned long long now = now_ms(), wake = 0;
+
+		while (u->waiting < (int)parallel && next < u->n_targets &&
+		       !iwlwav_unconn_busy(u, u->targets[next].addr)) {
+			struct iwlwav_unconn_target *t = &u->targets[next++];
+
+			t->sent_ms = now_ms();
+			err = iwlwav_unconn_send(state, u, t, width);
+			if (err == -ENOMEM || err == -ENOBUFS)
+				goto out;
+			if (err) {
+				t->state = IWLWAV_UNCONN_FAILED;
+				t->err = err;
+				continue;
+			}
+			t->state = IWLWAV_UNCONN_WAITING;
+			t->deadline_ms = t->sent_ms + timeout_ms;
+			u->waiting++;
+		}
+		err = 0;
+
+		now = now_ms();
+		for (i = 0; i < u->n_targets; i++) {
+			struct iwlwav_unconn_target *t = &u->targets[i];
+
+			if (t->state != IWLWAV_UNCONN_WAITING)
+				continue;
+			if (t->deadline_ms <= now) {
+				t->state = IWLWAV_UNCONN_TIMEOUT;
+				u->waiting--;
+			} else if (!wake || t->deadline_ms < wake) {
+				wake = t->deadline_ms;
+			}
+		}
 
-	printf("\tdev <devname> iwlwav sTaskletLimits <data_txout_lim> <data_rx_lim> <bss_rx_lim> <bss_cfm_lim> <legacy_lim>\n");
-	printf("\t\tSet tasklet limits.\n\n");
+		if (!u->waiting) {
+			if (next == u->n_targets)
+				break;
+			continue;
+		}
 
-	printf("\tdev <devname> iwlwav sScanExpTime <exp time>\n");
-	printf("\t\tSet scan exp time.\n\n");
+		if (poll(&pfd, 1, wake - now) > 0)
+			nl_recvmsgs(ev_sock, cb);
+	}
 
-	printf("\tdev <devname> iwlwav sScanParams <passiveScanTime> <activeScanTime> <numProbeReqs> <probeReqInterval> <passiveScanValidTime> <activeScanValidTime>\n");
-	printf("\t\tSet scan parameters.\n\n");
+	iwlwav_unconn_print(u);
+ out:
+	nl_cb_put(cb);
+	nl_socket_free(ev_sock);
+	return err;
+}
+COMMAND(iwlwav, unconnected_sta,
+	"<MAC address> <channel|freq> [<MAC address> <channel|freq>...] [--bw <20|40|80|160>] [--parallel <n>] [--timeout <ms>]",
+	0, 0, CIB_NETDEV, handle_iwlwav_unconnected_sta,
+	"Measure the RSSI of stations that are not associated, on the given\n"
+	"channels. At most <n> requests (default 1) are outstanding, and a\n"
+	"station that isn't reported within <ms> (default 5000) is given up.");
+
+/***************************** ATF QUOTAS *****************************/
+/*
+ * 'iwlwav atf_quotas' builds the variable length SET_ATF_QUOTAS message
+ * from a policy file:
+ *
+ *	distr static		disabled, dynamic or static (or a number)
+ *	algo weighted		global or weighted
+ *	weighted station	station, station_ac or vap
+ *	interval 100000		in microseconds
+ *	free_time 0		in microseconds
+ *	scale 10000		the grants add up to this
+ *	default 0		weight of stations not listed
+ *	max_sta 128		ap_max_num_sta, default from gAPCapsMaxSTAs
+ *	sta <MAC> <weight>
+ *	vap <ifname> <weight>	split evenly among its stations
+ *
+ * The type names map to the order given in the driver header comments.
+ * The stations of the interface and of the listed VAPs are found with a
+ * station dump each, and their firmware station IDs with the station
+ * measurements, all in one batch. The grants are the weights scaled to
+ * 'scale', rounded so that they add up exactly. nof_sta is the radio's
+ * configured ap_max_num_sta, not the number of stations granted.
+ */
+#define IWLWAV_ATF_MAX_STA	256
+#define IWLWAV_ATF_MAX_VAP	16
+
+struct iwlwav_atf_vap {
+	char ifname[IFNAMSIZ];
+	int ifindex;
+	long weight;
+	int n_stas;
+};
 
-	printf("\tdev <devname> iwlwav sScanParamsBG <passiveScanTimeBG> <activeScanTimeBG> <numProbeReqsBG> <probeReqIntervalBG> "
-	       "<numChansInChunkBG> <chanChunkIntervalBG> <window_slice> <window_slice_overlap> <cts_to_self_duration>\n");
-	printf("\t\tSet scan parameters background.\n\n");
+struct iwlwav_atf_sta {
+	uint8_t addr[ETH_ALEN];
+	struct iwlwav_atf_vap *vap;
+	long weight;		/* -1: not listed */
+	bool have_sid;
+	uint16_t sid;
+	double share;
+	uint16_t grant;
+};
 
-	printf("\tdev <devname> iwlwav sTATimerRes <timer resolution>\n");
-	printf("\t\tSet TA timer resolution.\n\n");
+struct iwlwav_atf_policy {
+	struct intel_vendor_atf_quotas hdr;
+	unsigned long scale;
+	long default_weight;
+	unsigned long max_sta;	/* 0: ask the driver */
+	struct iwlwav_atf_vap vaps[IWLWAV_ATF_MAX_VAP];
+	int n_vaps;
+	struct iwlwav_atf_sta stas[IWLWAV_ATF_MAX_STA];
+	int n_stas;
+	/* 'sta' lines, until the stations are known */
+	struct iwlwav_atf_sta listed[IWLWAV_ATF_MAX_STA];
+	int n_listed;
+};
 
-	printf("\tdev <devname> iwlwav sPCoCAutoCfg <interval_low2high> <interval_high2low> <limit_lower> <limit_upper active_polling_timeout>\n");
-	printf("\t\tSet PCOC auto parameters.\n\n");
+static struct iwlwav_atf_policy iwlwav_atf;
 
-	printf("\tdev <devname> iwlwav sPCoCPower <enable mode>\n");
-	printf("\t\tSet PCOC power mode.\n\n");
+static int iwlwav_atf_keyword(const char *val, const char * const *names,
+			      int n_names)
+{
+	char *end;
+	long v;
+	int i;
 
-	printf("\tdev <devname> iwlwav sWDSHostTO <host timeput>\n");
-	printf("\t\tSet WDS host timeout.\n\n");
+	for (i = 0; i < n_names; i++)
+		if (!strcmp(val, names[i]))
+			return i;
+	v = strtol(val, &end, 0);
+	if (*end || v < 0 || v > 255)
+		return -1;
+	return v;
+}
 
-	printf("\tdev <devname> iwlwav sMACWdPeriodMs <period ms>\n");
-	printf("\t\tSet mac watchdog period ms.\n\n");
+static struct iwlwav_atf_vap *iwlwav_atf_add_vap(struct iwlwav_atf_policy *p,
+						 const char *ifname)
+{
+	struct iwlwav_atf_vap *vap;
+	int i;
 
-	printf("\tdev <devname> iwlwav sMACWdTimeoutMs <timeout ms>\n");
-	printf("\t\tSet mac watchdog timeout ms.\n\n");
+	for (i = 0; i < p->n_vaps; i++)
+		if (!strcmp(p->vaps[i].ifname, ifname))
+			return &p->vaps[i];
+	if (p->n_vaps == IWLWAV_ATF_MAX_VAP || strlen(ifname) >= IFNAMSIZ)
+		return NULL;
 
-	printf("\tdev <devname> iwlwav sNonOccupatePrd <non occupated period>\n");
-	printf("\t\tSet non occupated period.\n\n");
+	vap = &p->vaps[p->n_vaps++];
+	strcpy(vap->ifname, ifname);
+	vap->ifindex = if_nametoindex(ifname);
+	vap->weight = -1;
+	return vap;
+}
 
-	printf("\tdev <devname> iwlwav s11hBeaconCount <beacon count>\n");
-	printf("\t\tSet 11h beacon count.\n\n");
+static int iwlwav_atf_read(const char *file, struct iwlwav_atf_policy *p)
+{
+	static const char * const distr[] = { "disabled", "dynamic", "static" };
+	static const char * const algo[] = { "global", "weighted" };
+	static const char * const weighted[] = { "station", "station_ac", "vap" };
+	char line[256], key[32], arg1[64], arg2[32];
+	int lineno = 0, n, v;
+	FILE *f;
 
-	printf("\tdev <devname> iwlwav sEnableTestBus <enable/disable>\n");
-	printf("\t\tSet enable test bus.\n\n");
+	f = fopen(file, "r");
+	if (!f) {
+		fprintf(stderr, "%s: %s\n", file, strerror(errno));
+		return -errno;
+	}
 
-	printf("\tdev <devname> iwlwav sDoFwDebug <value>\n");
-	printf("\t\tSet FW debug.\n\n");
+	while (fgets(line, sizeof(line), f)) {
+		char *hash = strchr(line, '#'), *end;
+		long val;
+
+		lineno++;
+		if (hash)
+			*hash = '\0';
+		n = sscanf(line, "%31s %63s %31s", key, arg1, arg2);
+		if (n <= 0)
+			continue;
+		if (n < 2)
+			goto bad;
+
+		if (!strcmp(key, "distr") && n == 2) {
+			if ((v = iwlwav_atf_keyword(arg1, distr, ARRAY_SIZE(distr))) < 0)
+				goto bad;
+			p->hdr.distr_type = v;
+		} else if (!strcmp(key, "algo") && n == 2) {
+			if ((v = iwlwav_atf_keyword(arg1, algo, ARRAY_SIZE(algo))) < 0)
+				goto bad;
+			p->hdr.algo_type = v;
+		} else if (!strcmp(key, "weighted") && n == 2) {
+			if ((v = iwlwav_atf_keyword(arg1, weighted, ARRAY_SIZE(weighted))) < 0)
+				goto bad;
+			p->hdr.weighted_type = v;
+		} else if (n == 2) {
+			val = strtol(arg1, &end, 0);
+			if (*end || val < 0)
+				goto bad;
+			if (!strcmp(key, "interval"))
+				p->hdr.interval = val;
+			else if (!strcmp(key, "free_time"))
+				p->hdr.free_time = val;
+			else if (!strcmp(key, "scale") && val && val <= 0xffff)
+				p->scale = val;
+			else if (!strcmp(key, "default"))
+				p->default_weight = val;
+			else if (!strcmp(key, "max_sta") && val && val <= 0xffff)
+				p->max_sta = val;
+			else
+				goto bad;
+		} else {
+			val = strtol(arg2, &end, 0);
+			if (*end || val < 0)
+				goto bad;
+			if (!strcmp(key, "sta")) {
+				struct iwlwav_atf_sta *sta;
+
+				if (p->n_listed == IWLWAV_ATF_MAX_STA)
+					goto bad;
+				sta = &p->listed[p->n_listed++];
+				if (mac_addr_a2n(sta->addr, arg1))
+					goto bad;
+				sta->weight = val;
+			} else if (!strcmp(key, "vap")) {
+				struct iwlwav_atf_vap *vap = iwlwav_atf_add_vap(p, arg1);
+
+				if (!vap || !vap->ifindex)
+					goto bad;
+				vap->weight = val;
+			} else {
+				goto bad;
+			}
+		}
+	}
+	fclose(f);
+	return 0;
+ bad:
+	fprintf(stderr, "%s:%d: invalid line\n", file, lineno);
+	fclose(f);
+	return -EINVAL;
+}
 
-	printf("\tdev <devname> iwlwav sDoSimpleCLI <value>\n");
-	printf("\t\tSet debug CLI.\n\n");
+static int iwlwav_atf_dump_handler(struct nl_msg *msg, void *arg)
+{
+	struct iwlwav_atf_vap *vap = arg;
+	struct iwlwav_atf_policy *p = &iwlwav_atf;
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct iwlwav_atf_sta *sta;
 
-	printf("\tdev <devname> iwlwav sPMCUDebug <debug>\n");
-	printf("\t\tSet pmcu debug.\n\n");
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+	if (!tb[NL80211_ATTR_MAC] || p->n_stas == IWLWAV_ATF_MAX_STA)
+		return NL_SKIP;
 
-	printf("\tdev <devname> iwlwav sFwLogSeverity <newLevel> <targetCPU>\n");
-	printf("\t\tSet fw log severity.\n\n");
+	sta = &p->stas[p->n_stas++];
+	memset(sta, 0, sizeof(*sta));
+	memcpy(sta->addr, nla_data(tb[NL80211_ATTR_MAC]), ETH_ALEN);
+	sta->vap = vap;
+	sta->weight = -1;
+	vap->n_stas++;
+	return NL_SKIP;
+}
 
-	printf("\tdev <devname> iwlwav sDebugCmdFw <CMD ID> <param1 size> <param1 value> [param2 size] [param2 value] ...\n");
-	printf("\t\tManually compose any message to FW.\n\n");
+static int iwlwav_atf_sid_handler(struct nl_msg *msg, void *arg)
+{
+	struct iwlwav_atf_sta *sta = arg;
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct intel_vendor_sta_info info;
+	struct nlattr *attr;
 
-	printf("\tdev <devname> iwlwav sEnableRadarFiFoDump <enable_dump> [immediate] [dfs_band]\n");
-	printf("\t\tSet Radar Fifo Dump.\n\n");
-#endif
+	attr = nla_find(genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0),
+			NL80211_ATTR_VENDOR_DATA);
+	if (!attr || nla_len(attr) < (int)sizeof(info))
+		return NL_SKIP;
+
+	memcpy(&info, nla_data(attr), sizeof(info));
+	sta->sid = info.StationId;
+	sta->have_sid = true;
+	return NL_SKIP;
+}
+
+static int iwlwav_atf_max_sta_handler(struct nl_msg *msg, void *arg)
+{
+	struct iwlwav_atf_policy *p = arg;
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr *attr;
+	uint32_t val;
+
+	attr = nla_find(genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0),
+			NL80211_ATTR_VENDOR_DATA);
+	if (!attr || nla_len(attr) < (int)sizeof(val))
+		return NL_SKIP;
+
+	memcpy(&val, nla_data(attr), sizeof(val));
+	p->max_sta = val;
+	return NL_SKIP;
+}
+
+static int iwlwav_atf_resolve(struct nl80211_state *state,
+			      struct iwlwav_atf_policy *p)
+{
+	struct nl80211_batch_req reqs[IWLWAV_ATF_MAX_STA] = {};
+	const struct iwlwav_cmd *caps = NULL;
+	int i, n, err;
+
+	for (i = 0; i < p->n_vaps; i++) {
+		reqs[i].msg = nl80211_batch_msg(state, NL80211_CMD_GET_STATION,
+						NLM_F_DUMP, p->vaps[i].ifindex);
+		reqs[i].handler = iwlwav_atf_dump_handler;
+		reqs[i].arg = &p->vaps[i];
+	}
+	n = p->n_vaps;
+	if (!p->max_sta) {
+		caps = iwlwav_cmd_find("gAPCapsMaxSTAs");
+		reqs[n].msg = nl80211_batch_msg(state, NL80211_CMD_VENDOR, 0,
+						p->vaps[0].ifindex);
+		if (reqs[n].msg && iwlwav_cmd_put(caps, reqs[n].msg, 0, NULL)) {
+			nlmsg_free(reqs[n].msg);
+			reqs[n].msg = NULL;
+		}
+		reqs[n].handler = iwlwav_atf_max_sta_handler;
+		reqs[n].arg = p;
+		n++;
+	}
+	err = nl80211_batch(state, reqs, n, 0);
+	for (i = 0; !err && i < p->n_vaps; i++)
+		if (reqs[i].err) {
+			fprintf(stderr, "%s: station dump: %s\n",
+				p->vaps[i].ifname, strerror(-reqs[i].err));
+			err = 2;
+		}
+	if (!err && caps && (reqs[p->n_vaps].err || !p->max_sta ||
+			     p->max_sta > 0xffff)) {
+		fprintf(stderr, "%s: no ap_max_num_sta, add a max_sta line\n",
+			caps->name);
+		err = 2;
+	}
+	for (i = 0; i < n; i++) {
+		nlmsg_free(reqs[i].msg);
+		reqs[i].msg = NULL;
+	}
+	if (err)
+		return err;
+
+	for (i = 0; i < p->n_stas; i++) {
+		struct iwlwav_atf_sta *sta = &p->stas[i];
+
+		reqs[i].msg = nl80211_batch_msg(state, NL80211_CMD_VENDOR, 0,
+						sta->vap->ifindex);
+		reqs[i].handler = iwlwav_atf_sid_handler;
+		reqs[i].arg = sta;
+		if (reqs[i].msg &&
+		    (nla_put_u32(reqs[i].msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ) ||
+		     nla_put_u32(reqs[i].msg, NL80211_ATTR_VENDOR_SUBCMD,
+				 LTQ_NL80211_VENDOR_SUBCMD_GET_STA_MEASUREMENTS) ||
+		     nla_put(reqs[i].msg, NL80211_ATTR_VENDOR_DATA, ETH_ALEN,
+			     sta->addr))) {
+			nlmsg_free(reqs[i].msg);
+			reqs[i].msg = NULL;
+		}
+	}
+	err = nl80211_batch(state, reqs, p->n_stas, 16);
+	for (i = 0; i < p->n_stas; i++)
+		nlmsg_free(reqs[i].msg);
+	return err;
+}
+
+/* station weights -> grants that add up to p->scale */
+static void iwlwav_atf_grants(struct iwlwav_atf_policy *p)
+{
+	double total = 0;
+	unsigned long sum = 0;
+	int i, j;
+
+	for (i = 0; i < p->n_stas; i++) {
+		struct iwlwav_atf_sta *sta = &p->stas[i];
+		double w = p->default_weight;
+
+		for (j = 0; j < p->n_listed; j++)
+			if (!memcmp(p->listed[j].addr, sta->addr, ETH_ALEN))
+				sta->weight = p->listed[j].weight;
+		if (sta->weight >= 0)
+			w = sta->weight;
+		else if (sta->vap->weight >= 0)
+			w = (double)sta->vap->weight / sta->vap->n_stas;
+		if (!sta->have_sid)
+			w = 0;
+		sta->share = w;
+		total += w;
+	}
+
+	for (i = 0; i < p->n_stas; i++) {
+		struct iwlwav_atf_sta *sta = &p->stas[i];
+
+		sta->share = total ? sta->share * p->scale / total : 0;
+		sta->grant = sta->share;
+		sum += sta->grant;
+	}
+
+	/* largest remainders get the rest */
+	while (total && sum < p->scale) {
+		struct iwlwav_atf_sta *best = NULL;
+
+		for (i = 0; i < p->n_stas; i++) {
+			struct iwlwav_atf_sta *sta = &p->stas[i];
+
+			if (sta->share - sta->grant <= 0)
+				continue;
+			if (!best || sta->share - sta->grant >
+				     best->share - best->grant)
+				best = sta;
+		}
+		if (!best)
+			break;
+		best->grant++;
+		best->share = best->grant;
+		sum++;
+	}
+}
+
+static int handle_iwlwav_atf_quotas(struct nl80211_state *state,
+				    struct nl_msg *msg,
+				    int argc, char **argv,
+				    enum id_input id)
+{
+	struct iwlwav_atf_policy *p = &iwlwav_atf;
+	struct intel_vendor_atf_quotas *q = NULL;
+	struct nl80211_batch_req req = {};
+	const char *dev = argv[0];
+	bool dry_run = false;
+	int ifindex, n_grants = 0, len, err, i;
+
+	/* we get the full command line, skip "<dev> iwlwav atf_quotas" */
+	argc -= 3;
+	argv += 3;
+
+	if (argc == 2 && !strcmp(argv[1], "--dry-run"))
+		dry_run = true;
+	else if (argc != 1)
+		return HANDLER_RET_USAGE;
+
+	ifindex = if_nametoindex(dev);
+	if (!ifindex)
+		return -errno;
+
+	memset(p, 0, sizeof(*p));
+	p->scale = 10000;
+	if (!iwlwav_atf_add_vap(p, dev))
+		return -EINVAL;
+	err = iwlwav_atf_read(argv[0], p);
+	if (err)
+		return 2;
+
+	err = iwlwav_atf_resolve(state, p);
+	if (err)
+		return err;
+	iwlwav_atf_grants(p);
+
+	for (i = 0; i < p->n_listed; i++) {
+		char addr[20];
+		int j;
+
+		for (j = 0; j < p->n_stas; j++)
+			if (!memcmp(p->listed[i].addr, p->stas[j].addr, ETH_ALEN))
+				break;
+		if (j < p->n_stas)
+			continue;
+		mac_addr_n2a(addr, p->listed[i].addr);
+		fprintf(stderr, "%s: not associated, ignored\n", addr);
+	}
+
+	for (i = 0; i < p->n_stas; i++)
+		if (p->stas[i].grant)
+			n_grants++;
+	/* sta_grant[] is sized by nof_sta on the driver side */
+	if (n_grants > (int)p->max_sta) {
+		fprintf(stderr, "%d grants, but ap_max_num_sta is %lu\n",
+			n_grants, p->max_sta);
+		return 2;
+	}
+
+	len = sizeof(*q) + n_grants * sizeof(q->sta_grant[0]);
+	q = calloc(1, len);
+	if (!q)
+		return -ENOMEM;
+	*q = p->hdr;
+	q->nof_bss = p->n_vaps;
+	q->nof_sta = p->max_sta;
+	q->nof_grants = n_grants;
+	q->data_len = n_grants * sizeof(q->sta_grant[0]);
+
+	printf("%-17s %-10s %5s %8s %6s\n", "mac", "vap", "sid", "weight", "grant");
+	for (i = 0, n_grants = 0; i < p->n_stas; i++) {
+		struct iwlwav_atf_sta *sta = &p->stas[i];
+		char addr[20];
+
+		mac_addr_n2a(addr, sta->addr);
+		if (!sta->have_sid) {
+			printf("%-17s %-10s %5s %8s %6s\n", addr, sta->vap->ifname,
+			       "?", "-", "-");
+			continue;
+		}
+		printf("%-17s %-10s %5u %8ld %6u\n", addr, sta->vap->ifname,
+		       sta->sid, sta->weight >= 0 ? sta->weight :
+		       sta->vap->weight >= 0 ? sta->vap->weight : p->default_weight,
+		       sta->grant);
+		if (!sta->grant)
+			continue;
+		q->sta_grant[n_grants].sid = sta->sid;
+		q->sta_grant[n_grants++].grant = sta->grant;
+	}
+
+	if (dry_run) {
+		printf("\n%d bytes, %u grants:\n", len, q->nof_grants);
+		iw_hexdump("atf", (const __u8 *)q, len);
+		err = 0;
+		goto out;
+	}
+
+	req.msg = nl80211_batch_msg(state, NL80211_CMD_VENDOR, 0, ifindex);
+	if (!req.msg) {
+		err = -ENOMEM;
+		goto out;
+	}
+	NLA_PUT_U32(req.msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ);
+	NLA_PUT_U32(req.msg, NL80211_ATTR_VENDOR_SUBCMD,
+		    LTQ_NL80211_VENDOR_SUBCMD_SET_ATF_QUOTAS);
+	NLA_PUT(req.msg, NL80211_ATTR_VENDOR_DATA, len, q);
+
+	err = nl80211_batch(state, &req, 1, 0);
+	if (!err)
+		err = req.err;
+	goto out;
+
+ nla_put_failure:
+	err = -ENOBUFS;
+ out:
+	nlmsg_free(req.msg);
+	free(q);
+	return err;
+}
+COMMAND(iwlwav, atf_quotas, "<policy file> [--dry-run]",
+	0, 0, CIB_NETDEV, handle_iwlwav_atf_quotas,
+	"Compute airtime fairness grants from a policy file with per-station\n"
+	"or per-VAP weights and send them; --dry-run prints the grants and a\n"
+	"hexdump of the message instead.");
+
+/***************************** STEERING *****************************/
+/*
+ * Client steering and blocking. 'iwlwav steer' sends STA_STEER for one
+ * client. 'iwlwav block_list' applies a file of deny list changes in
+ * one batch:
+ *
+ *	deny <MAC> [<snr hwm> <snr lwm> [<status>]]	entry added
+ *	allow <MAC>					entry removed
+ *
+ * vendor_cmds_copy.h doesn't say which structure SET_DENY_MAC or
+ * SET_SOFTBLOCK_THRESHOLDS take. Both are sent a blacklist_cfg, the only
+ * structure with a remove flag and the probe SNR watermarks, so a line
+ * can only set what that structure has: the address, remove, the
+ * watermarks and the status. There is no separate soft-block keyword;
+ * whether the driver soft-blocks a deny entry that has watermarks is
+ * up to the driver. 'iwlwav sb_monitor' counts the SOFTBLOCK_DROP events
+ * per client and message type.
+ */
+static int iwlwav_vendor_send(struct nl80211_state *state, int ifindex,
+			      enum ltq_nl80211_vendor_subcmds subcmd,
+			      const void *data, int len,
+			      struct nl80211_batch_req *req)
+{
+	req->msg = nl80211_batch_msg(state, NL80211_CMD_VENDOR, 0, ifindex);
+	if (!req->msg)
+		return -ENOMEM;
+	NLA_PUT_U32(req->msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ);
+	NLA_PUT_U32(req->msg, NL80211_ATTR_VENDOR_SUBCMD, subcmd);
+	NLA_PUT(req->msg, NL80211_ATTR_VENDOR_DATA, len, data);
+	return 0;
+
+ nla_put_failure:
+	nlmsg_free(req->msg);
+	req->msg = NULL;
+	return -ENOBUFS;
+}
+
+static int iwlwav_vendor_set(struct nl80211_state *state, const char *dev,
+			     enum ltq_nl80211_vendor_subcmds subcmd,
+			     const void *data, int len)
+{
+	struct nl80211_batch_req req = {};
+	int ifindex, err;
+
+	ifindex = if_nametoindex(dev);
+	if (!ifindex)
+		return -errno;
+
+	err = iwlwav_vendor_send(state, ifindex, subcmd, data, len, &req);
+	if (err)
+		return err;
+	err = nl80211_batch(state, &req, 1, 0);
+	if (!err)
+		err = req.err;
+	nlmsg_free(req.msg);
+	return err;
+}
+
+static int iwlwav_parse_u8(const char *arg, uint8_t *val)
+{
+	char *end;
+	unsigned long v = strtoul(arg, &end, 0);
+
+	if (*end || v > 255)
+		return -EINVAL;
+	*val = v;
+	return 0;
+}
+
+static int iwlwav_parse_u16(const char *arg, uint16_t *val)
+{
+	char *end;
+	unsigned long v = strtoul(arg, &end, 0);
+
+	if (!*arg || *end || v > 0xffff)
+		return -EINVAL;
+	*val = v;
+	return 0;
+}
+
+static int handle_iwlwav_steer(struct nl80211_state *state,
+			       struct nl_msg *msg,
+			       int argc, char **argv,
+			       enum id_input id)
+{
+	struct intel_vendor_steer_cfg cfg;
+	uint16_t status = 0;
+
+	/* we get the full command line, skip "<dev> iwlwav steer" */
+	if (argc < 5 || argc > 6)
+		return HANDLER_RET_USAGE;
+
+	memset(&cfg, 0, sizeof(cfg));
+	if (mac_addr_a2n(cfg.addr, argv[3]) || mac_addr_a2n(cfg.bssid, argv[4]))
+		return HANDLER_RET_USAGE;
+	if (argc == 6 && iwlwav_parse_u16(argv[5], &status))
+		return HANDLER_RET_USAGE;
+	cfg.status = status;
+
+	return iwlwav_vendor_set(state, argv[0],
+				 LTQ_NL80211_VENDOR_SUBCMD_STA_STEER,
+				 &cfg, sizeof(cfg));
+}
+COMMAND(iwlwav, steer, "<MAC address> <target BSSID> [<status>]",
+	0, 0, CIB_NETDEV, handle_iwlwav_steer,
+	"Steer a client to another BSS; <status> is the BTM status code.");
+
+static int handle_iwlwav_sb_thresholds(struct nl80211_state *state,
+				       struct nl_msg *msg,
+				       int argc, char **argv,
+				       enum id_input id)
+{
+	struct intel_vendor_blacklist_cfg cfg;
+
+	/* we get the full command line, skip "<dev> iwlwav sb_thresholds" */
+	if (argc != 6)
+		return HANDLER_RET_USAGE;
+
+	memset(&cfg, 0, sizeof(cfg));
+	if (mac_addr_a2n(cfg.addr, argv[3]) ||
+	    iwlwav_parse_u8(argv[4], &cfg.snrProbeHWM) ||
+	    iwlwav_parse_u8(argv[5], &cfg.snrProbeLWM) ||
+	    cfg.snrProbeLWM > cfg.snrProbeHWM)
+		return HANDLER_RET_USAGE;
+
+	return iwlwav_vendor_set(state, argv[0],
+				 LTQ_NL80211_VENDOR_SUBCMD_SET_SOFTBLOCK_THRESHOLDS,
+				 &cfg, sizeof(cfg));
+}
+COMMAND(iwlwav, sb_thresholds, "<MAC address> <snr hwm> <snr lwm>",
+	0, 0, CIB_NETDEV, handle_iwlwav_sb_thresholds,
+	"Set the probe SNR high and low watermarks (dB) of a soft-blocked client.\n"
+	"They are sent as a blacklist_cfg, as for block_list.");
+
+#define IWLWAV_BLOCK_MAX	512
+
+struct iwlwav_block_entry {
+	int line;
+	const char *what;
+	struct intel_vendor_blacklist_cfg cfg;
+};
+
+static int handle_iwlwav_block_list(struct nl80211_state *state,
+				    struct nl_msg *msg,
+				    int argc, char **argv,
+				    enum id_input id)
+{
+	static struct iwlwav_block_entry es[IWLWAV_BLOCK_MAX];
+	static struct nl80211_batch_req reqs[IWLWAV_BLOCK_MAX];
+	char line[256], key[16], mac[32], hwm[8], lwm[8], status[8];
+	int ifindex, n = 0, lineno = 0, failed = 0, err = 0, i, k;
+	const char *dev = argv[0], *file;
+	uint16_t sb_status;
+	bool dry_run = false;
+	FILE *f;
+
+	/* we get the full command line, skip "<dev> iwlwav block_list" */
+	argc -= 3;
+	argv += 3;
+	if (argc == 2 && !strcmp(argv[1], "--dry-run"))
+		dry_run = true;
+	else if (argc != 1)
+		return HANDLER_RET_USAGE;
+	file = argv[0];
+
+	ifindex = if_nametoindex(dev);
+	if (!ifindex)
+		return -errno;
+
+	f = fopen(file, "r");
+	if (!f) {
+		fprintf(stderr, "%s: %s\n", file, strerror(errno));
+		return 2;
+	}
+
+	memset(es, 0, sizeof(es));
+	while (fgets(line, sizeof(line), f)) {
+		struct iwlwav_block_entry *e = &es[n];
+		char *hash = strchr(line, '#');
+
+		lineno++;
+		if (hash)
+			*hash = '\0';
+		k = sscanf(line, "%15s %31s %7s %7s %7s", key, mac, hwm, lwm,
+			   status);
+		if (k <= 0)
+			continue;
+		if (n == IWLWAV_BLOCK_MAX || k < 2)
+			goto bad;
+		e->line = lineno;
+		e->what = !strcmp(key, "deny") ? "deny" :
+			  !strcmp(key, "allow") ? "allow" : NULL;
+		if (!e->what || mac_addr_a2n(e->cfg.addr, mac))
+			goto bad;
+
+		if (!strcmp(key, "allow")) {
+			if (k != 2)
+				goto bad;
+			e->cfg.remove = 1;
+		} else if (k > 2) {
+			if (k < 4 ||
+			    iwlwav_parse_u8(hwm, &e->cfg.snrProbeHWM) ||
+			    iwlwav_parse_u8(lwm, &e->cfg.snrProbeLWM) ||
+			    e->cfg.snrProbeLWM > e->cfg.snrProbeHWM)
+				goto bad;
+			if (k == 5) {
+				if (iwlwav_parse_u16(status, &sb_status))
+					goto bad;
+				e->cfg.status = sb_status;
+			}
+		}
+		n++;
+	}
+	fclose(f);
+
+	if (dry_run) {
+		for (i = 0; i < n; i++) {
+			char prefix[32];
+
+			snprintf(prefix, sizeof(prefix), "%d %s", es[i].line,
+				 es[i].what);
+			iw_hexdump(prefix, (const __u8 *)&es[i].cfg,
+				   sizeof(es[i].cfg));
+		}
+		return 0;
+	}
+
+	memset(reqs, 0, sizeof(reqs));
+	for (i = 0; i < n; i++) {
+		err = iwlwav_vendor_send(state, ifindex,
+					 LTQ_NL80211_VENDOR_SUBCMD_SET_DENY_MAC,
+					 &es[i].cfg, sizeof(es[i].cfg),
+					 &reqs[i]);
+		if (err)
+			goto out;
+	}
+
+	err = nl80211_batch(state, reqs, n, 16);
+	if (err)
+		goto out;
+	for (i = 0; i < n; i++) {
+		if (!reqs[i].err)
+			continue;
+		fprintf(stderr, "%s:%d: %s: %s%s%s\n", file, es[i].line,
+			es[i].what, strerror(-reqs[i].err),
+			reqs[i].ext_msg[0] ? " - " : "", reqs[i].ext_msg);
+		failed++;
+	}
+	printf("%d entries applied, %d failed\n", n - failed, failed);
+	err = failed ? 2 : 0;
+ out:
+	for (i = 0; i < n; i++)
+		nlmsg_free(reqs[i].msg);
+	return err;
+ bad:
+	fprintf(stderr, "%s:%d: invalid line\n", file, lineno);
+	fclose(f);
+	return 2;
+}
+COMMAND(iwlwav, block_list, "<file> [--dry-run]",
+	0, 0, CIB_NETDEV, handle_iwlwav_block_list,
+	"Apply deny list changes from a file with lines\n"
+	"'deny <MAC> [<snr hwm> <snr lwm> [<status>]]' and 'allow <MAC>';\n"
+	"--dry-run prints the messages instead.");
+
+#define IWLWAV_SB_MAX		256
+
+struct iwlwav_sb_count {
+	uint8_t addr[ETH_ALEN];
+	uint8_t msgtype;
+	unsigned long drops, blocked, rejected, broadcast;
+	unsigned long snr_sum;
+};
+
+struct iwlwav_sb_monitor {
+	struct iwlwav_sb_count counts[IWLWAV_SB_MAX];
+	int n;
+	unsigned long lost;
+	int ifindex;
+};
+
+static struct iwlwav_sb_monitor iwlwav_sb;
+
+static const char *iwlwav_sb_msgtype(uint8_t type, char *buf, int len)
+{
+	/* management frame subtypes */
+	switch (type) {
+	case 0:
+		return "assoc";
+	case 4:
+		return "probe";
+	case 11:
+		return "auth";
+	}
+	snprintf(buf, len, "type %u", type);
+	return buf;
+}
+
+static int iwlwav_sb_event(struct nl_msg *msg, void *arg)
+{
+	struct iwlwav_sb_monitor *m = arg;
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct intel_vendor_event_msg_drop ev;
+	struct iwlwav_sb_count *c = NULL;
+	int i;
+
+	if (gnlh->cmd != NL80211_CMD_VENDOR)
+		return NL_SKIP;
+
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+	if (!tb[NL80211_ATTR_VENDOR_ID] || !tb[NL80211_ATTR_VENDOR_SUBCMD] ||
+	    !tb[NL80211_ATTR_VENDOR_DATA] ||
+	    nla_get_u32(tb[NL80211_ATTR_VENDOR_ID]) != OUI_LTQ ||
+	    nla_get_u32(tb[NL80211_ATTR_VENDOR_SUBCMD]) !=
+			LTQ_NL80211_VENDOR_EVENT_SOFTBLOCK_DROP)
+		return NL_SKIP;
+	if (m->ifindex && tb[NL80211_ATTR_IFINDEX] &&
+	    (int)nla_get_u32(tb[NL80211_ATTR_IFINDEX]) != m->ifindex)
+		return NL_SKIP;
+	if (nla_len(tb[NL80211_ATTR_VENDOR_DATA]) < (int)sizeof(ev))
+		return NL_SKIP;
+	memcpy(&ev, nla_data(tb[NL80211_ATTR_VENDOR_DATA]), sizeof(ev));
+
+	for (i = 0; i < m->n; i++)
+		if (m->counts[i].msgtype == ev.msgtype &&
+		    !memcmp(m->counts[i].addr, ev.addr, ETH_ALEN))
+			c = &m->counts[i];
+	if (!c) {
+		if (m->n == IWLWAV_SB_MAX) {
+			m->lost++;
+			return NL_SKIP;
+		}
+		c = &m->counts[m->n++];
+		memcpy(c->addr, ev.addr, ETH_ALEN);
+		c->msgtype = ev.msgtype;
+	}
+
+	c->drops++;
+	c->blocked += !!ev.blocked;
+	c->rejected += !!ev.rejected;
+	c->broadcast += !!ev.broadcast;
+	c->snr_sum += ev.rx_snr;
+	return NL_SKIP;
+}
+
+static void iwlwav_sb_print(const struct iwlwav_sb_monitor *m)
+{
+	int i;
+
+	printf("%-17s %-8s %8s %8s %8s %8s %7s\n", "client", "message",
+	       "drops", "blocked", "rejected", "bcast", "snr");
+	for (i = 0; i < m->n; i++) {
+		const struct iwlwav_sb_count *c = &m->counts[i];
+		char addr[20], type[16];
+
+		mac_addr_n2a(addr, c->addr);
+		printf("%-17s %-8s %8lu %8lu %8lu %8lu %7.1f\n", addr,
+		       iwlwav_sb_msgtype(c->msgtype, type, sizeof(type)),
+		       c->drops, c->blocked, c->rejected, c->broadcast,
+		       (double)c->snr_sum / c->drops);
+	}
+	if (m->lost)
+		printf("%lu events of further clients not counted\n", m->lost);
+	printf("\n");
+	fflush(stdout);
+}
+
+static int handle_iwlwav_sb_monitor(struct nl80211_state *state,
+				    struct nl_msg *msg,
+				    int argc, char **argv,
+				    enum id_input id)
+{
+	struct iwlwav_sb_monitor *m = &iwlwav_sb;
+	unsigned long interval_ms = 10000, count = 0, n = 0;
+	unsigned long long next_ms, sample_ms;
+	struct nl_sock *ev_sock;
+	struct nl_cb *cb;
+	int i, used;
+
+	/* we get the full command line, skip "<dev> iwlwav sb_monitor" */
+	memset(m, 0, sizeof(*m));
+	m->ifindex = if_nametoindex(argv[0]);
+	if (!m->ifindex)
+		return -errno;
+	argc -= 3;
+	argv += 3;
+
+	for (i = 0; i < argc; i += used) {
+		used = parse_interval_count(argc - i, argv + i, &interval_ms,
+					    &count);
+		if (used <= 0)
+			return HANDLER_RET_USAGE;
+	}
+
+	ev_sock = iwlwav_event_socket();
+	if (!ev_sock) {
+		fprintf(stderr, "failed to listen for vendor events\n");
+		return -ENOLINK;
+	}
+	cb = nl_cb_alloc(iw_debug ? NL_CB_DEBUG : NL_CB_DEFAULT);
+	if (!cb) {
+		nl_socket_free(ev_sock);
+		return -ENOMEM;
+	}
+	/* no sequence checking for multicast messages */
+	nl_cb_set(cb, NL_CB_SEQ_CHECK, NL_CB_CUSTOM, iwlwav_event_seq_check, NULL);
+	nl_cb_set(cb, NL_CB_VALID, NL_CB_CUSTOM, iwlwav_sb_event, m);
+
+	next_ms = now_ms() + interval_ms;
+	while (!count || n < count) {
+		struct pollfd pfd = {
+			.fd = nl_socket_get_fd(ev_sock),
+			.events = POLLIN,
+		};
+
+		sample_ms = now_ms();
+		if (sample_ms >= next_ms) {
+			iwlwav_sb_print(m);
+			next_ms += interval_ms;
+			n++;
+			continue;
+		}
+		if (poll(&pfd, 1, next_ms - sample_ms) > 0)
+			nl_recvmsgs(ev_sock, cb);
+	}
+
+	nl_cb_put(cb);
+	nl_socket_free(ev_sock);
+	return 0;
+}
+COMMAND(iwlwav, sb_monitor, "[--interval <ms>] [--count <n>]",
+	0, 0, CIB_NETDEV, handle_iwlwav_sb_monitor,
+	"Count soft-block drop events per client and message type, printing\n"
+	"the totals every <ms> milliseconds (default 10000), <n> times.");
+
+/***************************** HELP FUNCTION *****************************/
+
+static int handle_iwlwav_help(struct nl80211_state *state,
+			      struct nl_msg *msg, int argc,
+			      char **argv, enum id_input id)
+{
+	printf("\tdev <devname> iwlwav s11hEmulatRadar <unused_param> [<radar bit map>] [<dfs band>]");
+	printf("\t\tSet emulate radar detection.\n\n");
+	printf("\t\t<radar bit map> should be between 0x1 to 0xFF\n\n");
+	printf("\t\t<dfs band> = ZWDFS ZWDFS_Band\n\n");
+
+	printf("\tdev <devname> iwlwav sFourAddrMode <4addr mode>\n");
+	printf("\t\tSet 4addr mode.\n\n");
+
+	printf("\tdev <devname> iwlwav sMuStatPlanCfg <19 to 170 params> <...>\n");
+	printf("\t\tSet mu stat plan cfg.\n\n");
+
+	printf("\tdev <devname> iwlwav sWdsWepEncCfg <key_id> <wds wep key>\n");
+	printf("\t\tSet wds wep key.\n\n");
+
+#ifdef WAVE_ENABLE_PIE
+	printf("\tdev <devname> iwlwav sPIEcfg <param_1> <..> <param_n>\n");
+	printf("\t\tSet PIE configuration.\n\n");
+#endif /* WAVE_ENABLE_PIE */
+
+	printf("\tdev <devname> iwlwav sEnableCsiEngine <Station MAC Addr> <br-lan MAC Addr> <Enable Flag>\n");
+	printf("\t\tSet Enable CSI Engine.\n\n");
+
+	printf("\tdev <devname> iwlwav sCsi <Station MAC Addr> <br-lan MAC Addr> <Enable Flag> <CSI Sampling Rate>\n");
+	printf("\t\tSet CSI Auto Configuration .\n\n");
+
+	printf("\tdev <devname> iwlwav sMLLinkStats <ml_aid>\n\n");
+	printf("\t\t Reset multilink link switch statistics\n");
 
-	printf("\tdev <devname> iwlwav sStartCcaMsr <channel> <dwellTimeMs>\n");
-	printf("\t\tStarts a CCA (Clear Channel Assessment) scan for a given interface and the given channel using a specific dwell time.\n\n");
-
-	printf("\tdev <devname> iwlwav g11hRadarDetect\n\n");
-	printf("\tdev <devname> iwlwav g11hChCheckTime\n\n");
-	printf("\tdev <devname> iwlwav gPeerAPkeyIdx\n\n");
-	printf("\tdev <devname> iwlwav gPeerAPs\n\n");
-	printf("\tdev <devname> iwlwav gBridgeMode\n\n");
-	printf("\tdev <devname> iwlwav gReliableMcast\n\n");
-	printf("\tdev <devname> iwlwav gAPforwarding\n\n");
-	printf("\tdev <devname> iwlwav gEEPROM\n\n");
-
-	printf("\tdev <devname> iwlwav gDataPathMode\n");
-	printf("\t\tGet actual datapath mode for a specified device\n\n");
-
-	printf("\tdev <devname> iwlwav gLtPathEnabled\n\n");
-	printf("\tdev <devname> iwlwav gIpxPpaEnabled\n\n");
-	printf("\tdev <devname> iwlwav gCoCPower\n\n");
-	printf("\tdev <devname> iwlwav gCoCAutoCfg\n\n");
-	printf("\tdev <devname> iwlwav gTpcLoopType\n\n");
-	printf("\tdev <devname> iwlwav gInterfDetThresh\n\n");
-	printf("\tdev <devname> iwlwav gAPCapsMaxSTAs\n\n");
-	printf("\tdev <devname> iwlwav gAPCapsMaxVAPs\n\n");
-	printf("\tdev <devname> iwlwav g11bAntSelection\n\n");
-	printf("\tdev <devname> iwlwav gFWRecovery\n\n");
-	printf("\tdev <devname> iwlwav gFWRecoveryStat\n\n");
-	printf("\tdev <devname> iwlwav gEnableRadio\n\n");
-	printf("\tdev <devname> iwlwav gAggrConfig\n\n");
-	printf("\tdev <devname> iwlwav gNumMsduInAmsdu\n\n");
-	printf("\tdev <devname> iwlwav gAggRateLimit\n\n");
-	printf("\tdev <devname> iwlwav gMuOfdmaBf\n\n");
-	printf("\tdev <devname> iwlwav gAvailAdmCap\n\n");
-	printf("\tdev <devname> iwlwav gSetRxTH\n\n");
-	printf("\tdev <devname> iwlwav gRxDutyCyc\n\n");
-	printf("\tdev <devname> iwlwav gPowerSelection\n\n");
-	printf("\tdev <devname> iwlwav g11nProtection\n\n");
-	printf("\tdev <devname> iwlwav gTemperature\n\n");
-	printf("\tdev <devname> iwlwav gQAMplus\n\n");
-	printf("\tdev <devname> iwlwav gAcsUpdateTo\n\n");
-	printf("\tdev <devname> iwlwav gMuOperation\n\n");
-	printf("\tdev <devname> iwlwav gCcaTh\n\n");
-	printf("\tdev <devname> iwlwav gCcaAdapt\n\n");
-	printf("\tdev <devname> iwlwav gRadarRssiTh\n\n");
-	printf("\tdev <devname> iwlwav gFilsBeaconFlag\n\n");
-	printf("\tdev <devname> iwlwav gRTSmode\n\n");
-	printf("\tdev <devname> iwlwav gMaxMpduLen\n\n");
-	printf("\tdev <devname> iwlwav gBfMode\n\n");
-	printf("\tdev <devname> iwlwav gProbeReqCltMode\n\n");
-	printf("\tdev <devname> iwlwav gActiveAntMask\n\n");
-	printf("\tdev <devname> iwlwav gFourAddrStas\n\n");
-	printf("\tdev <devname> iwlwav gTxopConfig\n\n");
-	printf("\tdev <devname> iwlwav gSsbMode\n\n");
-	printf("\tdev <devname> iwlwav gMcastRange\n\n");
-	printf("\tdev <devname> iwlwav gMcastRange6\n\n");
-	printf("\tdev <devname> iwlwav gOnlineACM\n\n");
-	printf("\tdev <devname> iwlwav gAlgoCalibrMask\n\n");
-	printf("\tdev <devname> iwlwav gRestrictAcMode\n\n");
-	printf("\tdev <devname> iwlwav gPdThresh\n\n");
-	printf("\tdev <devname> iwlwav gFastDrop\n\n");
-	printf("\tdev <devname> iwlwav gPVT\n\n");
-	printf("\tdev <devname> iwlwav gRtsRate\n\n");
 #ifdef WAVE_ENABLE_PIE
-	printf("\tdev <devname> iwlwav gPIEcfg\n\n");
 	printf("\tdev <devname> iwlwav gAqmEn\n\n");
 #endif /* WAVE_ENABLE_PIE */
-	printf("\tdev <devname> iwlwav gStationsStat\n\n");
-	printf("\tdev <devname> iwlwav gStatsPollPeriod\n\n");
-	printf("\tdev <devname> iwlwav gDynamicMu\n\n");
-	printf("\tdev <devname> iwlwav gMuFixedCfg\n\n");
-	printf("\tdev <devname> iwlwav gMuDurationCfg\n\n");
-	printf("\tdev <devname> iwlwav gIBpowerPerAnt\n\n");
 	printf("\tdev <devname> iwlwav gTwtParams <station mac address>\n\n");
-	printf("\tdev <devname> iwlwav gAxDefaultParams\n\n");
-	printf("\tdev <devname> iwlwav gETSILimitation\n\n");
-	printf("\tdev <devname> iwlwav gRtsThreshold\n\n");
-	printf("\tdev <devname> iwlwav gTxRetryLimit\n\n");
-	printf("\tdev <devname> iwlwav gCtsToSelfTo\n\n");
 	printf("\tdev <devname> iwlwav gGetCcaMsr <channel>\n\n");
-	printf("\tdev <devname> iwlwav gGetCcaStats\n\n");
-	printf("\tdev <devname> iwlwav sPreamPunCcaOvr\n\n");
-	printf("\tdev <devname> iwlwav gPreamPunCcaOvr\n\n");
 
 	printf("\tdev <devname> iwlwav gRadioUsageStats\n");
 	printf("\t\tGet Current Channel statistics\n\n");
 
-	printf("\tdev <devname> iwlwav gSlowProbingMask\n\n");
-	printf("\tdev <devname> iwlwav gScanModifFlags\n\n");
-	printf("\tdev <devname> iwlwav gScanPauseBGCache\n\n");
-	printf("\tdev <devname> iwlwav gZwdfsAnt\n\n");
 	printf("\tdev <devname> iwlwav gAdvertiseBcTwtSp\n\n");
-	printf("\tdev <devname> iwlwav gConfigMRCoex\n\n");
-	printf("\tdev <devname> iwlwav gFixedLtfGi\n\n");
-	printf("\tdev <devname> iwlwav gTxExceRetryLimit\n\n");
-	printf("\tdev <devname> iwlwav gMgmtFramePwrCtrl\n\n");
 	printf("\tdev <devname> iwlwav gEnableCsiEngine <station mac address>\n\n");
 	printf("\tdev <devname> iwlwav gCsi <station mac address>\n\n");
-	printf("\tdev <devname> iwlwav gAllow3AddrMcast\n\n");
 	printf("\tdev <devname> iwlwav gMuStaRangeForGroupPerType\n\n");
 	printf("\tdev <devname> iwlwav gMLLinkStats <ml_aid>\n\n");
 	printf("\tdev <devname> iwlwav gMLStaList\n\n");
 	printf("\tdev <devname> iwlwav gMaxTxPower\n\n");
 
-/*************************** DEBUG GET COMMANDS ****************************/
-#ifdef CONFIG_WAVE_DEBUG
-	printf("\tdev <devname> iwlwav gFixedRateThermal\n\n");
-	printf("\tdev <devname> iwlwav sMtlkLogLevel <oid:0-31> <level:0-2> <mode:1-3>\n \
-			\t\t set mtlk debug level oid: e.g. 8(mtlk) 6(tools) level: e.g. 1(level one) mode:e.g. (1)cdebug\n\n");
-	printf("\tdev <devname> iwlwav gCountersSrc\n\n");
-	printf("\tdev <devname> iwlwav gUnconnTime\n\n");
-	printf("\tdev <devname> iwlwav gFixedPower\n\n");
-	printf("\tdev <devname> iwlwav gCpuDmaLatency\n\n");
-	printf("\tdev <devname> iwlwav gBfExplicitCap\n\n");
-	printf("\tdev <devname> iwlwav gTaskletLimits\n\n");
-	printf("\tdev <devname> iwlwav gGenlFamilyId\n\n");
-	printf("\tdev <devname> iwlwav gScanExpTime\n\n");
-	printf("\tdev <devname> iwlwav gScanParams\n\n");
-	printf("\tdev <devname> iwlwav gScanParamsBG\n\n");
-	printf("\tdev <devname> iwlwav gTADbg\n\n");
-	printf("\tdev <devname> iwlwav gTATimerRes\n\n");
-	printf("\tdev <devname> iwlwav gPCoCAutoCfg\n\n");
-	printf("\tdev <devname> iwlwav gPCoCPower\n\n");\
-	printf("\tdev <devname> iwlwav gWDSHostTO\n\n");
-	printf("\tdev <devname> iwlwav gMACWdPeriodMs\n\n");
-	printf("\tdev <devname> iwlwav gMACWdTimeoutMs\n\n");
-	printf("\tdev <devname> iwlwav gNonOccupatePrd\n\n");
-	printf("\tdev <devname> iwlwav g11hBeaconCount\n\n");
-#endif
-
+	printf("\tdev <devname> iwlwav snapshot\n");
+	printf("\t\tPrint the values of all integer getters.\n\n");
+	printf("\tdev <devname> iwlwav diff <snapshot file>\n");
+	printf("\t\tCompare a snapshot with the current values.\n\n");
+	printf("\tdev <devname> iwlwav apply <snapshot file> [--dry-run]\n");
+	printf("\t\tSet the values of a snapshot that differ.\n\n");
+	printf("\tdev <devname> iwlwav watch <getter> [<args>] --interval <ms> [--count <n>]\n");
+	printf("\t\tPoll a getter, showing counter rates and gauge min/avg/max.\n\n");
+	printf("\tdev <devname> iwlwav cca_sweep [<channel>...] [--dwell <ms>] [--timeout <ms>] [--repeat <n>]\n");
+	printf("\t\tMeasure CCA on each channel and print them sorted, quietest first.\n\n");
+	printf("\tdev <devname> iwlwav probe_collect [--interval <ms>] [--report <polls>] [--count <polls>] [--max <clients>] [--random]\n");
+	printf("\t\tCollect probe requests per client over time.\n\n");
+	printf("\tdev <devname> iwlwav ml dump [--interval <ms> [--count <n>]]\n");
+	printf("\t\tPrint per-link info of all ML stations, or per-link rates.\n\n");
+	printf("\tdev <devname> iwlwav unconnected_sta <MAC address> <channel|freq> [...] [--bw <20|40|80|160>] [--parallel <n>] [--timeout <ms>]\n");
+	printf("\t\tMeasure stations that are not associated.\n\n");
+	printf("\tdev <devname> iwlwav atf_quotas <policy file> [--dry-run]\n");
+	printf("\t\tSet airtime fairness grants from per-station or per-VAP weights.\n\n");
+	printf("\tdev <devname> iwlwav steer <MAC address> <target BSSID> [<status>]\n");
+	printf("\t\tSteer a client to another BSS.\n\n");
+	printf("\tdev <devname> iwlwav sb_thresholds <MAC address> <snr hwm> <snr lwm>\n");
+	printf("\t\tSet the soft-block probe SNR watermarks of a client.\n\n");
+	printf("\tdev <devname> iwlwav block_list <file> [--dry-run]\n");
+	printf("\t\tApply deny list changes from a file.\n\n");
+	printf("\tdev <devname> iwlwav sb_monitor [--interval <ms>] [--count <n>]\n");
+	printf("\t\tCount soft-block drops per client and message type.\n\n");
+
+	iwlwav_cmd_help();
 	return 0;
 }
 COMMAND(iwlwav, help, "", 0, 0, CIB_NETDEV, handle_iwlwav_help, "");
@@ -21,6 +21,28 @@ struct link_result {
 
 static struct link_result lr = { .link_found = false };
 
+/*
+ * State for the fast path: the interface info tells us whether we are
+ * a connected client (SSID and frequency), and the station dump of a
+ * client interface only holds the AP (plus TDLS peers), so neither cost
+ * depends on the size of the scan cache.
+ */
+struct link_iface_result {
+	char dev[IF_NAMESIZE];
+	uint32_t iftype;
+	bool iftype_valid;
+	bool mlo;
+	uint8_t ssid[32];
+	int ssid_len;
+	uint32_t freq;
+	uint32_t freq_offset;
+	uint8_t ap_addr[ETH_ALEN];
+	int n_sta;
+	bool ap_found;
+};
+
+static struct link_iface_result lir;
+
 static int link_bss_handler(struct nl_msg *msg, void *arg)
 {
 	struct nlattr *tb[NL80211_ATTR_MAX + 1];
@@ -150,6 +172,110 @@ static int handle_scan_for_link(struct nl80211_state *state,
 	return 0;
 }
 
+static int link_iface_handler(struct nl_msg *msg, void *arg)
+{
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct link_iface_result *result = arg;
+
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+
+	if (tb[NL80211_ATTR_IFNAME])
+		snprintf(result->dev, sizeof(result->dev), "%s",
+			 nla_get_string(tb[NL80211_ATTR_IFNAME]));
+
+	if (tb[NL80211_ATTR_IFTYPE]) {
+		result->iftype = nla_get_u32(tb[NL80211_ATTR_IFTYPE]);
+		result->iftype_valid = true;
+	}
+
+	if (tb[NL80211_ATTR_MLO_LINKS])
+		result->mlo = true;
+
+	if (tb[NL80211_ATTR_SSID] &&
+	    nla_len(tb[NL80211_ATTR_SSID]) <= (int)sizeof(result->ssid)) {
+		result->ssid_len = nla_len(tb[NL80211_ATTR_SSID]);
+		memcpy(result->ssid, nla_data(tb[NL80211_ATTR_SSID]),
+		       result->ssid_len);
+	}
+
+	if (tb[NL80211_ATTR_WIPHY_FREQ])
+		result->freq = nla_get_u32(tb[NL80211_ATTR_WIPHY_FREQ]);
+	if (tb[NL80211_ATTR_WIPHY_FREQ_OFFSET])
+		result->freq_offset = nla_get_u32(tb[NL80211_ATTR_WIPHY_FREQ_OFFSET]);
+
+	return NL_SKIP;
+}
+
+static int handle_iface_for_link(struct nl80211_state *state,
+				 struct nl_msg *msg,
+				 int argc, char **argv,
+				 enum id_input id)
+{
+	if (argc > 0)
+		return 1;
+
+	register_handler(link_iface_handler, &lir);
+	return 0;
+}
+
+static int link_ap_handler(struct nl_msg *msg, void *arg)
+{
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr *sinfo[NL80211_STA_INFO_MAX + 1];
+	static struct nla_policy stats_policy[NL80211_STA_INFO_MAX + 1] = {
+		[NL80211_STA_INFO_STA_FLAGS] =
+			{ .minlen = sizeof(struct nl80211_sta_flag_update) },
+	};
+	struct link_iface_result *result = arg;
+	struct nl80211_sta_flag_update *sta_flags;
+	uint32_t assoc = BIT(NL80211_STA_FLAG_ASSOCIATED);
+	uint32_t tdls = BIT(NL80211_STA_FLAG_TDLS_PEER);
+
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+
+	if (!tb[NL80211_ATTR_MAC] || !tb[NL80211_ATTR_STA_INFO])
+		return NL_SKIP;
+
+	result->n_sta++;
+
+	if (result->ap_found)
+		return NL_SKIP;
+
+	if (nla_parse_nested(sinfo, NL80211_STA_INFO_MAX,
+			     tb[NL80211_ATTR_STA_INFO],
+			     stats_policy))
+		return NL_SKIP;
+
+	if (!sinfo[NL80211_STA_INFO_STA_FLAGS])
+		return NL_SKIP;
+
+	sta_flags = nla_data(sinfo[NL80211_STA_INFO_STA_FLAGS]);
+	if ((sta_flags->mask & tdls) && (sta_flags->set & tdls))
+		return NL_SKIP;
+	if (!(sta_flags->mask & assoc) || !(sta_flags->set & assoc))
+		return NL_SKIP;
+
+	memcpy(result->ap_addr, nla_data(tb[NL80211_ATTR_MAC]), ETH_ALEN);
+	result->ap_found = true;
+	return NL_SKIP;
+}
+
+static int handle_ap_for_link(struct nl80211_state *state,
+			      struct nl_msg *msg,
+			      int argc, char **argv,
+			      enum id_input id)
+{
+	if (argc > 0)
+		return 1;
+
+	register_handler(link_ap_handler, &lir);
+	return 0;
+}
+
 static int print_link_sta(struct nl_msg *msg, void *arg)
 {
 	struct nlattr *tb[NL80211_ATTR_MAX + 1];
@@ -296,6 +422,51 @@ static int handle_link(struct nl80211_state *state,
 	int err;
 
 	link_argv[0] = argv[0];
+	station_argv[0] = argv[0];
+
+	/*
+	 * Fast path for (non-MLO) client interfaces; anything else, e.g.
+	 * IBSS or authenticated-but-not-associated, needs the BSS status
+	 * from the full scan dump below.
+	 */
+	link_argv[2] = "get_iface";
+	err = handle_cmd(state, id, 3, link_argv);
+
+	if (!err && lir.iftype_valid && !lir.mlo &&
+	    (lir.iftype == NL80211_IFTYPE_STATION ||
+	     lir.iftype == NL80211_IFTYPE_P2P_CLIENT)) {
+		/*
+		 * Drivers without dump_station reject the station dump
+		 * (-EOPNOTSUPP), leave those to the scan dump below.
+		 */
+		link_argv[2] = "get_ap";
+		err = handle_cmd(state, id, 3, link_argv);
+
+		if (!err && !lir.n_sta) {
+			printf("Not connected.\n");
+			return 0;
+		}
+
+		if (!err && lir.ap_found && lir.ssid_len) {
+			uint8_t ssid_ie[2 + sizeof(lir.ssid)];
+
+			mac_addr_n2a(addr_buf, lir.ap_addr);
+			printf("Connected to %s (on %s)\n", addr_buf, lir.dev);
+
+			ssid_ie[0] = 0; /* SSID */
+			ssid_ie[1] = lir.ssid_len;
+			memcpy(ssid_ie + 2, lir.ssid, lir.ssid_len);
+			print_ies(ssid_ie, 2 + lir.ssid_len, false, PRINT_LINK);
+
+			if (lir.freq)
+				printf("\tfreq: %d.%d\n", lir.freq, lir.freq_offset);
+
+			station_argv[3] = addr_buf;
+			return handle_cmd(state, id, 4, station_argv);
+		}
+	}
+
+	link_argv[2] = "get_bss";
 	err = handle_cmd(state, id, 3, link_argv);
 	if (err)
 		return err;
@@ -312,7 +483,6 @@ static int handle_link(struct nl80211_state *state,
 	if (lr.mld)
 		printf("MLD %s stats:\n", addr_buf);
 
-	station_argv[0] = argv[0];
 	station_argv[3] = addr_buf;
 	return handle_cmd(state, id, 4, station_argv);
 }
@@ -322,3 +492,7 @@ HIDDEN(link, get_sta, "<mac-addr>", NL80211_CMD_GET_STATION, 0,
 	CIB_NETDEV, handle_link_sta);
 HIDDEN(link, get_bss, NULL, NL80211_CMD_GET_SCAN, NLM_F_DUMP,
 	CIB_NETDEV, handle_scan_for_link);
+HIDDEN(link, get_iface, NULL, NL80211_CMD_GET_INTERFACE, 0,
+	CIB_NETDEV, handle_iface_for_link);
+HIDDEN(link, get_ap, NULL, NL80211_CMD_GET_STATION, NLM_F_DUMP,
+	CIB_NETDEV, handle_ap_for_link);
@@ -6,6 +6,8 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <time.h>
+#include <net/if.h>
 
 #include <netlink/genl/genl.h>
 #include <netlink/genl/family.h>
@@ -847,19 +849,25 @@ COMMAND(set, txq, "limit <packets> | memory_limit <bytes> | quantum <bytes>",
 	"for the whole phy. The quantum is the DRR scheduler quantum setting.\n"
 	"Valid values: 1 - 2**32");
 
+static struct nla_policy txqstats_policy[NL80211_TXQ_STATS_MAX + 1] = {
+	[NL80211_TXQ_STATS_BACKLOG_BYTES] = { .type = NLA_U32 },
+	[NL80211_TXQ_STATS_BACKLOG_PACKETS] = { .type = NLA_U32 },
+	[NL80211_TXQ_STATS_FLOWS] = { .type = NLA_U32 },
+	[NL80211_TXQ_STATS_DROPS] = { .type = NLA_U32 },
+	[NL80211_TXQ_STATS_ECN_MARKS] = { .type = NLA_U32 },
+	[NL80211_TXQ_STATS_OVERLIMIT] = { .type = NLA_U32 },
+	[NL80211_TXQ_STATS_OVERMEMORY] = { .type = NLA_U32 },
+	[NL80211_TXQ_STATS_COLLISIONS] = { .type = NLA_U32 },
+	[NL80211_TXQ_STATS_TX_BYTES] = { .type = NLA_U32 },
+	[NL80211_TXQ_STATS_TX_PACKETS] = { .type = NLA_U32 },
+	[NL80211_TXQ_STATS_MAX_FLOWS] = { .type = NLA_U32 },
+};
+
 static int print_txq_handler(struct nl_msg *msg, void *arg)
 {
 	struct nlattr *attrs[NL80211_ATTR_MAX + 1];
 	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
 	struct nlattr *txqstats_info[NL80211_TXQ_STATS_MAX + 1], *txqinfo;
-	static struct nla_policy txqstats_policy[NL80211_TXQ_STATS_MAX + 1] = {
-		[NL80211_TXQ_STATS_BACKLOG_PACKETS] = { .type = NLA_U32 },
-		[NL80211_TXQ_STATS_BACKLOG_BYTES] = { .type = NLA_U32 },
-		[NL80211_TXQ_STATS_OVERLIMIT] = { .type = NLA_U32 },
-		[NL80211_TXQ_STATS_OVERMEMORY] = { .type = NLA_U32 },
-		[NL80211_TXQ_STATS_COLLISIONS] = { .type = NLA_U32 },
-		[NL80211_TXQ_STATS_MAX_FLOWS] = { .type = NLA_U32 },
-	};
 
 	nla_parse(attrs, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
 		  genlmsg_attrlen(gnlh, 0), NULL);
@@ -918,9 +926,522 @@ static int handle_get_txq(struct nl80211_state *state,
 	register_handler(print_txq_handler, NULL);
 	return 0;
 }
-COMMAND(get, txq, "",
+/*
+ * TXQ watch: sample the wiphy TXQ statistics and the per-TID TXQ
+ * statistics of every station on the phy's interfaces at a fixed
+ * interval, and print what happened in between: drops, ECN marks,
+ * overlimits and backlog, and which TIDs and stations the drops came
+ * from. The counters are 32 bits and subtracted modulo 2^32; a queue
+ * seen for the first time only gives a baseline. The backlog is only
+ * sampled once per interval, so its maximum is kept over the whole run
+ * rather than pretending to be a per-interval peak.
+ */
+#define TXQ_WATCH_HASH_SIZE	256
+#define TXQ_WATCH_MAX_IFACES	16
+#define TXQ_WATCH_TOP		5
+
+struct txq_counters {
+	uint32_t backlog_bytes, backlog_packets;
+	uint32_t drops, ecn_marks, overlimit, overmemory, collisions;
+	uint32_t tx_packets;
+};
+
+struct txq_queue {
+	struct txq_queue *next;
+	int ifindex;
+	unsigned char addr[ETH_ALEN];
+	int tid;
+	struct txq_counters c, d;	/* last sample, last interval */
+	uint32_t max_backlog;	/* over all samples */
+	bool seen, have_delta;
+};
+
+struct txq_watch {
+	unsigned long interval_ms, count;
+	int top;
+	int wiphy;
+	int ifindex[TXQ_WATCH_MAX_IFACES];
+	int n_ifaces;
+
+	/* the wiphy queues as a whole */
+	struct txq_counters phy, phy_d;
+	uint32_t phy_max_backlog;	/* over all samples */
+	bool phy_seen, phy_have_delta;
+
+	struct txq_queue *hash[TXQ_WATCH_HASH_SIZE];
+};
+
+static struct txq_watch txq_watch;
+
+static void txq_counters_get(struct nlattr *attr, struct txq_counters *c)
+{
+	struct nlattr *tb[NL80211_TXQ_STATS_MAX + 1];
+
+	memset(c, 0, sizeof(*c));
+	if (nla_parse_nested(tb, NL80211_TXQ_STATS_MAX, attr, txqstats_policy))
+		return;
+
+#define GET_U32(field, attr)						\
+	if (tb[NL80211_TXQ_STATS_ ## attr])				\
+		c->field = nla_get_u32(tb[NL80211_TXQ_STATS_ ## attr])
+
+	GET_U32(backlog_bytes, BACKLOG_BYTES);
+	GET_U32(backlog_packets, BACKLOG_PACKETS);
+	GET_U32(drops, DROPS);
+	GET_U32(ecn_marks, ECN_MARKS);
+	GET_U32(overlimit, OVERLIMIT);
+	GET_U32(overmemory, OVERMEMORY);
+	GET_U32(collisions, COLLISIONS);
+	GET_U32(tx_packets, TX_PACKETS);
+
+#undef GET_U32
+}
+
+/* counters are deltas modulo 2^32, the backlog stays a gauge */
+static void txq_counters_delta(const struct txq_counters *prev,
+			       const struct txq_counters *cur,
+			       struct txq_counters *d)
+{
+	d->backlog_bytes = cur->backlog_bytes;
+	d->backlog_packets = cur->backlog_packets;
+	d->drops = cur->drops - prev->drops;
+	d->ecn_marks = cur->ecn_marks - prev->ecn_marks;
+	d->overlimit = cur->overlimit - prev->overlimit;
+	d->overmemory = cur->overmemory - prev->overmemory;
+	d->collisions = cur->collisions - prev->collisions;
+	d->tx_packets = cur->tx_packets - prev->tx_packets;
+}
+
+static struct txq_queue *txq_watch_lookup(struct txq_watch *tw, int ifindex,
+					  const unsigned char *addr, int tid,
+					  bool *created)
+{
+	unsigned int h = (addr[4] ^ (addr[5] << 1) ^ (tid << 3)) %
+			 TXQ_WATCH_HASH_SIZE;
+	struct txq_queue *q;
+
+	*created = false;
+	for (q = tw->hash[h]; q; q = q->next)
+		if (q->ifindex == ifindex && q->tid == tid &&
+		    !memcmp(q->addr, addr, ETH_ALEN))
+			return q;
+
+	q = calloc(1, sizeof(*q));
+	if (!q)
+		return NULL;
+	q->ifindex = ifindex;
+	memcpy(q->addr, addr, ETH_ALEN);
+	q->tid = tid;
+	q->next = tw->hash[h];
+	tw->hash[h] = q;
+	*created = true;
+	return q;
+}
+
+static int txq_watch_wiphy_handler(struct nl_msg *msg, void *arg)
+{
+	struct txq_watch *tw = arg;
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct txq_counters c;
+
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+
+	if (tb[NL80211_ATTR_WIPHY])
+		tw->wiphy = nla_get_u32(tb[NL80211_ATTR_WIPHY]);
+
+	/* the split dump carries the TXQ stats in one of its messages */
+	if (!tb[NL80211_ATTR_TXQ_STATS])
+		return NL_SKIP;
+
+	txq_counters_get(tb[NL80211_ATTR_TXQ_STATS], &c);
+	if (tw->phy_seen) {
+		txq_counters_delta(&tw->phy, &c, &tw->phy_d);
+		tw->phy_have_delta = true;
+	}
+	tw->phy = c;
+	tw->phy_seen = true;
+	if (c.backlog_packets > tw->phy_max_backlog)
+		tw->phy_max_backlog = c.backlog_packets;
+
+	return NL_SKIP;
+}
+
+static int txq_watch_iface_handler(struct nl_msg *msg, void *arg)
+{
+	struct txq_watch *tw = arg;
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+
+	if (!tb[NL80211_ATTR_IFINDEX] || !tb[NL80211_ATTR_WIPHY] ||
+	    nla_get_u32(tb[NL80211_ATTR_WIPHY]) != (uint32_t)tw->wiphy)
+		return NL_SKIP;
+
+	if (tw->n_ifaces < TXQ_WATCH_MAX_IFACES)
+		tw->ifindex[tw->n_ifaces++] =
+			nla_get_u32(tb[NL80211_ATTR_IFINDEX]);
+
+	return NL_SKIP;
+}
+
+static int txq_watch_station_handler(struct nl_msg *msg, void *arg)
+{
+	struct txq_watch *tw = arg;
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr *sinfo[NL80211_STA_INFO_MAX + 1];
+	struct nlattr *tid_info[NL80211_TID_STATS_MAX + 1], *tidattr;
+	static struct nla_policy tid_policy[NL80211_TID_STATS_MAX + 1] = {
+		[NL80211_TID_STATS_TXQ_STATS] = { .type = NLA_NESTED },
+	};
+	struct txq_counters c;
+	struct txq_queue *q;
+	bool created;
+	int rem;
+
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+
+	if (!tb[NL80211_ATTR_MAC] || !tb[NL80211_ATTR_IFINDEX] ||
+	    !tb[NL80211_ATTR_STA_INFO])
+		return NL_SKIP;
+
+	if (nla_parse_nested(sinfo, NL80211_STA_INFO_MAX,
+			     tb[NL80211_ATTR_STA_INFO], NULL) ||
+	    !sinfo[NL80211_STA_INFO_TID_STATS])
+		return NL_SKIP;
+
+	nla_for_each_nested(tidattr, sinfo[NL80211_STA_INFO_TID_STATS], rem) {
+		if (nla_parse_nested(tid_info, NL80211_TID_STATS_MAX,
+				     tidattr, tid_policy) ||
+		    !tid_info[NL80211_TID_STATS_TXQ_STATS])
+			continue;
+
+		/* TID n is carried in attribute n + 1, 16 is non-QoS */
+		q = txq_watch_lookup(tw, nla_get_u32(tb[NL80211_ATTR_IFINDEX]),
+				     nla_data(tb[NL80211_ATTR_MAC]),
+				     nla_type(tidattr) - 1, &created);
+		if (!q)
+			continue;
+
+		txq_counters_get(tid_info[NL80211_TID_STATS_TXQ_STATS], &c);
+		q->have_delta = !created;
+		if (!created)
+			txq_counters_delta(&q->c, &c, &q->d);
+		q->c = c;
+		q->seen = true;
+		if (c.backlog_packets > q->max_backlog)
+			q->max_backlog = c.backlog_packets;
+	}
+
+	return NL_SKIP;
+}
+
+static int txq_queue_cmp(const void *_a, const void *_b)
+{
+	const struct txq_queue *a = *(const struct txq_queue **)_a;
+	const struct txq_queue *b = *(const struct txq_queue **)_b;
+	int diff;
+
+	if (a->d.drops != b->d.drops)
+		return a->d.drops > b->d.drops ? -1 : 1;
+	if (a->ifindex != b->ifindex)
+		return a->ifindex - b->ifindex;
+	diff = memcmp(a->addr, b->addr, ETH_ALEN);
+	if (diff)
+		return diff;
+	return a->tid - b->tid;
+}
+
+static void txq_watch_print_queue(const struct txq_queue *q,
+				  uint32_t total_drops, bool tid)
+{
+	char mac_addr[20], dev[IF_NAMESIZE] = "?";
+
+	mac_addr_n2a(mac_addr, q->addr);
+	if_indextoname(q->ifindex, dev);
+
+	printf("\t%-8s %s", dev, mac_addr);
+	if (tid)
+		printf(" tid %-2d", q->tid);
+	printf(": drops %u (%u%%), ecn %u, overlimit %u, overmemory %u",
+	       q->d.drops, total_drops ? q->d.drops * 100 / total_drops : 0,
+	       q->d.ecn_marks, q->d.overlimit, q->d.overmemory);
+	if (tid)
+		printf(", backlog %u pkts (max %u since start)",
+		       q->d.backlog_packets, q->max_backlog);
+	printf("\n");
+}
+
+/*
+ * Print the interval report and drop the queues that went away; the
+ * queues with drops are ranked per TID and summed up per station.
+ */
+static void txq_watch_report(struct txq_watch *tw, unsigned long long ms,
+			     bool report)
+{
+	struct txq_queue **qs = NULL, **pp, *q, *sta = NULL;
+	uint32_t total_drops = 0;
+	int n = 0, n_sta = 0, size = 0, i;
+
+	for (i = 0; i < TXQ_WATCH_HASH_SIZE; i++) {
+		pp = &tw->hash[i];
+		while ((q = *pp)) {
+			if (!q->seen) {
+				*pp = q->next;
+				free(q);
+				continue;
+			}
+			q->seen = false;
+			pp = &q->next;
+
+			if (!report || !q->have_delta || !q->d.drops)
+				continue;
+			if (n == size) {
+				struct txq_queue **tmp;
+
+				size = size ? size * 2 : 32;
+				tmp = realloc(qs, size * sizeof(*qs));
+				if (!tmp)
+					continue;
+				qs = tmp;
+			}
+			qs[n++] = q;
+			total_drops += q->d.drops;
+		}
+	}
+
+	if (!report)
+		goto out;
+
+	printf("phy#%d (%llu ms):", tw->wiphy, ms);
+	if (tw->phy_have_delta) {
+		printf(" drops %u, ecn %u, overlimit %u, overmemory %u, collisions %u, tx %u pkts\n",
+		       tw->phy_d.drops, tw->phy_d.ecn_marks, tw->phy_d.overlimit,
+		       tw->phy_d.overmemory, tw->phy_d.collisions,
+		       tw->phy_d.tx_packets);
+		printf("\tbacklog %u pkts / %u bytes (max %u pkts since start)\n",
+		       tw->phy.backlog_packets, tw->phy.backlog_bytes,
+		       tw->phy_max_backlog);
+	} else {
+		printf(" no wiphy TXQ statistics\n");
+	}
+
+	if (!n) {
+		printf("\tno station TXQ drops\n\n");
+		goto out;
+	}
+
+	qsort(qs, n, sizeof(*qs), txq_queue_cmp);
+
+	printf("  top TIDs by drops:\n");
+	for (i = 0; i < n && i < tw->top; i++)
+		txq_watch_print_queue(qs[i], total_drops, true);
+
+	/* sum up per station, the ranking above keeps its order */
+	sta = calloc(n, sizeof(*sta));
+	if (!sta)
+		goto out;
+	for (i = 0; i < n; i++) {
+		int j;
+
+		for (j = 0; j < n_sta; j++)
+			if (sta[j].ifindex == qs[i]->ifindex &&
+			    !memcmp(sta[j].addr, qs[i]->addr, ETH_ALEN))
+				break;
+		if (j == n_sta) {
+			sta[j].ifindex = qs[i]->ifindex;
+			memcpy(sta[j].addr, qs[i]->addr, ETH_ALEN);
+			n_sta++;
+		}
+		sta[j].d.drops += qs[i]->d.drops;
+		sta[j].d.ecn_marks += qs[i]->d.ecn_marks;
+		sta[j].d.overlimit += qs[i]->d.overlimit;
+		sta[j].d.overmemory += qs[i]->d.overmemory;
+	}
+
+	for (i = 0; i < n_sta; i++)
+		qs[i] = &sta[i];
+	qsort(qs, n_sta, sizeof(*qs), txq_queue_cmp);
+
+	printf("  top stations by drops:\n");
+	for (i = 0; i < n_sta && i < tw->top; i++)
+		txq_watch_print_queue(qs[i], total_drops, false);
+	printf("\n");
+
+ out:
+	fflush(stdout);
+	free(sta);
+	free(qs);
+}
+
+static int handle_get_txq_wiphy(struct nl80211_state *state,
+				struct nl_msg *msg,
+				int argc, char **argv,
+				enum id_input id)
+{
+	nla_put_flag(msg, NL80211_ATTR_SPLIT_WIPHY_DUMP);
+	register_handler(txq_watch_wiphy_handler, &txq_watch);
+	return 0;
+}
+HIDDEN(get, txq_wiphy, NULL, NL80211_CMD_GET_WIPHY, NLM_F_DUMP, CIB_PHY,
+	handle_get_txq_wiphy);
+
+static struct nl_msg *txq_watch_msg(struct nl80211_state *state, int cmd,
+				    int ifindex, int wiphy)
+{
+	struct nl_msg *msg;
+
+	msg = nl80211_batch_msg(state, cmd, NLM_F_DUMP, ifindex);
+	if (!msg)
+		return NULL;
+	if (wiphy >= 0)
+		NLA_PUT_U32(msg, NL80211_ATTR_WIPHY, wiphy);
+	if (cmd == NL80211_CMD_GET_WIPHY)
+		NLA_PUT_FLAG(msg, NL80211_ATTR_SPLIT_WIPHY_DUMP);
+	return msg;
+ nla_put_failure:
+	nlmsg_free(msg);
+	return NULL;
+}
+
+/* one sample: the wiphy and its interfaces, then their stations */
+static int txq_watch_sample(struct nl80211_state *state, struct txq_watch *tw)
+{
+	struct nl80211_batch_req reqs[TXQ_WATCH_MAX_IFACES] = {};
+	int n, err, i;
+
+	tw->n_ifaces = 0;
+	reqs[0].msg = txq_watch_msg(state, NL80211_CMD_GET_WIPHY, 0, tw->wiphy);
+	reqs[0].handler = txq_watch_wiphy_handler;
+	reqs[1].msg = txq_watch_msg(state, NL80211_CMD_GET_INTERFACE, 0,
+				    tw->wiphy);
+	reqs[1].handler = txq_watch_iface_handler;
+	reqs[0].arg = reqs[1].arg = tw;
+
+	err = -ENOMEM;
+	if (reqs[0].msg && reqs[1].msg)
+		err = nl80211_batch(state, reqs, 2, 0);
+	nlmsg_free(reqs[0].msg);
+	nlmsg_free(reqs[1].msg);
+	if (!err)
+		err = reqs[0].err ? reqs[0].err : reqs[1].err;
+	if (err)
+		return err;
+
+	n = tw->n_ifaces;
+	memset(reqs, 0, sizeof(reqs));
+	for (i = 0; i < n; i++) {
+		reqs[i].msg = txq_watch_msg(state, NL80211_CMD_GET_STATION,
+					    tw->ifindex[i], -1);
+		reqs[i].handler = txq_watch_station_handler;
+		reqs[i].arg = tw;
+		if (!reqs[i].msg)
+			err = -ENOMEM;
+	}
+
+	/*
+	 * Per-interface errors are ignored, interfaces without stations
+	 * (e.g. monitor) may refuse the dump.
+	 */
+	if (!err)
+		err = nl80211_batch(state, reqs, n, 0);
+	for (i = 0; i < n; i++)
+		nlmsg_free(reqs[i].msg);
+
+	return err;
+}
+
+static int handle_get_txq_watch(struct nl80211_state *state,
+				struct nl_msg *msg,
+				int argc, char **argv,
+				enum id_input id)
+{
+	struct txq_watch *tw = &txq_watch;
+	char *wiphy_argv[] = {
+		argv[0],
+		"get",
+		"txq_wiphy",
+	};
+	unsigned long long last_ms, sample_ms;
+	unsigned int n;
+	char *end;
+	int err, used;
+
+	/* we get the full command line, skip "<phy> get txq" */
+	argc -= 3;
+	argv += 3;
+
+	tw->top = TXQ_WATCH_TOP;
+	while (argc >= 2) {
+		used = parse_interval_count(argc, argv, &tw->interval_ms,
+					    &tw->count);
+		if (used < 0)
+			return HANDLER_RET_USAGE;
+		if (!used) {
+			if (strcmp(argv[0], "--top"))
+				return HANDLER_RET_USAGE;
+			tw->top = strtoul(argv[1], &end, 0);
+			if (*end)
+				return HANDLER_RET_USAGE;
+			used = 2;
+		}
+		argc -= used;
+		argv += used;
+	}
+	if (argc || !tw->interval_ms)
+		return HANDLER_RET_USAGE;
+
+	/* resolve the wiphy index and take the first wiphy sample */
+	tw->wiphy = -1;
+	err = handle_cmd(state, id, ARRAY_SIZE(wiphy_argv), wiphy_argv);
+	if (err)
+		return err;
+	if (tw->wiphy < 0)
+		return -ENODEV;
+	tw->phy_seen = false;
+
+	last_ms = now_ms();
+	for (n = 0; !tw->count || n <= tw->count; n++) {
+		err = txq_watch_sample(state, tw);
+		if (err)
+			return err;
+
+		sample_ms = now_ms();
+		txq_watch_report(tw, sample_ms - last_ms, n > 0);
+		last_ms = sample_ms;
+
+		if (!tw->count || n < tw->count)
+			usleep(tw->interval_ms * 1000);
+	}
+
+	return 0;
+}
+
+static const struct cmd *get_txq_plain;
+static const struct cmd *get_txq_watch;
+
+static const struct cmd *select_get_txq_cmd(int argc, char **argv)
+{
+	return argc ? get_txq_watch : get_txq_plain;
+}
+
+COMMAND_ALIAS(get, txq, "",
 	NL80211_CMD_GET_WIPHY, 0, CIB_PHY, handle_get_txq,
-	"Get TXQ parameters.");
+	"Get TXQ parameters.",
+	select_get_txq_cmd, get_txq_plain);
+COMMAND_ALIAS(get, txq, "--interval <ms> [--count <n>] [--top <n>]",
+	0, 0, CIB_PHY, handle_get_txq_watch,
+	"Sample the wiphy TXQ statistics and the per-TID TXQ statistics of\n"
+	"all stations every <ms> milliseconds (<n> times, default forever)\n"
+	"and print the drops, ECN marks and overlimits of each interval, the\n"
+	"backlog with its maximum since the start, plus the <n> TIDs and\n"
+	"stations (default 5) with the most drops.",
+	select_get_txq_cmd, get_txq_watch);
 
 static int handle_wmm(struct nl80211_state *state,
 			  struct nl_msg *msg,
@@ -8,10 +8,19 @@
 #include <netlink/msg.h>
 #include <netlink/attr.h>
 #include <time.h>
+#include <unistd.h>
 
 #include "nl80211.h"
 #include "iw.h"
 
+typedef unsigned long long int u64;
+typedef uint32_t u32;
+typedef uint16_t u16;
+typedef uint8_t u8;
+typedef int32_t s32;
+typedef int8_t s8;
+#include "vendor_cmds_copy.h"
+
 SECTION(station);
 
 enum plink_state {
@@ -312,6 +321,473 @@ static char *get_chain_signal(struct nlattr *attr_list)
 	return buf;
 }
 
+/*
+ * Options of 'station dump': filters and field projection. Both work on
+ * a cheap walk of the STA_INFO nest that only picks the attributes that
+ * are actually needed, so stations that are filtered out (and fields
+ * that are not asked for) never go through the full policy parse nor
+ * the formatting code below.
+ */
+#define STA_MAX_FIELDS 32
+
+struct sta_mac_filter {
+	unsigned char addr[ETH_ALEN];
+	unsigned char mask[ETH_ALEN];
+};
+
+struct sta_dump_opts {
+	bool verbose;
+	bool filter;
+
+	struct sta_mac_filter *macs;
+	int n_macs;
+
+	bool have_inactive_above, have_inactive_below;
+	uint32_t inactive_above, inactive_below;
+
+	bool have_signal;
+	int signal_min, signal_max;
+
+	/* -1: don't care, 0: must not be set, 1: must be set */
+	int authorized, associated, mlo;
+
+	int fields[STA_MAX_FIELDS];
+	int n_fields;
+
+	/* sampling mode, see handle_station_dump_interval() */
+	unsigned long interval_ms;
+	unsigned long count;
+
+	/* vendor statistics, see handle_station_dump_vendor() */
+	bool vendor, serial;
+
+	/* attributes to pick out of STA_INFO, with their minimum length */
+	bool want[NL80211_STA_INFO_MAX + 1];
+	int minlen[NL80211_STA_INFO_MAX + 1];
+};
+
+enum sta_field_type {
+	SF_U16,
+	SF_U32,
+	SF_U64,
+	SF_U32_U64,	/* 64-bit attribute preferred, 32-bit fallback */
+	SF_DBM,
+	SF_BITRATE,
+	SF_THROUGHPUT,
+};
+
+static const struct sta_field {
+	const char *name;
+	const char *fmt;
+	enum nl80211_sta_info attr;
+	enum nl80211_sta_info attr32;
+	enum sta_field_type type;
+} sta_fields[] = {
+	{ "inactive_time", "inactive time:\t%s ms", NL80211_STA_INFO_INACTIVE_TIME, 0, SF_U32 },
+	{ "rx_bytes", "rx bytes:\t%s", NL80211_STA_INFO_RX_BYTES64, NL80211_STA_INFO_RX_BYTES, SF_U32_U64 },
+	{ "rx_packets", "rx packets:\t%s", NL80211_STA_INFO_RX_PACKETS, 0, SF_U32 },
+	{ "tx_bytes", "tx bytes:\t%s", NL80211_STA_INFO_TX_BYTES64, NL80211_STA_INFO_TX_BYTES, SF_U32_U64 },
+	{ "tx_packets", "tx packets:\t%s", NL80211_STA_INFO_TX_PACKETS, 0, SF_U32 },
+	{ "tx_retries", "tx retries:\t%s", NL80211_STA_INFO_TX_RETRIES, 0, SF_U32 },
+	{ "tx_failed", "tx failed:\t%s", NL80211_STA_INFO_TX_FAILED, 0, SF_U32 },
+	{ "beacon_loss", "beacon loss:\t%s", NL80211_STA_INFO_BEACON_LOSS, 0, SF_U32 },
+	{ "beacon_rx", "beacon rx:\t%s", NL80211_STA_INFO_BEACON_RX, 0, SF_U64 },
+	{ "rx_drop_misc", "rx drop misc:\t%s", NL80211_STA_INFO_RX_DROP_MISC, 0, SF_U64 },
+	{ "signal", "signal:  \t%s dBm", NL80211_STA_INFO_SIGNAL, 0, SF_DBM },
+	{ "signal_avg", "signal avg:\t%s dBm", NL80211_STA_INFO_SIGNAL_AVG, 0, SF_DBM },
+	{ "beacon_signal_avg", "beacon signal avg:\t%s dBm", NL80211_STA_INFO_BEACON_SIGNAL_AVG, 0, SF_DBM },
+	{ "t_offset", "Toffset:\t%s us", NL80211_STA_INFO_T_OFFSET, 0, SF_U64 },
+	{ "tx_bitrate", "tx bitrate:\t%s", NL80211_STA_INFO_TX_BITRATE, 0, SF_BITRATE },
+	{ "tx_duration", "tx duration:\t%s us", NL80211_STA_INFO_TX_DURATION, 0, SF_U64 },
+	{ "rx_bitrate", "rx bitrate:\t%s", NL80211_STA_INFO_RX_BITRATE, 0, SF_BITRATE },
+	{ "rx_duration", "rx duration:\t%s us", NL80211_STA_INFO_RX_DURATION, 0, SF_U64 },
+	{ "ack_signal", "last ack signal:%s dBm", NL80211_STA_INFO_ACK_SIGNAL, 0, SF_DBM },
+	{ "ack_signal_avg", "avg ack signal:\t%s dBm", NL80211_STA_INFO_ACK_SIGNAL_AVG, 0, SF_DBM },
+	{ "airtime_weight", "airtime weight: %s", NL80211_STA_INFO_AIRTIME_WEIGHT, 0, SF_U16 },
+	{ "expected_throughput", "expected throughput:\t%sMbps", NL80211_STA_INFO_EXPECTED_THROUGHPUT, 0, SF_THROUGHPUT },
+	{ "connected_time", "connected time:\t%s seconds", NL80211_STA_INFO_CONNECTED_TIME, 0, SF_U32 },
+};
+
+static int sta_field_minlen(enum sta_field_type type)
+{
+	switch (type) {
+	case SF_DBM:
+		return sizeof(uint8_t);
+	case SF_U16:
+		return sizeof(uint16_t);
+	case SF_U32:
+	case SF_THROUGHPUT:
+		return sizeof(uint32_t);
+	case SF_U64:
+		return sizeof(uint64_t);
+	case SF_U32_U64:
+	case SF_BITRATE:
+		break;
+	}
+	return 0;
+}
+
+static void sta_opts_want(struct sta_dump_opts *opts,
+			  enum nl80211_sta_info attr, int minlen)
+{
+	opts->want[attr] = true;
+	opts->minlen[attr] = minlen;
+}
+
+static int parse_sta_fields(struct sta_dump_opts *opts, char *list)
+{
+	const struct sta_field *f;
+	char *tok, *saveptr = NULL;
+	unsigned int i;
+
+	for (tok = strtok_r(list, ",", &saveptr); tok;
+	     tok = strtok_r(NULL, ",", &saveptr)) {
+		for (i = 0; i < ARRAY_SIZE(sta_fields); i++)
+			if (!strcmp(tok, sta_fields[i].name))
+				break;
+		if (i == ARRAY_SIZE(sta_fields)) {
+			fprintf(stderr, "unknown field '%s', valid fields:", tok);
+			for (i = 0; i < ARRAY_SIZE(sta_fields); i++)
+				fprintf(stderr, " %s", sta_fields[i].name);
+			fprintf(stderr, "\n");
+			return -EINVAL;
+		}
+		if (opts->n_fields == STA_MAX_FIELDS) {
+			fprintf(stderr, "too many fields\n");
+			return -EINVAL;
+		}
+		opts->fields[opts->n_fields++] = i;
+
+		f = &sta_fields[i];
+		if (f->type == SF_U32_U64) {
+			sta_opts_want(opts, f->attr, sizeof(uint64_t));
+			sta_opts_want(opts, f->attr32, sizeof(uint32_t));
+		} else {
+			sta_opts_want(opts, f->attr, sta_field_minlen(f->type));
+		}
+	}
+
+	return 0;
+}
+
+static int parse_sta_mac_filter(struct sta_dump_opts *opts, char *list)
+{
+	struct sta_mac_filter *macs;
+	char *tok, *mask, *saveptr = NULL;
+
+	for (tok = strtok_r(list, ",", &saveptr); tok;
+	     tok = strtok_r(NULL, ",", &saveptr)) {
+		macs = realloc(opts->macs, (opts->n_macs + 1) * sizeof(*macs));
+		if (!macs)
+			return -ENOMEM;
+		opts->macs = macs;
+		macs = &opts->macs[opts->n_macs];
+
+		mask = strchr(tok, '/');
+		if (mask)
+			*mask++ = '\0';
+		if (mac_addr_a2n(macs->addr, tok) ||
+		    (mask && mac_addr_a2n(macs->mask, mask))) {
+			fprintf(stderr, "invalid mac address %s\n", tok);
+			return -EINVAL;
+		}
+		if (!mask)
+			memset(macs->mask, 0xff, ETH_ALEN);
+		opts->n_macs++;
+	}
+
+	return 0;
+}
+
+static int parse_sta_signal_range(struct sta_dump_opts *opts, char *range)
+{
+	char *sep, *end;
+
+	opts->signal_min = -128;
+	opts->signal_max = 127;
+
+	sep = strchr(range, ':');
+	if (sep)
+		*sep++ = '\0';
+	if (*range) {
+		opts->signal_min = strtol(range, &end, 10);
+		if (*end)
+			return -EINVAL;
+	}
+	if (sep && *sep) {
+		opts->signal_max = strtol(sep, &end, 10);
+		if (*end)
+			return -EINVAL;
+	}
+	opts->have_signal = true;
+	return 0;
+}
+
+static int parse_sta_u32(const char *arg, uint32_t *val)
+{
+	char *end;
+
+	*val = strtoul(arg, &end, 0);
+	return *end ? -EINVAL : 0;
+}
+
+/*
+ * Parse the 'station dump' options; stops at the first argument it
+ * doesn't know and leaves that in argc/argv for the caller.
+ */
+static int parse_sta_dump_opts(struct sta_dump_opts *opts,
+			       int *argc, char ***argv)
+{
+	char *opt, *val;
+	int used;
+
+	opts->authorized = opts->associated = opts->mlo = -1;
+
+	while (*argc) {
+		opt = (*argv)[0];
+		val = *argc > 1 ? (*argv)[1] : NULL;
+
+		used = parse_interval_count(*argc, *argv, &opts->interval_ms,
+					    &opts->count);
+		if (used < 0)
+			return HANDLER_RET_USAGE;
+		if (used) {
+			*argc -= used;
+			*argv += used;
+			continue;
+		}
+		used = 1;
+
+		if (!strcmp(opt, "-v")) {
+			opts->verbose = true;
+		} else if (!strcmp(opt, "--authorized") ||
+			   !strcmp(opt, "--unauthorized")) {
+			opts->authorized = opt[2] == 'a';
+			opts->filter = true;
+			sta_opts_want(opts, NL80211_STA_INFO_STA_FLAGS,
+				      sizeof(struct nl80211_sta_flag_update));
+		} else if (!strcmp(opt, "--associated") ||
+			   !strcmp(opt, "--unassociated")) {
+			opts->associated = opt[2] == 'a';
+			opts->filter = true;
+			sta_opts_want(opts, NL80211_STA_INFO_STA_FLAGS,
+				      sizeof(struct nl80211_sta_flag_update));
+		} else if (!strcmp(opt, "--mlo") || !strcmp(opt, "--no-mlo")) {
+			opts->mlo = opt[2] == 'm';
+			opts->filter = true;
+		} else if (!strcmp(opt, "--mac") && val) {
+			if (parse_sta_mac_filter(opts, val))
+				return HANDLER_RET_USAGE;
+			opts->filter = true;
+			used = 2;
+		} else if (!strcmp(opt, "--inactive-above") && val) {
+			if (parse_sta_u32(val, &opts->inactive_above))
+				return HANDLER_RET_USAGE;
+			opts->have_inactive_above = true;
+			opts->filter = true;
+			sta_opts_want(opts, NL80211_STA_INFO_INACTIVE_TIME,
+				      sizeof(uint32_t));
+			used = 2;
+		} else if (!strcmp(opt, "--inactive-below") && val) {
+			if (parse_sta_u32(val, &opts->inactive_below))
+				return HANDLER_RET_USAGE;
+			opts->have_inactive_below = true;
+			opts->filter = true;
+			sta_opts_want(opts, NL80211_STA_INFO_INACTIVE_TIME,
+				      sizeof(uint32_t));
+			used = 2;
+		} else if (!strcmp(opt, "--signal") && val) {
+			if (parse_sta_signal_range(opts, val))
+				return HANDLER_RET_USAGE;
+			opts->filter = true;
+			sta_opts_want(opts, NL80211_STA_INFO_SIGNAL,
+				      sizeof(uint8_t));
+			used = 2;
+		} else if (!strcmp(opt, "--fields") && val) {
+			if (parse_sta_fields(opts, val))
+				return HANDLER_RET_USAGE;
+			used = 2;
+		} else if (!strcmp(opt, "--vendor")) {
+			opts->vendor = true;
+		} else if (!strcmp(opt, "--serial")) {
+			opts->serial = true;
+		} else {
+			break;
+		}
+
+		*argc -= used;
+		*argv += used;
+	}
+
+	return 0;
+}
+
+/*
+ * Pick the wanted attributes out of the STA_INFO nest without running
+ * the policy over everything else; returns non-zero if one of them is
+ * malformed.
+ */
+static int sta_info_pick(const struct sta_dump_opts *opts,
+			 struct nlattr *sta_info,
+			 struct nlattr **sinfo)
+{
+	struct nlattr *attr;
+	int rem, type;
+
+	memset(sinfo, 0, sizeof(*sinfo) * (NL80211_STA_INFO_MAX + 1));
+
+	nla_for_each_nested(attr, sta_info, rem) {
+		type = nla_type(attr);
+		if (type > NL80211_STA_INFO_MAX || !opts->want[type])
+			continue;
+		if (nla_len(attr) < opts->minlen[type])
+			return -EINVAL;
+		sinfo[type] = attr;
+	}
+
+	return 0;
+}
+
+static bool sta_flag_match(const struct nl80211_sta_flag_update *flags,
+			   enum nl80211_sta_flags flag, int want)
+{
+	if (want < 0)
+		return true;
+	if (!flags || !(flags->mask & BIT(flag)))
+		return false;
+	return !!(flags->set & BIT(flag)) == want;
+}
+
+static bool sta_filter_match(const struct sta_dump_opts *opts,
+			     struct nlattr **tb, struct nlattr **sinfo)
+{
+	struct nl80211_sta_flag_update *sta_flags = NULL;
+	const unsigned char *mac;
+	uint32_t inactive;
+	bool mlo;
+	int i, j;
+
+	if (opts->n_macs) {
+		if (!tb[NL80211_ATTR_MAC])
+			return false;
+		mac = nla_data(tb[NL80211_ATTR_MAC]);
+		for (i = 0; i < opts->n_macs; i++) {
+			for (j = 0; j < ETH_ALEN; j++)
+				if ((mac[j] ^ opts->macs[i].addr[j]) &
+				    opts->macs[i].mask[j])
+					break;
+			if (j == ETH_ALEN)
+				break;
+		}
+		if (i == opts->n_macs)
+			return false;
+	}
+
+	if (opts->have_inactive_above || opts->have_inactive_below) {
+		if (!sinfo[NL80211_STA_INFO_INACTIVE_TIME])
+			return false;
+		inactive = nla_get_u32(sinfo[NL80211_STA_INFO_INACTIVE_TIME]);
+		if (opts->have_inactive_above && inactive <= opts->inactive_above)
+			return false;
+		if (opts->have_inactive_below && inactive >= opts->inactive_below)
+			return false;
+	}
+
+	if (opts->have_signal) {
+		int signal;
+
+		if (!sinfo[NL80211_STA_INFO_SIGNAL])
+			return false;
+		signal = (int8_t)nla_get_u8(sinfo[NL80211_STA_INFO_SIGNAL]);
+		if (signal < opts->signal_min || signal > opts->signal_max)
+			return false;
+	}
+
+	if (sinfo[NL80211_STA_INFO_STA_FLAGS])
+		sta_flags = nla_data(sinfo[NL80211_STA_INFO_STA_FLAGS]);
+	if (!sta_flag_match(sta_flags, NL80211_STA_FLAG_AUTHORIZED,
+			    opts->authorized) ||
+	    !sta_flag_match(sta_flags, NL80211_STA_FLAG_ASSOCIATED,
+			    opts->associated))
+		return false;
+
+	if (opts->mlo >= 0) {
+		mlo = tb[NL80211_ATTR_MLO_LINKS] || tb[NL80211_ATTR_MLD_ADDR] ||
+		      tb[NL80211_ATTR_MLO_LINK_ID];
+		if (mlo != opts->mlo)
+			return false;
+	}
+
+	return true;
+}
+
+static int print_sta_fields(const struct sta_dump_opts *opts,
+			    struct nlattr **tb, struct nlattr **sinfo)
+{
+	const struct sta_field *f;
+	struct nlattr *attr;
+	char mac_addr[20], dev[20], val[100];
+	uint32_t thr;
+	int i;
+
+	mac_addr_n2a(mac_addr, nla_data(tb[NL80211_ATTR_MAC]));
+	if_indextoname(nla_get_u32(tb[NL80211_ATTR_IFINDEX]), dev);
+	printf("Station %s (on %s)", mac_addr, dev);
+
+	for (i = 0; i < opts->n_fields; i++) {
+		f = &sta_fields[opts->fields[i]];
+		attr = sinfo[f->attr];
+
+		switch (f->type) {
+		case SF_U16:
+			if (attr)
+				snprintf(val, sizeof(val), "%u", nla_get_u16(attr));
+			break;
+		case SF_U32:
+			if (attr)
+				snprintf(val, sizeof(val), "%u", nla_get_u32(attr));
+			break;
+		case SF_U32_U64:
+			if (!attr && sinfo[f->attr32]) {
+				snprintf(val, sizeof(val), "%u",
+					 nla_get_u32(sinfo[f->attr32]));
+				attr = sinfo[f->attr32];
+				break;
+			}
+			/* fall through */
+		case SF_U64:
+			if (attr)
+				snprintf(val, sizeof(val), "%llu",
+					 (unsigned long long)nla_get_u64(attr));
+			break;
+		case SF_DBM:
+			if (attr)
+				snprintf(val, sizeof(val), "%d",
+					 (int8_t)nla_get_u8(attr));
+			break;
+		case SF_BITRATE:
+			if (attr)
+				parse_bitrate(attr, val, sizeof(val));
+			break;
+		case SF_THROUGHPUT:
+			if (!attr)
+				break;
+			/* convert in Mbps but scale by 1000 to save kbps units */
+			thr = nla_get_u32(attr) * 1000 / 1024;
+			snprintf(val, sizeof(val), "%u.%u", thr / 1000, thr % 1000);
+			break;
+		}
+
+		if (!attr)
+			continue;
+		printf("\n\t");
+		printf(f->fmt, val);
+	}
+
+	printf("\n");
+	return NL_SKIP;
+}
+
 static int print_sta_handler(struct nl_msg *msg, void *arg)
 {
 	struct nlattr *tb[NL80211_ATTR_MAX + 1];
@@ -319,6 +795,7 @@ static int print_sta_handler(struct nl_msg *msg, void *arg)
 	struct nlattr *sinfo[NL80211_STA_INFO_MAX + 1];
 	char mac_addr[20], state_name[10], dev[20];
 	struct nl80211_sta_flag_update *sta_flags;
+	const struct sta_dump_opts *opts = arg;
 	static struct nla_policy stats_policy[NL80211_STA_INFO_MAX + 1] = {
 		[NL80211_STA_INFO_INACTIVE_TIME] = { .type = NLA_U32 },
 		[NL80211_STA_INFO_RX_BYTES] = { .type = NLA_U32 },
@@ -377,6 +854,18 @@ static int print_sta_handler(struct nl_msg *msg, void *arg)
 		fprintf(stderr, "sta stats missing!\n");
 		return NL_SKIP;
 	}
+
+	if (opts && (opts->filter || opts->n_fields)) {
+		if (sta_info_pick(opts, tb[NL80211_ATTR_STA_INFO], sinfo)) {
+			fprintf(stderr, "failed to parse nested attributes!\n");
+			return NL_SKIP;
+		}
+		if (!sta_filter_match(opts, tb, sinfo))
+			return NL_SKIP;
+		if (opts->n_fields)
+			return print_sta_fields(opts, tb, sinfo);
+	}
+
 	if (nla_parse_nested(sinfo, NL80211_STA_INFO_MAX,
 			     tb[NL80211_ATTR_STA_INFO],
 			     stats_policy)) {
@@ -610,8 +1099,7 @@ static int print_sta_handler(struct nl_msg *msg, void *arg)
 		}
 	}
 
-	if (sinfo[NL80211_STA_INFO_TID_STATS] && arg != NULL &&
-	    !strcmp((char *)arg, "-v"))
+	if (sinfo[NL80211_STA_INFO_TID_STATS] && opts && opts->verbose)
 		parse_tid_stats(sinfo[NL80211_STA_INFO_TID_STATS]);
 	if (sinfo[NL80211_STA_INFO_BSS_PARAM])
 		parse_bss_param(sinfo[NL80211_STA_INFO_BSS_PARAM]);
@@ -668,9 +1156,213 @@ static int handle_station_get(struct nl80211_state *state,
  nla_put_failure:
 	return -ENOBUFS;
 }
-COMMAND(station, get, "<MAC address>",
+/*
+ * 'station get' with several stations: the requests are pipelined on
+ * the socket (at most STA_BATCH_WINDOW in flight), the replies are kept
+ * until all are in and then printed in the order the stations were
+ * given, so the output doesn't depend on the order of the replies.
+ */
+#define STA_BATCH_WINDOW	32
+
+struct sta_get_entry {
+	unsigned char addr[ETH_ALEN];
+	char name[20];
+	bool valid;
+	struct nl_msg *reply;
+};
+
+struct sta_get_list {
+	struct sta_get_entry *entries;
+	int n, size;
+};
+
+static int sta_get_add(struct sta_get_list *list, char *arg)
+{
+	struct sta_get_entry *e;
+
+	if (list->n == list->size) {
+		int size = list->size ? list->size * 2 : 16;
+
+		e = realloc(list->entries, size * sizeof(*e));
+		if (!e)
+			return -ENOMEM;
+		list->entries = e;
+		list->size = size;
+	}
+
+	e = &list->entries[list->n++];
+	memset(e, 0, sizeof(*e));
+	e->valid = !mac_addr_a2n(e->addr, arg);
+	snprintf(e->name, sizeof(e->name), "%s", arg);
+	return 0;
+}
+
+/* one MAC address per line, '#' starts a comment */
+static int sta_get_read_file(struct sta_get_list *list, const char *file)
+{
+	char line[128], *p, *end;
+	FILE *f;
+	int err = 0;
+
+	f = fopen(file, "r");
+	if (!f) {
+		fprintf(stderr, "cannot open %s: %s\n", file, strerror(errno));
+		return -errno;
+	}
+
+	while (!err && fgets(line, sizeof(line), f)) {
+		p = strchr(line, '#');
+		if (p)
+			*p = '\0';
+		for (p = line; *p == ' ' || *p == '\t'; p++)
+			;
+		for (end = p + strlen(p);
+		     end > p && (end[-1] == '\n' || end[-1] == '\r' ||
+				 end[-1] == ' ' || end[-1] == '\t');
+		     end--)
+			;
+		*end = '\0';
+		if (*p)
+			err = sta_get_add(list, p);
+	}
+
+	fclose(f);
+	return err;
+}
+
+static int sta_get_keep_reply(struct nl_msg *msg, void *arg)
+{
+	struct sta_get_entry *e = arg;
+
+	if (!e->reply) {
+		nlmsg_get(msg);
+		e->reply = msg;
+	}
+	return NL_SKIP;
+}
+
+static int handle_station_get_multi(struct nl80211_state *state,
+				    struct nl_msg *msg,
+				    int argc, char **argv,
+				    enum id_input id)
+{
+	struct sta_get_list list = {};
+	struct nl80211_batch_req *reqs = NULL, *req;
+	struct sta_get_entry *e;
+	int ifindex, failed = 0, err = 0, i;
+
+	ifindex = if_nametoindex(argv[0]);
+	if (!ifindex)
+		return -ENODEV;
+
+	/* we get the full command line, skip "<dev> station get" */
+	argc -= 3;
+	argv += 3;
+
+	if (!argc)
+		return HANDLER_RET_USAGE;
+
+	while (argc) {
+		if (!strcmp(argv[0], "--file")) {
+			if (argc < 2) {
+				err = HANDLER_RET_USAGE;
+				goto out;
+			}
+			err = sta_get_read_file(&list, argv[1]);
+			argc -= 2;
+			argv += 2;
+		} else {
+			err = sta_get_add(&list, argv[0]);
+			argc--;
+			argv++;
+		}
+		if (err)
+			goto out;
+	}
+
+	if (list.n) {
+		reqs = calloc(list.n, sizeof(*reqs));
+		if (!reqs) {
+			err = -ENOMEM;
+			goto out;
+		}
+	}
+
+	for (i = 0; i < list.n; i++) {
+		e = &list.entries[i];
+		req = &reqs[i];
+		if (!e->valid)
+			continue;
+
+		req->msg = nl80211_batch_msg(state, NL80211_CMD_GET_STATION,
+					     0, ifindex);
+		if (!req->msg ||
+		    nla_put(req->msg, NL80211_ATTR_MAC, ETH_ALEN, e->addr)) {
+			err = -ENOMEM;
+			goto out;
+		}
+		req->handler = sta_get_keep_reply;
+		req->arg = e;
+	}
+
+	/* invalid entries have no message and are skipped by the batch */
+	err = nl80211_batch(state, reqs, list.n, STA_BATCH_WINDOW);
+	if (err)
+		goto out;
+
+	for (i = 0; i < list.n; i++) {
+		e = &list.entries[i];
+		req = &reqs[i];
+
+		if (!e->valid) {
+			fprintf(stderr, "%s: invalid mac address\n", e->name);
+			failed++;
+		} else if (req->err == -ENOENT) {
+			fprintf(stderr, "Station %s: not found\n", e->name);
+			failed++;
+		} else if (req->err) {
+			fprintf(stderr, "Station %s: %s\n", e->name,
+				strerror(-req->err));
+			failed++;
+		} else if (e->reply) {
+			print_sta_handler(e->reply, NULL);
+		}
+	}
+
+	if (failed)
+		err = 2;
+
+ out:
+	for (i = 0; reqs && i < list.n; i++)
+		nlmsg_free(reqs[i].msg);
+	free(reqs);
+	for (i = 0; i < list.n; i++)
+		nlmsg_free(list.entries[i].reply);
+	free(list.entries);
+	return err;
+}
+
+static const struct cmd *station_get_single;
+static const struct cmd *station_get_multi;
+
+static const struct cmd *select_station_get_cmd(int argc, char **argv)
+{
+	if (argc == 1 && strcmp(argv[0], "--file"))
+		return station_get_single;
+	return station_get_multi;
+}
+
+COMMAND_ALIAS(station, get, "<MAC address>",
 	NL80211_CMD_GET_STATION, 0, CIB_NETDEV, handle_station_get,
-	"Get information for a specific station.");
+	"Get information for a specific station.",
+	select_station_get_cmd, station_get_single);
+COMMAND_ALIAS(station, get, "<MAC address>|--file <file> [<MAC address>|--file <file>...]",
+	0, 0, CIB_NETDEV, handle_station_get_multi,
+	"Get information for several stations, given on the command line\n"
+	"and/or in files with one MAC address per line. The output follows\n"
+	"the order of the stations; unknown stations are reported and\n"
+	"skipped.",
+	select_station_get_cmd, station_get_multi);
 
 static int handle_station_del(struct nl80211_state *state,
 			      struct nl_msg *msg,
@@ -1024,9 +1716,611 @@ static int handle_station_dump(struct nl80211_state *state,
 			       int argc, char **argv,
 			       enum id_input id)
 {
-	register_handler(print_sta_handler, *argv);
+	static struct sta_dump_opts opts;
+
+	if (parse_sta_dump_opts(&opts, &argc, &argv) || argc)
+		return HANDLER_RET_USAGE;
+	if (opts.count || opts.vendor || opts.serial)
+		return HANDLER_RET_USAGE;
+
+	register_handler(print_sta_handler, &opts);
+	return 0;
+}
+
+/*
+ * Station counter delta engine for 'station dump --interval': the
+ * previous sample of each station is kept in a small hash keyed by MAC
+ * address; the association start time (derived from the connected
+ * time) tells a reassociation apart from a counter wrap. 32-bit
+ * counters are subtracted modulo 2^32, a 64-bit counter that went
+ * backwards is treated as a reset of the station entry.
+ */
+#define STA_DELTA_HASH_SIZE	256
+/* slack in seconds when comparing association start times */
+#define STA_DELTA_ASSOC_SLACK	2
+
+struct sta_counters {
+	uint64_t rx_bytes, tx_bytes;
+	uint32_t rx_packets, tx_packets;
+	uint32_t tx_retries, tx_failed;
+	uint32_t beacon_loss;
+	bool rx_bytes64, tx_bytes64;
+};
+
+struct sta_sample {
+	struct sta_sample *next;
+	unsigned char addr[ETH_ALEN];
+	long long assoc_at;
+	struct sta_counters c;
+	bool seen;
+};
+
+struct sta_delta_state {
+	struct sta_dump_opts *opts;
+	struct sta_sample *hash[STA_DELTA_HASH_SIZE];
+	long long now;		/* seconds, CLOCK_MONOTONIC */
+	unsigned long long elapsed_ms;
+	bool report;
+	double total[7];
+	int n_sta;
+};
+
+static struct sta_delta_state sta_delta;
+
+static unsigned int sta_delta_hash(const unsigned char *addr)
+{
+	return (addr[3] ^ (addr[4] << 1) ^ (addr[5] << 2)) % STA_DELTA_HASH_SIZE;
+}
+
+static struct sta_sample *sta_delta_lookup(struct sta_delta_state *sd,
+					   const unsigned char *addr,
+					   bool *created)
+{
+	unsigned int h = sta_delta_hash(addr);
+	struct sta_sample *s;
+
+	*created = false;
+	for (s = sd->hash[h]; s; s = s->next)
+		if (!memcmp(s->addr, addr, ETH_ALEN))
+			return s;
+
+	s = calloc(1, sizeof(*s));
+	if (!s)
+		return NULL;
+	memcpy(s->addr, addr, ETH_ALEN);
+	s->next = sd->hash[h];
+	sd->hash[h] = s;
+	*created = true;
+	return s;
+}
+
+/* drop stations that were not part of the last sample */
+static void sta_delta_prune(struct sta_delta_state *sd)
+{
+	struct sta_sample **pp, *s;
+	int i;
+
+	for (i = 0; i < STA_DELTA_HASH_SIZE; i++) {
+		pp = &sd->hash[i];
+		while ((s = *pp)) {
+			if (!s->seen) {
+				*pp = s->next;
+				free(s);
+				continue;
+			}
+			s->seen = false;
+			pp = &s->next;
+		}
+	}
+}
+
+static void sta_counters_get(struct nlattr **sinfo, struct sta_counters *c)
+{
+	memset(c, 0, sizeof(*c));
+
+	if (sinfo[NL80211_STA_INFO_RX_BYTES64]) {
+		c->rx_bytes = nla_get_u64(sinfo[NL80211_STA_INFO_RX_BYTES64]);
+		c->rx_bytes64 = true;
+	} else if (sinfo[NL80211_STA_INFO_RX_BYTES]) {
+		c->rx_bytes = nla_get_u32(sinfo[NL80211_STA_INFO_RX_BYTES]);
+	}
+	if (sinfo[NL80211_STA_INFO_TX_BYTES64]) {
+		c->tx_bytes = nla_get_u64(sinfo[NL80211_STA_INFO_TX_BYTES64]);
+		c->tx_bytes64 = true;
+	} else if (sinfo[NL80211_STA_INFO_TX_BYTES]) {
+		c->tx_bytes = nla_get_u32(sinfo[NL80211_STA_INFO_TX_BYTES]);
+	}
+
+#define GET_U32(field, attr)						\
+	if (sinfo[NL80211_STA_INFO_ ## attr])				\
+		c->field = nla_get_u32(sinfo[NL80211_STA_INFO_ ## attr])
+
+	GET_U32(rx_packets, RX_PACKETS);
+	GET_U32(tx_packets, TX_PACKETS);
+	GET_U32(tx_retries, TX_RETRIES);
+	GET_U32(tx_failed, TX_FAILED);
+	GET_U32(beacon_loss, BEACON_LOSS);
+
+#undef GET_U32
+}
+
+/*
+ * Difference of a byte counter; a 64-bit counter that went backwards
+ * was reset, a 32-bit one wrapped. Returns false on reset.
+ */
+static bool sta_bytes_delta(uint64_t prev, uint64_t cur, bool is64,
+			    uint64_t *delta)
+{
+	if (!is64) {
+		*delta = (uint32_t)((uint32_t)cur - (uint32_t)prev);
+		return true;
+	}
+	if (cur < prev)
+		return false;
+	*delta = cur - prev;
+	return true;
+}
+
+static int sta_delta_handler(struct nl_msg *msg, void *arg)
+{
+	struct sta_delta_state *sd = arg;
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr *sinfo[NL80211_STA_INFO_MAX + 1];
+	struct sta_counters c, *p;
+	struct sta_sample *s;
+	uint64_t rx_bytes, tx_bytes;
+	double rate[7], secs;
+	long long assoc_at = 0;
+	char mac_addr[20];
+	bool created;
+	int i;
+
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+
+	if (!tb[NL80211_ATTR_MAC] || !tb[NL80211_ATTR_STA_INFO])
+		return NL_SKIP;
+
+	if (sta_info_pick(sd->opts, tb[NL80211_ATTR_STA_INFO], sinfo)) {
+		fprintf(stderr, "failed to parse nested attributes!\n");
+		return NL_SKIP;
+	}
+	if (sd->opts->filter && !sta_filter_match(sd->opts, tb, sinfo))
+		return NL_SKIP;
+
+	if (sinfo[NL80211_STA_INFO_CONNECTED_TIME])
+		assoc_at = sd->now -
+			   nla_get_u32(sinfo[NL80211_STA_INFO_CONNECTED_TIME]);
+
+	s = sta_delta_lookup(sd, nla_data(tb[NL80211_ATTR_MAC]), &created);
+	if (!s)
+		return NL_SKIP;
+	s->seen = true;
+
+	sta_counters_get(sinfo, &c);
+	p = &s->c;
+	mac_addr_n2a(mac_addr, s->addr);
+
+	if (created) {
+		if (sd->report)
+			printf("%-17s (new)\n", mac_addr);
+		goto out;
+	}
+
+	if (llabs(assoc_at - s->assoc_at) > STA_DELTA_ASSOC_SLACK ||
+	    c.rx_bytes64 != p->rx_bytes64 || c.tx_bytes64 != p->tx_bytes64 ||
+	    !sta_bytes_delta(p->rx_bytes, c.rx_bytes, c.rx_bytes64, &rx_bytes) ||
+	    !sta_bytes_delta(p->tx_bytes, c.tx_bytes, c.tx_bytes64, &tx_bytes)) {
+		if (sd->report)
+			printf("%-17s (reassociated/reset)\n", mac_addr);
+		goto out;
+	}
+
+	if (!sd->report)
+		goto out;
+
+	secs = sd->elapsed_ms ? sd->elapsed_ms / 1000.0 : 1;
+	rate[0] = rx_bytes / secs;
+	rate[1] = tx_bytes / secs;
+	rate[2] = (uint32_t)(c.rx_packets - p->rx_packets) / secs;
+	rate[3] = (uint32_t)(c.tx_packets - p->tx_packets) / secs;
+	rate[4] = (uint32_t)(c.tx_retries - p->tx_retries) / secs;
+	rate[5] = (uint32_t)(c.tx_failed - p->tx_failed) / secs;
+	rate[6] = (uint32_t)(c.beacon_loss - p->beacon_loss) / secs;
+
+	printf("%-17s", mac_addr);
+	for (i = 0; i < 7; i++) {
+		printf(i < 2 ? " %12.0f" : " %10.1f", rate[i]);
+		sd->total[i] += rate[i];
+	}
+	printf("\n");
+	sd->n_sta++;
+
+ out:
+	s->assoc_at = assoc_at;
+	s->c = c;
+	return NL_SKIP;
+}
+
+static int handle_station_dump_sample(struct nl80211_state *state,
+				      struct nl_msg *msg,
+				      int argc, char **argv,
+				      enum id_input id)
+{
+	register_handler(sta_delta_handler, &sta_delta);
 	return 0;
 }
-COMMAND(station, dump, "[-v]",
+HIDDEN(station, dump_sample, NULL, NL80211_CMD_GET_STATION, NLM_F_DUMP,
+	CIB_NETDEV, handle_station_dump_sample);
+
+static int handle_station_dump_interval(struct nl80211_state *state,
+					struct nl_msg *msg,
+					int argc, char **argv,
+					enum id_input id)
+{
+	static struct sta_dump_opts opts;
+	char *sample_argv[] = {
+		argv[0],
+		"station",
+		"dump_sample",
+	};
+	unsigned long long last_ms, sample_ms;
+	unsigned int n;
+	int err, i;
+
+	/* we get the full command line, skip "<dev> station dump" */
+	argc -= 3;
+	argv += 3;
+
+	if (parse_sta_dump_opts(&opts, &argc, &argv) || argc ||
+	    !opts.interval_ms || opts.n_fields || opts.vendor || opts.serial)
+		return HANDLER_RET_USAGE;
+
+	/* the counters we need besides whatever the filters want */
+	sta_opts_want(&opts, NL80211_STA_INFO_RX_BYTES, sizeof(uint32_t));
+	sta_opts_want(&opts, NL80211_STA_INFO_TX_BYTES, sizeof(uint32_t));
+	sta_opts_want(&opts, NL80211_STA_INFO_RX_BYTES64, sizeof(uint64_t));
+	sta_opts_want(&opts, NL80211_STA_INFO_TX_BYTES64, sizeof(uint64_t));
+	sta_opts_want(&opts, NL80211_STA_INFO_RX_PACKETS, sizeof(uint32_t));
+	sta_opts_want(&opts, NL80211_STA_INFO_TX_PACKETS, sizeof(uint32_t));
+	sta_opts_want(&opts, NL80211_STA_INFO_TX_RETRIES, sizeof(uint32_t));
+	sta_opts_want(&opts, NL80211_STA_INFO_TX_FAILED, sizeof(uint32_t));
+	sta_opts_want(&opts, NL80211_STA_INFO_BEACON_LOSS, sizeof(uint32_t));
+	sta_opts_want(&opts, NL80211_STA_INFO_CONNECTED_TIME, sizeof(uint32_t));
+
+	sta_delta.opts = &opts;
+	last_ms = now_ms();
+
+	for (n = 0; !opts.count || n <= opts.count; n++) {
+		sample_ms = now_ms();
+		sta_delta.now = sample_ms / 1000;
+		sta_delta.elapsed_ms = sample_ms - last_ms;
+		sta_delta.report = n > 0;
+		sta_delta.n_sta = 0;
+		memset(sta_delta.total, 0, sizeof(sta_delta.total));
+		last_ms = sample_ms;
+
+		if (sta_delta.report)
+			printf("%-17s %12s %12s %10s %10s %10s %10s %10s\n",
+			       "station", "rx B/s", "tx B/s", "rx pkt/s",
+			       "tx pkt/s", "retries/s", "failed/s",
+			       "bcnloss/s");
+
+		err = handle_cmd(state, id, ARRAY_SIZE(sample_argv), sample_argv);
+		if (err)
+			return err;
+
+		sta_delta_prune(&sta_delta);
+
+		if (sta_delta.report) {
+			printf("%-17s", "total");
+			for (i = 0; i < 7; i++)
+				printf(i < 2 ? " %12.0f" : " %10.1f",
+				       sta_delta.total[i]);
+			printf("\n(%d stations, %llu ms)\n\n", sta_delta.n_sta,
+			       sta_delta.elapsed_ms);
+			fflush(stdout);
+		}
+
+		if (!opts.count || n < opts.count)
+			usleep(opts.interval_ms * 1000);
+	}
+
+	return 0;
+}
+
+/*
+ * 'station dump --vendor': one nl80211 station dump, then the firmware
+ * per-peer statistics of every listed station. The vendor requests are
+ * pipelined on the nl80211 socket (see nl80211_batch()) instead of
+ * costing a round trip each; --serial sends them one at a time, which
+ * is what a per-station loop gets, to compare the timings.
+ */
+static const struct sta_vendor_cmd {
+	uint32_t subcmd;
+	const char *name;
+} sta_vendor_cmds[] = {
+	{ LTQ_NL80211_VENDOR_SUBCMD_GET_STA_MEASUREMENTS, "fw measurements" },
+	{ LTQ_NL80211_VENDOR_SUBCMD_GET_PEER_RATE_INFO, "fw peer rate info" },
+	{ LTQ_NL80211_VENDOR_SUBCMD_GET_PEER_PHY_RX_STATUS, "fw peer phy rx status" },
+};
+#define STA_VENDOR_N_CMDS	ARRAY_SIZE(sta_vendor_cmds)
+
+struct sta_vendor_blob {
+	void *data;
+	int len;
+};
+
+struct sta_vendor_rec {
+	struct nl_msg *sta;	/* reference to the station dump message */
+	unsigned char addr[ETH_ALEN];
+	struct sta_vendor_blob blob[STA_VENDOR_N_CMDS];
+};
+
+struct sta_vendor_state {
+	const struct sta_dump_opts *opts;
+	struct sta_vendor_rec *recs;
+	int n_recs, size;
+};
+
+static int sta_vendor_collect(struct nl_msg *msg, void *arg)
+{
+	struct sta_vendor_state *sv = arg;
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr *sinfo[NL80211_STA_INFO_MAX + 1];
+	struct sta_vendor_rec *rec;
+
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+
+	if (!tb[NL80211_ATTR_MAC] || !tb[NL80211_ATTR_STA_INFO])
+		return NL_SKIP;
+
+	if (sv->opts->filter) {
+		if (sta_info_pick(sv->opts, tb[NL80211_ATTR_STA_INFO], sinfo)) {
+			fprintf(stderr, "failed to parse nested attributes!\n");
+			return NL_SKIP;
+		}
+		if (!sta_filter_match(sv->opts, tb, sinfo))
+			return NL_SKIP;
+	}
+
+	if (sv->n_recs == sv->size) {
+		int size = sv->size ? sv->size * 2 : 64;
+
+		rec = realloc(sv->recs, size * sizeof(*rec));
+		if (!rec)
+			return NL_SKIP;
+		sv->recs = rec;
+		sv->size = size;
+	}
+
+	rec = &sv->recs[sv->n_recs++];
+	memset(rec, 0, sizeof(*rec));
+	memcpy(rec->addr, nla_data(tb[NL80211_ATTR_MAC]), ETH_ALEN);
+	/* keep the message around, it is printed once the vendor data is in */
+	nlmsg_get(msg);
+	rec->sta = msg;
+
+	return NL_SKIP;
+}
+
+static int sta_vendor_data_handler(struct nl_msg *msg, void *arg)
+{
+	struct sta_vendor_blob *blob = arg;
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr *attr;
+
+	attr = nla_find(genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0),
+			NL80211_ATTR_VENDOR_DATA);
+	if (!attr || blob->data)
+		return NL_SKIP;
+
+	blob->data = malloc(nla_len(attr));
+	if (!blob->data)
+		return NL_SKIP;
+	memcpy(blob->data, nla_data(attr), nla_len(attr));
+	blob->len = nla_len(attr);
+
+	return NL_SKIP;
+}
+
+static struct nl_msg *sta_vendor_msg(struct nl80211_state *state,
+				     int ifindex, uint32_t subcmd,
+				     const unsigned char *addr)
+{
+	struct nl_msg *msg;
+
+	msg = nl80211_batch_msg(state, NL80211_CMD_VENDOR, 0, ifindex);
+	if (!msg)
+		return NULL;
+
+	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ);
+	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_SUBCMD, subcmd);
+	NLA_PUT(msg, NL80211_ATTR_VENDOR_DATA, ETH_ALEN, addr);
+
+	return msg;
+ nla_put_failure:
+	nlmsg_free(msg);
+	return NULL;
+}
+
+/* the rate info and phy rx status replies are printed as raw words */
+static void print_sta_vendor_words(const char *name,
+				   const struct sta_vendor_blob *blob)
+{
+	const unsigned char *data = blob->data;
+	uint32_t val;
+	int i;
+
+	printf("\t%s:\t", name);
+	for (i = 0; i + (int)sizeof(val) <= blob->len; i += sizeof(val)) {
+		memcpy(&val, data + i, sizeof(val));
+		printf("%d ", (int)val);
+	}
+	printf("\n");
+}
+
+static int handle_station_dump_vendor(struct nl80211_state *state,
+				      struct nl_msg *msg,
+				      int argc, char **argv,
+				      enum id_input id)
+{
+	static struct sta_dump_opts opts;
+	struct sta_vendor_state sv = {
+		.opts = &opts,
+	};
+	struct nl80211_batch_req dump = {}, *reqs = NULL, *req;
+	unsigned long long start_ms, dump_ms, vendor_ms;
+	struct sta_vendor_rec *rec;
+	unsigned int j;
+	int ifindex, n_reqs, err = 0, i;
+
+	ifindex = if_nametoindex(argv[0]);
+	if (!ifindex)
+		return -ENODEV;
+
+	/* we get the full command line, skip "<dev> station dump" */
+	argc -= 3;
+	argv += 3;
+
+	if (parse_sta_dump_opts(&opts, &argc, &argv) || argc ||
+	    !opts.vendor || opts.interval_ms || opts.count)
+		return HANDLER_RET_USAGE;
+
+	dump.msg = nl80211_batch_msg(state, NL80211_CMD_GET_STATION,
+				     NLM_F_DUMP, ifindex);
+	if (!dump.msg)
+		return -ENOMEM;
+	dump.handler = sta_vendor_collect;
+	dump.arg = &sv;
+
+	start_ms = now_ms();
+	err = nl80211_batch(state, &dump, 1, 1);
+	nlmsg_free(dump.msg);
+	if (!err)
+		err = dump.err;
+	if (err)
+		goto out;
+	dump_ms = now_ms() - start_ms;
+
+	n_reqs = sv.n_recs * STA_VENDOR_N_CMDS;
+	if (n_reqs) {
+		reqs = calloc(n_reqs, sizeof(*reqs));
+		if (!reqs) {
+			err = -ENOMEM;
+			goto out;
+		}
+	}
+
+	for (i = 0; i < sv.n_recs; i++) {
+		rec = &sv.recs[i];
+		for (j = 0; j < STA_VENDOR_N_CMDS; j++) {
+			req = &reqs[i * STA_VENDOR_N_CMDS + j];
+			req->msg = sta_vendor_msg(state, ifindex,
+						  sta_vendor_cmds[j].subcmd,
+						  rec->addr);
+			if (!req->msg) {
+				err = -ENOMEM;
+				goto out;
+			}
+			req->handler = sta_vendor_data_handler;
+			req->arg = &rec->blob[j];
+		}
+	}
+
+	start_ms = now_ms();
+	err = nl80211_batch(state, reqs, n_reqs,
+			    opts.serial ? 1 : STA_BATCH_WINDOW);
+	if (err)
+		goto out;
+	vendor_ms = now_ms() - start_ms;
+
+	for (i = 0; i < sv.n_recs; i++) {
+		rec = &sv.recs[i];
+		print_sta_handler(rec->sta, &opts);
+
+		for (j = 0; j < STA_VENDOR_N_CMDS; j++) {
+			req = &reqs[i * STA_VENDOR_N_CMDS + j];
+			if (req->err) {
+				printf("\t%s:\terror: %s\n",
+				       sta_vendor_cmds[j].name,
+				       strerror(-req->err));
+			} else if (!rec->blob[j].data) {
+				printf("\t%s:\tno data\n",
+				       sta_vendor_cmds[j].name);
+			} else if (sta_vendor_cmds[j].subcmd ==
+				   LTQ_NL80211_VENDOR_SUBCMD_GET_STA_MEASUREMENTS) {
+				print_vendor_sta_info(rec->blob[j].data,
+						      rec->blob[j].len);
+			} else {
+				print_sta_vendor_words(sta_vendor_cmds[j].name,
+						       &rec->blob[j]);
+			}
+		}
+	}
+
+	printf("\n%d stations: station dump %llu ms, %d vendor requests %llu ms (%s)\n",
+	       sv.n_recs, dump_ms, n_reqs, vendor_ms,
+	       opts.serial ? "one at a time" : "pipelined");
+
+ out:
+	for (i = 0; reqs && i < n_reqs; i++)
+		nlmsg_free(reqs[i].msg);
+	free(reqs);
+	for (i = 0; i < sv.n_recs; i++) {
+		for (j = 0; j < STA_VENDOR_N_CMDS; j++)
+			free(sv.recs[i].blob[j].data);
+		nlmsg_free(sv.recs[i].sta);
+	}
+	free(sv.recs);
+	return err;
+}
+
+static const struct cmd *station_dump_plain;
+static const struct cmd *station_dump_interval;
+static const struct cmd *station_dump_vendor;
+
+static const struct cmd *select_station_dump_cmd(int argc, char **argv)
+{
+	bool vendor = false;
+	int i;
+
+	for (i = 0; i < argc; i++) {
+		if (!strcmp(argv[i], "--interval"))
+			return station_dump_interval;
+		if (!strcmp(argv[i], "--vendor"))
+			vendor = true;
+	}
+	return vendor ? station_dump_vendor : station_dump_plain;
+}
+
+COMMAND_ALIAS(station, dump, "[-v] [--mac <addr>[/<mask>][,<addr>[/<mask>]...]] "
+	"[--inactive-above <ms>] [--inactive-below <ms>] [--signal [<min>]:[<max>]] "
+	"[--authorized|--unauthorized] [--associated|--unassociated] [--mlo|--no-mlo] "
+	"[--fields <field>[,<field>...]]",
 	NL80211_CMD_GET_STATION, NLM_F_DUMP, CIB_NETDEV, handle_station_dump,
-	"List all stations known, e.g. the AP on managed interfaces");
+	"List all stations known, e.g. the AP on managed interfaces.\n"
+	"Stations can be filtered by MAC address (list or address/mask),\n"
+	"inactive time, signal range (dBm), authorized/associated flags and\n"
+	"MLO link presence. --fields restricts the output to the given\n"
+	"fields, e.g. --fields rx_bytes,tx_bytes,signal,tx_bitrate; an unknown\n"
+	"field name prints the list of valid ones.",
+	select_station_dump_cmd, station_dump_plain);
+COMMAND_ALIAS(station, dump, "[<filters>] --interval <ms> [--count <n>]",
+	0, 0, CIB_NETDEV, handle_station_dump_interval,
+	"Sample the stations every <ms> milliseconds (<n> times, default\n"
+	"forever) and print per-station rates: bytes/s, packets/s, tx\n"
+	"retries/s, tx failed/s and beacon loss/s, plus totals for the\n"
+	"interface. Counter wraps and reassociations are accounted for.\n"
+	"The filters are the same as for the plain dump.",
+	select_station_dump_cmd, station_dump_interval);
+COMMAND_ALIAS(station, dump, "[<filters>] --vendor [--serial]",
+	0, 0, CIB_NETDEV, handle_station_dump_vendor,
+	"Dump the stations together with the firmware per-peer statistics\n"
+	"(station measurements, peer rate info and phy rx status) in one\n"
+	"record per station. The vendor requests for all stations are\n"
+	"pipelined; --serial sends them one at a time for comparison.",
+	select_station_dump_cmd, station_dump_vendor);
@@ -1,6 +1,10 @@
 #include <errno.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <net/if.h>
 
 #include <netlink/genl/genl.h>
 #include <netlink/genl/family.h>
@@ -106,48 +110,171 @@ typedef struct la_mu_groups_counters_stats {
 	mu_groups_counters_t dlMimoGroupsCounters;
 	mu_groups_counters_t ulMimoGroupsCounters;
 } la_mu_groups_counters_stats_t;
+
+/*
+ * Firmware releases grow removalReason[], so the reply is not decoded by
+ * sizeof(la_mu_groups_counters_stats_t). The four sections are taken to
+ * be of equal size after the is_gen6 header, and the reason count is
+ * derived from the section size. Reasons past REMOVAL_REASON_MAX are
+ * printed by index; with an odd count the trailing padding shows up as
+ * one extra (zero) reason.
+ */
+#define MU_GROUPS_SECTIONS	4
+#define MU_GROUPS_REASONS_MAX	256
+
+typedef struct mu_groups_section {
+	uint32_t groupsCreated;
+	uint32_t groupsRemoved;
+	uint16_t removalReason[MU_GROUPS_REASONS_MAX];
+	int nReasons;
+} mu_groups_section_t;
+
+typedef struct mu_groups_sample {
+	bool valid;
+	bool is_gen6;
+	mu_groups_section_t sections[MU_GROUPS_SECTIONS];
+} mu_groups_sample_t;
+
+static const struct {
+	const char *name;
+	int reason_start, reason_end;
+} mu_groups_sections[MU_GROUPS_SECTIONS] = {
+	{ "Downlink OFDMA", REMOVAL_REASON_DLOFDMA_MINXPUT, REMOVAL_REASON_DLOFDMA_CONGESTION },
+	{ "Uplink OFDMA", REMOVAL_REASON_ULOFDMA_CONGESTION, REMOVAL_REASON_ULOFDMA_UPHALGO },
+	{ "Downlink MIMO", REMOVAL_REASON_DLMIMO_MINXPUT, REMOVAL_REASON_DLMIMO_ULPCALGO },
+	{ "Uplink MIMO", REMOVAL_REASON_ULMIMO_MINXPUT, REMOVAL_REASON_ULMIMO_UPHALGO },
+};
 /*****************************/
 
 /**** Headers ****/
 static int print_link_adapt_mu_groups_counters(struct nl_msg *msg, void *arg);
-static void dump_la_mu_groups_counters_stats(char *outData, unsigned int outLen);
+static void dump_la_mu_groups_counters_stats(mu_groups_sample_t *sample);
+static void dump_la_mu_groups_churn(const mu_groups_sample_t *now,
+				    const mu_groups_sample_t *old,
+				    unsigned long long interval_ms);
 /*****************/
 
-/***************************** GET FUNCTIONS *****************************/
-static int get_stat(struct nl_msg *msg,
-			int argc, char **argv,
-			enum ltq_nl80211_vendor_subcmds subcmd,
-			int (*stat_handler)(struct nl_msg *, void *))
+/***************************** GET HANDLERS *****************************/
+static int handle_stats_get_link_adapt_mu_groups_counters(struct nl80211_state *state,
+					struct nl_msg *msg, int argc,
+					char **argv, enum id_input id)
 {
-	if (!msg) return -EFAULT;
+	static mu_groups_sample_t samples[2];
+	struct nl80211_batch_req req = {};
+	unsigned long interval_ms = 0, count = 0, n;
+	unsigned long long last_ms = 0, sample_ms;
+	const char *dev = argv[0];
+	int ifindex, err = 0, cur = 0, i, used;
 
-	register_handler(stat_handler, NULL);
+	/* we get the full command line, skip "<dev> iwlwav gLinkAdaptationMuGroupsCounters" */
+	argc -= 3;
+	argv += 3;
 
-	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_ID, OUI_MXL);
-	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_SUBCMD, subcmd);
+	for (i = 0; i < argc; i += used) {
+		used = parse_interval_count(argc - i, argv + i, &interval_ms,
+					    &count);
+		if (used <= 0)
+			return HANDLER_RET_USAGE;
+	}
+	if (count && !interval_ms)
+		return HANDLER_RET_USAGE;
 
-	return 0;
-nla_put_failure:
+	ifindex = if_nametoindex(dev);
+	if (!ifindex)
+		return -ENODEV;
+
+	req.msg = nl80211_batch_msg(state, NL80211_CMD_VENDOR, 0, ifindex);
+	if (!req.msg)
+		return -ENOMEM;
+	NLA_PUT_U32(req.msg, NL80211_ATTR_VENDOR_ID, OUI_MXL);
+	NLA_PUT_U32(req.msg, NL80211_ATTR_VENDOR_SUBCMD,
+		    LTQ_NL80211_VENDOR_SUBCMD_GET_LINK_ADAPT_MU_GROUPS_COUNTERS_STATS);
+	req.handler = print_link_adapt_mu_groups_counters;
+
+	for (n = 0; ; n++) {
+		memset(&samples[cur], 0, sizeof(samples[cur]));
+		req.arg = &samples[cur];
+		req.done = false;
+		req.err = 0;
+		err = nl80211_batch(state, &req, 1, 1);
+		if (!err)
+			err = req.err;
+		/* the handler has said what is wrong with the reply */
+		if (!err && !samples[cur].valid)
+			err = -EINVAL;
+		if (err)
+			goto out;
+		sample_ms = now_ms();
+
+		if (!interval_ms) {
+			dump_la_mu_groups_counters_stats(&samples[cur]);
+			break;
+		}
+
+		if (n > 0) {
+			dump_la_mu_groups_churn(&samples[cur], &samples[!cur],
+						sample_ms - last_ms);
+			fflush(stdout);
+		}
+		last_ms = sample_ms;
+		cur = !cur;
+
+		if (count && n >= count)
+			break;
+		usleep(interval_ms * 1000);
+	}
+
+ out:
+	nlmsg_free(req.msg);
+	return err;
+
+ nla_put_failure:
+	nlmsg_free(req.msg);
 	return -ENOBUFS;
 }
-/*************************************************************************/
+COMMAND(iwlwav, gLinkAdaptationMuGroupsCounters, "[--interval <ms> [--count <n>]]",
+	0, 0, CIB_NETDEV, handle_stats_get_link_adapt_mu_groups_counters,
+	"Get the MU groups counters. With --interval print the group churn\n"
+	"per category and the dominant removal reasons every <ms> milliseconds.");
+/************************************************************************/
 
-/***************************** GET HANDLERS *****************************/
-static int handle_stats_get_link_adapt_mu_groups_counters(struct nl80211_state *state,
-					struct nl_msg *msg, int argc,
-					char **argv, enum id_input id)
+/***************************** PRINT FUNCTIONS ****************************/
+static int mu_groups_parse(const uint8_t *data, int len, mu_groups_sample_t *sample)
 {
-	return get_stat(msg, argc, argv, LTQ_NL80211_VENDOR_SUBCMD_GET_LINK_ADAPT_MU_GROUPS_COUNTERS_STATS, print_link_adapt_mu_groups_counters);
+	int hdr = offsetof(la_mu_groups_counters_stats_t, dlOfdmaGroupsCounters);
+	int reasons = offsetof(mu_groups_counters_t, removalReason);
+	int sec_len, i, j;
+
+	if (len <= hdr || (len - hdr) % MU_GROUPS_SECTIONS)
+		return -EMSGSIZE;
+	sec_len = (len - hdr) / MU_GROUPS_SECTIONS;
+	if (sec_len < reasons || sec_len % __alignof__(mu_groups_counters_t))
+		return -EMSGSIZE;
+
+	sample->is_gen6 = data[0];
+	for (i = 0; i < MU_GROUPS_SECTIONS; i++) {
+		const uint8_t *sec = data + hdr + i * sec_len;
+		mu_groups_section_t *s = &sample->sections[i];
+
+		memcpy(&s->groupsCreated, sec + offsetof(mu_groups_counters_t, groupsCreated),
+		       sizeof(s->groupsCreated));
+		memcpy(&s->groupsRemoved, sec + offsetof(mu_groups_counters_t, groupsRemoved),
+		       sizeof(s->groupsRemoved));
+		s->nReasons = MIN((sec_len - reasons) / (int)sizeof(uint16_t),
+				  MU_GROUPS_REASONS_MAX);
+		for (j = 0; j < s->nReasons; j++)
+			memcpy(&s->removalReason[j], sec + reasons + j * sizeof(uint16_t),
+			       sizeof(uint16_t));
+	}
+	sample->valid = true;
+	return 0;
 }
-COMMAND(iwlwav, gLinkAdaptationMuGroupsCounters, "", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_stats_get_link_adapt_mu_groups_counters, "");
-/************************************************************************/
 
-/***************************** PRINT FUNCTIONS ****************************/
 static int print_link_adapt_mu_groups_counters(struct nl_msg *msg, void *arg)
 {
+	mu_groups_sample_t *sample = arg;
 	struct nlattr *attr;
 	struct genlmsghdr *gnlh;
-	char *data = NULL;
 
 	gnlh = nlmsg_data(nlmsg_hdr(msg));
 	attr = nla_find(genlmsg_attrdata(gnlh, 0),
@@ -159,12 +286,11 @@ static int print_link_adapt_mu_groups_counters(struct nl_msg *msg, void *arg)
 		return NL_SKIP;
 	}
 
-	data = (char *)nla_data(attr);
-	if (data != NULL) {
-		dump_la_mu_groups_counters_stats(data, nla_len(attr));
-	}
+	if (mu_groups_parse(nla_data(attr), nla_len(attr), sample))
+		fprintf(stderr, "ERROR: MU groups counters reply of %d bytes doesn't match the layout\n",
+			nla_len(attr));
 
-	return NL_OK;
+	return NL_SKIP;
 }
 /**************************************************************************/
 
@@ -265,7 +391,7 @@ static const char* _getLaMuRemovalReasonName(group_removal_reason_t reason)
 	}
 }
 
-static void _dump_la_mu_groups_counters(mu_groups_counters_t *counters, int removal_reason_start, int removal_reason_end)
+static void _dump_la_mu_groups_counters(const mu_groups_section_t *counters, int removal_reason_start, int removal_reason_end)
 {
 	const char *_fmt = "\t\t%-40s - %3u\n";
 	int loop_start;
@@ -278,47 +404,1687 @@ static void _dump_la_mu_groups_counters(mu_groups_counters_t *counters, int remo
 
 	/* Print removal reasons that can only be applied to this Formation Type */
 	loop_start = removal_reason_start;
-	loop_end   = MIN((REMOVAL_REASON_MAX -1), removal_reason_end);
+	loop_end   = MIN((counters->nReasons - 1), removal_reason_end);
 	for (i = loop_start; i <= loop_end; i++) {
 		fprintf(stdout, _fmt, _getLaMuRemovalReasonName(i), counters->removalReason[i]);
 	}
 
 	/* Print Removal Requestors */
 	loop_start  = REMOVAL_REASON_REQUESTOR_DISABLE_PROCESS;
-	loop_end    = REMOVAL_REASON_REQUESTOR_INVALID_UL_PSDU_LENGTH;
+	loop_end    = MIN((counters->nReasons - 1), REMOVAL_REASON_REQUESTOR_INVALID_UL_PSDU_LENGTH);
 	for (i = loop_start; i <= loop_end; i++) {
 		fprintf(stdout, _fmt, _getLaMuRemovalReasonName(i), counters->removalReason[i]);
 	}
 
 	/* Print Other Reasons */
-	fprintf(stdout, _fmt, _getLaMuRemovalReasonName(REMOVAL_REASON_OTHER), counters->removalReason[REMOVAL_REASON_OTHER]);
+	if (REMOVAL_REASON_OTHER < counters->nReasons)
+		fprintf(stdout, _fmt, _getLaMuRemovalReasonName(REMOVAL_REASON_OTHER), counters->removalReason[REMOVAL_REASON_OTHER]);
+
+	/* Print reasons newer than this iw by index */
+	for (i = REMOVAL_REASON_MAX; i < counters->nReasons; i++)
+		fprintf(stdout, "\t\tReason %-33d - %3u\n", i, counters->removalReason[i]);
 }
 
-static void dump_la_mu_groups_counters_stats(char *outData, unsigned int outLen)
+static void dump_la_mu_groups_counters_stats(mu_groups_sample_t *stats)
 {
-	la_mu_groups_counters_stats_t *stats = (la_mu_groups_counters_stats_t *)outData;
+	int i;
 
-	if (outLen != sizeof(*stats)) {
-		fprintf(stdout, "\nERROR: Unaligned iw/driver shared structure\n");
+	if (!stats->valid)
 		return;
-	}
 
 	fprintf(stdout, "\n####################################################################\n");
 
-	fprintf(stdout, "\nDownlink OFDMA Groups Counters\n");
-	_dump_la_mu_groups_counters(&stats->dlOfdmaGroupsCounters, REMOVAL_REASON_DLOFDMA_MINXPUT, REMOVAL_REASON_DLOFDMA_CONGESTION);
-
-	fprintf(stdout, "\nUplink OFDMA Groups Counters\n");
-	_dump_la_mu_groups_counters(&stats->ulOfdmaGroupsCounters, REMOVAL_REASON_ULOFDMA_CONGESTION, REMOVAL_REASON_ULOFDMA_UPHALGO);
+	if (stats->sections[0].nReasons != REMOVAL_REASON_MAX)
+		fprintf(stdout, "\nremovalReason[] has %d entries, %d known\n",
+			stats->sections[0].nReasons, REMOVAL_REASON_MAX);
 
-	fprintf(stdout, "\nDownlink MIMO Groups Counters\n");
-	_dump_la_mu_groups_counters(&stats->dlMimoGroupsCounters, REMOVAL_REASON_DLMIMO_MINXPUT, REMOVAL_REASON_DLMIMO_ULPCALGO);
-
-	if (!stats->is_gen6) {
-		fprintf(stdout, "\nUplink MIMO Groups Counters\n");
-		_dump_la_mu_groups_counters(&stats->ulMimoGroupsCounters, REMOVAL_REASON_ULMIMO_MINXPUT, REMOVAL_REASON_ULMIMO_UPHALGO);
+	for (i = 0; i < MU_GROUPS_SECTIONS; i++) {
+		/* gen6 has no uplink MIMO groups */
+		if (stats->is_gen6 && mu_groups_sections[i].reason_start == REMOVAL_REASON_ULMIMO_MINXPUT)
+			continue;
+		fprintf(stdout, "\n%s Groups Counters\n", mu_groups_sections[i].name);
+		_dump_la_mu_groups_counters(&stats->sections[i], mu_groups_sections[i].reason_start,
+					    mu_groups_sections[i].reason_end);
 	}
 
 	fprintf(stdout, "\n####################################################################\n\n");
 }
+
+static const char *mu_groups_reason_name(int reason, char *buf, size_t len)
+{
+	if (reason < REMOVAL_REASON_MAX)
+		return _getLaMuRemovalReasonName(reason);
+	snprintf(buf, len, "Reason %d", reason);
+	return buf;
+}
+
+/*
+ * Interval mode: per category the groups created and removed in the
+ * interval with their rate, and the three removal reasons that account
+ * for most of the removals. Reasons are 16 bit counters, deltas are
+ * taken modulo 2^16 so a wrap doesn't show up as a huge count.
+ */
+#define MU_GROUPS_TOP_REASONS	3
+
+static void dump_la_mu_groups_churn(const mu_groups_sample_t *now,
+				    const mu_groups_sample_t *old,
+				    unsigned long long interval_ms)
+{
+	int i, j, k, n;
+
+	if (!now->valid || !old->valid)
+		return;
+
+	fprintf(stdout, "%llu ms:\n", interval_ms);
+	for (i = 0; i < MU_GROUPS_SECTIONS; i++) {
+		const mu_groups_section_t *c = &now->sections[i];
+		const mu_groups_section_t *p = &old->sections[i];
+		int top[MU_GROUPS_TOP_REASONS] = {};
+		uint16_t top_d[MU_GROUPS_TOP_REASONS] = {};
+		uint32_t created = c->groupsCreated - p->groupsCreated;
+		uint32_t removed = c->groupsRemoved - p->groupsRemoved;
+		unsigned int total = 0;
+		char buf[24];
+
+		if (now->is_gen6 && mu_groups_sections[i].reason_start == REMOVAL_REASON_ULMIMO_MINXPUT)
+			continue;
+
+		fprintf(stdout, "\t%-16s created %6u (%.1f/s) removed %6u (%.1f/s)\n",
+			mu_groups_sections[i].name, created,
+			created * 1000.0 / interval_ms, removed,
+			removed * 1000.0 / interval_ms);
+
+		n = MIN(c->nReasons, p->nReasons);
+		for (j = 0; j < n; j++) {
+			uint16_t d = c->removalReason[j] - p->removalReason[j];
+
+			total += d;
+			/* insertion into the top list, largest first */
+			for (k = MU_GROUPS_TOP_REASONS; k > 0 && d > top_d[k - 1]; k--) {
+				if (k < MU_GROUPS_TOP_REASONS) {
+					top[k] = top[k - 1];
+					top_d[k] = top_d[k - 1];
+				}
+			}
+			if (k < MU_GROUPS_TOP_REASONS) {
+				top[k] = j;
+				top_d[k] = d;
+			}
+		}
+
+		for (k = 0; k < MU_GROUPS_TOP_REASONS && top_d[k]; k++)
+			fprintf(stdout, "\t\t%-40s %6u (%.1f%%)\n",
+				mu_groups_reason_name(top[k], buf, sizeof(buf)),
+				top_d[k], top_d[k] * 100.0 / total);
+	}
+	fprintf(stdout, "\n");
+}
 /*************************************************************************/
+
+static void print_vendor_antennas(const char *name, const s8 *val)
+{
+	int i;
+
+	fprintf(stdout, "\t%s:\t[", name);
+	for (i = 0; i < WAVE_STAT_MAX_ANTENNAS; i++)
+		fprintf(stdout, "%s%d", i ? ", " : "", val[i]);
+	fprintf(stdout, "]\n");
+}
+
+/*
+ * Decode a GET_STA_MEASUREMENTS reply (struct intel_vendor_sta_info).
+ * A reply that is longer than the structure is decoded up to its size,
+ * a shorter one is refused.
+ */
+int print_vendor_sta_info(const void *data, int len)
+{
+	struct intel_vendor_sta_info info;
+
+	if (len < (int)sizeof(info)) {
+		fprintf(stdout, "\tfw measurements:\tshort reply (%d < %d bytes)\n",
+			len, (int)sizeof(info));
+		return -EINVAL;
+	}
+
+	/* the reply isn't necessarily aligned for the 64-bit counters */
+	memcpy(&info, data, sizeof(info));
+
+	fprintf(stdout, "\tfw station id:\t%u\n", info.StationId);
+	fprintf(stdout, "\tfw net modes:\t0x%x\n", info.NetModesSupported);
+	fprintf(stdout, "\tfw rx bytes:\t%llu\n", info.BytesReceived);
+	fprintf(stdout, "\tfw rx packets:\t%llu\n", info.PacketsReceived);
+	fprintf(stdout, "\tfw tx bytes:\t%llu\n", info.BytesSent);
+	fprintf(stdout, "\tfw tx packets:\t%llu\n", info.PacketsSent);
+	fprintf(stdout, "\tfw tx retrans:\t%u\n", info.RetransCount);
+	fprintf(stdout, "\tfw tx retrans failed:\t%u\n", info.FailedRetransCount);
+	fprintf(stdout, "\tfw tx retries:\t%u\n", info.RetryCount);
+	fprintf(stdout, "\tfw tx errors:\t%u\n", info.ErrorsSent);
+	fprintf(stdout, "\tfw last uplink rate:\t%u kbps\n", info.LastDataUplinkRate);
+	fprintf(stdout, "\tfw last downlink rate:\t%u kbps\n", info.LastDataDownlinkRate);
+	fprintf(stdout, "\tfw max rate:\t%u kbps\n", info.MaxRate);
+	if (info.RateInfoFlag)
+		fprintf(stdout, "\tfw rate info:\tphy mode %u, %u MHz, MCS %u, NSS %u\n",
+			info.RatePhyMode, info.RateCbwMHz, info.RateMcs, info.RateNss);
+	print_vendor_antennas("fw snr", info.snr);
+	print_vendor_antennas("fw rssi avg", info.ShortTermRSSIAverage);
+	fprintf(stdout, "\tfw signal:\t%d dBm\n", info.SignalStrength);
+	fprintf(stdout, "\tfw tx mgmt power:\t%u\n", info.TxMgmtPwr);
+	fprintf(stdout, "\tfw tx stbc mode:\t%u\n", info.TxStbcMode);
+
+	return 0;
+}
+
+/*
+ * 'iwlwav gStaMeasurements' reads GET_STA_MEASUREMENTS of one station or,
+ * without an address, of every station of the VAP: one nl80211 station
+ * dump for the addresses, then the vendor requests pipelined. With
+ * --interval the 64-bit counters are turned into rates. The RSSI
+ * imbalance is the spread of the per-antenna short term averages;
+ * antennas reporting -128 are not connected and left out.
+ */
+#define STA_MSR_MAX		256
+#define STA_MSR_WINDOW		16
+#define STA_MSR_NO_ANTENNA	-128
+
+struct sta_msr {
+	unsigned char addr[ETH_ALEN];
+	bool valid;
+	int err;
+	struct intel_vendor_sta_info info;
+};
+
+struct sta_msr_set {
+	struct sta_msr stas[STA_MSR_MAX];
+	int n;
+};
+
+/* current and previous sample */
+static struct sta_msr_set sta_msr_sets[2];
+
+static int sta_msr_dump_handler(struct nl_msg *msg, void *arg)
+{
+	struct sta_msr_set *set = arg;
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+	if (!tb[NL80211_ATTR_MAC] || set->n == STA_MSR_MAX)
+		return NL_SKIP;
+
+	memset(&set->stas[set->n], 0, sizeof(set->stas[0]));
+	memcpy(set->stas[set->n++].addr, nla_data(tb[NL80211_ATTR_MAC]),
+	       ETH_ALEN);
+	return NL_SKIP;
+}
+
+static int sta_msr_handler(struct nl_msg *msg, void *arg)
+{
+	struct sta_msr *sm = arg;
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr *attr;
+
+	attr = nla_find(genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0),
+			NL80211_ATTR_VENDOR_DATA);
+	if (!attr) {
+		sm->err = -ENODATA;
+		return NL_SKIP;
+	}
+	if (nla_len(attr) < (int)sizeof(sm->info)) {
+		sm->err = -EMSGSIZE;
+		return NL_SKIP;
+	}
+
+	/* the reply isn't necessarily aligned for the 64-bit counters */
+	memcpy(&sm->info, nla_data(attr), sizeof(sm->info));
+	sm->valid = true;
+	return NL_SKIP;
+}
+
+static int sta_msr_fetch(struct nl80211_state *state, int ifindex,
+			 struct sta_msr_set *set)
+{
+	struct nl80211_batch_req *reqs;
+	int i, err = 0;
+
+	reqs = calloc(set->n, sizeof(*reqs));
+	if (set->n && !reqs)
+		return -ENOMEM;
+
+	for (i = 0; i < set->n; i++) {
+		struct nl_msg *msg;
+
+		set->stas[i].valid = false;
+		set->stas[i].err = 0;
+
+		msg = nl80211_batch_msg(state, NL80211_CMD_VENDOR, 0, ifindex);
+		if (!msg) {
+			err = -ENOMEM;
+			goto out;
+		}
+		reqs[i].msg = msg;
+		reqs[i].handler = sta_msr_handler;
+		reqs[i].arg = &set->stas[i];
+		NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ);
+		NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_SUBCMD,
+			    LTQ_NL80211_VENDOR_SUBCMD_GET_STA_MEASUREMENTS);
+		NLA_PUT(msg, NL80211_ATTR_VENDOR_DATA, ETH_ALEN,
+			set->stas[i].addr);
+	}
+
+	err = nl80211_batch(state, reqs, set->n, STA_MSR_WINDOW);
+	for (i = 0; !err && i < set->n; i++)
+		if (reqs[i].err)
+			set->stas[i].err = reqs[i].err;
+	goto out;
+
+ nla_put_failure:
+	err = -ENOBUFS;
+ out:
+	for (i = 0; i < set->n; i++)
+		nlmsg_free(reqs[i].msg);
+	free(reqs);
+	return err;
+}
+
+/* spread of the connected antennas, -1 if fewer than two */
+static int sta_msr_imbalance(const struct intel_vendor_sta_info *info,
+			     int *min, int *max)
+{
+	int i, n = 0;
+
+	for (i = 0; i < WAVE_STAT_MAX_ANTENNAS; i++) {
+		int rssi = info->ShortTermRSSIAverage[i];
+
+		if (rssi == STA_MSR_NO_ANTENNA)
+			continue;
+		if (!n || rssi < *min)
+			*min = rssi;
+		if (!n || rssi > *max)
+			*max = rssi;
+		n++;
+	}
+	return n < 2 ? -1 : *max - *min;
+}
+
+static const struct sta_msr *sta_msr_find(const struct sta_msr_set *set,
+					  const unsigned char *addr)
+{
+	int i;
+
+	for (i = 0; i < set->n; i++)
+		if (!memcmp(set->stas[i].addr, addr, ETH_ALEN))
+			return &set->stas[i];
+	return NULL;
+}
+
+static void sta_msr_print_rates(const struct sta_msr *sm,
+				const struct sta_msr *prev,
+				unsigned long long ms)
+{
+	const struct intel_vendor_sta_info *cur = &sm->info, *old;
+	char addr[20];
+	int min = 0, max = 0, imb;
+
+	mac_addr_n2a(addr, sm->addr);
+	if (!sm->valid || !prev || !prev->valid || !ms) {
+		fprintf(stdout, "%s\t%s\n", addr,
+			sm->err ? strerror(-sm->err) : "-");
+		return;
+	}
+	old = &prev->info;
+
+	/* 64-bit counters going backwards means the station re-associated */
+	if (cur->BytesSent < old->BytesSent ||
+	    cur->BytesReceived < old->BytesReceived ||
+	    cur->PacketsSent < old->PacketsSent ||
+	    cur->PacketsReceived < old->PacketsReceived) {
+		fprintf(stdout, "%s\tcounters reset\n", addr);
+		return;
+	}
+
+	fprintf(stdout, "%s\trx %.1f kbit/s %.1f pkt/s\ttx %.1f kbit/s %.1f pkt/s\tretries %.1f/s\terrors %.1f/s",
+		addr,
+		(cur->BytesReceived - old->BytesReceived) * 8.0 / ms,
+		(cur->PacketsReceived - old->PacketsReceived) * 1000.0 / ms,
+		(cur->BytesSent - old->BytesSent) * 8.0 / ms,
+		(cur->PacketsSent - old->PacketsSent) * 1000.0 / ms,
+		(u32)(cur->RetryCount - old->RetryCount) * 1000.0 / ms,
+		(u32)(cur->ErrorsSent - old->ErrorsSent) * 1000.0 / ms);
+
+	imb = sta_msr_imbalance(cur, &min, &max);
+	if (imb >= 0)
+		fprintf(stdout, "\trssi imbalance %d dB (%d..%d)", imb, min, max);
+	fprintf(stdout, "\n");
+}
+
+static int handle_stats_get_sta_measurements(struct nl80211_state *state,
+					     struct nl_msg *msg, int argc,
+					     char **argv, enum id_input id)
+{
+	unsigned long interval_ms = 0, count = 0, n;
+	unsigned long long last_ms = 0, sample_ms;
+	struct sta_msr_set *set = &sta_msr_sets[0];
+	const char *dev = argv[0];
+	int ifindex, err, cur = 0, i, used;
+
+	/* we get the full command line, skip "<dev> iwlwav gStaMeasurements" */
+	argc -= 3;
+	argv += 3;
+
+	set->n = 0;
+	if (argc && strncmp(argv[0], "--", 2)) {
+		memset(&set->stas[0], 0, sizeof(set->stas[0]));
+		if (mac_addr_a2n(set->stas[0].addr, argv[0]))
+			return HANDLER_RET_USAGE;
+		set->n = 1;
+		argc--;
+		argv++;
+	}
+
+	for (i = 0; i < argc; i += used) {
+		used = parse_interval_count(argc - i, argv + i, &interval_ms,
+					    &count);
+		if (used <= 0)
+			return HANDLER_RET_USAGE;
+	}
+	if (count && !interval_ms)
+		return HANDLER_RET_USAGE;
+
+	ifindex = if_nametoindex(dev);
+	if (!ifindex)
+		return -ENODEV;
+
+	if (!set->n) {
+		struct nl80211_batch_req dump = {};
+
+		dump.msg = nl80211_batch_msg(state, NL80211_CMD_GET_STATION,
+					     NLM_F_DUMP, ifindex);
+		if (!dump.msg)
+			return -ENOMEM;
+		dump.handler = sta_msr_dump_handler;
+		dump.arg = set;
+		err = nl80211_batch(state, &dump, 1, 1);
+		nlmsg_free(dump.msg);
+		if (!err)
+			err = dump.err;
+		if (err)
+			return err;
+	}
+	/* the same stations are followed in interval mode */
+	sta_msr_sets[1] = *set;
+
+	for (n = 0; ; n++) {
+		err = sta_msr_fetch(state, ifindex, &sta_msr_sets[cur]);
+		if (err)
+			return err;
+		sample_ms = now_ms();
+
+		if (!interval_ms) {
+			for (i = 0; i < set->n; i++) {
+				struct sta_msr *sm = &set->stas[i];
+				char addr[20];
+				int min = 0, max = 0, imb;
+
+				mac_addr_n2a(addr, sm->addr);
+				fprintf(stdout, "Station %s\n", addr);
+				if (!sm->valid) {
+					fprintf(stdout, "\tfw measurements:\t%s\n",
+						sm->err == -EMSGSIZE ?
+						"short reply" : strerror(-sm->err));
+					continue;
+				}
+				print_vendor_sta_info(&sm->info, sizeof(sm->info));
+				imb = sta_msr_imbalance(&sm->info, &min, &max);
+				if (imb >= 0)
+					fprintf(stdout, "\tfw rssi imbalance:\t%d dB\n",
+						imb);
+			}
+			return 0;
+		}
+
+		if (n > 0) {
+			const struct sta_msr_set *now = &sta_msr_sets[cur];
+			const struct sta_msr_set *old = &sta_msr_sets[!cur];
+
+			fprintf(stdout, "%llu ms:\n", sample_ms - last_ms);
+			for (i = 0; i < now->n; i++)
+				sta_msr_print_rates(&now->stas[i],
+						    sta_msr_find(old, now->stas[i].addr),
+						    sample_ms - last_ms);
+			fprintf(stdout, "\n");
+			fflush(stdout);
+		}
+		last_ms = sample_ms;
+		cur = !cur;
+
+		if (count && n >= count)
+			break;
+		usleep(interval_ms * 1000);
+	}
+	return 0;
+}
+COMMAND(iwlwav, gStaMeasurements, "[<MAC address>] [--interval <ms> [--count <n>]]",
+	0, 0, CIB_NETDEV, handle_stats_get_sta_measurements,
+	"Get the firmware measurements of one station, or of all stations of\n"
+	"the interface. With --interval print TX/RX rates and the per-antenna\n"
+	"RSSI imbalance every <ms> milliseconds.");
+
+/*
+ * 'iwlwav gVapMeasurements' decodes GET_VAP_MEASUREMENTS of the interface
+ * or, with --all, of every AP interface on the same radio; the interface
+ * dump and the vendor requests are each one batch. With --interval the
+ * deltas give the A-MPDU density (MPDUs per A-MPDU), the RTS failure
+ * ratio and the unicast/multicast/broadcast split of the packets.
+ */
+#define VAP_MSR_MAX		32
+
+struct vap_msr {
+	int ifindex;
+	char ifname[IFNAMSIZ];
+	uint32_t wiphy;
+	uint32_t iftype;
+	bool valid;
+	int err;
+	struct intel_vendor_vap_info info;
+};
+
+struct vap_msr_set {
+	struct vap_msr vaps[VAP_MSR_MAX];
+	int n;
+};
+
+static struct vap_msr_set vap_msr_sets[2];
+
+static int vap_msr_iface_handler(struct nl_msg *msg, void *arg)
+{
+	struct vap_msr_set *set = arg;
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct vap_msr *vm;
+
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+	if (!tb[NL80211_ATTR_IFINDEX] || !tb[NL80211_ATTR_WIPHY] ||
+	    set->n == VAP_MSR_MAX)
+		return NL_SKIP;
+
+	vm = &set->vaps[set->n++];
+	memset(vm, 0, sizeof(*vm));
+	vm->ifindex = nla_get_u32(tb[NL80211_ATTR_IFINDEX]);
+	vm->wiphy = nla_get_u32(tb[NL80211_ATTR_WIPHY]);
+	if (tb[NL80211_ATTR_IFTYPE])
+		vm->iftype = nla_get_u32(tb[NL80211_ATTR_IFTYPE]);
+	if (tb[NL80211_ATTR_IFNAME])
+		strncpy(vm->ifname, nla_get_string(tb[NL80211_ATTR_IFNAME]),
+			IFNAMSIZ - 1);
+	return NL_SKIP;
+}
+
+static int vap_msr_handler(struct nl_msg *msg, void *arg)
+{
+	struct vap_msr *vm = arg;
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr *attr;
+
+	attr = nla_find(genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0),
+			NL80211_ATTR_VENDOR_DATA);
+	if (!attr) {
+		vm->err = -ENODATA;
+		return NL_SKIP;
+	}
+	if (nla_len(attr) < (int)sizeof(vm->info)) {
+		vm->err = -EMSGSIZE;
+		return NL_SKIP;
+	}
+
+	memcpy(&vm->info, nla_data(attr), sizeof(vm->info));
+	vm->valid = true;
+	return NL_SKIP;
+}
+
+/* the interface itself, or all AP interfaces of its radio */
+static int vap_msr_list(struct nl80211_state *state, int ifindex, bool all,
+			struct vap_msr_set *set)
+{
+	struct nl80211_batch_req dump = {};
+	uint32_t wiphy = 0;
+	int i, n = 0, err;
+
+	set->n = 0;
+	dump.msg = nl80211_batch_msg(state, NL80211_CMD_GET_INTERFACE,
+				     NLM_F_DUMP, 0);
+	if (!dump.msg)
+		return -ENOMEM;
+	dump.handler = vap_msr_iface_handler;
+	dump.arg = set;
+	err = nl80211_batch(state, &dump, 1, 1);
+	nlmsg_free(dump.msg);
+	if (!err)
+		err = dump.err;
+	if (err)
+		return err;
+
+	for (i = 0; i < set->n; i++)
+		if (set->vaps[i].ifindex == ifindex)
+			wiphy = set->vaps[i].wiphy;
+
+	for (i = 0; i < set->n; i++) {
+		struct vap_msr *vm = &set->vaps[i];
+
+		if (vm->ifindex == ifindex ||
+		    (all && vm->wiphy == wiphy &&
+		     vm->iftype == NL80211_IFTYPE_AP))
+			set->vaps[n++] = *vm;
+	}
+	set->n = n;
+	return n ? 0 : -ENODEV;
+}
+
+static int vap_msr_fetch(struct nl80211_state *state, struct vap_msr_set *set)
+{
+	struct nl80211_batch_req reqs[VAP_MSR_MAX] = {};
+	int i, err = 0;
+
+	for (i = 0; i < set->n; i++) {
+		struct nl_msg *msg;
+
+		set->vaps[i].valid = false;
+		set->vaps[i].err = 0;
+
+		msg = nl80211_batch_msg(state, NL80211_CMD_VENDOR, 0,
+					set->vaps[i].ifindex);
+		if (!msg) {
+			err = -ENOMEM;
+			goto out;
+		}
+		reqs[i].msg = msg;
+		reqs[i].handler = vap_msr_handler;
+		reqs[i].arg = &set->vaps[i];
+		NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ);
+		NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_SUBCMD,
+			    LTQ_NL80211_VENDOR_SUBCMD_GET_VAP_MEASUREMENTS);
+	}
+
+	err = nl80211_batch(state, reqs, set->n, 0);
+	for (i = 0; !err && i < set->n; i++)
+		if (reqs[i].err)
+			set->vaps[i].err = reqs[i].err;
+	goto out;
+
+ nla_put_failure:
+	err = -ENOBUFS;
+ out:
+	for (i = 0; i < set->n; i++)
+		nlmsg_free(reqs[i].msg);
+	return err;
+}
+
+static void print_vendor_traffic_stats(const struct intel_vendor_traffic_stats *t,
+				       const struct intel_vendor_error_stats *e)
+{
+	fprintf(stdout, "\trx bytes:\t%llu\n", t->BytesReceived);
+	fprintf(stdout, "\trx packets:\t%llu (unicast %u, multicast %u, broadcast %u)\n",
+		t->PacketsReceived, t->UnicastPacketsReceived,
+		t->MulticastPacketsReceived, t->BroadcastPacketsReceived);
+	fprintf(stdout, "\ttx bytes:\t%llu\n", t->BytesSent);
+	fprintf(stdout, "\ttx packets:\t%llu (unicast %u, multicast %u, broadcast %u)\n",
+		t->PacketsSent, t->UnicastPacketsSent,
+		t->MulticastPacketsSent, t->BroadcastPacketsSent);
+	fprintf(stdout, "\trx errors:\t%u (discarded %u)\n",
+		e->ErrorsReceived, e->DiscardPacketsReceived);
+	fprintf(stdout, "\ttx errors:\t%u (discarded %u)\n",
+		e->ErrorsSent, e->DiscardPacketsSent);
+}
+
+static void print_vendor_vap_info(const struct intel_vendor_vap_info *info)
+{
+	print_vendor_traffic_stats(&info->traffic_stats, &info->error_stats);
+	fprintf(stdout, "\ttx retrans:\t%u (failed %u)\n",
+		info->RetransCount, info->FailedRetransCount);
+	fprintf(stdout, "\ttx retries:\t%u (multiple %u)\n",
+		info->RetryCount, info->MultipleRetryCount);
+	fprintf(stdout, "\tack failures:\t%u\n", info->ACKFailureCount);
+	fprintf(stdout, "\taggregated packets:\t%u\n", info->AggregatedPacketCount);
+	fprintf(stdout, "\tunknown protocol rx:\t%u\n", info->UnknownProtoPacketsReceived);
+	fprintf(stdout, "\ttx a-msdu:\t%u (%llu octets, failed %u, ack failures %u)\n",
+		info->TransmittedAMSDUCount, info->TransmittedOctetsInAMSDUCount,
+		info->FailedAMSDUCount, info->AMSDUAckFailureCount);
+	fprintf(stdout, "\trx a-msdu:\t%u (%llu octets)\n",
+		info->ReceivedAMSDUCount, info->ReceivedOctetsInAMSDUCount);
+	fprintf(stdout, "\ttx a-mpdu:\t%u (%u mpdus, %llu octets)\n",
+		info->TransmittedAMPDUCount, info->TransmittedMPDUsInAMPDUCount,
+		info->TransmittedOctetsInAMPDUCount);
+	fprintf(stdout, "\trx a-mpdu:\t%u (%u mpdus, %llu octets)\n",
+		info->AMPDUReceivedCount, info->MPDUInReceivedAMPDUCount,
+		info->ReceivedOctetsInAMPDUCount);
+	fprintf(stdout, "\trts:\t%u ok, %u failed\n",
+		info->RTSSuccessCount, info->RTSFailureCount);
+	fprintf(stdout, "\tbar failures:\t%u implicit, %u explicit\n",
+		info->ImplicitBARFailureCount, info->ExplicitBARFailureCount);
+	fprintf(stdout, "\ttx 20/40 MHz frames:\t%u / %u\n",
+		info->TwentyMHzFrameTransmittedCount,
+		info->FortyMHzFrameTransmittedCount);
+	fprintf(stdout, "\tchannel switches 20->40 / 40->20:\t%u / %u\n",
+		info->SwitchChannel20To40, info->SwitchChannel40To20);
+	fprintf(stdout, "\tduplicate frames:\t%u\n", info->FrameDuplicateCount);
+}
+
+/* percentages of the unicast/multicast/broadcast packets in an interval */
+static void print_cast_split(const char *dir, u32 uc, u32 mc, u32 bc)
+{
+	double total = (double)uc + mc + bc;
+
+	if (!total) {
+		fprintf(stdout, "\t%s u/m/b -", dir);
+		return;
+	}
+	fprintf(stdout, "\t%s u/m/b %.0f/%.0f/%.0f%%", dir, uc * 100 / total,
+		mc * 100 / total, bc * 100 / total);
+}
+
+static void vap_msr_print_delta(const struct vap_msr *vm,
+				const struct vap_msr *prev,
+				unsigned long long ms)
+{
+	const struct intel_vendor_vap_info *cur = &vm->info, *old;
+	const struct intel_vendor_traffic_stats *t = &cur->traffic_stats;
+	const struct intel_vendor_traffic_stats *pt;
+	u32 ampdu, mpdu, rts_ok, rts_fail;
+
+	if (!vm->valid || !prev || !prev->valid || !ms) {
+		fprintf(stdout, "%s\t%s\n", vm->ifname,
+			vm->err ? strerror(-vm->err) : "-");
+		return;
+	}
+	old = &prev->info;
+	pt = &old->traffic_stats;
+	if (t->BytesSent < pt->BytesSent ||
+	    t->BytesReceived < pt->BytesReceived) {
+		fprintf(stdout, "%s\tcounters reset\n", vm->ifname);
+		return;
+	}
+
+	fprintf(stdout, "%s\trx %.1f kbit/s\ttx %.1f kbit/s", vm->ifname,
+		(t->BytesReceived - pt->BytesReceived) * 8.0 / ms,
+		(t->BytesSent - pt->BytesSent) * 8.0 / ms);
+
+	print_cast_split("rx", t->UnicastPacketsReceived - pt->UnicastPacketsReceived,
+			 t->MulticastPacketsReceived - pt->MulticastPacketsReceived,
+			 t->BroadcastPacketsReceived - pt->BroadcastPacketsReceived);
+	print_cast_split("tx", t->UnicastPacketsSent - pt->UnicastPacketsSent,
+			 t->MulticastPacketsSent - pt->MulticastPacketsSent,
+			 t->BroadcastPacketsSent - pt->BroadcastPacketsSent);
+
+	ampdu = cur->TransmittedAMPDUCount - old->TransmittedAMPDUCount;
+	mpdu = cur->TransmittedMPDUsInAMPDUCount - old->TransmittedMPDUsInAMPDUCount;
+	if (ampdu)
+		fprintf(stdout, "\ttx a-mpdu density %.1f", (double)mpdu / ampdu);
+	else
+		fprintf(stdout, "\ttx a-mpdu density -");
+
+	ampdu = cur->AMPDUReceivedCount - old->AMPDUReceivedCount;
+	mpdu = cur->MPDUInReceivedAMPDUCount - old->MPDUInReceivedAMPDUCount;
+	if (ampdu)
+		fprintf(stdout, "\trx a-mpdu density %.1f", (double)mpdu / ampdu);
+	else
+		fprintf(stdout, "\trx a-mpdu density -");
+
+	rts_ok = cur->RTSSuccessCount - old->RTSSuccessCount;
+	rts_fail = cur->RTSFailureCount - old->RTSFailureCount;
+	if (rts_ok + rts_fail)
+		fprintf(stdout, "\trts failed %.1f%%",
+			rts_fail * 100.0 / ((double)rts_ok + rts_fail));
+	else
+		fprintf(stdout, "\trts failed -");
+	fprintf(stdout, "\n");
+}
+
+static int handle_stats_get_vap_measurements(struct nl80211_state *state,
+					     struct nl_msg *msg, int argc,
+					     char **argv, enum id_input id)
+{
+	unsigned long interval_ms = 0, count = 0, n;
+	unsigned long long last_ms = 0, sample_ms;
+	struct vap_msr_set *set = &vap_msr_sets[0];
+	const char *dev = argv[0];
+	int ifindex, err, cur = 0, i, used;
+	bool all = false;
+
+	/* we get the full command line, skip "<dev> iwlwav gVapMeasurements" */
+	argc -= 3;
+	argv += 3;
+
+	for (i = 0; i < argc; i++) {
+		if (!strcmp(argv[i], "--all")) {
+			all = true;
+			continue;
+		}
+		used = parse_interval_count(argc - i, argv + i, &interval_ms,
+					    &count);
+		if (used <= 0)
+			return HANDLER_RET_USAGE;
+		i += used - 1;
+	}
+	if (count && !interval_ms)
+		return HANDLER_RET_USAGE;
+
+	ifindex = if_nametoindex(dev);
+	if (!ifindex)
+		return -ENODEV;
+
+	err = vap_msr_list(state, ifindex, all, set);
+	if (err)
+		return err;
+	vap_msr_sets[1] = *set;
+
+	for (n = 0; ; n++) {
+		err = vap_msr_fetch(state, &vap_msr_sets[cur]);
+		if (err)
+			return err;
+		sample_ms = now_ms();
+
+		if (!interval_ms) {
+			for (i = 0; i < set->n; i++) {
+				struct vap_msr *vm = &set->vaps[i];
+
+				fprintf(stdout, "VAP %s\n", vm->ifname);
+				if (vm->valid)
+					print_vendor_vap_info(&vm->info);
+				else
+					fprintf(stdout, "\tvap measurements:\t%s\n",
+						vm->err == -EMSGSIZE ?
+						"short reply" : strerror(-vm->err));
+			}
+			return 0;
+		}
+
+		if (n > 0) {
+			fprintf(stdout, "%llu ms:\n", sample_ms - last_ms);
+			for (i = 0; i < set->n; i++)
+				vap_msr_print_delta(&vap_msr_sets[cur].vaps[i],
+						    &vap_msr_sets[!cur].vaps[i],
+						    sample_ms - last_ms);
+			fprintf(stdout, "\n");
+			fflush(stdout);
+		}
+		last_ms = sample_ms;
+		cur = !cur;
+
+		if (count && n >= count)
+			break;
+		usleep(interval_ms * 1000);
+	}
+	return 0;
+}
+COMMAND(iwlwav, gVapMeasurements, "[--all] [--interval <ms> [--count <n>]]",
+	0, 0, CIB_NETDEV, handle_stats_get_vap_measurements,
+	"Get the firmware measurements of the VAP, or with --all of every AP\n"
+	"interface of the radio. With --interval print rates, the A-MPDU\n"
+	"density, the RTS failure ratio and the unicast/multicast/broadcast\n"
+	"split every <ms> milliseconds.");
+
+/*
+ * 'iwlwav gRadioInfo' decodes GET_RADIO_INFO and compares the channel,
+ * width and center frequencies with what nl80211 reports for the
+ * interface; both requests go out in one batch. With --interval the
+ * FCS errors are given against the received packets, and noise and load
+ * with their change and range over the run.
+ */
+struct radio_info_sample {
+	bool valid;
+	int err;
+	struct intel_vendor_radio_info info;
+	/* from nl80211 */
+	bool have_chan;
+	uint32_t freq, center_freq1, center_freq2;
+	int width;
+};
+
+static int radio_info_handler(struct nl_msg *msg, void *arg)
+{
+	struct radio_info_sample *rs = arg;
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr *attr;
+
+	attr = nla_find(genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0),
+			NL80211_ATTR_VENDOR_DATA);
+	if (!attr) {
+		rs->err = -ENODATA;
+		return NL_SKIP;
+	}
+	if (nla_len(attr) < (int)sizeof(rs->info)) {
+		rs->err = -EMSGSIZE;
+		return NL_SKIP;
+	}
+
+	memcpy(&rs->info, nla_data(attr), sizeof(rs->info));
+	rs->valid = true;
+	return NL_SKIP;
+}
+
+static int radio_width_mhz(enum nl80211_chan_width width)
+{
+	switch (width) {
+	case NL80211_CHAN_WIDTH_20_NOHT:
+	case NL80211_CHAN_WIDTH_20:
+		return 20;
+	case NL80211_CHAN_WIDTH_40:
+		return 40;
+	case NL80211_CHAN_WIDTH_80:
+		return 80;
+	case NL80211_CHAN_WIDTH_80P80:
+	case NL80211_CHAN_WIDTH_160:
+		return 160;
+	case NL80211_CHAN_WIDTH_320:
+		return 320;
+	default:
+		return 0;
+	}
+}
+
+static int radio_iface_handler(struct nl_msg *msg, void *arg)
+{
+	struct radio_info_sample *rs = arg;
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+	if (!tb[NL80211_ATTR_WIPHY_FREQ])
+		return NL_SKIP;
+
+	rs->have_chan = true;
+	rs->freq = nla_get_u32(tb[NL80211_ATTR_WIPHY_FREQ]);
+	if (tb[NL80211_ATTR_CHANNEL_WIDTH])
+		rs->width = radio_width_mhz(nla_get_u32(tb[NL80211_ATTR_CHANNEL_WIDTH]));
+	if (tb[NL80211_ATTR_CENTER_FREQ1])
+		rs->center_freq1 = nla_get_u32(tb[NL80211_ATTR_CENTER_FREQ1]);
+	if (tb[NL80211_ATTR_CENTER_FREQ2])
+		rs->center_freq2 = nla_get_u32(tb[NL80211_ATTR_CENTER_FREQ2]);
+	return NL_SKIP;
+}
+
+static int radio_info_fetch(struct nl80211_state *state, int ifindex,
+			    struct radio_info_sample *rs)
+{
+	struct nl80211_batch_req reqs[2] = {};
+	int err, i;
+
+	memset(rs, 0, sizeof(*rs));
+
+	reqs[0].msg = nl80211_batch_msg(state, NL80211_CMD_VENDOR, 0, ifindex);
+	reqs[1].msg = nl80211_batch_msg(state, NL80211_CMD_GET_INTERFACE, 0,
+					ifindex);
+	if (!reqs[0].msg || !reqs[1].msg) {
+		err = -ENOMEM;
+		goto out;
+	}
+	reqs[0].handler = radio_info_handler;
+	reqs[1].handler = radio_iface_handler;
+	reqs[0].arg = reqs[1].arg = rs;
+	NLA_PUT_U32(reqs[0].msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ);
+	NLA_PUT_U32(reqs[0].msg, NL80211_ATTR_VENDOR_SUBCMD,
+		    LTQ_NL80211_VENDOR_SUBCMD_GET_RADIO_INFO);
+
+	err = nl80211_batch(state, reqs, 2, 0);
+	if (!err && reqs[0].err)
+		rs->err = reqs[0].err;
+	goto out;
+
+ nla_put_failure:
+	err = -ENOBUFS;
+ out:
+	for (i = 0; i < 2; i++)
+		nlmsg_free(reqs[i].msg);
+	return err;
+}
+
+/* returns the number of mismatches printed */
+static int radio_info_check(const struct radio_info_sample *rs)
+{
+	const struct intel_vendor_radio_info *info = &rs->info;
+	int chan, bad = 0;
+
+	if (!rs->have_chan) {
+		fprintf(stdout, "\tnl80211:\tno channel, not checked\n");
+		return 0;
+	}
+
+	chan = ieee80211_frequency_to_channel(rs->freq);
+	if (info->Channel != chan) {
+		fprintf(stdout, "\tMISMATCH channel:\tfw %u, nl80211 %d\n",
+			info->Channel, chan);
+		bad++;
+	}
+	if (info->primary_center_freq != rs->freq) {
+		fprintf(stdout, "\tMISMATCH primary freq:\tfw %u MHz, nl80211 %u MHz\n",
+			info->primary_center_freq, rs->freq);
+		bad++;
+	}
+	if (rs->width && info->width != (u32)rs->width) {
+		fprintf(stdout, "\tMISMATCH width:\tfw %u MHz, nl80211 %d MHz\n",
+			info->width, rs->width);
+		bad++;
+	}
+	if (rs->center_freq1 && info->center_freq1 != rs->center_freq1) {
+		fprintf(stdout, "\tMISMATCH center freq1:\tfw %u MHz, nl80211 %u MHz\n",
+			info->center_freq1, rs->center_freq1);
+		bad++;
+	}
+	if (info->center_freq2 != rs->center_freq2) {
+		fprintf(stdout, "\tMISMATCH center freq2:\tfw %u MHz, nl80211 %u MHz\n",
+			info->center_freq2, rs->center_freq2);
+		bad++;
+	}
+	return bad;
+}
+
+static void print_vendor_radio_info(const struct intel_vendor_radio_info *info)
+{
+	fprintf(stdout, "\tenabled:\t%u\n", info->Enable);
+	fprintf(stdout, "\tchannel:\t%u\n", info->Channel);
+	fprintf(stdout, "\tprimary freq:\t%u MHz\n", info->primary_center_freq);
+	fprintf(stdout, "\tcenter freq1:\t%u MHz\n", info->center_freq1);
+	if (info->center_freq2)
+		fprintf(stdout, "\tcenter freq2:\t%u MHz\n", info->center_freq2);
+	fprintf(stdout, "\twidth:\t%u MHz\n", info->width);
+	fprintf(stdout, "\tnoise:\t%d dBm\n", info->Noise);
+	fprintf(stdout, "\tload:\t%u%%\n", info->load);
+	fprintf(stdout, "\tfcs errors:\t%u\n", info->FCSErrorCount);
+	fprintf(stdout, "\ttx power cfg:\t%u\n", info->tx_pwr_cfg);
+	fprintf(stdout, "\tantennas:\t%u tx, %u rx\n",
+		info->num_tx_antennas, info->num_rx_antennas);
+	fprintf(stdout, "\ttsf start:\t%llu\n", info->tsf_start_time);
+	print_vendor_traffic_stats(&info->traffic_stats, &info->error_stats);
+}
+
+static int handle_stats_get_radio_info(struct nl80211_state *state,
+				       struct nl_msg *msg, int argc,
+				       char **argv, enum id_input id)
+{
+	static struct radio_info_sample samples[2];
+	unsigned long interval_ms = 0, count = 0, n;
+	unsigned long long last_ms = 0, sample_ms;
+	const char *dev = argv[0];
+	int ifindex, err, cur = 0, i, used;
+	int noise_min = 0, noise_max = 0, load_min = 0, load_max = 0;
+	bool seen = false;
+
+	/* we get the full command line, skip "<dev> iwlwav gRadioInfo" */
+	argc -= 3;
+	argv += 3;
+
+	for (i = 0; i < argc; i += used) {
+		used = parse_interval_count(argc - i, argv + i, &interval_ms,
+					    &count);
+		if (used <= 0)
+			return HANDLER_RET_USAGE;
+	}
+	if (count && !interval_ms)
+		return HANDLER_RET_USAGE;
+
+	ifindex = if_nametoindex(dev);
+	if (!ifindex)
+		return -ENODEV;
+
+	for (n = 0; ; n++) {
+		struct radio_info_sample *rs = &samples[cur];
+		const struct radio_info_sample *prev = &samples[!cur];
+
+		err = radio_info_fetch(state, ifindex, rs);
+		if (err)
+			return err;
+		sample_ms = now_ms();
+
+		if (!rs->valid) {
+			fprintf(stderr, "%s: %s\n", dev, rs->err == -EMSGSIZE ?
+				"short radio info reply" : strerror(-rs->err));
+			return 2;
+		}
+
+		if (!interval_ms) {
+			fprintf(stdout, "Radio %s\n", dev);
+			print_vendor_radio_info(&rs->info);
+			radio_info_check(rs);
+			return 0;
+		}
+
+		if (!seen || rs->info.Noise < noise_min)
+			noise_min = rs->info.Noise;
+		if (!seen || rs->info.Noise > noise_max)
+			noise_max = rs->info.Noise;
+		if (!seen || rs->info.load < load_min)
+			load_min = rs->info.load;
+		if (!seen || rs->info.load > load_max)
+			load_max = rs->info.load;
+		seen = true;
+
+		if (n > 0) {
+			const struct intel_vendor_traffic_stats *t = &rs->info.traffic_stats;
+			const struct intel_vendor_traffic_stats *pt = &prev->info.traffic_stats;
+			u32 fcs = rs->info.FCSErrorCount - prev->info.FCSErrorCount;
+			unsigned long long rx = 0;
+
+			if (t->PacketsReceived >= pt->PacketsReceived)
+				rx = t->PacketsReceived - pt->PacketsReceived;
+
+			fprintf(stdout, "%s (%llu ms):\tfcs errors %.1f/s", dev,
+				sample_ms - last_ms,
+				fcs * 1000.0 / (sample_ms - last_ms));
+			if (rx + fcs)
+				fprintf(stdout, " (%.2f%% of rx)",
+					fcs * 100.0 / ((double)rx + fcs));
+			fprintf(stdout, "\tnoise %d dBm (%+d, %d..%d)\tload %u%% (%+d, %d..%d)\n",
+				rs->info.Noise, rs->info.Noise - prev->info.Noise,
+				noise_min, noise_max, rs->info.load,
+				rs->info.load - prev->info.load,
+				load_min, load_max);
+			radio_info_check(rs);
+			fflush(stdout);
+		}
+		last_ms = sample_ms;
+		cur = !cur;
+
+		if (count && n >= count)
+			break;
+		usleep(interval_ms * 1000);
+	}
+	return 0;
+}
+COMMAND(iwlwav, gRadioInfo, "[--interval <ms> [--count <n>]]",
+	0, 0, CIB_NETDEV, handle_stats_get_radio_info,
+	"Get the firmware radio info and check its channel and width against\n"
+	"nl80211. With --interval print the FCS error rate and the noise and\n"
+	"load trend every <ms> milliseconds.");
+
+/*
+ * 'iwlwav gTR181' exports the TR-181 Device.WiFi counters of a radio:
+ * GET_TR181_HW_STATS for the radio, GET_TR181_WLAN_STATS for each of its
+ * AP interfaces and GET_TR181_PEER_STATS for each associated station,
+ * all requested in one batch after an interface and station dump.
+ *
+ * The vendor header has no structures of its own for these replies. They
+ * are assumed to be the structures it has for the same TR-181 counters,
+ * intel_vendor_radio_info, intel_vendor_vap_info and intel_vendor_sta_info
+ * ("corresponds to vendor_sta_info in Driver"), and the tables below pick
+ * the TR-181 parameters out of those by offsetof(). A reply whose length
+ * isn't the sizeof() of its structure is reported and not decoded, so a
+ * different driver structure isn't misread.
+ */
+enum tr181_type {
+	TR181_U8,
+	TR181_U32,
+	TR181_S32,
+	TR181_U64,
+};
+
+struct tr181_field {
+	const char *name;
+	size_t offset;
+	enum tr181_type type;
+};
+
+struct tr181_layout {
+	const char *name;
+	const char *source;
+	size_t size;
+	const struct tr181_field *fields;
+	int n_fields;
+};
+
+#define TR181_FIELD(_struct, _member, _name, _type)		\
+	{ _name, offsetof(struct _struct, _member), _type }
+
+#define TR181_RADIO(_member, _name, _type)			\
+	TR181_FIELD(intel_vendor_radio_info, _member, _name, _type)
+#define TR181_SSID(_member, _name, _type)			\
+	TR181_FIELD(intel_vendor_vap_info, _member, _name, _type)
+#define TR181_PEER(_member, _name, _type)			\
+	TR181_FIELD(intel_vendor_sta_info, _member, _name, _type)
+
+static const struct tr181_field tr181_radio_fields[] = {
+	TR181_RADIO(Enable, "Enable", TR181_U8),
+	TR181_RADIO(Channel, "Channel", TR181_U8),
+	TR181_RADIO(traffic_stats.BytesSent, "Stats.BytesSent", TR181_U64),
+	TR181_RADIO(traffic_stats.BytesReceived, "Stats.BytesReceived", TR181_U64),
+	TR181_RADIO(traffic_stats.PacketsSent, "Stats.PacketsSent", TR181_U64),
+	TR181_RADIO(traffic_stats.PacketsReceived, "Stats.PacketsReceived", TR181_U64),
+	TR181_RADIO(error_stats.ErrorsSent, "Stats.ErrorsSent", TR181_U32),
+	TR181_RADIO(error_stats.ErrorsReceived, "Stats.ErrorsReceived", TR181_U32),
+	TR181_RADIO(error_stats.DiscardPacketsSent, "Stats.DiscardPacketsSent", TR181_U32),
+	TR181_RADIO(error_stats.DiscardPacketsReceived, "Stats.DiscardPacketsReceived", TR181_U32),
+	TR181_RADIO(FCSErrorCount, "Stats.FCSErrorCount", TR181_U32),
+	TR181_RADIO(Noise, "Stats.Noise", TR181_S32),
+};
+
+static const struct tr181_field tr181_ssid_fields[] = {
+	TR181_SSID(traffic_stats.BytesSent, "Stats.BytesSent", TR181_U64),
+	TR181_SSID(traffic_stats.BytesReceived, "Stats.BytesReceived", TR181_U64),
+	TR181_SSID(traffic_stats.PacketsSent, "Stats.PacketsSent", TR181_U64),
+	TR181_SSID(traffic_stats.PacketsReceived, "Stats.PacketsReceived", TR181_U64),
+	TR181_SSID(traffic_stats.UnicastPacketsSent, "Stats.UnicastPacketsSent", TR181_U32),
+	TR181_SSID(traffic_stats.UnicastPacketsReceived, "Stats.UnicastPacketsReceived", TR181_U32),
+	TR181_SSID(traffic_stats.MulticastPacketsSent, "Stats.MulticastPacketsSent", TR181_U32),
+	TR181_SSID(traffic_stats.MulticastPacketsReceived, "Stats.MulticastPacketsReceived", TR181_U32),
+	TR181_SSID(traffic_stats.BroadcastPacketsSent, "Stats.BroadcastPacketsSent", TR181_U32),
+	TR181_SSID(traffic_stats.BroadcastPacketsReceived, "Stats.BroadcastPacketsReceived", TR181_U32),
+	TR181_SSID(error_stats.ErrorsSent, "Stats.ErrorsSent", TR181_U32),
+	TR181_SSID(error_stats.ErrorsReceived, "Stats.ErrorsReceived", TR181_U32),
+	TR181_SSID(error_stats.DiscardPacketsSent, "Stats.DiscardPacketsSent", TR181_U32),
+	TR181_SSID(error_stats.DiscardPacketsReceived, "Stats.DiscardPacketsReceived", TR181_U32),
+	TR181_SSID(RetransCount, "Stats.RetransCount", TR181_U32),
+	TR181_SSID(FailedRetransCount, "Stats.FailedRetransCount", TR181_U32),
+	TR181_SSID(RetryCount, "Stats.RetryCount", TR181_U32),
+	TR181_SSID(MultipleRetryCount, "Stats.MultipleRetryCount", TR181_U32),
+	TR181_SSID(ACKFailureCount, "Stats.ACKFailureCount", TR181_U32),
+	TR181_SSID(AggregatedPacketCount, "Stats.AggregatedPacketCount", TR181_U32),
+	TR181_SSID(UnknownProtoPacketsReceived, "Stats.UnknownProtoPacketsReceived", TR181_U32),
+};
+
+static const struct tr181_field tr181_peer_fields[] = {
+	TR181_PEER(LastDataDownlinkRate, "LastDataDownlinkRate", TR181_U32),
+	TR181_PEER(LastDataUplinkRate, "LastDataUplinkRate", TR181_U32),
+	TR181_PEER(SignalStrength, "SignalStrength", TR181_S32),
+	TR181_PEER(RetransCount, "Retransmissions", TR181_U32),
+	TR181_PEER(BytesSent, "Stats.BytesSent", TR181_U64),
+	TR181_PEER(BytesReceived, "Stats.BytesReceived", TR181_U64),
+	TR181_PEER(PacketsSent, "Stats.PacketsSent", TR181_U64),
+	TR181_PEER(PacketsReceived, "Stats.PacketsReceived", TR181_U64),
+	TR181_PEER(ErrorsSent, "Stats.ErrorsSent", TR181_U32),
+	TR181_PEER(RetransCount, "Stats.RetransCount", TR181_U32),
+	TR181_PEER(FailedRetransCount, "Stats.FailedRetransCount", TR181_U32),
+	TR181_PEER(RetryCount, "Stats.RetryCount", TR181_U32),
+};
+
+static const struct tr181_layout tr181_radio = {
+	"GET_TR181_HW_STATS", "intel_vendor_radio_info",
+	sizeof(struct intel_vendor_radio_info),
+	tr181_radio_fields, ARRAY_SIZE(tr181_radio_fields),
+};
+static const struct tr181_layout tr181_ssid = {
+	"GET_TR181_WLAN_STATS", "intel_vendor_vap_info",
+	sizeof(struct intel_vendor_vap_info),
+	tr181_ssid_fields, ARRAY_SIZE(tr181_ssid_fields),
+};
+static const struct tr181_layout tr181_peer = {
+	"GET_TR181_PEER_STATS", "intel_vendor_sta_info",
+	sizeof(struct intel_vendor_sta_info),
+	tr181_peer_fields, ARRAY_SIZE(tr181_peer_fields),
+};
+
+static void tr181_print(const char *path, const struct tr181_layout *l,
+			const uint8_t *data, int len)
+{
+	int i;
+
+	if (len != (int)l->size) {
+		fprintf(stderr, "%s: %s reply is %d bytes, struct %s has %zu, not decoded\n",
+			path, l->name, len, l->source, l->size);
+		return;
+	}
+
+	for (i = 0; i < l->n_fields; i++) {
+		const struct tr181_field *f = &l->fields[i];
+		uint64_t u64;
+		uint32_t u32;
+
+		switch (f->type) {
+		case TR181_U8:
+			fprintf(stdout, "%s.%s=%u\n", path, f->name,
+				data[f->offset]);
+			break;
+		case TR181_U64:
+			memcpy(&u64, data + f->offset, sizeof(u64));
+			fprintf(stdout, "%s.%s=%llu\n", path, f->name,
+				(unsigned long long)u64);
+			break;
+		case TR181_U32:
+			memcpy(&u32, data + f->offset, sizeof(u32));
+			fprintf(stdout, "%s.%s=%u\n", path, f->name, u32);
+			break;
+		case TR181_S32:
+			memcpy(&u32, data + f->offset, sizeof(u32));
+			fprintf(stdout, "%s.%s=%d\n", path, f->name, (int32_t)u32);
+			break;
+		}
+	}
+}
+
+struct stats_blob {
+	uint8_t *data;
+	int len;
+};
+
+struct tr181_peer {
+	unsigned char addr[ETH_ALEN];
+	int vap;
+	struct stats_blob blob;
+};
+
+struct tr181_state {
+	struct vap_msr_set vaps;
+	struct stats_blob radio;
+	struct stats_blob ssid[VAP_MSR_MAX];
+	struct tr181_peer *peers;
+	int n_peers, cur_vap;
+};
+
+static int stats_blob_handler(struct nl_msg *msg, void *arg)
+{
+	struct stats_blob *blob = arg;
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr *attr;
+
+	attr = nla_find(genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0),
+			NL80211_ATTR_VENDOR_DATA);
+	if (!attr || blob->data)
+		return NL_SKIP;
+
+	blob->data = malloc(nla_len(attr));
+	if (!blob->data)
+		return NL_SKIP;
+	memcpy(blob->data, nla_data(attr), nla_len(attr));
+	blob->len = nla_len(attr);
+	return NL_SKIP;
+}
+
+static int tr181_station_handler(struct nl_msg *msg, void *arg)
+{
+	struct tr181_state *ts = arg;
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct tr181_peer *peers;
+	int i;
+
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+	if (!tb[NL80211_ATTR_MAC] || !tb[NL80211_ATTR_IFINDEX])
+		return NL_SKIP;
+
+	peers = realloc(ts->peers, (ts->n_peers + 1) * sizeof(*peers));
+	if (!peers)
+		return NL_SKIP;
+	ts->peers = peers;
+	memset(&peers[ts->n_peers], 0, sizeof(*peers));
+	memcpy(peers[ts->n_peers].addr, nla_data(tb[NL80211_ATTR_MAC]), ETH_ALEN);
+	peers[ts->n_peers].vap = -1;
+	for (i = 0; i < ts->vaps.n; i++)
+		if (ts->vaps.vaps[i].ifindex == (int)nla_get_u32(tb[NL80211_ATTR_IFINDEX]))
+			peers[ts->n_peers].vap = i;
+	ts->n_peers++;
+	return NL_SKIP;
+}
+
+static struct nl_msg *stats_vendor_msg(struct nl80211_state *state,
+				       int ifindex, uint32_t subcmd,
+				       const unsigned char *addr)
+{
+	struct nl_msg *msg;
+
+	msg = nl80211_batch_msg(state, NL80211_CMD_VENDOR, 0, ifindex);
+	if (!msg)
+		return NULL;
+
+	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_ID, OUI_LTQ);
+	NLA_PUT_U32(msg, NL80211_ATTR_VENDOR_SUBCMD, subcmd);
+	if (addr)
+		NLA_PUT(msg, NL80211_ATTR_VENDOR_DATA, ETH_ALEN, addr);
+	return msg;
+
+ nla_put_failure:
+	nlmsg_free(msg);
+	return NULL;
+}
+
+static int handle_stats_get_tr181(struct nl80211_state *state,
+				  struct nl_msg *msg, int argc,
+				  char **argv, enum id_input id)
+{
+	static struct tr181_state ts;
+	struct nl80211_batch_req *reqs = NULL;
+	int ifindex, n_reqs, err, i, n = 0;
+	const char *dev = argv[0];
+	char path[128];
+
+	/* we get the full command line, skip "<dev> iwlwav gTR181" */
+	if (argc != 3)
+		return HANDLER_RET_USAGE;
+
+	ifindex = if_nametoindex(dev);
+	if (!ifindex)
+		return -ENODEV;
+
+	memset(&ts, 0, sizeof(ts));
+	err = vap_msr_list(state, ifindex, true, &ts.vaps);
+	if (err)
+		return err;
+
+	/* associated devices of all VAPs */
+	reqs = calloc(ts.vaps.n, sizeof(*reqs));
+	if (!reqs)
+		return -ENOMEM;
+	for (i = 0; i < ts.vaps.n; i++) {
+		reqs[i].msg = nl80211_batch_msg(state, NL80211_CMD_GET_STATION,
+						NLM_F_DUMP, ts.vaps.vaps[i].ifindex);
+		reqs[i].handler = tr181_station_handler;
+		reqs[i].arg = &ts;
+	}
+	err = nl80211_batch(state, reqs, ts.vaps.n, 0);
+	for (i = 0; i < ts.vaps.n; i++)
+		nlmsg_free(reqs[i].msg);
+	free(reqs);
+	reqs = NULL;
+	if (err)
+		goto out;
+
+	n_reqs = 1 + ts.vaps.n + ts.n_peers;
+	reqs = calloc(n_reqs, sizeof(*reqs));
+	if (!reqs) {
+		err = -ENOMEM;
+		goto out;
+	}
+
+	reqs[n].msg = stats_vendor_msg(state, ifindex,
+				       LTQ_NL80211_VENDOR_SUBCMD_GET_TR181_HW_STATS,
+				       NULL);
+	reqs[n].handler = stats_blob_handler;
+	reqs[n++].arg = &ts.radio;
+	for (i = 0; i < ts.vaps.n; i++) {
+		reqs[n].msg = stats_vendor_msg(state, ts.vaps.vaps[i].ifindex,
+					       LTQ_NL80211_VENDOR_SUBCMD_GET_TR181_WLAN_STATS,
+					       NULL);
+		reqs[n].handler = stats_blob_handler;
+		reqs[n++].arg = &ts.ssid[i];
+	}
+	for (i = 0; i < ts.n_peers; i++) {
+		struct tr181_peer *p = &ts.peers[i];
+
+		reqs[n].msg = stats_vendor_msg(state, p->vap >= 0 ?
+					       ts.vaps.vaps[p->vap].ifindex : ifindex,
+					       LTQ_NL80211_VENDOR_SUBCMD_GET_TR181_PEER_STATS,
+					       p->addr);
+		reqs[n].handler = stats_blob_handler;
+		reqs[n++].arg = &p->blob;
+	}
+
+	err = nl80211_batch(state, reqs, n_reqs, STA_MSR_WINDOW);
+	if (err)
+		goto out;
+
+	/* TR-181 instances count from 1, wiphy indexes from 0 */
+	snprintf(path, sizeof(path), "Device.WiFi.Radio.1");
+	for (i = 0; i < ts.vaps.n; i++)
+		if (ts.vaps.vaps[i].ifindex == ifindex)
+			snprintf(path, sizeof(path), "Device.WiFi.Radio.%u",
+				 ts.vaps.vaps[i].wiphy + 1);
+	fprintf(stdout, "%s.Name=%s\n", path, dev);
+	if (reqs[0].err)
+		fprintf(stderr, "%s: %s\n", path, strerror(-reqs[0].err));
+	else
+		tr181_print(path, &tr181_radio, ts.radio.data, ts.radio.len);
+
+	for (i = 0; i < ts.vaps.n; i++) {
+		int j, k = 0;
+
+		snprintf(path, sizeof(path), "Device.WiFi.SSID.%d", i + 1);
+		fprintf(stdout, "%s.Name=%s\n", path, ts.vaps.vaps[i].ifname);
+		if (reqs[1 + i].err)
+			fprintf(stderr, "%s: %s\n", path, strerror(-reqs[1 + i].err));
+		else
+			tr181_print(path, &tr181_ssid, ts.ssid[i].data,
+				    ts.ssid[i].len);
+
+		for (j = 0; j < ts.n_peers; j++) {
+			struct tr181_peer *p = &ts.peers[j];
+			char addr[20];
+
+			if (p->vap != i)
+				continue;
+			snprintf(path, sizeof(path),
+				 "Device.WiFi.AccessPoint.%d.AssociatedDevice.%d",
+				 i + 1, ++k);
+			mac_addr_n2a(addr, p->addr);
+			fprintf(stdout, "%s.MACAddress=%s\n", path, addr);
+			if (reqs[1 + ts.vaps.n + j].err)
+				fprintf(stderr, "%s: %s\n", path,
+					strerror(-reqs[1 + ts.vaps.n + j].err));
+			else
+				tr181_print(path, &tr181_peer, p->blob.data,
+					    p->blob.len);
+		}
+	}
+
+ out:
+	for (i = 0; reqs && i < n; i++)
+		nlmsg_free(reqs[i].msg);
+	free(reqs);
+	free(ts.radio.data);
+	for (i = 0; i < ts.vaps.n; i++)
+		free(ts.ssid[i].data);
+	for (i = 0; i < ts.n_peers; i++)
+		free(ts.peers[i].blob.data);
+	free(ts.peers);
+	return err;
+}
+COMMAND(iwlwav, gTR181, "",
+	0, 0, CIB_NETDEV, handle_stats_get_tr181,
+	"Print the TR-181 Device.WiFi radio, SSID and associated device\n"
+	"counters of the radio under their TR-181 parameter names.");
+
+/*
+ * 'iwlwav gLinkAdaptation' fetches every link adaptation statistics
+ * family of a station (request data is its MAC address) or of the radio
+ * in one batch. The MU groups counters are decoded like
+ * gLinkAdaptationMuGroupsCounters does. The vendor header has no
+ * structures for the other replies, so they are hexdumped unless the user
+ * gives a --schema file ('vendor recv --schema' uses the same format)
+ * with a layout for them. In interval mode the families are fetched again
+ * every <ms> milliseconds and printed as deltas: counters as rates,
+ * counter arrays as distributions (MCS, RU size, group), and gauges such
+ * as the current rate or MU group as transitions.
+ */
+struct la_family {
+	const char *name;
+	uint32_t subcmd;
+	void (*decode)(const struct stats_blob *now,
+		       const struct stats_blob *old,
+		       unsigned long long interval_ms);
+};
+
+static void la_mu_groups_decode(const struct stats_blob *now,
+				const struct stats_blob *old,
+				unsigned long long interval_ms)
+{
+	mu_groups_sample_t cur = {}, prev = {};
+
+	if (mu_groups_parse(now->data, now->len, &cur)) {
+		fprintf(stderr, "MU groups counters reply of %d bytes doesn't match the layout\n",
+			now->len);
+		iw_hexdump("vendor response", now->data, now->len);
+		return;
+	}
+	if (!old) {
+		dump_la_mu_groups_counters_stats(&cur);
+		return;
+	}
+	if (!mu_groups_parse(old->data, old->len, &prev))
+		dump_la_mu_groups_churn(&cur, &prev, interval_ms);
+}
+
+static const struct la_family la_families[] = {
+	{ "GET_LINK_ADAPTION_STATS",
+	  LTQ_NL80211_VENDOR_SUBCMD_GET_LINK_ADAPTION_STATS, NULL },
+	{ "GET_LINK_ADAPT_MU_OFDMA_STATS",
+	  LTQ_NL80211_VENDOR_SUBCMD_GET_LINK_ADAPT_MU_OFDMA_STATS, NULL },
+	{ "GET_LINK_ADAPT_SU_MU_RU_OFDMA_STATS",
+	  LTQ_NL80211_VENDOR_SUBCMD_GET_LINK_ADAPT_SU_MU_RU_OFDMA_STATS, NULL },
+	{ "GET_LINK_ADAPT_MIMO_OFDMA_STATS",
+	  LTQ_NL80211_VENDOR_SUBCMD_GET_LINK_ADAPT_MIMO_OFDMA_STATS, NULL },
+	{ "GET_LA_MU_HE_EHT_STATS",
+	  LTQ_NL80211_VENDOR_SUBCMD_GET_LA_MU_HE_EHT_STATS, NULL },
+	{ "GET_LINK_ADAPT_MU_GROUPS_COUNTERS_STATS",
+	  LTQ_NL80211_VENDOR_SUBCMD_GET_LINK_ADAPT_MU_GROUPS_COUNTERS_STATS,
+	  la_mu_groups_decode },
+};
+
+#define LA_FAMILIES	ARRAY_SIZE(la_families)
+
+struct la_sample {
+	struct stats_blob blob[LA_FAMILIES];
+};
+
+static void la_sample_clear(struct la_sample *ls)
+{
+	unsigned int i;
+
+	for (i = 0; i < LA_FAMILIES; i++) {
+		free(ls->blob[i].data);
+		ls->blob[i].data = NULL;
+		ls->blob[i].len = 0;
+	}
+}
+
+static int handle_stats_get_link_adaptation(struct nl80211_state *state,
+					    struct nl_msg *msg, int argc,
+					    char **argv, enum id_input id)
+{
+	static struct la_sample samples[2];
+	const struct vendor_schema *layouts[LA_FAMILIES] = {};
+	struct nl80211_batch_req reqs[LA_FAMILIES] = {};
+	unsigned long interval_ms = 0, count = 0, n;
+	unsigned long long last_ms = 0, sample_ms;
+	struct vendor_schema *schema = NULL;
+	unsigned char addr[ETH_ALEN];
+	bool sta = false;
+	const char *dev = argv[0], *path = NULL;
+	int ifindex, err = 0, cur = 0, i, used;
+	unsigned int f;
+
+	/* we get the full command line, skip "<dev> iwlwav gLinkAdaptation" */
+	argc -= 3;
+	argv += 3;
+
+	if (argc && strncmp(argv[0], "--", 2)) {
+		if (mac_addr_a2n(addr, argv[0]))
+			return HANDLER_RET_USAGE;
+		sta = true;
+		argc--;
+		argv++;
+	}
+
+	for (i = 0; i < argc; i += used) {
+		if (!strcmp(argv[i], "--schema") && i + 1 < argc) {
+			path = argv[i + 1];
+			used = 2;
+			continue;
+		}
+		used = parse_interval_count(argc - i, argv + i, &interval_ms,
+					    &count);
+		if (used <= 0)
+			return HANDLER_RET_USAGE;
+	}
+	if (count && !interval_ms)
+		return HANDLER_RET_USAGE;
+
+	ifindex = if_nametoindex(dev);
+	if (!ifindex)
+		return -ENODEV;
+
+	if (path) {
+		schema = vendor_schema_load(path);
+		if (!schema)
+			return 2;
+	}
+
+	for (f = 0; f < LA_FAMILIES; f++) {
+		if (schema && !la_families[f].decode) {
+			layouts[f] = vendor_schema_find(schema, OUI_LTQ,
+							la_families[f].subcmd);
+			if (!layouts[f])
+				fprintf(stderr, "%s: no layout for %s, hexdumped\n",
+					path, la_families[f].name);
+		}
+		reqs[f].msg = stats_vendor_msg(state, ifindex,
+					       la_families[f].subcmd,
+					       sta ? addr : NULL);
+		if (!reqs[f].msg) {
+			err = -ENOMEM;
+			goto out;
+		}
+		reqs[f].handler = stats_blob_handler;
+	}
+
+	for (n = 0; ; n++) {
+		struct la_sample *now = &samples[cur], *old = &samples[!cur];
+
+		la_sample_clear(now);
+		for (f = 0; f < LA_FAMILIES; f++) {
+			reqs[f].arg = &now->blob[f];
+			reqs[f].done = false;
+			reqs[f].err = 0;
+		}
+		err = nl80211_batch(state, reqs, LA_FAMILIES, LA_FAMILIES);
+		if (err)
+			goto out;
+		sample_ms = now_ms();
+
+		if (n > 0 || !interval_ms) {
+			if (interval_ms)
+				fprintf(stdout, "%llu ms:\n", sample_ms - last_ms);
+			for (f = 0; f < LA_FAMILIES; f++) {
+				struct stats_blob *b = &now->blob[f];
+
+				fprintf(stdout, "%s:\n", la_families[f].name);
+				if (reqs[f].err) {
+					fprintf(stdout, "\t%s\n",
+						strerror(-reqs[f].err));
+					continue;
+				}
+				if (!b->data)
+					continue;
+				if (la_families[f].decode)
+					la_families[f].decode(b, interval_ms ?
+							      &old->blob[f] : NULL,
+							      sample_ms - last_ms);
+				else if (!layouts[f])
+					iw_hexdump("vendor response", b->data,
+						   b->len);
+				else if (!interval_ms || old->blob[f].len != b->len)
+					vendor_schema_decode(layouts[f], false,
+							     b->data, b->len);
+				else
+					vendor_schema_delta(layouts[f],
+							    old->blob[f].data,
+							    b->data, b->len,
+							    sample_ms - last_ms);
+			}
+			fprintf(stdout, "\n");
+			fflush(stdout);
+		}
+		if (!interval_ms)
+			break;
+		last_ms = sample_ms;
+		cur = !cur;
+
+		if (count && n >= count)
+			break;
+		usleep(interval_ms * 1000);
+	}
+
+ out:
+	for (f = 0; f < LA_FAMILIES; f++)
+		nlmsg_free(reqs[f].msg);
+	la_sample_clear(&samples[0]);
+	la_sample_clear(&samples[1]);
+	vendor_schema_free(schema);
+	return err;
+}
+COMMAND(iwlwav, gLinkAdaptation,
+	"[<MAC address>] [--schema <file>] [--interval <ms> [--count <n>]]",
+	0, 0, CIB_NETDEV, handle_stats_get_link_adaptation,
+	"Get all link adaptation statistics of the station, or of the radio\n"
+	"without a MAC address. The MU groups counters are always decoded, the\n"
+	"other families are hexdumped unless the schema file has a layout for\n"
+	"them. With --interval print counter\n"
+	"rates and distributions and gauge transitions every <ms> milliseconds.");
@@ -1,4 +1,8 @@
 #include <net/if.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
 
 #include <netlink/genl/genl.h>
 #include <netlink/genl/family.h>
@@ -84,7 +88,310 @@ static int handle_survey_dump(struct nl80211_state *state,
 	register_handler(print_survey_handler, NULL);
 	return 0;
 }
-COMMAND(survey, dump, "[--radio]",
-	NL80211_CMD_GET_SURVEY, NLM_F_DUMP, CIB_NETDEV, handle_survey_dump,
-	"List all gathered channel survey data");
 
+/*
+ * 'survey dump --interval': the survey counters are cumulative, so each
+ * interval is reported as the share of the active time the channel was
+ * busy, transmitting and receiving; what is busy but neither our rx
+ * nor our tx is accounted to other BSSs (obss). Drivers restart the
+ * counters of a channel when they switch to it, a counter that went
+ * backwards is therefore taken as having started from zero within the
+ * interval. With --radio there is one entry for the whole radio.
+ */
+struct survey_sample {
+	uint32_t freq;		/* 0 for radio statistics */
+	bool in_use, seen;
+	bool have_busy, have_rx, have_tx, have_noise;
+	uint64_t active, busy, rx, tx;
+	int noise, noise_min, noise_max, noise_prev;
+	long long noise_sum;
+	unsigned int n_noise;
+};
+
+struct survey_watch {
+	struct survey_sample *s;
+	int n, size;
+	bool report;
+	int idle;
+};
+
+static struct survey_watch survey_watch;
+
+static struct survey_sample *survey_watch_lookup(struct survey_watch *sw,
+						 uint32_t freq)
+{
+	struct survey_sample *s;
+	int i;
+
+	for (i = 0; i < sw->n; i++)
+		if (sw->s[i].freq == freq)
+			return &sw->s[i];
+
+	if (sw->n == sw->size) {
+		int size = sw->size ? sw->size * 2 : 32;
+
+		s = realloc(sw->s, size * sizeof(*s));
+		if (!s)
+			return NULL;
+		sw->s = s;
+		sw->size = size;
+	}
+
+	s = &sw->s[sw->n++];
+	memset(s, 0, sizeof(*s));
+	s->freq = freq;
+	return s;
+}
+
+/* counter difference, restarting from zero if it went backwards */
+static uint64_t survey_delta(uint64_t now, uint64_t prev, bool *reset)
+{
+	if (now >= prev)
+		return now - prev;
+	*reset = true;
+	return now;
+}
+
+static void survey_watch_print(struct survey_sample *s, uint64_t active,
+			       uint64_t busy, uint64_t rx, uint64_t tx,
+			       bool reset)
+{
+	if (s->freq)
+		printf("%5u%s", s->freq, s->in_use ? "*" : " ");
+	else
+		printf("%-6s", "radio");
+	printf(" %8llu", (unsigned long long)active);
+
+	if (s->have_busy)
+		printf(" %6.1f", 100.0 * busy / active);
+	else
+		printf(" %6s", "-");
+	if (s->have_tx)
+		printf(" %6.1f", 100.0 * tx / active);
+	else
+		printf(" %6s", "-");
+	if (s->have_rx)
+		printf(" %6.1f", 100.0 * rx / active);
+	else
+		printf(" %6s", "-");
+	if (s->have_busy && s->have_rx && s->have_tx)
+		printf(" %6.1f", busy > rx + tx ?
+				 100.0 * (busy - rx - tx) / active : 0.0);
+	else
+		printf(" %6s", "-");
+
+	if (s->have_noise && s->n_noise)
+		printf(" %6d %+6d %6.1f %4d/%-4d", s->noise,
+		       s->n_noise > 1 ? s->noise - s->noise_prev : 0,
+		       (double)s->noise_sum / s->n_noise,
+		       s->noise_min, s->noise_max);
+	else
+		printf(" %6s %6s %6s %9s", "-", "-", "-", "-");
+
+	printf("%s\n", reset ? "  (counters reset)" : "");
+}
+
+static int survey_watch_handler(struct nl_msg *msg, void *arg)
+{
+	struct survey_watch *sw = arg;
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+	struct nlattr *sinfo[NL80211_SURVEY_INFO_MAX + 1];
+	struct survey_sample *s, prev;
+	uint64_t active, busy = 0, rx = 0, tx = 0;
+	bool reset = false;
+	uint32_t freq = 0;
+
+	static struct nla_policy survey_policy[NL80211_SURVEY_INFO_MAX + 1] = {
+		[NL80211_SURVEY_INFO_FREQUENCY] = { .type = NLA_U32 },
+		[NL80211_SURVEY_INFO_NOISE] = { .type = NLA_U8 },
+		[NL80211_SURVEY_INFO_CHANNEL_TIME] = { .type = NLA_U64 },
+		[NL80211_SURVEY_INFO_CHANNEL_TIME_BUSY] = { .type = NLA_U64 },
+		[NL80211_SURVEY_INFO_CHANNEL_TIME_RX] = { .type = NLA_U64 },
+		[NL80211_SURVEY_INFO_CHANNEL_TIME_TX] = { .type = NLA_U64 },
+	};
+
+	nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0),
+		  genlmsg_attrlen(gnlh, 0), NULL);
+
+	if (!tb[NL80211_ATTR_SURVEY_INFO] ||
+	    nla_parse_nested(sinfo, NL80211_SURVEY_INFO_MAX,
+			     tb[NL80211_ATTR_SURVEY_INFO], survey_policy))
+		return NL_SKIP;
+
+	/* without the active time there is nothing to relate to */
+	if (!sinfo[NL80211_SURVEY_INFO_CHANNEL_TIME])
+		return NL_SKIP;
+
+	if (sinfo[NL80211_SURVEY_INFO_FREQUENCY])
+		freq = nla_get_u32(sinfo[NL80211_SURVEY_INFO_FREQUENCY]);
+
+	s = survey_watch_lookup(sw, freq);
+	if (!s)
+		return NL_SKIP;
+	prev = *s;
+
+	s->seen = true;
+	s->in_use = !!sinfo[NL80211_SURVEY_INFO_IN_USE];
+	s->active = nla_get_u64(sinfo[NL80211_SURVEY_INFO_CHANNEL_TIME]);
+	s->have_busy = !!sinfo[NL80211_SURVEY_INFO_CHANNEL_TIME_BUSY];
+	if (s->have_busy)
+		s->busy = nla_get_u64(sinfo[NL80211_SURVEY_INFO_CHANNEL_TIME_BUSY]);
+	s->have_rx = !!sinfo[NL80211_SURVEY_INFO_CHANNEL_TIME_RX];
+	if (s->have_rx)
+		s->rx = nla_get_u64(sinfo[NL80211_SURVEY_INFO_CHANNEL_TIME_RX]);
+	s->have_tx = !!sinfo[NL80211_SURVEY_INFO_CHANNEL_TIME_TX];
+	if (s->have_tx)
+		s->tx = nla_get_u64(sinfo[NL80211_SURVEY_INFO_CHANNEL_TIME_TX]);
+
+	s->have_noise = !!sinfo[NL80211_SURVEY_INFO_NOISE];
+	if (s->have_noise) {
+		int noise = (int8_t)nla_get_u8(sinfo[NL80211_SURVEY_INFO_NOISE]);
+
+		if (!s->n_noise || noise < s->noise_min)
+			s->noise_min = noise;
+		if (!s->n_noise || noise > s->noise_max)
+			s->noise_max = noise;
+		s->noise_prev = s->n_noise ? s->noise : noise;
+		s->noise = noise;
+		s->noise_sum += noise;
+		s->n_noise++;
+	}
+
+	/* first time we see this channel, nothing to compare with */
+	if (!sw->report || !prev.seen)
+		return NL_SKIP;
+
+	active = survey_delta(s->active, prev.active, &reset);
+	/* after a reset all counters started over together */
+	if (reset) {
+		busy = s->busy;
+		rx = s->rx;
+		tx = s->tx;
+	} else {
+		busy = survey_delta(s->busy, prev.busy, &reset);
+		rx = survey_delta(s->rx, prev.rx, &reset);
+		tx = survey_delta(s->tx, prev.tx, &reset);
+	}
+
+	/* channels not visited during this interval */
+	if (!active) {
+		sw->idle++;
+		return NL_SKIP;
+	}
+
+	survey_watch_print(s, active, busy, rx, tx, reset);
+	return NL_SKIP;
+}
+
+static int handle_survey_dump_sample(struct nl80211_state *state,
+				     struct nl_msg *msg,
+				     int argc, char **argv,
+				     enum id_input id)
+{
+	if (argc && !strcmp(argv[0], "--radio"))
+		nla_put_flag(msg, NL80211_ATTR_SURVEY_RADIO_STATS);
+
+	register_handler(survey_watch_handler, &survey_watch);
+	return 0;
+}
+HIDDEN(survey, dump_sample, "[--radio]", NL80211_CMD_GET_SURVEY, NLM_F_DUMP,
+	CIB_NETDEV, handle_survey_dump_sample);
+
+static int handle_survey_dump_interval(struct nl80211_state *state,
+				       struct nl_msg *msg,
+				       int argc, char **argv,
+				       enum id_input id)
+{
+	struct survey_watch *sw = &survey_watch;
+	char *sample_argv[] = {
+		argv[0],
+		"survey",
+		"dump_sample",
+		NULL,
+	};
+	int sample_argc = 3;
+	unsigned long long last_ms, sample_ms;
+	unsigned long interval_ms = 0, count = 0, n;
+	int err, used;
+
+	/* we get the full command line, skip "<dev> survey dump" */
+	argc -= 3;
+	argv += 3;
+
+	while (argc) {
+		if (!strcmp(argv[0], "--radio")) {
+			sample_argv[sample_argc++] = "--radio";
+			argc--;
+			argv++;
+			continue;
+		}
+		used = parse_interval_count(argc, argv, &interval_ms, &count);
+		if (used <= 0)
+			return HANDLER_RET_USAGE;
+		argc -= used;
+		argv += used;
+	}
+
+	if (!interval_ms)
+		return HANDLER_RET_USAGE;
+
+	last_ms = now_ms();
+
+	for (n = 0; !count || n <= count; n++) {
+		sample_ms = now_ms();
+		sw->report = n > 0;
+		sw->idle = 0;
+
+		if (sw->report)
+			printf("%-6s %8s %6s %6s %6s %6s %6s %6s %6s %9s\n",
+			       "freq", "active", "busy%", "tx%", "rx%",
+			       "obss%", "noise", "d", "avg", "min/max");
+
+		err = handle_cmd(state, id, sample_argc, sample_argv);
+		if (err)
+			return err;
+
+		if (sw->report) {
+			printf("(%llu ms", sample_ms - last_ms);
+			if (sw->idle)
+				printf(", %d channels not visited", sw->idle);
+			printf(")\n\n");
+			fflush(stdout);
+		}
+		last_ms = sample_ms;
+
+		if (!count || n < count)
+			usleep(interval_ms * 1000);
+	}
+
+	free(sw->s);
+	return 0;
+}
+
+static const struct cmd *survey_dump_plain;
+static const struct cmd *survey_dump_interval;
+
+static const struct cmd *select_survey_dump_cmd(int argc, char **argv)
+{
+	int i;
+
+	for (i = 0; i < argc; i++)
+		if (!strcmp(argv[i], "--interval"))
+			return survey_dump_interval;
+	return survey_dump_plain;
+}
+
+COMMAND_ALIAS(survey, dump, "[--radio]",
+	NL80211_CMD_GET_SURVEY, NLM_F_DUMP, CIB_NETDEV, handle_survey_dump,
+	"List all gathered channel survey data",
+	select_survey_dump_cmd, survey_dump_plain);
+COMMAND_ALIAS(survey, dump, "[--radio] --interval <ms> [--count <n>]",
+	0, 0, CIB_NETDEV, handle_survey_dump_interval,
+	"Sample the survey data every <ms> milliseconds (<n> times, default\n"
+	"forever) and print per channel the active time of the interval and\n"
+	"the share of it the channel was busy, transmitting, receiving and\n"
+	"busy with other BSSs (busy - rx - tx), plus the noise floor with\n"
+	"its change, average and range. Channels marked * are in use;\n"
+	"counters that were reset (e.g. on a channel change) are detected.",
+	select_survey_dump_cmd, survey_dump_interval);
@@ -2,6 +2,7 @@
 #include <netlink/attr.h>
 #include <errno.h>
 #include <stdbool.h>
+#include <time.h>
 #include "iw.h"
 #include "nl80211.h"
 
@@ -1847,6 +1848,49 @@ void iw_hexdump(const char *prefix, const __u8 *buf, size_t size)
 	printf("\n\n");
 }
 
+/* monotonic time in milliseconds, for the interval modes */
+unsigned long long now_ms(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000ULL + ts.tv_nsec / 1000000;
+}
+
+/*
+ * Parse "--interval <ms>" or "--count <n>" of an interval mode at argv[0].
+ * Returns the number of arguments used, 0 if argv[0] is neither option,
+ * or -EINVAL if the value is missing, isn't a number, or the interval is 0.
+ */
+int parse_interval_count(int argc, char **argv,
+			 unsigned long *interval_ms, unsigned long *count)
+{
+	unsigned long val;
+	bool interval;
+	char *end;
+
+	if (argc < 1)
+		return 0;
+	if (!strcmp(argv[0], "--interval"))
+		interval = true;
+	else if (!strcmp(argv[0], "--count"))
+		interval = false;
+	else
+		return 0;
+
+	if (argc < 2)
+		return -EINVAL;
+	val = strtoul(argv[1], &end, 10);
+	if (*end || end == argv[1] || (interval && !val))
+		return -EINVAL;
+
+	if (interval)
+		*interval_ms = val;
+	else
+		*count = val;
+	return 2;
+}
+
 int get_cf1(const struct chanmode *chanmode, unsigned long freq)
 {
 	unsigned int cf1 = freq, j;
@@ -1,5 +1,7 @@
 #include <errno.h>
 #include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
 
 #include <netlink/genl/genl.h>
 #include <netlink/genl/family.h>
@@ -39,6 +41,470 @@ static int print_vendor_response(struct nl_msg *msg, void *arg)
 	return NL_OK;
 }
 
+/*
+ * Vendor replies are mostly packed driver structures that iw has no
+ * printer for. 'vendor recv ... --schema <file>' decodes them from a text
+ * description instead, one block per (OUI, subcmd):
+ *
+ *	# comment
+ *	struct <name> <oui> <subcmd>
+ *		<field> <type>[[<count>]] [le|be] [counter|gauge]
+ *		...
+ *
+ * <type> is one of u8, s8, u16, s16, u32, s32, u64, s64, mac or pad, an
+ * empty count ("[]") on the last field takes the rest of the reply.
+ * Fields are packed and in host byte order unless le or be is given. The
+ * reply length must match the layout, otherwise it is only hexdumped, so
+ * a changed driver structure is noticed instead of being misdecoded.
+ * With --export the fields are printed as counters and gauges in the
+ * Prometheus text format.
+ */
+enum vendor_schema_type {
+	VS_U8,
+	VS_S8,
+	VS_U16,
+	VS_S16,
+	VS_U32,
+	VS_S32,
+	VS_U64,
+	VS_S64,
+	VS_MAC,
+	VS_PAD,
+};
+
+static const struct {
+	const char *name;
+	int size;
+} vendor_schema_types[] = {
+	[VS_U8] = { "u8", 1 },
+	[VS_S8] = { "s8", 1 },
+	[VS_U16] = { "u16", 2 },
+	[VS_S16] = { "s16", 2 },
+	[VS_U32] = { "u32", 4 },
+	[VS_S32] = { "s32", 4 },
+	[VS_U64] = { "u64", 8 },
+	[VS_S64] = { "s64", 8 },
+	[VS_MAC] = { "mac", 6 },
+	[VS_PAD] = { "pad", 1 },
+};
+
+enum vendor_schema_order {
+	VS_HOST,
+	VS_LE,
+	VS_BE,
+};
+
+struct vendor_schema_field {
+	char name[64];
+	enum vendor_schema_type type;
+	enum vendor_schema_order order;
+	unsigned int count;	/* 0: rest of the reply */
+	bool counter;
+};
+
+struct vendor_schema {
+	char name[64];
+	unsigned int oui, subcmd;
+	struct vendor_schema_field *fields;
+	int n_fields;
+	struct vendor_schema *next;
+};
+
+struct vendor_schema_print {
+	const struct vendor_schema *schema;
+	bool export;
+};
+
+void vendor_schema_free(struct vendor_schema *vs)
+{
+	struct vendor_schema *next;
+
+	for (; vs; vs = next) {
+		next = vs->next;
+		free(vs->fields);
+		free(vs);
+	}
+}
+
+static int vendor_schema_parse_field(struct vendor_schema *vs, char *line)
+{
+	struct vendor_schema_field *f, *fields;
+	char *tok, *count, *end;
+	unsigned int i;
+
+	if (vs->n_fields && !vs->fields[vs->n_fields - 1].count)
+		return -EINVAL;	/* only the last field may be open */
+
+	fields = realloc(vs->fields, (vs->n_fields + 1) * sizeof(*fields));
+	if (!fields)
+		return -ENOMEM;
+	vs->fields = fields;
+	f = &fields[vs->n_fields];
+	memset(f, 0, sizeof(*f));
+	f->count = 1;
+
+	tok = strtok(line, " \t");
+	if (!tok || strlen(tok) >= sizeof(f->name))
+		return -EINVAL;
+	strcpy(f->name, tok);
+
+	tok = strtok(NULL, " \t");
+	if (!tok)
+		return -EINVAL;
+	count = strchr(tok, '[');
+	if (count) {
+		*count++ = '\0';
+		if (*count == ']') {
+			f->count = 0;
+			end = count;
+		} else {
+			f->count = strtoul(count, &end, 0);
+			if (!f->count)
+				return -EINVAL;
+		}
+		if (strcmp(end, "]"))
+			return -EINVAL;
+	}
+	for (i = 0; i < ARRAY_SIZE(vendor_schema_types); i++)
+		if (!strcmp(tok, vendor_schema_types[i].name))
+			break;
+	if (i == ARRAY_SIZE(vendor_schema_types))
+		return -EINVAL;
+	f->type = i;
+
+	while ((tok = strtok(NULL, " \t"))) {
+		if (!strcmp(tok, "le"))
+			f->order = VS_LE;
+		else if (!strcmp(tok, "be"))
+			f->order = VS_BE;
+		else if (!strcmp(tok, "counter"))
+			f->counter = true;
+		else if (!strcmp(tok, "gauge"))
+			f->counter = false;
+		else
+			return -EINVAL;
+	}
+
+	vs->n_fields++;
+	return 0;
+}
+
+struct vendor_schema *vendor_schema_load(const char *path)
+{
+	struct vendor_schema *head = NULL, **tail = &head, *vs = NULL;
+	char line[256], *p, *end, *name, *oui, *subcmd;
+	int lineno = 0, err = 0;
+	FILE *file;
+
+	file = fopen(path, "r");
+	if (!file) {
+		fprintf(stderr, "%s: %s\n", path, strerror(errno));
+		return NULL;
+	}
+
+	while (!err && fgets(line, sizeof(line), file)) {
+		lineno++;
+		p = strchr(line, '#');
+		if (p)
+			*p = '\0';
+		p = line + strlen(line);
+		while (p > line && isspace(p[-1]))
+			*--p = '\0';
+		for (p = line; isspace(*p); p++)
+			;
+		if (!*p)
+			continue;
+
+		if (strncmp(p, "struct", 6) || !isspace(p[6])) {
+			err = vs ? vendor_schema_parse_field(vs, p) : -EINVAL;
+			continue;
+		}
+
+		strtok(p, " \t");
+		name = strtok(NULL, " \t");
+		oui = strtok(NULL, " \t");
+		subcmd = strtok(NULL, " \t");
+		if (!subcmd || strtok(NULL, " \t") ||
+		    strlen(name) >= sizeof(vs->name)) {
+			err = -EINVAL;
+			continue;
+		}
+
+		vs = calloc(1, sizeof(*vs));
+		if (!vs) {
+			err = -ENOMEM;
+			continue;
+		}
+		*tail = vs;
+		tail = &vs->next;
+		strcpy(vs->name, name);
+		vs->oui = strtoul(oui, &end, 0);
+		if (*end)
+			err = -EINVAL;
+		vs->subcmd = strtoul(subcmd, &end, 0);
+		if (*end)
+			err = -EINVAL;
+	}
+	fclose(file);
+
+	if (err) {
+		fprintf(stderr, "%s:%d: %s\n", path, lineno,
+			err == -ENOMEM ? strerror(ENOMEM) : "invalid schema line");
+		vendor_schema_free(head);
+		return NULL;
+	}
+	return head;
+}
+
+const struct vendor_schema *
+vendor_schema_find(const struct vendor_schema *vs, unsigned int oui,
+		   unsigned int subcmd)
+{
+	for (; vs; vs = vs->next)
+		if (vs->oui == oui && vs->subcmd == subcmd)
+			return vs;
+	return NULL;
+}
+
+static uint64_t vendor_schema_get(const struct vendor_schema_field *f,
+				  const uint8_t *data)
+{
+	static const uint16_t probe = 1;
+	int i, size = vendor_schema_types[f->type].size;
+	bool le = f->order == VS_LE;
+	uint64_t val = 0;
+
+	if (f->order == VS_HOST)
+		le = *(const uint8_t *)&probe;
+
+	if (le) {
+		for (i = size - 1; i >= 0; i--)
+			val = (val << 8) | data[i];
+	} else {
+		for (i = 0; i < size; i++)
+			val = (val << 8) | data[i];
+	}
+
+	/* sign extend */
+	if (size < 8 && (f->type == VS_S8 || f->type == VS_S16 ||
+			 f->type == VS_S32) &&
+	    (val & (1ULL << (size * 8 - 1))))
+		val |= ~0ULL << (size * 8);
+	return val;
+}
+
+static bool vendor_schema_signed(enum vendor_schema_type type)
+{
+	return type == VS_S8 || type == VS_S16 || type == VS_S32 ||
+	       type == VS_S64;
+}
+
+/* size of the layout, with open arrays sized to fit @len */
+static int vendor_schema_size(const struct vendor_schema *vs, int len,
+			      unsigned int *open_count)
+{
+	int i, size = 0, elem;
+
+	*open_count = 0;
+	for (i = 0; i < vs->n_fields; i++) {
+		elem = vendor_schema_types[vs->fields[i].type].size;
+		if (vs->fields[i].count) {
+			size += elem * vs->fields[i].count;
+			continue;
+		}
+		if (len < size || (len - size) % elem)
+			return -1;
+		*open_count = (len - size) / elem;
+		size = len;
+	}
+	return size;
+}
+
+static void vendor_schema_print_value(const struct vendor_schema *vs,
+				      const struct vendor_schema_field *f,
+				      const uint8_t *data, unsigned int idx,
+				      bool array, bool export)
+{
+	uint64_t val = vendor_schema_get(f, data);
+	char index[24] = "", addr[20];
+
+	if (f->type == VS_MAC) {
+		mac_addr_n2a(addr, data);
+		if (!export)
+			printf(" %s", addr);
+		else if (array)
+			printf("%s_%s_info{index=\"%u\",addr=\"%s\"} 1\n",
+			       vs->name, f->name, idx, addr);
+		else
+			printf("%s_%s_info{addr=\"%s\"} 1\n",
+			       vs->name, f->name, addr);
+		return;
+	}
+
+	if (!export) {
+		if (vendor_schema_signed(f->type))
+			printf(" %lld", (long long)val);
+		else
+			printf(" %llu", (unsigned long long)val);
+		return;
+	}
+
+	if (array)
+		snprintf(index, sizeof(index), "{index=\"%u\"}", idx);
+	if (vendor_schema_signed(f->type))
+		printf("%s_%s%s %lld\n", vs->name, f->name, index,
+		       (long long)val);
+	else
+		printf("%s_%s%s %llu\n", vs->name, f->name, index,
+		       (unsigned long long)val);
+}
+
+void vendor_schema_decode(const struct vendor_schema *vs, bool export,
+			  const uint8_t *data, int len)
+{
+	unsigned int open_count, count, j;
+	int i, off = 0, size, elem;
+
+	size = vendor_schema_size(vs, len, &open_count);
+	if (size < 0) {
+		fprintf(stderr, "%s: reply of %d bytes doesn't fit the schema\n",
+			vs->name, len);
+		iw_hexdump("vendor response", data, len);
+		return;
+	}
+	if (size != len) {
+		fprintf(stderr, "%s: reply is %d bytes, schema describes %d\n",
+			vs->name, len, size);
+		iw_hexdump("vendor response", data, len);
+		return;
+	}
+
+	for (i = 0; i < vs->n_fields; i++) {
+		const struct vendor_schema_field *f = &vs->fields[i];
+		bool array = f->count != 1;
+
+		elem = vendor_schema_types[f->type].size;
+		count = f->count ? f->count : open_count;
+		if (f->type == VS_PAD) {
+			off += elem * count;
+			continue;
+		}
+
+		if (!export)
+			printf("%s:", f->name);
+		else if (f->type != VS_MAC)
+			printf("# TYPE %s_%s %s\n", vs->name, f->name,
+			       f->counter ? "counter" : "gauge");
+		for (j = 0; j < count; j++, off += elem)
+			vendor_schema_print_value(vs, f, data + off, j, array,
+						  export);
+		if (!export)
+			printf("\n");
+	}
+}
+
+/*
+ * Print what changed between two replies of the same layout: counters as
+ * deltas and per second rates, counter arrays as the share of each
+ * non-zero index (e.g. an MCS or RU distribution), gauges with their
+ * previous value where they moved.
+ */
+void vendor_schema_delta(const struct vendor_schema *vs, const uint8_t *prev,
+			 const uint8_t *cur, int len,
+			 unsigned long long interval_ms)
+{
+	unsigned int open_count, count, j;
+	int i, off, size, elem;
+	uint64_t d, total, mask;
+	char addr[20];
+
+	size = vendor_schema_size(vs, len, &open_count);
+	if (size != len) {
+		fprintf(stderr, "%s: reply of %d bytes doesn't fit the schema\n",
+			vs->name, len);
+		return;
+	}
+	if (!interval_ms)
+		interval_ms = 1;
+
+	for (i = 0, off = 0; i < vs->n_fields; i++, off += elem * count) {
+		const struct vendor_schema_field *f = &vs->fields[i];
+
+		elem = vendor_schema_types[f->type].size;
+		count = f->count ? f->count : open_count;
+		mask = elem == 8 ? ~0ULL : (1ULL << (elem * 8)) - 1;
+		if (f->type == VS_PAD)
+			continue;
+
+		if (f->type == VS_MAC) {
+			mac_addr_n2a(addr, cur + off);
+			printf("%s: %s\n", f->name, addr);
+			continue;
+		}
+
+		if (f->counter && count == 1) {
+			/* unsigned difference, so a wrapped counter still works */
+			d = (vendor_schema_get(f, cur + off) -
+			     vendor_schema_get(f, prev + off)) & mask;
+			printf("%s: +%llu (%.1f/s)\n", f->name,
+			       (unsigned long long)d, d * 1000.0 / interval_ms);
+			continue;
+		}
+
+		if (f->counter) {
+			total = 0;
+			for (j = 0; j < count; j++)
+				total += (vendor_schema_get(f, cur + off + j * elem) -
+					  vendor_schema_get(f, prev + off + j * elem)) & mask;
+			printf("%s: +%llu", f->name, (unsigned long long)total);
+			for (j = 0; total && j < count; j++) {
+				d = (vendor_schema_get(f, cur + off + j * elem) -
+				     vendor_schema_get(f, prev + off + j * elem)) & mask;
+				if (d)
+					printf(" [%u] %.1f%%", j, d * 100.0 / total);
+			}
+			printf("\n");
+			continue;
+		}
+
+		printf("%s:", f->name);
+		for (j = 0; j < count; j++) {
+			uint64_t p = vendor_schema_get(f, prev + off + j * elem);
+			uint64_t c = vendor_schema_get(f, cur + off + j * elem);
+
+			if (vendor_schema_signed(f->type) && p != c)
+				printf(" %lld->%lld", (long long)p, (long long)c);
+			else if (vendor_schema_signed(f->type))
+				printf(" %lld", (long long)c);
+			else if (p != c)
+				printf(" %llu->%llu", (unsigned long long)p,
+				       (unsigned long long)c);
+			else
+				printf(" %llu", (unsigned long long)c);
+		}
+		printf("\n");
+	}
+}
+
+static int print_vendor_schema(struct nl_msg *msg, void *arg)
+{
+	struct vendor_schema_print *vp = arg;
+	struct nlattr *attr;
+	struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+
+	attr = nla_find(genlmsg_attrdata(gnlh, 0),
+			genlmsg_attrlen(gnlh, 0),
+			NL80211_ATTR_VENDOR_DATA);
+	if (!attr) {
+		fprintf(stderr, "vendor data attribute missing!\n");
+		return NL_SKIP;
+	}
+
+	vendor_schema_decode(vp->schema, vp->export, nla_data(attr),
+			     nla_len(attr));
+	return NL_OK;
+}
+
 static int read_file(FILE *file, char *buf, size_t size)
 {
 	size_t count = 0;
@@ -130,7 +596,49 @@ static int handle_vendor_recv(struct nl80211_state *state,
 			      struct nl_msg *msg, int argc,
 			      char **argv, enum id_input id)
 {
-	register_handler(print_vendor_response, (void *) true);
+	static struct vendor_schema_print vp;
+	static struct vendor_schema *schemas;
+	const char *path = NULL;
+	unsigned int oui, subcmd;
+	int i;
+
+	for (i = 0; i < argc; i++)
+		if (!strcmp(argv[i], "--schema"))
+			break;
+	if (i == argc) {
+		register_handler(print_vendor_response, (void *) true);
+		return handle_vendor(state, msg, argc, argv, id);
+	}
+
+	if (i + 1 >= argc)
+		return HANDLER_RET_USAGE;
+	path = argv[i + 1];
+	if (i + 2 < argc) {
+		if (i + 3 != argc || strcmp(argv[i + 2], "--export"))
+			return HANDLER_RET_USAGE;
+		vp.export = true;
+	}
+	argc = i;
+
+	if (argc < 3)
+		return HANDLER_RET_USAGE;
+	if (sscanf(argv[0], "0x%x", &oui) != 1 ||
+	    sscanf(argv[1], "0x%x", &subcmd) != 1)
+		return handle_vendor(state, msg, argc, argv, id);
+
+	schemas = vendor_schema_load(path);
+	if (!schemas)
+		return 2;
+	vp.schema = vendor_schema_find(schemas, oui, subcmd);
+	if (!vp.schema) {
+		fprintf(stderr, "%s: no layout for OUI 0x%x subcmd 0x%x\n",
+			path, oui, subcmd);
+		vendor_schema_free(schemas);
+		schemas = NULL;
+		return 2;
+	}
+
+	register_handler(print_vendor_schema, &vp);
 	return handle_vendor(state, msg, argc, argv, id);
 }
 
@@ -143,5 +651,8 @@ static int handle_vendor_recv_bin(struct nl80211_state *state,
 }
 
 COMMAND(vendor, send, "<oui> <subcmd> <filename|-|hex data>", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_vendor, "");
-COMMAND(vendor, recv, "<oui> <subcmd> <filename|-|hex data>", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_vendor_recv, "");
+COMMAND(vendor, recv, "<oui> <subcmd> <filename|-|hex data> [--schema <file> [--export]]", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_vendor_recv,
+	"Send a vendor command and hexdump the reply, or with --schema decode\n"
+	"it using the layout the schema file gives for <oui> and <subcmd>.\n"
+	"With --export print the fields in the Prometheus text format.");
 COMMAND(vendor, recvbin, "<oui> <subcmd> <filename|-|hex data>", NL80211_CMD_VENDOR, 0, CIB_NETDEV, handle_vendor_recv_bin, "");